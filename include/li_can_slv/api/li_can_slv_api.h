@@ -422,6 +422,30 @@ extern "C" {
  */
 #define lcsa_dload_set_end_handle(hdl)	li_can_slv_dload_set_end_handle(hdl);
 
+#ifdef LI_CAN_SLV_DLOAD_PIPELINE
+/**
+ * @remarks NULL removes the handle while no block is committed.
+ * @param hdl handle function which starts the commit of a block of the pipelined download or NULL
+ * @return #LCSA_ERROR_DLOAD_ADD_HANDLE or #LCSA_ERROR_OK
+ */
+#define lcsa_dload_set_block_commit_handle(hdl)	li_can_slv_dload_set_block_commit_handle(hdl);
+
+/**
+ * @remarks Must be called from the context of the asynchronous CAN receive handling or from a context which cannot
+ * interrupt it, it may be called from within the block commit handle.
+ * @param err result of the commit of the block
+ * @return #LCSA_ERROR_OK or an error code
+ */
+#define lcsa_dload_block_committed(err)	li_can_slv_dload_block_committed(err)
+#endif // #ifdef LI_CAN_SLV_DLOAD_PIPELINE
+
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+/**
+ * @return offset at which the running download continues, 0 for a new download
+ */
+#define lcsa_dload_get_resume_offset()	li_can_slv_dload_get_resume_offset()
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+
 /**
  * @}
  */
@@ -452,6 +476,35 @@ extern "C" {
  */
 #define lcsa_uload_set_uload_block_ack_handle(hdl)	li_can_slv_uload_set_uload_block_ack_handle(hdl);
 
+/**
+ * @param hdl handle function for the progress of an upload block
+ * @return #LCSA_ERROR_ULOAD_ADD_HANDLE or #LCSA_ERROR_OK
+ */
+#define lcsa_uload_set_progress_handle(hdl)	li_can_slv_uload_set_progress_handle(hdl);
+
+/**
+ * @param hdl handle function for the end of an upload block
+ * @return #LCSA_ERROR_ULOAD_ADD_HANDLE or #LCSA_ERROR_OK
+ */
+#define lcsa_uload_set_block_sent_handle(hdl)	li_can_slv_uload_set_block_sent_handle(hdl);
+
+/**
+ * @remarks Blocks until all data objects and the data block end of the block are queued.
+ * @param data data of the component
+ * @param len number of bytes of the component sent at the end of the block
+ * @return #LCSA_ERROR_OK or an error code
+ */
+#define lcsa_uload_data_from_buffer(data, len)	li_can_slv_uload_data_from_buffer(data, len)
+
+/**
+ * @remarks Does not block, the block is sent by li_can_slv_process() and its end is reported by the block sent
+ * handle. The buffer must be valid until then.
+ * @param data data of the component
+ * @param len number of bytes of the component sent at the end of the block
+ * @return #LCSA_ERROR_OK or an error code
+ */
+#define lcsa_uload_data_from_buffer_start(data, len)	li_can_slv_uload_data_from_buffer_start(data, len)
+
 /**
  * @}
  */
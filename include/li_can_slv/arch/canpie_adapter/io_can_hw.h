@@ -54,6 +54,9 @@ extern "C" {
 /*--------------------------------------------------------------------------*/
 /* function prototypes                                                      */
 /*--------------------------------------------------------------------------*/
+#ifdef LI_CAN_SLV_HW_TIMESTAMP
+uint32_t can_hw_get_rx_ticks(CpCanMsg_ts *ptsCanMsgV);
+#endif // #ifdef LI_CAN_SLV_HW_TIMESTAMP
 
 #ifdef __cplusplus
 }// closing brace for extern "C"
@@ -47,6 +47,20 @@ extern "C" {
 #define CANPIE_MODE_LISTEN_ONLY	(eCP_MODE_LISTEN_ONLY)
 #define CANPIE_BUFFER_DIR_TX	(eCP_BUFFER_DIR_TRM)
 #define CANPIE_BUFFER_DIR_RX	(eCP_BUFFER_DIR_RCV)
+
+#ifdef LI_CAN_SLV_FD
+#ifndef LI_CAN_SLV_FD_DATA_BITRATE
+#define LI_CAN_SLV_FD_DATA_BITRATE	(eCP_BITRATE_2M)
+#endif // #ifndef LI_CAN_SLV_FD_DATA_BITRATE
+#define CANPIE_DATA_BITRATE	(LI_CAN_SLV_FD_DATA_BITRATE)
+/**
+ * @brief frame format of a message object, payloads above #CAN_DLC_MAX are transmitted as CAN FD
+ */
+#define CANPIE_MSG_FORMAT(dlc)	(((dlc) > CAN_DLC_MAX) ? CP_MSG_FORMAT_FBFF : CP_MSG_FORMAT_CBFF)
+#else
+#define CANPIE_DATA_BITRATE	(eCP_BITRATE_NONE)
+#define CANPIE_MSG_FORMAT(dlc)	(CP_MSG_FORMAT_CBFF)
+#endif // #ifdef LI_CAN_SLV_FD
 /*--------------------------------------------------------------------------*/
 /* structure/type definitions                                               */
 /*--------------------------------------------------------------------------*/
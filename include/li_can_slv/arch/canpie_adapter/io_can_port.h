@@ -64,6 +64,10 @@ extern "C" {
 #define can_port_msec_2_ticks(a)	li_can_slv_port_msec_2_ticks(a)
 #define can_port_ticks_2_msec(a)	li_can_slv_port_ticks_2_msec(a)
 
+#ifdef LI_CAN_SLV_HW_TIMESTAMP
+#define can_port_hw_time_2_ticks(sec, nsec)	li_can_slv_port_hw_time_2_ticks(sec, nsec)
+#endif // #ifdef LI_CAN_SLV_HW_TIMESTAMP
+
 #if defined(OUTER) || defined(OUTER_APP)
 #define can_port_trigger_can_main_async_data_tx_queue() can_main_handler_tx(3)
 #endif // #if defined(OUTER) || defined(OUTER_APP)
@@ -71,8 +75,12 @@ extern "C" {
 #define can_port_trigger_can_main_sync_process_data_tx_queue() can_main_handler_tx(4)
 
 #ifdef CAN_ASYNC_CTRL_RX_QUEUE
-#warning can_port_trigger_can_async_ctrl_rx_queue() not implemented!
+#ifdef li_can_slv_port_trigger_async_ctrl_rx_queue
+#define can_port_trigger_can_async_ctrl_rx_queue()	li_can_slv_port_trigger_async_ctrl_rx_queue()
+#else // #ifdef li_can_slv_port_trigger_async_ctrl_rx_queue
+/* the queue is processed by li_can_slv_process() */
 #define can_port_trigger_can_async_ctrl_rx_queue()
+#endif // #ifdef li_can_slv_port_trigger_async_ctrl_rx_queue
 #endif // #ifdef CAN_ASYNC_CTRL_RX_QUEUE
 
 #define can_port_get_boot_kernel_version_major()	li_can_slv_port_get_boot_kernel_version_major()
@@ -89,6 +97,13 @@ extern "C" {
 #define can_port_memory_cpy(dest, source, size)		li_can_slv_port_memory_cpy(dest, source, size)
 #define can_port_memory_set(ptr, value, num)		li_can_slv_port_memory_set(ptr, value, num)
 
+#ifdef li_can_slv_port_memory_barrier
+#define can_port_memory_barrier()	li_can_slv_port_memory_barrier()
+#else // #ifdef li_can_slv_port_memory_barrier
+/* the volatile accesses keep the order on single core controllers */
+#define can_port_memory_barrier()
+#endif // #ifdef li_can_slv_port_memory_barrier
+
 #define can_port_string_cmp(str1, str2)				li_can_slv_port_string_cmp(str1, str2)
 #define can_port_string_n_cmp(str1, str2, num)		li_can_slv_port_string_n_cmp(str1, str2, num)
 #define can_port_string_cpy(dest, source)			li_can_slv_port_string_cpy(dest, source)
@@ -145,6 +145,16 @@ extern li_can_slv_errorcode_t can_main_hw_set_baudrate_listen_only(can_config_bd
  */
 extern li_can_slv_errorcode_t can_main_hw_send_msg(uint16_t can_id, uint16_t dlc, const volatile byte_t *data);
 
+/**
+ * @brief send a message using the transmit queue of the given class
+ * @param tx_class transmit class used, see #can_main_tx_class_t
+ * @param can_id
+ * @param dlc
+ * @param data
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+extern li_can_slv_errorcode_t can_main_hw_send_msg_class(can_main_tx_class_t tx_class, uint16_t can_id, uint16_t dlc, const volatile byte_t *data);
+
 #ifdef __cplusplus
 }// closing brace for extern "C"
 #endif // #ifdef __cplusplus
@@ -72,6 +72,7 @@
 #define	CAN_ASYNC_DL_TERMINATION			0x1Cu /*!< download termination */
 #define	CAN_ASYNC_UL_START_REQUEST1			0x1Du /*!< upload start request 1 */
 #define	CAN_ASYNC_UL_START_REQUEST2			0x1Eu /*!< upload start request 2 */
+#define	CAN_ASYNC_DL_DATA_LZ				0x1Fu /*!< download data compressed */
 
 #define	CAN_ASYNC_UL_INFO_REQUEST_SHORT		0x50u /*!< upload info request short */
 #define	CAN_ASYNC_UL_INFO_ANSWER			0x53u /*!< upload info answer */
@@ -132,6 +133,16 @@ typedef struct can_async_tunnel_tag
 	uint16_t async_data_delay; /*!< Negotiated delay time in us between two consecutive asynchronous tunnel data objects */
 	byte_t connection_type; /*!< decision if default CAN asynchronous connection(0x00) or SPS Monitor LP connection(0x01) */
 } can_async_tunnel_t;
+
+/*!
+ * \brief buffer of a tunnel write with several buffers
+ * \struct can_async_tunnel_iovec_t
+ */
+typedef struct
+{
+	const byte_t *data; /*!< data bytes */
+	uint16_t len; /*!< number of data bytes */
+} can_async_tunnel_iovec_t;
 #endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL
 
 #ifdef CAN_ASYNC_CTRL_RX_QUEUE
@@ -143,7 +154,8 @@ typedef struct can_async_tunnel_tag
 typedef struct can_async_rx_queue_tag
 {
 	li_can_slv_module_nr_t module_nr; /**< module number*/
-	byte_t data[CAN_CONFIG_SYS_MSG_DLC]; /**< data*/
+	uint16_t dlc; /**< data length code*/
+	byte_t data[CAN_CONFIG_ASYNC_CTRL_RX_DLC]; /**< data*/
 } can_async_rx_queue_t;
 #endif // #ifdef CAN_ASYNC_CTRL_RX_QUEUE
 
@@ -175,15 +187,8 @@ typedef enum
 extern volatile can_async_tunnel_t can_async_tunnel;
 #endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL
 
-#ifdef CAN_ASYNC_CTRL_RX_QUEUE
-/* asynchronous message receive queue */
-extern volatile uint16_t can_async_rx_queue_read;
-extern volatile uint16_t can_async_rx_queue_state;
-extern volatile can_async_rx_queue_t can_async_ctrl_rx_queue[CAN_ASYNC_CTRL_RX_QUEUE_LENGTH];
-#endif // #ifdef CAN_ASYNC_CTRL_RX_QUEUE
-
 #if defined(OUTER) || defined(OUTER_APP)
-extern volatile uint16_t can_async_data_tx_queue_state; /*!< state of the asynchronous transmit data queue */
+extern volatile uint16_t can_async_ctrl_tx_queue_state; /*!< number of objects in all asynchronous transmit ctrl queues */
 #endif // #if defined(OUTER) || defined(OUTER_APP)
 
 /*--------------------------------------------------------------------------*/
@@ -191,24 +196,50 @@ extern volatile uint16_t can_async_data_tx_queue_state; /*!< state of the asynch
 /*--------------------------------------------------------------------------*/
 #ifdef CAN_ASYNC_CTRL_RX_QUEUE
 li_can_slv_errorcode_t can_async_init(void);
+li_can_slv_errorcode_t can_async_handle_async_ctrl_rx_queue(void);
+uint16_t can_async_ctrl_rx_queue_get_nr_of_objs(void);
 #endif // #ifdef CAN_ASYNC_CTRL_RX_QUEUE
 
-li_can_slv_errorcode_t can_async_rx(li_can_slv_module_nr_t module_nr, byte_t const *data);
+li_can_slv_errorcode_t can_async_rx(li_can_slv_module_nr_t module_nr, uint16_t dlc, byte_t const *data);
 
-li_can_slv_errorcode_t can_async_send_data_to_async_ctrl_rx_queue(li_can_slv_module_nr_t module_nr, byte_t const *src);
+li_can_slv_errorcode_t can_async_send_data_to_async_ctrl_rx_queue(li_can_slv_module_nr_t module_nr, uint16_t dlc, byte_t const *src);
 li_can_slv_errorcode_t can_async_send_data_to_async_ctrl_tx_queue(li_can_slv_module_nr_t module_nr, can_async_ctrl_tx_type_t type, const byte_t *src);
+#ifdef LI_CAN_SLV_XLOAD_FD
+li_can_slv_errorcode_t can_async_send_fd_data_to_async_ctrl_tx_queue(li_can_slv_module_nr_t module_nr, can_async_ctrl_tx_type_t type, byte_t dlc, const byte_t *src);
+#endif // #ifdef LI_CAN_SLV_XLOAD_FD
 
 #if defined(OUTER) || defined(OUTER_APP)
 li_can_slv_errorcode_t can_async_send_data_to_async_data_tx_queue(li_can_slv_module_nr_t module_nr, can_async_data_tx_type_t type, byte_t dlc, const byte_t *src);
+li_can_slv_errorcode_t can_async_send_bulk_to_async_data_tx_queue(li_can_slv_module_nr_t module_nr, can_async_data_tx_type_t type, const byte_t *src, uint16_t len, uint16_t *accepted);
+uint16_t can_async_data_tx_queue_get_nr_of_objs(void);
+uint16_t can_async_data_tx_queue_get_nr_of_free_objs(void);
 #endif // #if defined(OUTER) || defined(OUTER_APP)
 
 #if defined(OUTER) || defined(OUTER_APP)
 li_can_slv_errorcode_t can_async_handle_async_data_tx_queue(void);
+li_can_slv_errorcode_t can_async_handle_async_ctrl_tx_queue(void);
+li_can_slv_errorcode_t can_async_ctrl_tx_queue_set_weight(li_can_slv_module_nr_t module_nr, uint8_t weight);
+void can_async_ctrl_tx_queue_clear(void);
+#ifdef CAN_ASYNC_TX_SHAPER
+void can_async_tx_shaper_process(void);
+#endif // #ifdef CAN_ASYNC_TX_SHAPER
 #endif // #if defined(OUTER) || defined(OUTER_APP)
 
 #ifdef LI_CAN_SLV_ASYNC_TUNNEL
 #if defined(OUTER) || defined(OUTER_APP)
 li_can_slv_errorcode_t can_async_tunnel_process_tx_data(void);
+li_can_slv_errorcode_t can_async_tunnel_write(const byte_t *src, uint16_t len, uint16_t *accepted);
+li_can_slv_errorcode_t can_async_tunnel_writev(const can_async_tunnel_iovec_t *iov, uint16_t iovcnt, uint16_t *accepted);
+li_can_slv_errorcode_t can_async_tunnel_set_writable_cbk(void (*pfnc)(void));
+uint16_t can_async_tunnel_is_writable(void);
+li_can_slv_errorcode_t can_async_tunnel_send_obj(const byte_t *src, byte_t dlc);
+#ifdef LI_CAN_SLV_ASYNC_TUNNEL_RX_RING
+li_can_slv_errorcode_t can_async_tunnel_data_rx(const byte_t *src, uint16_t len);
+uint16_t can_async_tunnel_rx_peek(const byte_t **data);
+li_can_slv_errorcode_t can_async_tunnel_rx_consume(uint16_t len);
+uint16_t can_async_tunnel_rx_get_nr_of_bytes(void);
+li_can_slv_errorcode_t can_async_tunnel_set_readable_cbk(void (*pfnc)(void));
+#endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL_RX_RING
 li_can_slv_errorcode_t can_async_tunnel_shutdown(void);
 #endif // #if defined(OUTER) || defined(OUTER_APP)
 #endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL
@@ -0,0 +1,113 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/**
+ * @file io_can_async_isotp.h
+ * @brief header to IO CAN ASYNC ISOTP module
+ * @addtogroup can_async_isotp
+ * @{
+ */
+
+#ifndef IO_CAN_ASYNC_ISOTP_H
+#define IO_CAN_ASYNC_ISOTP_H
+
+/*--------------------------------------------------------------------------*/
+/* included files                                                           */
+/*--------------------------------------------------------------------------*/
+#include <li_can_slv/config/li_can_slv_config_internal.h>
+#include <li_can_slv/core/io_can_types.h>
+#include <li_can_slv/error/li_can_slv_error_types.h>
+
+/*--------------------------------------------------------------------------*/
+/* general definitions                                                      */
+/*--------------------------------------------------------------------------*/
+#define CAN_ASYNC_ISOTP_MAX_LEN	(0x0FFFu) /**< maximum length of a message */
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions                                               */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables                                                         */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes                                                      */
+/*--------------------------------------------------------------------------*/
+/*!
+ * \brief aborts a running transmission and reception, called when the tunnel is opened with the UDS connection type
+ * \remarks The receive buffer and the callbacks are kept.
+ */
+void can_async_isotp_reset(void);
+
+/*!
+ * \brief handles a received tunnel data object of the UDS connection type
+ * \remarks Called from the receive interrupt.
+ * \param[in] data received object
+ * \param dlc data length code of the object
+ * \return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_async_isotp_rx(const byte_t *data, uint16_t dlc);
+
+/*!
+ * \brief transmits flow control and consecutive frames, supervises the timeouts
+ * \remarks Called by li_can_slv_process() and on every received process request.
+ * \return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_async_isotp_process(void);
+
+/*!
+ * \brief provides the buffer into which the next message is received
+ * \remarks The frames are copied directly to the buffer. The buffer belongs to the stack until the receive callback
+ * reported the complete message, then a buffer must be provided again before the next message can be received.
+ * \param[in] buf receive buffer, NULL to withdraw it
+ * \param size size of the receive buffer
+ * \return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_async_isotp_set_rx_buffer(byte_t *buf, uint16_t size);
+
+/*!
+ * \brief sets the callback which reports a received message or an aborted reception
+ * \remarks The callback is called from the receive interrupt or from can_async_isotp_process().
+ * \param pfnc callback with the error code, the receive buffer and the length of the message
+ * \return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_async_isotp_set_rx_cbk(void (*pfnc)(li_can_slv_errorcode_t err, byte_t *data, uint16_t len));
+
+/*!
+ * \brief starts the transmission of a message
+ * \remarks The message is not copied, the data must be valid until the transmit callback is called.
+ * \param[in] data message
+ * \param len length of the message, 1 to #CAN_ASYNC_ISOTP_MAX_LEN
+ * \return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_async_isotp_send(const byte_t *data, uint16_t len);
+
+/*!
+ * \brief sets the callback which reports the end of a transmission
+ * \remarks The callback is called from can_async_isotp_process() or the receive interrupt.
+ * \param pfnc callback with the error code of the transmission
+ * \return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_async_isotp_set_tx_cbk(void (*pfnc)(li_can_slv_errorcode_t err));
+
+#endif // #ifndef IO_CAN_ASYNC_ISOTP_H
+
+/** @} */
@@ -159,6 +159,10 @@ typedef struct can_config_module_tag
 	li_can_slv_errorcode_t (*tx_mon_sync[CAN_CONFIG_NR_OF_MODULE_OBJS])(byte_t *can, void *app, uint16_t dlc); /*!< pointer to monitor tx conversion code */
 #endif // #ifdef LI_CAN_SLV_MON
 
+#ifdef LI_CAN_SLV_SYNC_FD
+	byte_t rx_dlc_fd; /*!< payload length of the packed CAN FD receive frame */
+	byte_t tx_dlc_fd; /*!< payload length of the packed CAN FD transmit frame */
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
 #endif // #ifndef LI_CAN_SLV_BOOT
 } li_can_slv_config_module_t;
 
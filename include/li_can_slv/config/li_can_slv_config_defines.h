@@ -64,6 +64,15 @@ extern "C" {
 /* define message object for synchronous data transmission */
 #define CAN_CONFIG_MSG_MAIN_OBJ_TX_SYNC	CAN_MSG_OBJ10
 
+/* define message objects for system and asynchronous transmission, placed at the end of the object range behind the synchronous transmit object */
+#ifndef CAN_CONFIG_MSG_MAIN_OBJ_TX_SYS
+#define CAN_CONFIG_MSG_MAIN_OBJ_TX_SYS	(LI_CAN_SLV_MAIN_NODE_MAX_NOF_MSG_OBJ - 2u) /*!< used CAN message object for transmitting system and error messages */
+#endif // #ifndef CAN_CONFIG_MSG_MAIN_OBJ_TX_SYS
+
+#ifndef CAN_CONFIG_MSG_MAIN_OBJ_TX_ASYNC
+#define CAN_CONFIG_MSG_MAIN_OBJ_TX_ASYNC	(LI_CAN_SLV_MAIN_NODE_MAX_NOF_MSG_OBJ - 1u) /*!< used CAN message object for transmitting asynchronous control and data messages */
+#endif // #ifndef CAN_CONFIG_MSG_MAIN_OBJ_TX_ASYNC
+
 #ifdef LI_CAN_SLV_ASYNC
 #define CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_DATA_RX	CAN_MSG_OBJ6 /*!< used CAN message object for receiving asynchronous data */
 
@@ -121,7 +130,12 @@ extern "C" {
 #define CAN_CONFIG_ASYNC_CTRL_RX_MASTER_ID	(0x0601u) /**< CAN identifier of asynchronous control data rx master */
 #define CAN_CONFIG_ASYNC_DATA_RX_SLAVE_ID	(0x0602u) /**< CAN identifier of asynchronous data rx slave */
 #define CAN_CONFIG_ASYNC_DATA_RX_MASTER_ID	(0x0603u) /**< CAN identifier of asynchronous data rx master */
+#ifdef LI_CAN_SLV_XLOAD_FD
+#define CAN_CONFIG_ASYNC_CTRL_RX_DLC		CAN_DLC_FD_MAX /**< DLC of asynchronous control data rx, large enough for CAN FD download data */
+#define CAN_CONFIG_ASYNC_CTRL_FD_DLC		CAN_DLC_FD_MAX /**< DLC of asynchronous control data objects of an up/download in CAN FD mode */
+#else // #ifdef LI_CAN_SLV_XLOAD_FD
 #define CAN_CONFIG_ASYNC_CTRL_RX_DLC		LI_CAN_SLV_CONFIG_DLC_USED_8 /**< DLC of asynchronous control data rx */
+#endif // #ifdef LI_CAN_SLV_XLOAD_FD
 #define CAN_CONFIG_ASYNC_MSG_DLC			LI_CAN_SLV_CONFIG_DLC_USED_8 /**< */
 #endif // #ifdef LI_CAN_SLV_ASYNC
 
@@ -230,6 +230,124 @@ extern "C" {
  * @}
  */
 
+/**
+ * @defgroup li_can_slv_defines_quality Defines for the CAN quality measurement
+ * @addtogroup li_can_slv_defines_quality
+ * @{
+ */
+#ifdef __DOXYGEN__
+/**
+ * Use the CAN quality measurement (message, byte and last error code counters, node load and quality),
+ * see io_can_quality.
+ */
+#define LI_CAN_SLV_USE_QUALITY
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_USE_QUALITY
+#define LI_CAN_SLV_QUALITY
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Set the length of the quality window in ms which is used for the node load and the current quality, the
+ * default value is 1000 ms.
+ */
+#define LI_CAN_SLV_SET_QUALITY_WINDOW_MS
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_SET_QUALITY_WINDOW_MS
+#define LI_CAN_SLV_QUALITY_WINDOW_MS	(LI_CAN_SLV_SET_QUALITY_WINDOW_MS)
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Set the ratio of the CAN FD data bit rate to the nominal bit rate which is used to calculate the node load
+ * of CAN FD frames, the default value is 4.
+ */
+#define LI_CAN_SLV_SET_QUALITY_FD_BITRATE_FACTOR
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_SET_QUALITY_FD_BITRATE_FACTOR
+#define LI_CAN_SLV_QUALITY_FD_BITRATE_FACTOR	(LI_CAN_SLV_SET_QUALITY_FD_BITRATE_FACTOR)
+#endif
+#endif // #ifdef __DOXYGEN__
+/**
+ * @}
+ */
+
+/**
+ * @defgroup li_can_slv_defines_analyzer Defines for the CAN analyzer
+ * @addtogroup li_can_slv_defines_analyzer
+ * @{
+ */
+#ifdef __DOXYGEN__
+/**
+ * Use the CAN analyzer which records the received and transmitted messages in a ring buffer and stops the
+ * recording on a trigger, see io_can_analyzer.
+ */
+#define LI_CAN_SLV_USE_ANALYZER
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_USE_ANALYZER
+#define LI_CAN_SLV_ANALYZER
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Set the number of recorded messages of the CAN analyzer, must be a power of two. The default value is 64.
+ */
+#define LI_CAN_SLV_SET_ANALYZER_SIZE
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_SET_ANALYZER_SIZE
+#define LI_CAN_SLV_ANALYZER_SIZE	(LI_CAN_SLV_SET_ANALYZER_SIZE)
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Set the number of messages recorded after the trigger, the default value is the half of the analyzer size.
+ */
+#define LI_CAN_SLV_SET_ANALYZER_POST_TRIGGER
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_SET_ANALYZER_POST_TRIGGER
+#define LI_CAN_SLV_ANALYZER_POST_TRIGGER	(LI_CAN_SLV_SET_ANALYZER_POST_TRIGGER)
+#endif
+#endif // #ifdef __DOXYGEN__
+/**
+ * @}
+ */
+
+/**
+ * @defgroup li_can_slv_defines_traffic Defines for the CAN traffic counters
+ * @addtogroup li_can_slv_defines_traffic
+ * @{
+ */
+#ifdef __DOXYGEN__
+/**
+ * Use the CAN traffic counters which count the accepted and rejected messages per CAN identifier and reason,
+ * see io_can_traffic.
+ */
+#define LI_CAN_SLV_USE_TRAFFIC
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_USE_TRAFFIC
+#define LI_CAN_SLV_TRAFFIC
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Set the number of CAN identifiers besides the synchronous process data of the configured logical modules counted by
+ * the CAN traffic counters, must be a power of two. The default value is 32.
+ */
+#define LI_CAN_SLV_SET_TRAFFIC_SIZE
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_SET_TRAFFIC_SIZE
+#define LI_CAN_SLV_TRAFFIC_SIZE	(LI_CAN_SLV_SET_TRAFFIC_SIZE)
+#endif
+#endif // #ifdef __DOXYGEN__
+/**
+ * @}
+ */
+
 /**
  * @defgroup li_can_slv_defines_system Defines for the system protocol definitions
  * @addtogroup li_can_slv_defines_system
@@ -369,6 +487,27 @@ extern "C" {
 #define LI_CAN_SLV_SYNC_PROCESS_PERIODE_MAX	(LI_CAN_SLV_SET_SYNC_PROCESS_PERIODE_MAX)
 #endif
 #endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ \rst
+ Transfer the synchronous process data of a logical module as one CAN FD frame with bit rate switch instead
+ of up to four classic frames. The objects of the module are packed in slots of 8 bytes in object order and
+ the frame length is rounded up to the next valid CAN FD length (12 to 64 bytes). The frame uses the
+ identifier of object 0 of the module.
+
+ .. attention::
+     The master and all nodes on the bus must support CAN FD with the same data phase bit rate,
+     see #LI_CAN_SLV_ARCH_SET_FD_DATA_BITRATE.
+
+ \endrst
+*/
+#define LI_CAN_SLV_USE_SYNC_FD
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_USE_SYNC_FD
+#define LI_CAN_SLV_SYNC_FD
+#endif
+#endif // #ifdef __DOXYGEN__
 /**
  * @}
  */
@@ -407,6 +546,119 @@ extern "C" {
 #endif
 #endif // #ifdef __DOXYGEN__
 
+#ifdef __DOXYGEN__
+/**
+ * Use the pipelined download with the internal download buffer. A received block is copied to a free block buffer
+ * and acknowledged at once. The application programs it in the background, started by the block commit handle set
+ * with li_can_slv_dload_set_block_commit_handle(), and reports the end with li_can_slv_dload_block_committed().
+ * A failed commit terminates the download at the next block boundary. Without a block commit handle the download
+ * is handled by the data block end handle as before.
+ */
+#define LI_CAN_SLV_USE_ASYNC_DOWNLOAD_PIPELINE
+/**
+ * Set the number of block buffers of the pipelined download, at least 2. The default value is 2.
+ */
+#define LI_CAN_SLV_SET_ASYNC_DOWNLOAD_PIPELINE_BLOCKS
+#else // #ifdef __DOXYGEN__
+#if defined(LI_CAN_SLV_USE_ASYNC_DOWNLOAD_PIPELINE) && defined(LI_CAN_SLV_DLOAD_BUFFER_INTERNAL)
+#define LI_CAN_SLV_DLOAD_PIPELINE
+#endif
+#ifdef LI_CAN_SLV_SET_ASYNC_DOWNLOAD_PIPELINE_BLOCKS
+#define LI_CAN_SLV_XLOAD_PIPELINE_BLOCKS	(LI_CAN_SLV_SET_ASYNC_DOWNLOAD_PIPELINE_BLOCKS)
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Use the windowed download with the internal download buffer. The download start acknowledge announces the number
+ * of blocks the master may send without waiting for the block acknowledge. A master which opts in with the first
+ * data block end of a download (exactly #XLOAD_FLAG_WINDOW in byte 7 and block number 0 in byte 6) gets numbered
+ * block acknowledges and, for a lost or damaged block, a retransmit request instead of a download termination.
+ * Without the opt-in the download is handled stop-and-wait as before.
+ */
+#define LI_CAN_SLV_USE_ASYNC_DOWNLOAD_WINDOW
+/**
+ * Set the number of blocks in flight of the windowed download, 2 to 127. The default value is 4.
+ */
+#define LI_CAN_SLV_SET_ASYNC_DOWNLOAD_WINDOW_BLOCKS
+#else // #ifdef __DOXYGEN__
+#if defined(LI_CAN_SLV_USE_ASYNC_DOWNLOAD_WINDOW) && defined(LI_CAN_SLV_DLOAD_BUFFER_INTERNAL)
+#define LI_CAN_SLV_DLOAD_WINDOW
+#endif
+#ifdef LI_CAN_SLV_SET_ASYNC_DOWNLOAD_WINDOW_BLOCKS
+#define LI_CAN_SLV_XLOAD_WINDOW_BLOCKS	(LI_CAN_SLV_SET_ASYNC_DOWNLOAD_WINDOW_BLOCKS)
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Use the built-in table driven CRC16 (CRC-16/CCITT-FALSE, polynomial 0x1021, initial value 0xFFFF). The xload info
+ * uses it instead of the functions li_can_slv_xload_info_crc16_init() and li_can_slv_xload_info_crc16_update()
+ * of the application.
+ */
+#define LI_CAN_SLV_USE_XLOAD_CRC16
+/**
+ * Set the number of bytes the built-in CRC16 processes per step: 1 uses one table of 512 bytes, 4 or 8 (slice-by-4
+ * or slice-by-8 for 32 bit cores and hosts) use 3 or 7 additional constant tables of 512 bytes. The default value is 1.
+ */
+#define LI_CAN_SLV_SET_XLOAD_CRC16_SLICE
+/**
+ * Verify the component CRC of the download start request in li_can_slv_dload_end(). The CRC is updated with every
+ * received block, so the programmed component must not be read again. Needs the built-in CRC16 and the internal
+ * download buffer.
+ */
+#define LI_CAN_SLV_USE_DOWNLOAD_CRC_CHECK
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_USE_XLOAD_CRC16
+#define LI_CAN_SLV_XLOAD_CRC16
+#endif
+#ifdef LI_CAN_SLV_SET_XLOAD_CRC16_SLICE
+#define LI_CAN_SLV_XLOAD_CRC16_SLICE	(LI_CAN_SLV_SET_XLOAD_CRC16_SLICE)
+#endif
+#if defined(LI_CAN_SLV_USE_DOWNLOAD_CRC_CHECK) && defined(LI_CAN_SLV_XLOAD_CRC16) && defined(LI_CAN_SLV_DLOAD_BUFFER_INTERNAL)
+#define LI_CAN_SLV_DLOAD_CRC_CHECK
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Accept compressed download data objects with the internal download buffer. The download start acknowledge
+ * announces the compression and the size of the window, the master then may send the data of a block as
+ * compressed data objects. They are decompressed at the data block end, the maximum bytes per block of the start
+ * acknowledge limit the decompressed size of a block. Needs RAM for the window and a second buffer of the size of
+ * the download buffer (LI_CAN_SLV_XLOAD_BUFFER_SIZE_DLOAD) for the compressed bytes of a block.
+ */
+#define LI_CAN_SLV_USE_ASYNC_DOWNLOAD_LZ
+/**
+ * Set the window size of the compressed download, a power of two from 256 to 4096. The default value is 1024.
+ */
+#define LI_CAN_SLV_SET_ASYNC_DOWNLOAD_LZ_WINDOW
+#else // #ifdef __DOXYGEN__
+#if defined(LI_CAN_SLV_USE_ASYNC_DOWNLOAD_LZ) && defined(LI_CAN_SLV_DLOAD_BUFFER_INTERNAL)
+#define LI_CAN_SLV_DLOAD_LZ
+#endif
+#ifdef LI_CAN_SLV_SET_ASYNC_DOWNLOAD_LZ_WINDOW
+#define LI_CAN_SLV_XLOAD_LZ_WINDOW	(LI_CAN_SLV_SET_ASYNC_DOWNLOAD_LZ_WINDOW)
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Keep the number of programmed bytes and the running CRC of the download in the xload_info. A master opts in with
+ * #XLOAD_FLAG_RESUME in byte 8 of the version request long2 in front of the download start request. Then a download
+ * start request with the same component, CRC and download ID resumes an interrupted download at this offset, the block
+ * acknowledge following the download start acknowledge reports the offset to the master. Without the opt-in the
+ * download starts at 0 and the stored progress is cleared once the download start is accepted. Needs the xload_info
+ * and LI_CAN_SLV_USE_DOWNLOAD_CRC_CHECK, the layout of the xload_info is not backward compatible. The progress
+ * carries #LI_CAN_SLV_XLOAD_INFO_RESUME_VERSION, a progress stored with another version is not resumed.
+ */
+#define LI_CAN_SLV_USE_ASYNC_DOWNLOAD_RESUME
+#else // #ifdef __DOXYGEN__
+#if defined(LI_CAN_SLV_USE_ASYNC_DOWNLOAD_RESUME) && defined(LI_CAN_SLV_DLOAD) && !defined(LI_CAN_SLV_NO_XLOAD_INFO)
+#define LI_CAN_SLV_DLOAD_RESUME
+#endif
+#endif // #ifdef __DOXYGEN__
+
 #ifdef __DOXYGEN__
 /**
  * Use the asynchrony protocol upload handling.
@@ -419,6 +671,77 @@ extern "C" {
 #endif
 #endif // #ifdef __DOXYGEN__
 
+#ifdef __DOXYGEN__
+/**
+ * Process the received asynchronous control objects (download, upload, tunnel control) in task context. The receive
+ * interrupt only adds them to a queue which is processed by li_can_slv_process(). If the port defines
+ * li_can_slv_port_trigger_async_ctrl_rx_queue() it is called for every added object, e.g. to wake up a task which
+ * calls can_async_handle_async_ctrl_rx_queue().
+ */
+#define LI_CAN_SLV_USE_ASYNC_CTRL_RX_QUEUE
+/**
+ * Set the number of objects of the asynchronous control receive queue, must be a power of two. The default value
+ * is 16.
+ */
+#define LI_CAN_SLV_SET_ASYNC_CTRL_RX_QUEUE_LENGTH
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_USE_ASYNC_CTRL_RX_QUEUE
+#define CAN_ASYNC_CTRL_RX_QUEUE
+#endif
+#ifdef LI_CAN_SLV_SET_ASYNC_CTRL_RX_QUEUE_LENGTH
+#define CAN_ASYNC_CTRL_RX_QUEUE_LENGTH	(LI_CAN_SLV_SET_ASYNC_CTRL_RX_QUEUE_LENGTH)
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Set the number of objects of the asynchronous control transmit queue of every logical module. The default value
+ * is 8.
+ */
+#define LI_CAN_SLV_SET_ASYNC_CTRL_TX_QUEUE_LENGTH
+/**
+ * Set the default weight (1 to 255) of a logical module in the round robin scheduling of the asynchronous control
+ * transmit queues. A module with a higher weight may send proportionally more bytes per round, the weight of a
+ * single module can be changed with can_async_ctrl_tx_queue_set_weight(). The default value is 1.
+ */
+#define LI_CAN_SLV_SET_ASYNC_CTRL_TX_WEIGHT
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_SET_ASYNC_CTRL_TX_QUEUE_LENGTH
+#define CAN_ASYNC_CTRL_TX_QUEUE_LENGTH	(LI_CAN_SLV_SET_ASYNC_CTRL_TX_QUEUE_LENGTH)
+#endif
+#ifdef LI_CAN_SLV_SET_ASYNC_CTRL_TX_WEIGHT
+#define CAN_ASYNC_CTRL_TX_WEIGHT	(LI_CAN_SLV_SET_ASYNC_CTRL_TX_WEIGHT)
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Use a token bucket to limit the bus share of all asynchronous transmit objects (control objects, uploads, tunnel and
+ * ISO-TP data). The budget of one process period is derived from the measured process period, objects above the
+ * budget are held back and sent by li_can_slv_process() or after the next process request.
+ */
+#define LI_CAN_SLV_USE_ASYNC_TX_SHAPER
+/**
+ * Set the bus share in percent (1 to 100) which the asynchronous transmit objects may use. The default value is 30.
+ */
+#define LI_CAN_SLV_SET_ASYNC_TX_SHAPER_SHARE
+/**
+ * Set the time in ms before the predicted next process request in which no asynchronous objects are passed to the
+ * hardware. The default value is 0 (no guard window).
+ */
+#define LI_CAN_SLV_SET_ASYNC_TX_SHAPER_GUARD_MS
+#else // #ifdef __DOXYGEN__
+#if defined(LI_CAN_SLV_USE_ASYNC_TX_SHAPER) && defined(LI_CAN_SLV_ASYNC) && defined(LI_CAN_SLV_SYNC)
+#define CAN_ASYNC_TX_SHAPER
+#endif
+#ifdef LI_CAN_SLV_SET_ASYNC_TX_SHAPER_SHARE
+#define CAN_ASYNC_TX_SHAPER_SHARE	(LI_CAN_SLV_SET_ASYNC_TX_SHAPER_SHARE)
+#endif
+#ifdef LI_CAN_SLV_SET_ASYNC_TX_SHAPER_GUARD_MS
+#define CAN_ASYNC_TX_SHAPER_GUARD_MS	(LI_CAN_SLV_SET_ASYNC_TX_SHAPER_GUARD_MS)
+#endif
+#endif // #ifdef __DOXYGEN__
+
 #ifdef __DOXYGEN__
 /**
  * Use the asynchrony protocol tunnel handling.
@@ -429,6 +752,124 @@ extern "C" {
 #define LI_CAN_SLV_ASYNC_TUNNEL
 #endif
 #endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Set the number of objects of the asynchronous data transmit queue used by the tunnel, must be a power of two.
+ * The default value is 4.
+ */
+#define LI_CAN_SLV_SET_ASYNC_DATA_TX_QUEUE_LENGTH
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_SET_ASYNC_DATA_TX_QUEUE_LENGTH
+#define CAN_ASYNC_DATA_TX_QUEUE_LENGTH	(LI_CAN_SLV_SET_ASYNC_DATA_TX_QUEUE_LENGTH)
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Set the number of queued tunnel data objects from which the tunnel is not writable. The default value is three
+ * quarters of the asynchronous data transmit queue.
+ */
+#define LI_CAN_SLV_SET_ASYNC_TUNNEL_TX_HIGH_WATERMARK
+/**
+ * Set the number of queued tunnel data objects up to which the tunnel is writable again. The default value is a
+ * quarter of the asynchronous data transmit queue.
+ */
+#define LI_CAN_SLV_SET_ASYNC_TUNNEL_TX_LOW_WATERMARK
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_SET_ASYNC_TUNNEL_TX_HIGH_WATERMARK
+#define CAN_ASYNC_TNL_TX_HIGH_WATERMARK	(LI_CAN_SLV_SET_ASYNC_TUNNEL_TX_HIGH_WATERMARK)
+#endif
+#ifdef LI_CAN_SLV_SET_ASYNC_TUNNEL_TX_LOW_WATERMARK
+#define CAN_ASYNC_TNL_TX_LOW_WATERMARK	(LI_CAN_SLV_SET_ASYNC_TUNNEL_TX_LOW_WATERMARK)
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Set the maximum time in ms a partly filled tunnel data object waits for further bytes while tunnel data is
+ * transmitted, measured from its first byte. If no tunnel data is pending it is sent at once. The default value is 50.
+ */
+#define LI_CAN_SLV_SET_ASYNC_TUNNEL_TX_COALESCE_TIMEOUT_MS
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_SET_ASYNC_TUNNEL_TX_COALESCE_TIMEOUT_MS
+#define CAN_ASYNC_TNL_PARTLYFILLES_TXOBJ_DELAY_MS	(LI_CAN_SLV_SET_ASYNC_TUNNEL_TX_COALESCE_TIMEOUT_MS)
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Use the tunnel receive ring of the stack. Received tunnel data is read by the application with
+ * can_async_tunnel_rx_peek()/can_async_tunnel_rx_consume() instead of li_can_slv_port_async_tunnel_data_rx_handle(),
+ * XON/XOFF to the tunnel partner is handled by the stack.
+ */
+#define LI_CAN_SLV_USE_ASYNC_TUNNEL_RX_RING
+/**
+ * Set the size in bytes of the tunnel receive ring, must be a power of two. The default value is 256.
+ */
+#define LI_CAN_SLV_SET_ASYNC_TUNNEL_RX_RING_SIZE
+#else // #ifdef __DOXYGEN__
+#if defined(LI_CAN_SLV_USE_ASYNC_TUNNEL_RX_RING) && defined(LI_CAN_SLV_ASYNC_TUNNEL)
+#define LI_CAN_SLV_ASYNC_TUNNEL_RX_RING
+#endif
+#ifdef LI_CAN_SLV_SET_ASYNC_TUNNEL_RX_RING_SIZE
+#define CAN_ASYNC_TNL_RX_RING_SIZE	(LI_CAN_SLV_SET_ASYNC_TUNNEL_RX_RING_SIZE)
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Use ISO-TP (ISO 15765-2) on the tunnel opened with the UDS connection type. Needs the source file
+ * io_can_async_isotp.c (interface library li_can_slv_isotp).
+ */
+#define LI_CAN_SLV_USE_ASYNC_ISOTP
+/**
+ * Set the ISO-TP block size sent in the flow control. The default value is 0, the whole message is sent without
+ * further flow control.
+ */
+#define LI_CAN_SLV_SET_ASYNC_ISOTP_BLOCK_SIZE
+/**
+ * Set the ISO-TP minimum separation time sent in the flow control. The default value is 0.
+ */
+#define LI_CAN_SLV_SET_ASYNC_ISOTP_STMIN
+#else // #ifdef __DOXYGEN__
+#if defined(LI_CAN_SLV_USE_ASYNC_ISOTP) && defined(LI_CAN_SLV_ASYNC_TUNNEL)
+#define LI_CAN_SLV_ASYNC_ISOTP
+#endif
+#ifdef LI_CAN_SLV_SET_ASYNC_ISOTP_BLOCK_SIZE
+#define CAN_ASYNC_ISOTP_BS	(LI_CAN_SLV_SET_ASYNC_ISOTP_BLOCK_SIZE)
+#endif
+#ifdef LI_CAN_SLV_SET_ASYNC_ISOTP_STMIN
+#define CAN_ASYNC_ISOTP_STMIN	(LI_CAN_SLV_SET_ASYNC_ISOTP_STMIN)
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ \rst
+ Transfer the data objects of a download and an upload as CAN FD frames of 64 bytes with bit rate switch
+ (63 bytes of payload per frame instead of 7). The slave announces the capability in the download start
+ acknowledge and the master decides whether it sends FD data frames. For an upload the master requests FD
+ data frames in the upload start request. Without a request the transfer falls back to classic frames.
+
+ .. attention::
+     The master must support CAN FD with the same data phase bit rate, see #LI_CAN_SLV_ARCH_SET_FD_DATA_BITRATE.
+
+ \endrst
+*/
+#define LI_CAN_SLV_USE_XLOAD_FD
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_USE_XLOAD_FD
+#define LI_CAN_SLV_XLOAD_FD
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#if defined(LI_CAN_SLV_SYNC_FD) || defined(LI_CAN_SLV_XLOAD_FD)
+/**
+ * @brief the controller is operated in CAN FD mode
+ */
+#define LI_CAN_SLV_FD
+#endif // #if defined(LI_CAN_SLV_SYNC_FD) || defined(LI_CAN_SLV_XLOAD_FD)
 /**
  * @}
  */
@@ -500,6 +941,53 @@ extern "C" {
 #endif // #ifdef LI_CAN_SLV_ARCH_USE_CANPIE_CH2_FOR_MON_NODE
 #endif // #ifdef __DOXYGEN__
 
+#ifdef __DOXYGEN__
+/**
+ * Set the data phase bit rate used for CAN FD frames, the default value is eCP_BITRATE_2M. Only used
+ * together with #LI_CAN_SLV_USE_SYNC_FD or #LI_CAN_SLV_USE_XLOAD_FD.
+ */
+#define LI_CAN_SLV_ARCH_SET_FD_DATA_BITRATE
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_ARCH_SET_FD_DATA_BITRATE
+#define LI_CAN_SLV_FD_DATA_BITRATE	(LI_CAN_SLV_ARCH_SET_FD_DATA_BITRATE)
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Evaluate the bus errors of the main node from the error callback of the CANpie driver. The periodic
+ * li_can_slv_process() then only polls the driver state while the bus is disturbed or a reconnect is running.
+ */
+#define LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Set the minimum time in ms between two evaluated error events of the driver error callback, the default
+ * value is 10 ms. Events within this time are coalesced. Only used together with
+ * #LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER.
+ */
+#define LI_CAN_SLV_ARCH_SET_ERROR_HANDLER_RATE_LIMIT_MS
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_ARCH_SET_ERROR_HANDLER_RATE_LIMIT_MS
+#define LI_CAN_SLV_ERROR_HANDLER_RATE_LIMIT_MS	(LI_CAN_SLV_ARCH_SET_ERROR_HANDLER_RATE_LIMIT_MS)
+#endif
+#endif // #ifdef __DOXYGEN__
+
+#ifdef __DOXYGEN__
+/**
+ * Use the receive time stamps of the CANpie driver (CP_CAN_MSG_TIME) for the process period, the validity time of
+ * the process image and the reconnect timing. The port has to convert the time stamp to system ticks with
+ * li_can_slv_port_hw_time_2_ticks(sec1970, nanosec), messages without a time stamp get the current system time.
+ * The interrupt latency is available with li_can_slv_get_rx_latency().
+ */
+#define LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_HW_TIMESTAMP
+#else // #ifdef __DOXYGEN__
+#ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_HW_TIMESTAMP
+#define LI_CAN_SLV_HW_TIMESTAMP
+#endif
+#endif // #ifdef __DOXYGEN__
+
 #ifdef __DOXYGEN__
 /**
  * Set the maximum of usable message objects
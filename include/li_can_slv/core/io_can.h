@@ -44,6 +44,16 @@ extern "C" {
 /*--------------------------------------------------------------------------*/
 /* general definitions                                                      */
 /*--------------------------------------------------------------------------*/
+#define CAN_RX_NODE_MAIN	0 /**< receive time of the main CAN node */
+#define CAN_RX_NODE_MON	1 /**< receive time of the monitor CAN node */
+#define CAN_RX_NR_OF_NODES	2 /**< number of CAN nodes with a receive time */
+
+#ifndef LI_CAN_SLV_HW_TIMESTAMP
+/**
+ * @brief without time stamps of the driver the receive time is the current system time
+ */
+#define can_rx_ticks_get(node)	((void)(node), can_port_get_system_ticks())
+#endif // #ifndef LI_CAN_SLV_HW_TIMESTAMP
 
 /*--------------------------------------------------------------------------*/
 /* structure/type definitions                                               */
@@ -72,6 +82,30 @@ li_can_slv_errorcode_t li_can_slv_set_node_mode(li_can_slv_node_mode_t new_mode)
  */
 li_can_slv_node_mode_t li_can_slv_get_node_mode(void);
 
+#ifdef LI_CAN_SLV_HW_TIMESTAMP
+/**
+ * @brief sets the receive time of the message which is currently processed on a node, called from the receive handler
+ * @param node #CAN_RX_NODE_MAIN or #CAN_RX_NODE_MON
+ * @param ticks receive time in system ticks
+ */
+void can_rx_ticks_set(uint16_t node, uint32_t ticks);
+
+/**
+ * @brief get the receive time of the message which is currently processed on a node
+ * @param node #CAN_RX_NODE_MAIN or #CAN_RX_NODE_MON
+ * @return receive time in system ticks
+ */
+uint32_t can_rx_ticks_get(uint16_t node);
+
+/**
+ * @brief get the interrupt latency, the system time of the receive handler minus the receive time of the driver
+ * @param[out] latency latency of the last received message in system ticks
+ * @param[out] latency_max maximum latency since initialization in system ticks
+ * @return #LI_CAN_SLV_ERR_OK
+ */
+li_can_slv_errorcode_t li_can_slv_get_rx_latency(uint32_t *latency, uint32_t *latency_max);
+#endif // #ifdef LI_CAN_SLV_HW_TIMESTAMP
+
 #ifdef __cplusplus
 }// closing brace for extern "C"
 #endif
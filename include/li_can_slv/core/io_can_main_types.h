@@ -67,6 +67,21 @@ typedef enum
 	CAN_MAIN_ASYNC_CTRL_SERVICE_ID_RX = 4
 } can_main_service_id_t;
 
+/**
+ * @brief defines the transmit classes of the main CAN-controller
+ * @remarks Every class uses its own transmit message object and queue, a lower value means a higher priority.
+ * @enum can_main_tx_class_tag
+ * @typedef enum #can_main_tx_class_tag can_main_tx_class_t
+ */
+typedef enum can_main_tx_class_tag
+{
+	CAN_MAIN_TX_CLASS_SYNC = 0, /**< synchronous process data */
+	CAN_MAIN_TX_CLASS_SYS = 1, /**< system and error messages */
+	CAN_MAIN_TX_CLASS_ASYNC = 2 /**< asynchronous control and data messages */
+} can_main_tx_class_t;
+
+#define CAN_MAIN_TX_CLASS_NOF	(3u) /**< number of transmit classes */
+
 /*--------------------------------------------------------------------------*/
 /* global variables                                                         */
 /*--------------------------------------------------------------------------*/
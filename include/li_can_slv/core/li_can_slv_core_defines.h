@@ -46,6 +46,7 @@ extern "C" {
 #define CAN_IDENTIFIER_MAX	0x7FF /*!< maximum value of CAN identifier */
 #define CAN_DLC_MIN			0u /*!< minimum value of CAN DLC */
 #define CAN_DLC_MAX			8u /*!< maximum value of CAN DLC */
+#define CAN_DLC_FD_MAX		64u /*!< maximum payload length of a CAN FD frame */
 
 #define CAN_DIR_TX			1u /*!< CAN direction transmit */
 #define CAN_DIR_RX			0u /*!< CAN direction receive */
@@ -234,6 +234,18 @@ extern "C" {
 #define ERR_MSG_CAN_ERR_NOT_DEFINED						(MSG_SG_SHIFT(MSG_SUBGROUP_CAN_CAN) | 0x076u)
 #define ERR_MSG_CAN_CONFIG_INVALID						(MSG_SG_SHIFT(MSG_SUBGROUP_CAN_CAN) | 0x077u)
 #define ERR_MSG_CAN_MSG_SEND							(MSG_SG_SHIFT(MSG_SUBGROUP_CAN_CAN) | 0x078u)
+#define ERR_MSG_CAN_MSG_SEND_BUSY						(MSG_SG_SHIFT(MSG_SUBGROUP_CAN_CAN) | 0x079u)  /*!<transmit path full, retry on next transmit complete */
+#define ERR_MSG_CAN_QUALITY_INVALID_NODE				(MSG_SG_SHIFT(MSG_SUBGROUP_CAN_CAN) | 0x07Au)  /*!<quality statistic of an unknown CAN node requested */
+#define ERR_MSG_CAN_ANALYZER_NOT_STOPPED				(MSG_SG_SHIFT(MSG_SUBGROUP_CAN_CAN) | 0x07Bu)  /*!<the trace of the CAN analyzer could only be read after the recording stopped */
+#define ERR_MSG_CAN_ANALYZER_NO_ENTRY					(MSG_SG_SHIFT(MSG_SUBGROUP_CAN_CAN) | 0x07Cu)  /*!<entry of the CAN analyzer trace not recorded */
+#define ERR_MSG_CAN_ASYNC_TNL_RX_OVERFLOW				(MSG_SG_SHIFT(MSG_SUBGROUP_CAN_CAN) | 0x07Du)  /*!<tunnel receive ring full, received tunnel data dropped */
+#define ERR_MSG_CAN_ASYNC_ISOTP_BUSY					(MSG_SG_SHIFT(MSG_SUBGROUP_CAN_CAN) | 0x07Eu)  /*!<ISO-TP transmission or reception in progress */
+#define ERR_MSG_CAN_ASYNC_ISOTP_TIMEOUT					(MSG_SG_SHIFT(MSG_SUBGROUP_CAN_CAN) | 0x07Fu)  /*!<ISO-TP flow control or consecutive frame not received in time */
+#define ERR_MSG_CAN_ASYNC_ISOTP_WRONG_SN				(MSG_SG_SHIFT(MSG_SUBGROUP_CAN_CAN) | 0x080u)  /*!<ISO-TP consecutive frame with wrong sequence number */
+#define ERR_MSG_CAN_ASYNC_ISOTP_OVERFLOW				(MSG_SG_SHIFT(MSG_SUBGROUP_CAN_CAN) | 0x081u)  /*!<ISO-TP message longer than the receive buffer */
+#define ERR_MSG_CAN_ASYNC_ISOTP_PROTOCOL				(MSG_SG_SHIFT(MSG_SUBGROUP_CAN_CAN) | 0x082u)  /*!<ISO-TP frame unexpected or malformed */
+#define ERR_MSG_CAN_ASYNC_ISOTP_INVALID_LENGTH			(MSG_SG_SHIFT(MSG_SUBGROUP_CAN_CAN) | 0x083u)  /*!<ISO-TP message length not supported */
+#define ERR_MSG_CAN_DLOAD_LZ_FORMAT						(MSG_SG_SHIFT(MSG_SUBGROUP_CAN_CAN) | 0x084u)  /*!<compressed download data malformed or mixed with uncompressed data */
 
 /*--------------------------------------------------------------------------*/
 /* structure/type definitions                                               */
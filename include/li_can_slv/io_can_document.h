@@ -100,6 +100,11 @@
  * \defgroup can_async asynchronous
  */
 
+/*!
+ * \defgroup can_async_isotp ISO-TP
+ * \ingroup can_async
+ */
+
 /**
  * @defgroup can_utils utilities
  */
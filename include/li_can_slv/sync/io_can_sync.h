@@ -165,15 +165,23 @@ li_can_slv_errorcode_t can_sync_rx_data_main(uint16_t table_pos, uint16_t int_id
 li_can_slv_errorcode_t can_sync_tx_data_main(uint16_t table_pos, uint16_t obj, uint16_t dlc, byte_t *can);
 li_can_slv_errorcode_t can_sync_tx_data_main_ok(uint16_t table_pos, uint16_t obj);
 
+#ifdef LI_CAN_SLV_SYNC_FD
+li_can_slv_errorcode_t can_sync_rx_data_main_fd(uint16_t table_pos, uint16_t int_id, uint16_t dlc, byte_t *can);
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
+
 #ifdef LI_CAN_SLV_MON
 li_can_slv_errorcode_t can_sync_rx_process_mon(uint16_t dlc, byte_t const *can);
 li_can_slv_errorcode_t can_sync_rx_data_mon(uint16_t table_pos, uint16_t int_id, uint16_t dlc, byte_t *can);
 li_can_slv_errorcode_t can_sync_tx_data_mon(uint16_t table_pos, uint16_t int_id, uint16_t dlc, byte_t *can);
+#ifdef LI_CAN_SLV_SYNC_FD
+li_can_slv_errorcode_t can_sync_rx_data_mon_fd(uint16_t table_pos, uint16_t int_id, uint16_t dlc, byte_t *can);
+li_can_slv_errorcode_t can_sync_tx_data_mon_fd(uint16_t table_pos, uint16_t int_id, uint16_t dlc, byte_t *can);
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
 #endif // #ifdef LI_CAN_SLV_MON
 
 li_can_slv_errorcode_t can_sync_clr_rx_data_main_mon(uint16_t taple_pos);
 
-void li_can_slv_sync_check_process_image(void);
+void li_can_slv_sync_check_process_image(uint32_t pr_ticks);
 
 /**
  * @brief li_can_slv_sync_get_process_valid_time
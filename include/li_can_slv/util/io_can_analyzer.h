@@ -31,14 +31,53 @@
 /*--------------------------------------------------------------------------*/
 /* included files                                                           */
 /*--------------------------------------------------------------------------*/
+#include <li_can_slv/config/li_can_slv_config_internal.h>
+#include <li_can_slv/core/io_can_types.h>
+#include <li_can_slv/error/li_can_slv_error_types.h>
 
 /*--------------------------------------------------------------------------*/
 /* general definitions                                                      */
 /*--------------------------------------------------------------------------*/
+#define CAN_ANALYZER_NODE_MAIN	0 /**< main CAN node */
+#define CAN_ANALYZER_NODE_MON	1 /**< monitor CAN node */
+
+#define CAN_ANALYZER_FLAG_TX	0x01u /**< entry is a transmitted message */
+#define CAN_ANALYZER_FLAG_MON	0x02u /**< entry is recorded on the monitor CAN node */
+
+#define CAN_ANALYZER_TRIGGER_IMAGE_NOT_VALID	0x0001u /**< process image of a logical module not valid */
+#define CAN_ANALYZER_TRIGGER_MAIN_MON_DATA_RX	0x0002u /**< received data on main and monitor not identical (ERR_MSG_CAN_MAIN_MON_DATA_RX) */
+#define CAN_ANALYZER_TRIGGER_RECONNECT	0x0004u /**< reconnect started */
+#define CAN_ANALYZER_TRIGGER_USER	0x8000u /**< trigger of the application */
+
+#define CAN_ANALYZER_DATA_SIZE	8 /**< recorded data bytes of a message */
 
 /*--------------------------------------------------------------------------*/
 /* structure/type definitions                                               */
 /*--------------------------------------------------------------------------*/
+/**
+ * @brief state of the analyzer
+ * @enum can_analyzer_state_t
+ */
+typedef enum
+{
+	CAN_ANALYZER_STATE_OFF = 0, /**< nothing is recorded */
+	CAN_ANALYZER_STATE_ARMED = 1, /**< recording the pre trigger window, waiting for a trigger */
+	CAN_ANALYZER_STATE_TRIGGERED = 2, /**< triggered, recording the post trigger window */
+	CAN_ANALYZER_STATE_STOPPED = 3 /**< recording stopped, the trace could be read */
+} can_analyzer_state_t;
+
+/**
+ * @brief recorded message
+ * @struct can_analyzer_entry_t
+ */
+typedef struct
+{
+	uint32_t time; /**< system ticks */
+	uint16_t canid; /**< CAN identifier */
+	uint8_t dlc; /**< number of data bytes of the message */
+	uint8_t flags; /**< #CAN_ANALYZER_FLAG_TX, #CAN_ANALYZER_FLAG_MON */
+	uint8_t data[CAN_ANALYZER_DATA_SIZE]; /**< data, CAN FD messages are truncated to #CAN_ANALYZER_DATA_SIZE bytes */
+} can_analyzer_entry_t;
 
 /*--------------------------------------------------------------------------*/
 /* global variables                                                         */
@@ -47,6 +86,78 @@
 /*--------------------------------------------------------------------------*/
 /* function prototypes                                                      */
 /*--------------------------------------------------------------------------*/
+/*!
+ * \brief initializes the analyzer, nothing is recorded until can_analyzer_start() is called
+ * \return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_analyzer_init(void);
+
+/*!
+ * \brief clears the trace and starts recording
+ * \param trigger_mask trigger sources (CAN_ANALYZER_TRIGGER_...) which stop the recording after the post trigger window,
+ * with 0 the recording runs until can_analyzer_stop() is called
+ * \return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_analyzer_start(uint16_t trigger_mask);
+
+/*!
+ * \brief stops recording immediately
+ * \return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_analyzer_stop(void);
+
+/*!
+ * \brief reports a trigger condition, ignored if the source is not part of the trigger mask
+ * \param source trigger source CAN_ANALYZER_TRIGGER_...
+ */
+void can_analyzer_trigger(uint16_t source);
+
+/*!
+ * \brief records a received message
+ * \param node #CAN_ANALYZER_NODE_MAIN or #CAN_ANALYZER_NODE_MON
+ * \param canid CAN identifier
+ * \param dlc number of data bytes
+ * \param data received data
+ */
+void can_analyzer_rx(uint16_t node, uint16_t canid, uint16_t dlc, const volatile uint8_t *data);
+
+/*!
+ * \brief records a transmitted message
+ * \param node #CAN_ANALYZER_NODE_MAIN or #CAN_ANALYZER_NODE_MON
+ * \param canid CAN identifier
+ * \param dlc number of data bytes
+ * \param data transmitted data
+ */
+void can_analyzer_tx(uint16_t node, uint16_t canid, uint16_t dlc, const volatile uint8_t *data);
+
+/*!
+ * \brief get state of the analyzer
+ * \return can_analyzer_state_t
+ */
+can_analyzer_state_t can_analyzer_get_state(void);
+
+/*!
+ * \brief get the trigger of a stopped recording
+ * \param[out] source trigger source CAN_ANALYZER_TRIGGER_..., 0 if stopped by can_analyzer_stop()
+ * \param[out] entry_nr number of the first entry recorded after the trigger
+ * \return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_analyzer_get_trigger(uint16_t *source, uint16_t *entry_nr);
+
+/*!
+ * \brief get number of recorded entries of a stopped recording
+ * \param[out] nr_of_entries number of entries
+ * \return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_analyzer_get_nr_of_entries(uint16_t *nr_of_entries);
+
+/*!
+ * \brief reads an entry of a stopped recording
+ * \param entry_nr number of the entry, 0 is the oldest entry
+ * \param[out] entry copy of the entry
+ * \return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_analyzer_read(uint16_t entry_nr, can_analyzer_entry_t *entry);
 
 #endif // #ifndef IO_CAN_ANALYZER_H
 /** @} */
@@ -31,16 +31,48 @@
 /*--------------------------------------------------------------------------*/
 /* included files                                                           */
 /*--------------------------------------------------------------------------*/
+#include <li_can_slv/config/li_can_slv_config_internal.h>
 #include <li_can_slv/core/io_can_types.h>
 #include <li_can_slv/error/li_can_slv_error_types.h>
 
 /*--------------------------------------------------------------------------*/
 /* general definitions                                                      */
 /*--------------------------------------------------------------------------*/
+#define CAN_QUALITY_NODE_MAIN	0 /**< main CAN node */
+#define CAN_QUALITY_NODE_MON	1 /**< monitor CAN node */
+
+#ifdef LI_CAN_SLV_MON
+#define CAN_QUALITY_NR_OF_NODES	2 /**< number of measured CAN nodes */
+#else // #ifdef LI_CAN_SLV_MON
+#define CAN_QUALITY_NR_OF_NODES	1 /**< number of measured CAN nodes */
+#endif // #ifdef LI_CAN_SLV_MON
+
+#define CAN_QUALITY_LEC_STUFF	0 /**< stuff error */
+#define CAN_QUALITY_LEC_FORM	1 /**< form error */
+#define CAN_QUALITY_LEC_ACK		2 /**< acknowledge error */
+#define CAN_QUALITY_LEC_BIT1	3 /**< bit 1 error */
+#define CAN_QUALITY_LEC_BIT0	4 /**< bit 0 error */
+#define CAN_QUALITY_LEC_CRC		5 /**< crc error */
+#define CAN_QUALITY_NR_OF_LEC	6 /**< number of last error code counters */
 
 /*--------------------------------------------------------------------------*/
 /* structure/type definitions                                               */
 /*--------------------------------------------------------------------------*/
+/**
+ * @brief statistic of one CAN node
+ * @struct can_quality_t
+ */
+typedef struct
+{
+	uint32_t rx_msg_cnt; /**< received messages */
+	uint32_t rx_byte_cnt; /**< received data bytes */
+	uint32_t tx_msg_cnt; /**< transmitted messages */
+	uint32_t tx_byte_cnt; /**< transmitted data bytes */
+	uint32_t cnt_lec[CAN_QUALITY_NR_OF_LEC]; /**< last error code counters, see CAN_QUALITY_LEC_STUFF... */
+	uint16_t node_load; /**< load of the node in the last quality window in per mill */
+	uint16_t current_quality; /**< quality of the last quality window in per mill */
+	uint16_t quality; /**< quality since start up in per mill */
+} can_quality_t;
 
 /*--------------------------------------------------------------------------*/
 /* global variables                                                         */
@@ -56,28 +88,62 @@
 li_can_slv_errorcode_t can_quality_init(void);
 
 /*!
- * \brief CAN-diagnose on main CAN-controller
- * \param obj_nr object number
- * \param interrupt_id CAN interrupt identification
- * \param can_status status of the CAN-controller
+ * \brief counts a received message, called from the receive handler of the node
+ * \param node CAN node #CAN_QUALITY_NODE_MAIN or #CAN_QUALITY_NODE_MON
+ * \param dlc number of data bytes of the message
+ */
+void can_quality_rx(uint16_t node, uint16_t dlc);
+
+/*!
+ * \brief counts a transmitted message, called from the transmit complete handler of the node
+ * \param node CAN node #CAN_QUALITY_NODE_MAIN or #CAN_QUALITY_NODE_MON
+ * \param dlc number of data bytes of the message
+ */
+void can_quality_tx(uint16_t node, uint16_t dlc);
+
+/*!
+ * \brief counts a bus error reported by the CAN-controller
+ * \param node CAN node #CAN_QUALITY_NODE_MAIN or #CAN_QUALITY_NODE_MON
+ * \param lec last error code #CAN_QUALITY_LEC_STUFF...#CAN_QUALITY_LEC_CRC
+ */
+void can_quality_lec(uint16_t node, uint16_t lec);
+
+/*!
+ * \brief moves the quality window and calculates node load and quality, called from li_can_slv_process()
  * \return	li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
  */
-li_can_slv_errorcode_t can_quality_process(uint16_t obj_nr, uint16_t interrupt_id, uint16_t can_status);
+li_can_slv_errorcode_t can_quality_process(void);
 
 /*!
- * \brief get current quality
+ * \brief get current quality of the main CAN node
  * \param[out] current_quality current CAN bus quality
  * \return	li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
  */
 li_can_slv_errorcode_t can_quality_current_get(uint16_t *current_quality);
 
 /*!
- * \brief get quality
+ * \brief get quality of the main CAN node
  * \param[out] quality of CAN bus since start up
  * \return	li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
  */
 li_can_slv_errorcode_t can_quality_get(uint16_t *quality);
 
+/*!
+ * \brief get the node load, the share of the bit rate used by the frames the node received or transmitted
+ * \param node CAN node #CAN_QUALITY_NODE_MAIN or #CAN_QUALITY_NODE_MON
+ * \param[out] node_load load of the node in the last quality window in per mill
+ * \return	li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_quality_node_load_get(uint16_t node, uint16_t *node_load);
+
+/*!
+ * \brief get a consistent copy of the statistic of a CAN node
+ * \param node CAN node #CAN_QUALITY_NODE_MAIN or #CAN_QUALITY_NODE_MON
+ * \param[out] statistic copy of the statistic
+ * \return	li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_quality_statistic_get(uint16_t node, can_quality_t *statistic);
+
 #endif // #ifndef IO_CAN_QUALITY_H
 /** @} */
 
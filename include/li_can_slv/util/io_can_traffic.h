@@ -0,0 +1,125 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/**
+ * @file io_can_traffic.h
+ * @brief header to IO CAN TRAFFIC module
+ * @addtogroup can_traffic
+ * @{
+ */
+
+#ifndef IO_CAN_TRAFFIC_H
+#define IO_CAN_TRAFFIC_H
+
+/*--------------------------------------------------------------------------*/
+/* included files                                                           */
+/*--------------------------------------------------------------------------*/
+#include <li_can_slv/config/li_can_slv_config_internal.h>
+#include <li_can_slv/core/io_can_types.h>
+#include <li_can_slv/error/li_can_slv_error_types.h>
+
+/*--------------------------------------------------------------------------*/
+/* general definitions                                                      */
+/*--------------------------------------------------------------------------*/
+#define CAN_TRAFFIC_NODE_MAIN	0 /**< main CAN node */
+#define CAN_TRAFFIC_NODE_MON	1 /**< monitor CAN node */
+
+#define CAN_TRAFFIC_REASON_ACCEPTED	0 /**< message accepted */
+#define CAN_TRAFFIC_REASON_WRONG_DLC	1 /**< message rejected, data length code does not match the configuration */
+#define CAN_TRAFFIC_REASON_WRONG_MODULE_NR	2 /**< message rejected, module number does not match the configuration */
+#define CAN_TRAFFIC_REASON_DEACTIVATED	3 /**< message ignored, synchronous process data of the logical module deactivated */
+#define CAN_TRAFFIC_REASON_DROPPED	4 /**< message dropped for any other error, e.g. full queue */
+#define CAN_TRAFFIC_NR_OF_REASONS	5 /**< */
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions                                               */
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief counters of one CAN identifier
+ * @struct can_traffic_entry_t
+ */
+typedef struct
+{
+	uint16_t canid; /**< CAN identifier */
+	uint16_t node; /**< #CAN_TRAFFIC_NODE_MAIN or #CAN_TRAFFIC_NODE_MON */
+	uint32_t cnt[CAN_TRAFFIC_NR_OF_REASONS]; /**< number of messages per reason CAN_TRAFFIC_REASON_... */
+} can_traffic_entry_t;
+
+/*--------------------------------------------------------------------------*/
+/* global variables                                                         */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes                                                      */
+/*--------------------------------------------------------------------------*/
+/*!
+ * \brief initializes the traffic counters
+ * \return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_traffic_init(void);
+
+/*!
+ * \brief counts a received message
+ * \param node #CAN_TRAFFIC_NODE_MAIN or #CAN_TRAFFIC_NODE_MON
+ * \param canid CAN identifier
+ * \param reason CAN_TRAFFIC_REASON_...
+ */
+void can_traffic_rx(uint16_t node, uint16_t canid, uint16_t reason);
+
+/*!
+ * \brief counts a received synchronous process data message of a configured logical module
+ * \param node #CAN_TRAFFIC_NODE_MAIN or #CAN_TRAFFIC_NODE_MON
+ * \param table_pos position of the logical module in the configuration table as resolved by the receive handler
+ * \param canid CAN identifier
+ * \param reason CAN_TRAFFIC_REASON_...
+ */
+void can_traffic_rx_sync(uint16_t node, uint16_t table_pos, uint16_t canid, uint16_t reason);
+
+/*!
+ * \brief get the reason of the error code returned by a receive function
+ * \param err error code of the receive function
+ * \return CAN_TRAFFIC_REASON_...
+ */
+uint16_t can_traffic_reason(li_can_slv_errorcode_t err);
+
+/*!
+ * \brief copies the counters of all counted CAN identifiers
+ * \param[out] entries table for the copy
+ * \param size number of entries of the table
+ * \param[out] nr_of_entries number of copied entries
+ * \return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_traffic_snapshot(can_traffic_entry_t *entries, uint16_t size, uint16_t *nr_of_entries);
+
+/*!
+ * \brief get number of messages not counted because the counter table is full
+ * \param[out] overflow number of messages
+ * \return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_traffic_get_overflow(uint32_t *overflow);
+
+/*!
+ * \brief clears all counters and the counter table
+ * \return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_traffic_reset(void);
+
+#endif // #ifndef IO_CAN_TRAFFIC_H
+/** @} */
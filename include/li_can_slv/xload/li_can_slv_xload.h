@@ -64,6 +64,13 @@ li_can_slv_errorcode_t li_can_slv_dload_set_version_request_handle(li_can_slv_dl
 li_can_slv_errorcode_t li_can_slv_dload_set_start_request_handle(li_can_slv_dload_start_request_handle_funcp_t handle);
 li_can_slv_errorcode_t li_can_slv_dload_set_data_block_end_handle(li_can_slv_dload_data_block_end_handle_funcp_t handle);
 li_can_slv_errorcode_t li_can_slv_dload_set_end_handle(li_can_slv_dload_end_handle_funcp_t handle);
+#ifdef LI_CAN_SLV_DLOAD_PIPELINE
+li_can_slv_errorcode_t li_can_slv_dload_set_block_commit_handle(li_can_slv_dload_block_commit_handle_funcp_t handle);
+li_can_slv_errorcode_t li_can_slv_dload_block_committed(li_can_slv_errorcode_t err);
+#endif // #ifdef LI_CAN_SLV_DLOAD_PIPELINE
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+uint32_t li_can_slv_dload_get_resume_offset(void);
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
 
 li_can_slv_errorcode_t li_can_slv_dload_version_request_short(li_can_slv_module_nr_t module_nr, const byte_t *src);
 li_can_slv_errorcode_t li_can_slv_dload_version_request_long1(li_can_slv_module_nr_t module_nr, const byte_t *src);
@@ -74,7 +81,10 @@ li_can_slv_errorcode_t li_can_slv_dload_start_request1(li_can_slv_module_nr_t mo
 li_can_slv_errorcode_t li_can_slv_dload_start_request2(li_can_slv_module_nr_t module_nr, const byte_t *src);
 li_can_slv_errorcode_t li_can_slv_dload_start(li_can_slv_xload_component_t *dload_component);
 
-li_can_slv_errorcode_t li_can_slv_dload_data(li_can_slv_module_nr_t module_nr, const byte_t *src);
+li_can_slv_errorcode_t li_can_slv_dload_data(li_can_slv_module_nr_t module_nr, uint16_t dlc, const byte_t *src);
+#ifdef LI_CAN_SLV_DLOAD_LZ
+li_can_slv_errorcode_t li_can_slv_dload_data_lz(li_can_slv_module_nr_t module_nr, uint16_t dlc, const byte_t *src);
+#endif // #ifdef LI_CAN_SLV_DLOAD_LZ
 li_can_slv_errorcode_t li_can_slv_dload_data_block_end(li_can_slv_module_nr_t module_nr, const byte_t *src);
 li_can_slv_errorcode_t li_can_slv_dload_end(li_can_slv_module_nr_t module_nr);
 li_can_slv_errorcode_t li_can_slv_dload_termination(li_can_slv_module_nr_t module_nr, uint32_t error);
@@ -89,6 +99,8 @@ uint8_t li_can_slv_xload_active(void);
 li_can_slv_errorcode_t li_can_slv_uload_set_info_request_handle(li_can_slv_uload_info_request_handle_funcp_t handle);
 li_can_slv_errorcode_t li_can_slv_uload_set_start_request_handle(li_can_slv_uload_start_request_handle_funcp_t handle);
 li_can_slv_errorcode_t li_can_slv_uload_set_uload_block_ack_handle(li_can_slv_uload_block_ack_handle_funcp_t handle);
+li_can_slv_errorcode_t li_can_slv_uload_set_progress_handle(li_can_slv_uload_progress_handle_funcp_t handle);
+li_can_slv_errorcode_t li_can_slv_uload_set_block_sent_handle(li_can_slv_uload_block_sent_handle_funcp_t handle);
 #endif // #ifdef LI_CAN_SLV_ULOAD
 
 #ifdef LI_CAN_SLV_ULOAD
@@ -96,7 +108,12 @@ li_can_slv_errorcode_t li_can_slv_uload_info_request_short(li_can_slv_module_nr_
 li_can_slv_errorcode_t li_can_slv_uload_info_answer(li_can_slv_module_nr_t module_nr, byte_t index, uint32_t size_of_component);
 li_can_slv_errorcode_t li_can_slv_uload_start_request1(li_can_slv_module_nr_t module_nr, const byte_t *src);
 li_can_slv_errorcode_t li_can_slv_uload_start_request2(li_can_slv_module_nr_t module_nr, const byte_t *src);
+// li_can_slv_uload_data_from_buffer() blocks until the block is queued, the other functions only start the block,
+// which is then sent by li_can_slv_uload_process() in the context of li_can_slv_process()
 li_can_slv_errorcode_t li_can_slv_uload_data_from_buffer(uint8_t *data, uint16_t data_length);
+li_can_slv_errorcode_t li_can_slv_uload_data_from_buffer_start(const uint8_t *data, uint16_t data_length);
+li_can_slv_errorcode_t li_can_slv_uload_data_from_source(li_can_slv_uload_read_funcp_t read, uint16_t data_length);
+void li_can_slv_uload_process(void);
 li_can_slv_errorcode_t li_can_slv_uload_block_ackn(li_can_slv_module_nr_t module_nr, const byte_t *src);
 li_can_slv_errorcode_t li_can_slv_uload_end_ackn(li_can_slv_module_nr_t module_nr, const byte_t *src);
 li_can_slv_errorcode_t li_can_slv_uload_termination(li_can_slv_module_nr_t module_nr, const byte_t *src, uint32_t *error);
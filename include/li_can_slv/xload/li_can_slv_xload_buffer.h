@@ -81,8 +81,10 @@ extern uint32_t dload_hexchar_to_uint32_internal(const char *hex_string, uint16_
 
 #ifdef LI_CAN_SLV_DLOAD_BUFFER_INTERNAL
 li_can_slv_errorcode_t dload_add_byte_to_buffer(byte_t byte);
+li_can_slv_errorcode_t dload_add_bytes_to_buffer(const byte_t *src, uint16_t len);
 
 li_can_slv_errorcode_t xload_buffer_get_byte(byte_t *data);
+li_can_slv_errorcode_t xload_buffer_get_bytes(byte_t *data, uint16_t len);
 li_can_slv_errorcode_t dload_get_str_byte(byte_t *data);
 li_can_slv_errorcode_t dload_get_str_uint16(uint16_t *data);
 li_can_slv_errorcode_t dload_get_str_uint32(uint32_t *data);
@@ -90,6 +92,9 @@ li_can_slv_errorcode_t xload_buffer_get_len(uint16_t *nr_of_bytes);
 li_can_slv_errorcode_t dload_store_buf_state(void);
 li_can_slv_errorcode_t dload_restore_buf_state(void);
 li_can_slv_errorcode_t dload_remove_bytes(uint16_t num);
+#ifdef LI_CAN_SLV_DLOAD_CRC_CHECK
+uint16_t dload_crc16_update_last_bytes(uint16_t crc, uint16_t num);
+#endif // #ifdef LI_CAN_SLV_DLOAD_CRC_CHECK
 
 #if defined(OUTER) || defined(OUTER_APP)
 li_can_slv_errorcode_t dload_add_str_to_buffer(byte_t *src, uint16_t max_length);
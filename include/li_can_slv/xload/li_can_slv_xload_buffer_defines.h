@@ -46,11 +46,17 @@ extern "C" {
 
 #ifdef LI_CAN_SLV_XLOAD_BLOCK_BUFFER_SIZE_DLOAD_USER_DEFINED
 #define LI_CAN_SLV_XLOAD_BLOCK_BUFFER_SIZE_DLOAD (LI_CAN_SLV_XLOAD_BLOCK_BUFFER_SIZE_DLOAD_USER_DEFINED)
+#elif defined(LI_CAN_SLV_XLOAD_FD)
+#define LI_CAN_SLV_XLOAD_BLOCK_BUFFER_SIZE_DLOAD (1008) /*!< block buffer size for download 16 can fd objects with 63 bytes each */
 #else // #ifdef LI_CAN_SLV_XLOAD_BLOCK_BUFFER_SIZE_DLOAD_USER_DEFINED
 #define LI_CAN_SLV_XLOAD_BLOCK_BUFFER_SIZE_DLOAD (140) /*!< block buffer size for download 20 can objects with 7 bytes each */
 #endif // #ifdef LI_CAN_SLV_XLOAD_BLOCK_BUFFER_SIZE_DLOAD_USER_DEFINED
 
+#ifdef LI_CAN_SLV_XLOAD_FD
+#define LI_CAN_SLV_XLOAD_BUFFER_SIZE_DLOAD	(LI_CAN_SLV_XLOAD_BLOCK_BUFFER_SIZE_DLOAD + 62) /*!< leaves room for the dummy bytes of the last can fd object of a block */
+#else // #ifdef LI_CAN_SLV_XLOAD_FD
 #define LI_CAN_SLV_XLOAD_BUFFER_SIZE_DLOAD	(LI_CAN_SLV_XLOAD_BLOCK_BUFFER_SIZE_DLOAD)
+#endif // #ifdef LI_CAN_SLV_XLOAD_FD
 #define LI_CAN_SLV_XLOAD_MAX_BYTES_PER_BLOCK_DLOAD (LI_CAN_SLV_XLOAD_BLOCK_BUFFER_SIZE_DLOAD) /**< Default max per block for dload */
 #define LI_CAN_SLV_XLOAD_MAX_BYTES_PER_BLOCK_HEX_DLOAD (LI_CAN_SLV_XLOAD_BLOCK_BUFFER_SIZE_DLOAD - 56) /**< Default max per block for dload - maximum hexline count (51 byte round to 56 (7 * 8) */
 
@@ -0,0 +1,82 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/**
+ * @file li_can_slv_xload_crc16.h
+ * @brief header to li_can_slv_xload_crc16.h module
+ * @addtogroup lcs_xload
+ * @{
+ */
+
+#ifndef LI_CAN_SLV_XLOAD_CRC16_H_
+#define LI_CAN_SLV_XLOAD_CRC16_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+/*--------------------------------------------------------------------------*/
+/* included files                                                           */
+/*--------------------------------------------------------------------------*/
+#include <li_can_slv/config/li_can_slv_config_internal.h>
+#include <li_can_slv/core/io_can_types.h>
+#include <stddef.h>
+
+/*--------------------------------------------------------------------------*/
+/* general definitions                                                      */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions                                               */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables                                                         */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes                                                      */
+/*--------------------------------------------------------------------------*/
+#ifdef LI_CAN_SLV_XLOAD_CRC16
+/*!
+ * \brief returns the initial value of a CRC16 calculation
+ * \remarks CRC-16/CCITT-FALSE: polynomial 0x1021, initial value 0xFFFF, no reflection, no final xor.
+ * \return initial value
+ */
+uint16_t li_can_slv_xload_crc16_init(void);
+
+/*!
+ * \brief updates a CRC16 with the given data
+ * \remarks The data may be passed in pieces of any length, the result is the same as for the whole data.
+ * \param crc CRC of the previous data or the initial value
+ * \param[in] data data
+ * \param data_len number of bytes
+ * \return updated CRC
+ */
+uint16_t li_can_slv_xload_crc16_update(uint16_t crc, const void *data, size_t data_len);
+#endif // #ifdef LI_CAN_SLV_XLOAD_CRC16
+
+#ifdef __cplusplus
+} // closing brace for extern "C"
+#endif // #ifdef __cplusplus
+
+#endif // #ifndef LI_CAN_SLV_XLOAD_CRC16_H_
+/** @} */
+
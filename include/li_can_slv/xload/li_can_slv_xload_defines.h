@@ -61,6 +61,12 @@ extern "C" {
 #define ULOAD_COMPONENT_NAME_LENGTH			DLOAD_COMPONENT_NAME_LENGTH /*!< length of component name to program in byte */
 #define ULOAD_BLOCK_BUFFER_SIZE				LI_CAN_SLV_XLOAD_BLOCK_BUFFER_SIZE_DLOAD /*!< block buffer size for download */
 
+#define XLOAD_FLAG_FD			0x01u /*!< CAN FD data objects are accepted (download start acknowledge) or requested (upload start request) */
+#define XLOAD_FLAG_WINDOW		0x02u /*!< numbered blocks are accepted (download start acknowledge) or used (data block end, block acknowledge) */
+#define XLOAD_FLAG_RETRANSMIT	0x04u /*!< the block acknowledge requests the retransmission of the numbered block and the blocks sent after it */
+#define XLOAD_FLAG_LZ			0x08u /*!< compressed data objects are accepted (download start acknowledge) */
+#define XLOAD_FLAG_RESUME		0x10u /*!< an interrupted download may be resumed (version request long2, download start acknowledge, block acknowledge with the offset) */
+
 #define DLOAD_SENDING_DATA		0x0001
 #define	DLOAD_SUCCESS			0x0002
 #define	DLOAD_END				0x0004
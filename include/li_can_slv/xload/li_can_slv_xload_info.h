@@ -47,6 +47,14 @@ extern "C" {
 #define LI_CAN_SLV_XLOAD_INFO_VALID			0x1000
 #define LI_CAN_SLV_XLOAD_INFO_NOT_VALID		0x1001
 
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+/*!
+ * \brief layout version of the download progress, a stored progress of another version is never resumed
+ * \remarks Change it with every change of li_can_slv_xload_info_resume_t.
+ */
+#define LI_CAN_SLV_XLOAD_INFO_RESUME_VERSION	0x5201u
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+
 /*!
  * \brief define the possible resets reset on a module
  */
@@ -79,6 +87,18 @@ typedef struct
 	uint32_t error_two; /*!< error two */
 } li_can_slv_xload_info_error_t;
 
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+/*!
+ * \brief progress of the download stored for a resume
+ */
+typedef struct
+{
+	uint16_t version; /*!< layout version of the progress, see #LI_CAN_SLV_XLOAD_INFO_RESUME_VERSION */
+	uint32_t offset; /*!< number of programmed bytes of the download */
+	uint16_t crc; /*!< running CRC16 of the programmed bytes */
+} li_can_slv_xload_info_resume_t;
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+
 /*--------------------------------------------------------------------------*/
 /* structure/type definitions                                               */
 /*--------------------------------------------------------------------------*/
@@ -97,6 +117,9 @@ typedef struct
 #endif // #ifdef LI_CAN_SLV_XLOAD_INFO_BACKWARD_COMPATIBILITY
 	li_can_slv_xload_component_t dload; /*!< dload component */
 	li_can_slv_config_bdr_t can_baudrate; /*!< can_baudrate 100, 250, 500 or 1000 kBaud */
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+	li_can_slv_xload_info_resume_t resume; /*!< progress of the download of the dload component */
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
 #ifdef LI_CAN_SLV_XLOAD_INFO_BACKWARD_COMPATIBILITY
 	li_can_slv_xload_info_error_t err; /*!< xload_info err */
 #endif // #ifdef LI_CAN_SLV_XLOAD_INFO_BACKWARD_COMPATIBILITY
@@ -112,6 +135,9 @@ typedef struct
 #elif defined (LI_CAN_SLV_XLOAD_INFO_BACKWARD_COMPATIBILITY) && defined (LI_CAN_SLV_XLOAD_INFO_USER)
 #error only use LI_CAN_SLV_XLOAD_INFO_BACKWARD_COMPATIBILITY or LI_CAN_SLV_XLOAD_INFO_USER
 #endif // #if defined (LI_CAN_SLV_XLOAD_INFO_BACKWARD_COMPATIBILITY) && !defined (LI_CAN_SLV_XLOAD_INFO_USER)
+#if defined (LI_CAN_SLV_XLOAD_INFO_BACKWARD_COMPATIBILITY) && defined (LI_CAN_SLV_DLOAD_RESUME)
+#error only use LI_CAN_SLV_XLOAD_INFO_BACKWARD_COMPATIBILITY or LI_CAN_SLV_USE_ASYNC_DOWNLOAD_RESUME
+#endif // #if defined (LI_CAN_SLV_XLOAD_INFO_BACKWARD_COMPATIBILITY) && defined (LI_CAN_SLV_DLOAD_RESUME)
 } li_can_slv_xload_info_t;
 #ifdef __GNUC__
 #pragma pack()
@@ -149,6 +175,11 @@ void li_can_slv_xload_info_get_dload_component(li_can_slv_xload_component_t *dlo
 void li_can_slv_xload_info_get_can_baudrate(uint16_t *can_baudrate);
 void li_can_slv_xload_info_set_can_baudrate(uint16_t can_baudrate);
 
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+void li_can_slv_xload_info_set_dload_resume(uint32_t offset, uint16_t crc);
+void li_can_slv_xload_info_get_dload_resume(uint32_t *offset, uint16_t *crc);
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+
 #ifdef LI_CAN_SLV_XLOAD_INFO_USER
 void li_can_slv_xload_info_set_user1(uint8_t user1_data);
 void li_can_slv_xload_info_get_user1(uint8_t *user1_data);
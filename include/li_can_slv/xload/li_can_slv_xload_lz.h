@@ -0,0 +1,105 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/**
+ * @file li_can_slv_xload_lz.h
+ * @brief header to li_can_slv_xload_lz.h module
+ * @addtogroup lcs_xload
+ * @{
+ */
+
+#ifndef LI_CAN_SLV_XLOAD_LZ_H_
+#define LI_CAN_SLV_XLOAD_LZ_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+/*--------------------------------------------------------------------------*/
+/* included files                                                           */
+/*--------------------------------------------------------------------------*/
+#include <li_can_slv/config/li_can_slv_config_internal.h>
+#include <li_can_slv/core/io_can_types.h>
+#include <li_can_slv/error/li_can_slv_error_types.h>
+
+/*--------------------------------------------------------------------------*/
+/* general definitions                                                      */
+/*--------------------------------------------------------------------------*/
+#ifdef LI_CAN_SLV_DLOAD_LZ
+#ifndef LI_CAN_SLV_XLOAD_LZ_WINDOW
+#define LI_CAN_SLV_XLOAD_LZ_WINDOW	(1024) /**< window size of the compressed download */
+#endif // #ifndef LI_CAN_SLV_XLOAD_LZ_WINDOW
+#endif // #ifdef LI_CAN_SLV_DLOAD_LZ
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions                                               */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables                                                         */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes                                                      */
+/*--------------------------------------------------------------------------*/
+#ifdef LI_CAN_SLV_DLOAD_LZ
+/*!
+ * \brief clears the window and the received data at the start of a download
+ * \param max_bytes_per_block maximum decompressed bytes of a block announced by the download start acknowledge
+ */
+void dload_lz_init(uint16_t max_bytes_per_block);
+
+/*!
+ * \brief adds the payload of a compressed data object to the received data of the block
+ * \param[in] src payload
+ * \param len number of bytes
+ * \return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t dload_lz_add_bytes(const byte_t *src, uint16_t len);
+
+/*!
+ * \brief returns the number of received compressed bytes of the block
+ * \return number of bytes
+ */
+uint16_t dload_lz_get_len(void);
+
+/*!
+ * \brief drops the received compressed bytes of the block, the window is not changed
+ */
+void dload_lz_drop_block(void);
+
+/*!
+ * \brief decompresses the received block into the download buffer
+ * \remarks Items may be split between blocks, the state of the decompression is kept until the next block. A block
+ * decompressing to more than the maximum bytes per block is rejected with ERR_MSG_CAN_DLOAD_BUF_OVERFLOW.
+ * \param len number of compressed bytes of the block without the dummy bytes of the last object
+ * \param[out] out_len number of bytes added to the download buffer
+ * \return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t dload_lz_block_end(uint16_t len, uint16_t *out_len);
+#endif // #ifdef LI_CAN_SLV_DLOAD_LZ
+
+#ifdef __cplusplus
+} // closing brace for extern "C"
+#endif // #ifdef __cplusplus
+
+#endif // #ifndef LI_CAN_SLV_XLOAD_LZ_H_
+/** @} */
+
@@ -71,12 +71,18 @@ typedef li_can_slv_errorcode_t (*li_can_slv_dload_version_request_handle_funcp_t
 typedef li_can_slv_errorcode_t (*li_can_slv_dload_start_request_handle_funcp_t)(li_can_slv_xload_component_t *dload_component);
 typedef li_can_slv_errorcode_t (*li_can_slv_dload_data_block_end_handle_funcp_t)(li_can_slv_xload_component_t *dload_component);
 typedef li_can_slv_errorcode_t (*li_can_slv_dload_end_handle_funcp_t)(li_can_slv_xload_component_t *dload_component, li_can_slv_xload_end_handle_status_t *status);
+#ifdef LI_CAN_SLV_DLOAD_PIPELINE
+typedef li_can_slv_errorcode_t (*li_can_slv_dload_block_commit_handle_funcp_t)(li_can_slv_xload_component_t *dload_component, const byte_t *data, uint16_t len);
+#endif // #ifdef LI_CAN_SLV_DLOAD_PIPELINE
 
 #ifdef LI_CAN_SLV_ULOAD
 typedef int16_t (*li_can_slv_uload_read_byte_funcp_t)(void);
 typedef li_can_slv_errorcode_t (*li_can_slv_uload_info_request_handle_funcp_t)(li_can_slv_xload_component_t *dload_component, uint32_t *size_of_component, li_can_slv_xload_end_handle_status_t *status);
 typedef li_can_slv_errorcode_t (*li_can_slv_uload_start_request_handle_funcp_t)(li_can_slv_xload_component_t *dload_component);
 typedef li_can_slv_errorcode_t (*li_can_slv_uload_block_ack_handle_funcp_t)(li_can_slv_xload_component_t *dload_component);
+typedef li_can_slv_errorcode_t (*li_can_slv_uload_read_funcp_t)(byte_t *data, uint16_t len);
+typedef void (*li_can_slv_uload_progress_handle_funcp_t)(li_can_slv_xload_component_t *uload_component, uint16_t bytes_sent, uint16_t data_length);
+typedef void (*li_can_slv_uload_block_sent_handle_funcp_t)(li_can_slv_xload_component_t *uload_component, li_can_slv_errorcode_t err);
 #endif // #ifdef LI_CAN_SLV_ULOAD
 
 /*--------------------------------------------------------------------------*/
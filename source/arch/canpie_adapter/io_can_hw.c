@@ -31,9 +31,18 @@
 #include <li_can_slv/core/io_can_main_types.h>
 #include <li_can_slv/error/io_can_errno.h>
 
+#ifdef LI_CAN_SLV_HW_TIMESTAMP
+#include "cp_msg.h"
+#endif // #ifdef LI_CAN_SLV_HW_TIMESTAMP
+
 /*--------------------------------------------------------------------------*/
 /* general definitions (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
+#ifdef LI_CAN_SLV_HW_TIMESTAMP
+#if CP_CAN_MSG_TIME != 1
+#error LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_HW_TIMESTAMP needs the CANpie time stamp field (CP_CAN_MSG_TIME)
+#endif // #if CP_CAN_MSG_TIME != 1
+#endif // #ifdef LI_CAN_SLV_HW_TIMESTAMP
 
 /*--------------------------------------------------------------------------*/
 /* structure/type definitions (private/not exported)                        */
@@ -84,6 +93,28 @@ li_can_slv_errorcode_t can_hw_combine_msg_obj_to_two_stage_fifo(uint16_t msg_obj
 #endif // #ifdef LI_CAN_SLV_SYS_OBJ2
 #endif // #if defined(OUTER) || defined(OUTER_APP)
 
+#ifdef LI_CAN_SLV_HW_TIMESTAMP
+/**
+ * @brief receive time of a message
+ * @remarks The time stamp of the driver is converted by the port, messages without a time stamp get the current
+ * system time.
+ * @param ptsCanMsgV received message
+ * @return receive time in system ticks
+ */
+uint32_t can_hw_get_rx_ticks(CpCanMsg_ts *ptsCanMsgV)
+{
+	CpTime_ts *time;
+
+	time = CpMsgGetTime(ptsCanMsgV);
+	if ((time == NULL) || ((time->ulSec1970 == 0) && (time->ulNanoSec == 0)))
+	{
+		return (can_port_get_system_ticks());
+	}
+
+	return (can_port_hw_time_2_ticks(time->ulSec1970, time->ulNanoSec));
+}
+#endif // #ifdef LI_CAN_SLV_HW_TIMESTAMP
+
 /*--------------------------------------------------------------------------*/
 /* function definition (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
@@ -43,6 +43,10 @@
 #include <li_can_slv/config/io_can_config_types.h>
 #include "io_can_main_hw_handler.h"
 
+#ifdef LI_CAN_SLV_ANALYZER
+#include <li_can_slv/util/io_can_analyzer.h>
+#endif // #ifdef LI_CAN_SLV_ANALYZER
+
 #include "canpie.h"
 #include "cp_core.h"
 #include "cp_msg.h"
@@ -56,7 +60,17 @@
 /*--------------------------------------------------------------------------*/
 /* general definitions (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
-#define CAN_MAIN_TX_FIFO_SIZE	(16u)
+#ifndef CAN_MAIN_TX_SYNC_FIFO_SIZE
+#define CAN_MAIN_TX_SYNC_FIFO_SIZE	(16u) /**< size of the transmit fifo for synchronous process data */
+#endif // #ifndef CAN_MAIN_TX_SYNC_FIFO_SIZE
+
+#ifndef CAN_MAIN_TX_SYS_FIFO_SIZE
+#define CAN_MAIN_TX_SYS_FIFO_SIZE	(8u) /**< size of the transmit fifo for system and error messages */
+#endif // #ifndef CAN_MAIN_TX_SYS_FIFO_SIZE
+
+#ifndef CAN_MAIN_TX_ASYNC_FIFO_SIZE
+#define CAN_MAIN_TX_ASYNC_FIFO_SIZE	(8u) /**< size of the transmit fifo for asynchronous messages */
+#endif // #ifndef CAN_MAIN_TX_ASYNC_FIFO_SIZE
 
 /*--------------------------------------------------------------------------*/
 /* structure/type definitions (private/not exported)                        */
@@ -83,12 +97,15 @@ const can_config_bdr_tab_t can_main_hw_default_baudrate_table[CAN_CONFIG_SIZE_OF
 /* global variables (private/not exported)                                  */
 /*--------------------------------------------------------------------------*/
 static uint8_t msg_obj_used[LI_CAN_SLV_MAIN_NODE_MAX_NOF_MSG_OBJ];
-static CpFifo_ts tx_fifo;
-static CpCanMsg_ts tx_fifo_messages[CAN_MAIN_TX_FIFO_SIZE];
+static CpFifo_ts tx_fifo[CAN_MAIN_TX_CLASS_NOF];
+static CpCanMsg_ts tx_fifo_sync_messages[CAN_MAIN_TX_SYNC_FIFO_SIZE];
+static CpCanMsg_ts tx_fifo_sys_messages[CAN_MAIN_TX_SYS_FIFO_SIZE];
+static CpCanMsg_ts tx_fifo_async_messages[CAN_MAIN_TX_ASYNC_FIFO_SIZE];
 
 /*--------------------------------------------------------------------------*/
 /* function prototypes (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
+static uint8_t can_main_hw_get_tx_msg_obj(can_main_tx_class_t tx_class);
 
 /*--------------------------------------------------------------------------*/
 /* function definition (public/exported)                                    */
@@ -100,17 +117,32 @@ static CpCanMsg_ts tx_fifo_messages[CAN_MAIN_TX_FIFO_SIZE];
 li_can_slv_errorcode_t can_main_hw_init(void)
 {
 	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
+	uint16_t tx_class;
+	uint8_t msg_obj;
+
 	CpCoreDriverInit(LI_CAN_SLV_MAIN_ARCH, &can_port_main, 0);
 
 #ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
-	CpCoreIntFunctions(&can_port_main,  can_main_hw_handler_rx, 0L, _can_main_hw_handler_error);
+	CpCoreIntFunctions(&can_port_main, can_main_hw_handler_rx, can_main_hw_handler_tx, _can_main_hw_handler_error);
 #else // #ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
-	CpCoreIntFunctions(&can_port_main, can_main_hw_handler_rx, 0L, 0L);
+	CpCoreIntFunctions(&can_port_main, can_main_hw_handler_rx, can_main_hw_handler_tx, 0L);
 #endif // #ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
 
-	CpFifoInit(&tx_fifo, &tx_fifo_messages[0], CAN_MAIN_TX_FIFO_SIZE);
-	CpCoreBufferConfig(&can_port_main, li_can_slv_sync_main_tx_msg_obj, (uint32_t) 0, CP_MASK_STD_FRAME, CP_MSG_FORMAT_CBFF, eCP_BUFFER_DIR_TRM);
-	CpCoreFifoConfig(&can_port_main, li_can_slv_sync_main_tx_msg_obj, &tx_fifo);
+	/**
+	 * Every transmit class gets its own message object and fifo. The synchronous object has the lowest
+	 * object number followed by the system and the asynchronous object, so a controller transmitting
+	 * pending buffers by object number drains the classes in strict priority order.
+	 */
+	CpFifoInit(&tx_fifo[CAN_MAIN_TX_CLASS_SYNC], &tx_fifo_sync_messages[0], CAN_MAIN_TX_SYNC_FIFO_SIZE);
+	CpFifoInit(&tx_fifo[CAN_MAIN_TX_CLASS_SYS], &tx_fifo_sys_messages[0], CAN_MAIN_TX_SYS_FIFO_SIZE);
+	CpFifoInit(&tx_fifo[CAN_MAIN_TX_CLASS_ASYNC], &tx_fifo_async_messages[0], CAN_MAIN_TX_ASYNC_FIFO_SIZE);
+
+	for (tx_class = CAN_MAIN_TX_CLASS_SYNC; tx_class < CAN_MAIN_TX_CLASS_NOF; tx_class++)
+	{
+		msg_obj = can_main_hw_get_tx_msg_obj((can_main_tx_class_t) tx_class);
+		CpCoreBufferConfig(&can_port_main, msg_obj, (uint32_t) 0, CP_MASK_STD_FRAME, CP_MSG_FORMAT_CBFF, eCP_BUFFER_DIR_TRM);
+		CpCoreFifoConfig(&can_port_main, msg_obj, &tx_fifo[tx_class]);
+	}
 
 	return err;
 }
@@ -215,7 +247,9 @@ li_can_slv_errorcode_t can_main_hw_define_msg_obj(uint16_t msg_obj, uint16_t can
 	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
 	enum CpBufferDir_e msg_dir;
 
+#ifndef LI_CAN_SLV_FD
 	/* TODO: unused */	(void)dlc;
+#endif // #ifndef LI_CAN_SLV_FD
 	ubBufferIdxV = (uint8_t) msg_obj;
 
 #ifdef LI_CAN_SLV_DEBUG_CAN_INIT_HW
@@ -237,7 +271,7 @@ li_can_slv_errorcode_t can_main_hw_define_msg_obj(uint16_t msg_obj, uint16_t can
 	}
 
 
-	status = CpCoreBufferConfig(&can_port_main, ubBufferIdxV, can_id, acceptance_mask, CP_MSG_FORMAT_CBFF, msg_dir);
+	status = CpCoreBufferConfig(&can_port_main, ubBufferIdxV, can_id, acceptance_mask, CANPIE_MSG_FORMAT(dlc), msg_dir);
 
 	if (eCP_ERR_NONE == status)
 	{
@@ -303,19 +337,19 @@ li_can_slv_errorcode_t can_main_hw_set_baudrate(can_config_bdr_tab_t *bdr_tab_en
 		switch (bdr_tab_entry->baudrate)
 		{
 			case 125:
-				CpCoreBitrate(&can_port_main, eCP_BITRATE_125K, eCP_BITRATE_NONE);
+				CpCoreBitrate(&can_port_main, eCP_BITRATE_125K, CANPIE_DATA_BITRATE);
 				break;
 
 			case 250:
-				CpCoreBitrate(&can_port_main, eCP_BITRATE_250K, eCP_BITRATE_NONE);
+				CpCoreBitrate(&can_port_main, eCP_BITRATE_250K, CANPIE_DATA_BITRATE);
 				break;
 
 			case 500:
-				CpCoreBitrate(&can_port_main, eCP_BITRATE_500K, eCP_BITRATE_NONE);
+				CpCoreBitrate(&can_port_main, eCP_BITRATE_500K, CANPIE_DATA_BITRATE);
 				break;
 
 			case 1000:
-				CpCoreBitrate(&can_port_main, eCP_BITRATE_1M, eCP_BITRATE_NONE);
+				CpCoreBitrate(&can_port_main, eCP_BITRATE_1M, CANPIE_DATA_BITRATE);
 				break;
 
 			default:
@@ -333,6 +367,11 @@ li_can_slv_errorcode_t can_main_hw_set_baudrate(can_config_bdr_tab_t *bdr_tab_en
 }
 
 li_can_slv_errorcode_t can_main_hw_send_msg(uint16_t can_id, uint16_t dlc, const volatile byte_t *data)
+{
+	return can_main_hw_send_msg_class(CAN_MAIN_TX_CLASS_SYNC, can_id, dlc, data);
+}
+
+li_can_slv_errorcode_t can_main_hw_send_msg_class(can_main_tx_class_t tx_class, uint16_t can_id, uint16_t dlc, const volatile byte_t *data)
 {
 	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
 	CpCanMsg_ts can_msg = {0};
@@ -340,20 +379,44 @@ li_can_slv_errorcode_t can_main_hw_send_msg(uint16_t can_id, uint16_t dlc, const
 	CpStatus_tv ret;
 
 	CpMsgClear(&can_msg);
+#ifdef LI_CAN_SLV_FD
+	if (dlc > CAN_DLC_MAX)
+	{
+		CpMsgInit(&can_msg, CP_MSG_FORMAT_FBFF);
+		CpMsgSetDlc(&can_msg, CpMsgSizeToDlc(dlc));
+		CpMsgSetBitrateSwitch(&can_msg);
+	}
+	else
+	{
+		CpMsgInit(&can_msg, CP_MSG_FORMAT_CBFF);
+		CpMsgSetDlc(&can_msg, dlc);
+	}
+#else
 	CpMsgInit(&can_msg, CP_MSG_FORMAT_CBFF);
 
 	CpMsgSetDlc(&can_msg, dlc);
+#endif // #ifdef LI_CAN_SLV_FD
 	CpMsgSetIdentifier(&can_msg, can_id);
 
 	li_can_slv_port_memory_cpy(&can_msg.tuMsgData, (uint8_t *)data, dlc);
 
 	tx_cnt = 1;
-	ret = CpCoreFifoWrite(&can_port_main, li_can_slv_sync_main_tx_msg_obj,  &can_msg, &tx_cnt);
+	ret = CpCoreFifoWrite(&can_port_main, can_main_hw_get_tx_msg_obj(tx_class), &can_msg, &tx_cnt);
 
-	if (eCP_ERR_NONE != ret)
+	if (eCP_ERR_FIFO_FULL == ret)
+	{
+		err = ERR_MSG_CAN_MSG_SEND_BUSY;
+	}
+	else if (eCP_ERR_NONE != ret)
 	{
 		err = ERR_MSG_CAN_MSG_SEND;
 	}
+#ifdef LI_CAN_SLV_ANALYZER
+	else
+	{
+		can_analyzer_tx(CAN_ANALYZER_NODE_MAIN, can_id, dlc, data);
+	}
+#endif // #ifdef LI_CAN_SLV_ANALYZER
 
 	return err;
 }
@@ -373,4 +436,35 @@ li_can_slv_errorcode_t can_main_hw_reserve_msg_obj(uint16_t msg_obj)
 	return err;
 }
 
+/*--------------------------------------------------------------------------*/
+/* function definition (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief returns the transmit message object of the given class
+ * @param tx_class transmit class
+ * @return number of the message object
+ */
+static uint8_t can_main_hw_get_tx_msg_obj(can_main_tx_class_t tx_class)
+{
+	uint8_t msg_obj;
+
+	switch (tx_class)
+	{
+		case CAN_MAIN_TX_CLASS_SYS:
+			msg_obj = (uint8_t) CAN_CONFIG_MSG_MAIN_OBJ_TX_SYS;
+			break;
+
+		case CAN_MAIN_TX_CLASS_ASYNC:
+			msg_obj = (uint8_t) CAN_CONFIG_MSG_MAIN_OBJ_TX_ASYNC;
+			break;
+
+		case CAN_MAIN_TX_CLASS_SYNC:
+		default:
+			msg_obj = (uint8_t) li_can_slv_sync_main_tx_msg_obj;
+			break;
+	}
+
+	return msg_obj;
+}
+
 /** @} */
@@ -41,6 +41,7 @@
 #include <li_can_slv/core/io_can_types.h>
 #include <li_can_slv/error/io_can_error.h>
 #include <li_can_slv/core/io_can_main.h>
+#include <li_can_slv/core/io_can_main_handler.h>
 
 #ifdef LI_CAN_SLV_ASYNC
 #include <li_can_slv/async/io_can_async.h>
@@ -58,9 +59,21 @@
 
 #include <li_can_slv/sys/io_can_sys.h>
 
+#ifdef LI_CAN_SLV_QUALITY
+#include <li_can_slv/util/io_can_quality.h>
+#endif // #ifdef LI_CAN_SLV_QUALITY
+
+#ifdef LI_CAN_SLV_ANALYZER
+#include <li_can_slv/util/io_can_analyzer.h>
+#endif // #ifdef LI_CAN_SLV_ANALYZER
+
 #include "io_can_main_hw.h"
 #include <li_can_slv/arch/io_can_main_hw_inline.h>
 
+#ifdef LI_CAN_SLV_HW_TIMESTAMP
+#include "io_can_hw.h"
+#endif // #ifdef LI_CAN_SLV_HW_TIMESTAMP
+
 #include "cp_core.h"
 #include "cp_msg.h"
 
@@ -76,7 +89,17 @@
 #define CANPIE_STATE_BUS_OFF	(eCP_STATE_BUS_OFF)
 #define CANPIE_ERR_TYPE_NONE	(eCP_ERR_TYPE_NONE)
 #define CANPIE_ERR_TYPE_FORM	(eCP_ERR_TYPE_FORM)
+#define CANPIE_ERR_TYPE_BIT0	(eCP_ERR_TYPE_BIT0)
+#define CANPIE_ERR_TYPE_BIT1	(eCP_ERR_TYPE_BIT1)
+#define CANPIE_ERR_TYPE_STUFF	(eCP_ERR_TYPE_STUFF)
+#define CANPIE_ERR_TYPE_CRC	(eCP_ERR_TYPE_CRC)
+#define CANPIE_ERR_TYPE_ACK	(eCP_ERR_TYPE_ACK)
 
+#ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
+#ifndef LI_CAN_SLV_ERROR_HANDLER_RATE_LIMIT_MS
+#define LI_CAN_SLV_ERROR_HANDLER_RATE_LIMIT_MS	(10) /**< minimum time in ms between two evaluated error events */
+#endif // #ifndef LI_CAN_SLV_ERROR_HANDLER_RATE_LIMIT_MS
+#endif // #ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
 
 /*--------------------------------------------------------------------------*/
 /* structure/type definitions (private/not exported)                        */
@@ -97,9 +120,23 @@
 /* if reconnect is enabled the error handler may be called from the 5ms task */
 static volatile uint32_t can_main_hw_handler_error_lock = 0;
 #endif // #ifdef LI_CAN_SLV_RECONNECT_ENA_ERR_HANDLER_LOCK
+
+#ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
+static volatile CpState_ts can_main_hw_error_event; /**< error event reported by the driver, repeated events are coalesced until it is evaluated */
+static volatile uint8_t can_main_hw_error_event_pending = FALSE; /**< an error event waits for evaluation */
+static volatile uint32_t can_main_hw_error_event_tick = 0; /**< system tick of the last evaluated error event */
+static volatile uint8_t can_main_hw_error_bus_ok = TRUE; /**< the last evaluated state was bus active without error */
+#endif // #ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
 /*--------------------------------------------------------------------------*/
 /* function prototypes (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
+static void can_main_hw_handler_error_state(CpState_ts *cp_state);
+#ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
+static void can_main_hw_handler_error_event(void);
+#endif // #ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
+#ifdef LI_CAN_SLV_QUALITY
+static void can_main_hw_handler_quality_lec(uint8_t err_type);
+#endif // #ifdef LI_CAN_SLV_QUALITY
 
 /*--------------------------------------------------------------------------*/
 /* function definition (public/exported)                                    */
@@ -111,10 +148,18 @@ static volatile uint32_t can_main_hw_handler_error_lock = 0;
  */
 uint8_t can_main_hw_handler_rx(CpCanMsg_ts *ptsCanMsgV, uint8_t ubBufferIdxV)
 {
+#ifdef LI_CAN_SLV_FD
+	uint8_t data[CAN_DLC_FD_MAX];
+#else
 	uint8_t data[8];
+#endif // #ifdef LI_CAN_SLV_FD
 	uint16_t canid;
 	uint8_t dlc;
 
+#ifdef LI_CAN_SLV_HW_TIMESTAMP
+	can_rx_ticks_set(CAN_RX_NODE_MAIN, can_hw_get_rx_ticks(ptsCanMsgV));
+#endif // #ifdef LI_CAN_SLV_HW_TIMESTAMP
+
 #ifdef LI_CAN_SLV_RECONNECT
 	// on canpie adapter layer we use no error interrupt and no software triggered call of this function
 	// so if we get here we are receiving any valid message
@@ -128,7 +173,7 @@ uint8_t can_main_hw_handler_rx(CpCanMsg_ts *ptsCanMsgV, uint8_t ubBufferIdxV)
 	}
 #ifdef LI_CAN_SLV_RECONNECT_IGNORE_RX_AFTER_RECONNECT_FOR_A_TIME
 	/* ignore incoming frames for a time if the reconnect has finished to prevent TX-Fifo overflow */
-	if (can_port_get_system_ticks() < + can_port_msec_2_ticks((li_can_slv_reconnect_get_back_time_ms() + LI_CAN_SLV_RECONNECT_IGNORE_RX_MS)))
+	if (can_rx_ticks_get(CAN_RX_NODE_MAIN) < + can_port_msec_2_ticks((li_can_slv_reconnect_get_back_time_ms() + LI_CAN_SLV_RECONNECT_IGNORE_RX_MS)))
 	{
 		return (LI_CAN_SLV_ERR_OK);
 	}
@@ -143,8 +188,20 @@ uint8_t can_main_hw_handler_rx(CpCanMsg_ts *ptsCanMsgV, uint8_t ubBufferIdxV)
 
 	canid = CpMsgGetStdId(ptsCanMsgV);
 	CpCoreBufferGetDlc(&can_port_main, ubBufferIdxV, &dlc);
+#ifdef LI_CAN_SLV_FD
+	// the driver reports the data length code, on CAN FD frames it differs from the payload size
+	dlc = CpMsgDlcToSize(dlc);
+#endif // #ifdef LI_CAN_SLV_FD
 	CpCoreBufferGetData(&can_port_main, ubBufferIdxV, &(data[0]), 0, dlc);
 
+#ifdef LI_CAN_SLV_QUALITY
+	can_quality_rx(CAN_QUALITY_NODE_MAIN, dlc);
+#endif // #ifdef LI_CAN_SLV_QUALITY
+
+#ifdef LI_CAN_SLV_ANALYZER
+	can_analyzer_rx(CAN_ANALYZER_NODE_MAIN, canid, dlc, data);
+#endif // #ifdef LI_CAN_SLV_ANALYZER
+
 #ifdef LI_CAN_SLV_DEBUG_CAN_MAIN_HW_HANDLER
 	LI_CAN_SLV_DEBUG_PRINT("rx obj: %d id: 0x%x\n", ubBufferIdxV, canid);
 #endif // #ifdef LI_CAN_SLV_DEBUG_CAN_MAIN_HW_HANDLER
@@ -165,23 +222,131 @@ uint8_t can_main_hw_handler_rx(CpCanMsg_ts *ptsCanMsgV, uint8_t ubBufferIdxV)
 	return 0;
 }
 
-#ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
 /**
+ * @brief transmit complete handler, refills the hardware transmit path of the asynchronous
+ * message object from the asynchronous software queues as soon as a slot is free again
+ * @param ptsCanMsgV
+ * @param ubBufferIdxV
  * @return
  */
+uint8_t can_main_hw_handler_tx(CpCanMsg_ts *ptsCanMsgV, uint8_t ubBufferIdxV)
+{
+#ifdef LI_CAN_SLV_QUALITY
+	uint8_t dlc;
+#endif // #ifdef LI_CAN_SLV_QUALITY
+
+	ptsCanMsgV = ptsCanMsgV;
+
+#ifdef LI_CAN_SLV_QUALITY
+	CpCoreBufferGetDlc(&can_port_main, ubBufferIdxV, &dlc);
+#ifdef LI_CAN_SLV_FD
+	dlc = CpMsgDlcToSize(dlc);
+#endif // #ifdef LI_CAN_SLV_FD
+	can_quality_tx(CAN_QUALITY_NODE_MAIN, dlc);
+#endif // #ifdef LI_CAN_SLV_QUALITY
+
+#if defined(OUTER) || defined(OUTER_APP)
+#ifdef LI_CAN_SLV_ASYNC
+	if (CAN_CONFIG_MSG_MAIN_OBJ_TX_ASYNC == ubBufferIdxV)
+	{
+		(void) can_main_handler_tx(ubBufferIdxV);
+	}
+#else // #ifdef LI_CAN_SLV_ASYNC
+	ubBufferIdxV = ubBufferIdxV;
+#endif // #ifdef LI_CAN_SLV_ASYNC
+#else // #if defined(OUTER) || defined(OUTER_APP)
+	ubBufferIdxV = ubBufferIdxV;
+#endif // #if defined(OUTER) || defined(OUTER_APP)
+
+	return 0;
+}
+
+#ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
+/**
+ * @brief error callback of the driver
+ *
+ * Repeated events are coalesced into one pending event, the last reported error type is kept until the
+ * event is evaluated. Events are evaluated at most once per #LI_CAN_SLV_ERROR_HANDLER_RATE_LIMIT_MS, a
+ * deferred event is evaluated from can_main_hw_handler_error().
+ * @param ptsErrV state reported by the driver
+ * @return 0
+ */
 uint8_t _can_main_hw_handler_error(CpState_ts *ptsErrV)
 {
-	ptsErrV = ptsErrV;
+#ifdef LI_CAN_SLV_QUALITY
+	// every reported error is counted, the rate limit only applies to the evaluation
+	can_main_hw_handler_quality_lec(ptsErrV->ubCanErrType);
+#endif // #ifdef LI_CAN_SLV_QUALITY
+
+	can_main_hw_error_event.ubCanErrState = ptsErrV->ubCanErrState;
+	can_main_hw_error_event.ubCanRcvErrCnt = ptsErrV->ubCanRcvErrCnt;
+	can_main_hw_error_event.ubCanTrmErrCnt = ptsErrV->ubCanTrmErrCnt;
+	if ((can_main_hw_error_event_pending == FALSE) || (ptsErrV->ubCanErrType != CANPIE_ERR_TYPE_NONE))
+	{
+		can_main_hw_error_event.ubCanErrType = ptsErrV->ubCanErrType;
+	}
+	can_main_hw_error_event_pending = TRUE;
 
-	can_main_hw_handler_error();
+	if ((uint32_t)(can_port_get_system_ticks() - can_main_hw_error_event_tick) >= can_port_msec_2_ticks(LI_CAN_SLV_ERROR_HANDLER_RATE_LIMIT_MS))
+	{
+		can_main_hw_handler_error_event();
+	}
 
 	return 0;
 }
 #endif // #ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
 
+/**
+ * @brief periodic error handling of the main node
+ *
+ * With #LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER the errors are evaluated from the driver callback,
+ * the periodic call only evaluates a deferred event and polls the driver state while the bus is disturbed
+ * or a reconnect is running. On an undisturbed bus no driver function is called.
+ * @return 0
+ */
 uint8_t can_main_hw_handler_error(void)
 {
 	CpState_ts cp_state;
+
+#ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
+	if (can_main_hw_error_event_pending != FALSE)
+	{
+		if ((uint32_t)(can_port_get_system_ticks() - can_main_hw_error_event_tick) >= can_port_msec_2_ticks(LI_CAN_SLV_ERROR_HANDLER_RATE_LIMIT_MS))
+		{
+			can_main_hw_handler_error_event();
+		}
+		return 0;
+	}
+
+#ifdef LI_CAN_SLV_RECONNECT
+	if ((can_main_hw_error_bus_ok == TRUE) && (CAN_RECONNECT_STATE_OFF == li_can_slv_reconnect_get_state()))
+#else // #ifdef LI_CAN_SLV_RECONNECT
+	if (can_main_hw_error_bus_ok == TRUE)
+#endif // #ifdef LI_CAN_SLV_RECONNECT
+	{
+		return 0;
+	}
+#endif // #ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
+
+	(void) CpCoreCanState(&can_port_main, &cp_state);
+#if defined(LI_CAN_SLV_QUALITY) && !defined(LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER)
+	// without the error callback the last error code is sampled on every call
+	can_main_hw_handler_quality_lec(cp_state.ubCanErrType);
+#endif // #if defined(LI_CAN_SLV_QUALITY) && !defined(LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER)
+	can_main_hw_handler_error_state(&cp_state);
+
+	return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/* function definition (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief evaluates the error state of the main node
+ * @param cp_state error state of the driver
+ */
+static void can_main_hw_handler_error_state(CpState_ts *cp_state)
+{
 #ifdef LI_CAN_SLV_RECONNECT
 	int16_t cp_lec;
 #endif // #ifdef LI_CAN_SLV_RECONNECT
@@ -196,18 +361,20 @@ uint8_t can_main_hw_handler_error(void)
 		can_main_hw_handler_error_lock = 1;
 		li_can_slv_port_enable_irq();
 #endif // #ifdef LI_CAN_SLV_RECONNECT_ENA_ERR_HANDLER_LOCK
-		(void) CpCoreCanState(&can_port_main, &cp_state);
 #ifdef LI_CAN_SLV_RECONNECT
-		cp_lec = cp_state.ubCanErrType;
+		cp_lec = cp_state->ubCanErrType;
 #endif // #ifdef LI_CAN_SLV_RECONNECT
+#ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
+		can_main_hw_error_bus_ok = ((cp_state->ubCanErrState == CANPIE_STATE_BUS_ACTIVE) && (cp_state->ubCanErrType == CANPIE_ERR_TYPE_NONE)) ? TRUE : FALSE;
+#endif // #ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
 
-		if ((cp_state.ubCanErrState != CANPIE_STATE_BUS_ACTIVE) || (cp_state.ubCanErrType != CANPIE_ERR_TYPE_NONE))
+		if ((cp_state->ubCanErrState != CANPIE_STATE_BUS_ACTIVE) || (cp_state->ubCanErrType != CANPIE_ERR_TYPE_NONE))
 		{
 #ifdef LI_CAN_SLV_DEBUG_CAN_ERROR
-			LI_CAN_SLV_DEBUG_PRINT("CAN_ERR->state:%d\n", cp_state.ubCanErrState);
-			LI_CAN_SLV_DEBUG_PRINT("CAN_ERR->type:%d\n", cp_state.ubCanErrType);
-			LI_CAN_SLV_DEBUG_PRINT("CAN_ERR->txcnt:%d\n", cp_state.ubCanTrmErrCnt);
-			LI_CAN_SLV_DEBUG_PRINT("CAN_ERR->rxcnt:%d\n", cp_state.ubCanRcvErrCnt);
+			LI_CAN_SLV_DEBUG_PRINT("CAN_ERR->state:%d\n", cp_state->ubCanErrState);
+			LI_CAN_SLV_DEBUG_PRINT("CAN_ERR->type:%d\n", cp_state->ubCanErrType);
+			LI_CAN_SLV_DEBUG_PRINT("CAN_ERR->txcnt:%d\n", cp_state->ubCanTrmErrCnt);
+			LI_CAN_SLV_DEBUG_PRINT("CAN_ERR->rxcnt:%d\n", cp_state->ubCanRcvErrCnt);
 #endif // #ifdef LI_CAN_SLV_DEBUG_CAN_ERROR
 
 #ifdef LI_CAN_SLV_RECONNECT
@@ -218,7 +385,7 @@ uint8_t can_main_hw_handler_error(void)
 #endif // #ifdef LI_CAN_SLV_MAIN_MON
 				if (CAN_RECONNECT_STATE_OFF == li_can_slv_reconnect_get_state())
 				{
-					if ((cp_state.ubCanErrState == CANPIE_STATE_BUS_OFF) || (cp_state.ubCanErrType != CANPIE_ERR_TYPE_NONE))
+					if ((cp_state->ubCanErrState == CANPIE_STATE_BUS_OFF) || (cp_state->ubCanErrType != CANPIE_ERR_TYPE_NONE))
 					{
 						(void)li_can_slv_set_node_mode(LI_CAN_SLV_MODE_STOPPED);
 						(void)li_can_slv_set_node_mode(LI_CAN_SLV_MODE_LISTEN_ONLY);
@@ -226,11 +393,11 @@ uint8_t can_main_hw_handler_error(void)
 						li_can_slv_reconnect_on_main_node_recovery(1);
 					}
 
-					if ((cp_state.ubCanErrState == CANPIE_STATE_BUS_PASSIVE))
-						// if ((cp_state.ubCanErrType != CANPIE_ERR_TYPE_NONE))
-						// if (((cp_state.ubCanErrState == CANPIE_STATE_BUS_PASSIVE)) && (cp_state.ubCanErrType != CANPIE_ERR_TYPE_NONE)) // || (cp_state.ubCanErrType == CANPIE_ERR_TYPE_FORM))
-						// if ((cp_state.ubCanErrState == CANPIE_STATE_BUS_PASSIVE) || (cp_state.ubCanErrType != CANPIE_ERR_TYPE_NONE))
-						// if ((cp_state.ubCanErrState == CANPIE_STATE_BUS_PASSIVE) ||  ((cp_state.ubCanErrState == CANPIE_STATE_BUS_ACTIVE) && (cp_state.ubCanErrType == CANPIE_ERR_TYPE_FORM)))
+					if ((cp_state->ubCanErrState == CANPIE_STATE_BUS_PASSIVE))
+						// if ((cp_state->ubCanErrType != CANPIE_ERR_TYPE_NONE))
+						// if (((cp_state->ubCanErrState == CANPIE_STATE_BUS_PASSIVE)) && (cp_state->ubCanErrType != CANPIE_ERR_TYPE_NONE)) // || (cp_state->ubCanErrType == CANPIE_ERR_TYPE_FORM))
+						// if ((cp_state->ubCanErrState == CANPIE_STATE_BUS_PASSIVE) || (cp_state->ubCanErrType != CANPIE_ERR_TYPE_NONE))
+						// if ((cp_state->ubCanErrState == CANPIE_STATE_BUS_PASSIVE) ||  ((cp_state->ubCanErrState == CANPIE_STATE_BUS_ACTIVE) && (cp_state->ubCanErrType == CANPIE_ERR_TYPE_FORM)))
 					{
 
 
@@ -268,12 +435,61 @@ uint8_t can_main_hw_handler_error(void)
 		li_can_slv_port_enable_irq();
 	}
 #endif // #ifdef LI_CAN_SLV_RECONNECT_ENA_ERR_HANDLER_LOCK
-	return 0;
 }
 
-/*--------------------------------------------------------------------------*/
-/* function definition (private/not exported)                               */
-/*--------------------------------------------------------------------------*/
+#ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
+/**
+ * @brief evaluates the pending error event
+ */
+static void can_main_hw_handler_error_event(void)
+{
+	CpState_ts cp_state;
+
+	li_can_slv_port_disable_irq();
+	cp_state.ubCanErrState = can_main_hw_error_event.ubCanErrState;
+	cp_state.ubCanErrType = can_main_hw_error_event.ubCanErrType;
+	cp_state.ubCanRcvErrCnt = can_main_hw_error_event.ubCanRcvErrCnt;
+	cp_state.ubCanTrmErrCnt = can_main_hw_error_event.ubCanTrmErrCnt;
+	can_main_hw_error_event_pending = FALSE;
+	can_main_hw_error_event_tick = can_port_get_system_ticks();
+	li_can_slv_port_enable_irq();
+
+	can_main_hw_handler_error_state(&cp_state);
+}
+#endif // #ifdef LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
+
+#ifdef LI_CAN_SLV_QUALITY
+/**
+ * @brief counts the error type of the driver on the quality measurement
+ * @param err_type error type of the driver
+ */
+static void can_main_hw_handler_quality_lec(uint8_t err_type)
+{
+	switch (err_type)
+	{
+		case CANPIE_ERR_TYPE_STUFF:
+			can_quality_lec(CAN_QUALITY_NODE_MAIN, CAN_QUALITY_LEC_STUFF);
+			break;
+		case CANPIE_ERR_TYPE_FORM:
+			can_quality_lec(CAN_QUALITY_NODE_MAIN, CAN_QUALITY_LEC_FORM);
+			break;
+		case CANPIE_ERR_TYPE_ACK:
+			can_quality_lec(CAN_QUALITY_NODE_MAIN, CAN_QUALITY_LEC_ACK);
+			break;
+		case CANPIE_ERR_TYPE_BIT1:
+			can_quality_lec(CAN_QUALITY_NODE_MAIN, CAN_QUALITY_LEC_BIT1);
+			break;
+		case CANPIE_ERR_TYPE_BIT0:
+			can_quality_lec(CAN_QUALITY_NODE_MAIN, CAN_QUALITY_LEC_BIT0);
+			break;
+		case CANPIE_ERR_TYPE_CRC:
+			can_quality_lec(CAN_QUALITY_NODE_MAIN, CAN_QUALITY_LEC_CRC);
+			break;
+		default:
+			break;
+	}
+}
+#endif // #ifdef LI_CAN_SLV_QUALITY
 
 /** @} */
 
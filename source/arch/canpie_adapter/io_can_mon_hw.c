@@ -63,6 +63,17 @@
 #define CANPIE_BUFFER_DIR_TX	(eCP_BUFFER_DIR_TRM)
 #define CANPIE_BUFFER_DIR_RX	(eCP_BUFFER_DIR_RCV)
 
+#ifdef LI_CAN_SLV_FD
+#ifndef LI_CAN_SLV_FD_DATA_BITRATE
+#define LI_CAN_SLV_FD_DATA_BITRATE	(eCP_BITRATE_2M)
+#endif // #ifndef LI_CAN_SLV_FD_DATA_BITRATE
+#define CANPIE_DATA_BITRATE	(LI_CAN_SLV_FD_DATA_BITRATE)
+#define CANPIE_MSG_FORMAT(dlc)	(((dlc) > CAN_DLC_MAX) ? CP_MSG_FORMAT_FBFF : CP_MSG_FORMAT_CBFF)
+#else
+#define CANPIE_DATA_BITRATE	(eCP_BITRATE_NONE)
+#define CANPIE_MSG_FORMAT(dlc)	(CP_MSG_FORMAT_CBFF)
+#endif // #ifdef LI_CAN_SLV_FD
+
 /*--------------------------------------------------------------------------*/
 /* structure/type definitions (private/not exported)                        */
 /*--------------------------------------------------------------------------*/
@@ -193,7 +204,9 @@ li_can_slv_errorcode_t can_mon_hw_define_msg_obj(uint16_t msg_obj, uint16_t can_
 	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
 	enum CpBufferDir_e msg_dir;
 
+#ifndef LI_CAN_SLV_FD
 	/* TODO: unused */	(void)dlc;
+#endif // #ifndef LI_CAN_SLV_FD
 	ubBufferIdxV = (uint8_t) msg_obj;
 
 #ifdef LI_CAN_SLV_DEBUG_CAN_INIT_HW
@@ -212,7 +225,7 @@ li_can_slv_errorcode_t can_mon_hw_define_msg_obj(uint16_t msg_obj, uint16_t can_
 		msg_dir = CANPIE_BUFFER_DIR_RX;
 	}
 
-	status = CpCoreBufferConfig(&can_port_mon, ubBufferIdxV, can_id, acceptance_mask, CP_MSG_FORMAT_CBFF, msg_dir);
+	status = CpCoreBufferConfig(&can_port_mon, ubBufferIdxV, can_id, acceptance_mask, CANPIE_MSG_FORMAT(dlc), msg_dir);
 
 	if (eCP_ERR_NONE == status)
 	{
@@ -246,19 +259,19 @@ li_can_slv_errorcode_t can_mon_hw_set_baudrate(can_config_bdr_tab_t *bdr_tab_ent
 	switch (bdr_tab_entry->baudrate)
 	{
 		case 125:
-			CpCoreBitrate(&can_port_mon, eCP_BITRATE_125K, eCP_BITRATE_NONE);
+			CpCoreBitrate(&can_port_mon, eCP_BITRATE_125K, CANPIE_DATA_BITRATE);
 			break;
 
 		case 250:
-			CpCoreBitrate(&can_port_mon, eCP_BITRATE_250K, eCP_BITRATE_NONE);
+			CpCoreBitrate(&can_port_mon, eCP_BITRATE_250K, CANPIE_DATA_BITRATE);
 			break;
 
 		case 500:
-			CpCoreBitrate(&can_port_mon, eCP_BITRATE_500K, eCP_BITRATE_NONE);
+			CpCoreBitrate(&can_port_mon, eCP_BITRATE_500K, CANPIE_DATA_BITRATE);
 			break;
 
 		case 1000:
-			CpCoreBitrate(&can_port_mon, eCP_BITRATE_1M, eCP_BITRATE_NONE);
+			CpCoreBitrate(&can_port_mon, eCP_BITRATE_1M, CANPIE_DATA_BITRATE);
 			break;
 
 		default:
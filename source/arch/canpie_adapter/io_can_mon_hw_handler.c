@@ -51,9 +51,21 @@
 
 #include <li_can_slv/sys/io_can_sys.h>
 
+#ifdef LI_CAN_SLV_QUALITY
+#include <li_can_slv/util/io_can_quality.h>
+#endif // #ifdef LI_CAN_SLV_QUALITY
+
+#ifdef LI_CAN_SLV_ANALYZER
+#include <li_can_slv/util/io_can_analyzer.h>
+#endif // #ifdef LI_CAN_SLV_ANALYZER
+
 #include "io_can_mon_hw.h"
 #include <li_can_slv/arch/io_can_mon_hw_inline.h>
 
+#ifdef LI_CAN_SLV_HW_TIMESTAMP
+#include "io_can_hw.h"
+#endif // #ifdef LI_CAN_SLV_HW_TIMESTAMP
+
 #include "cp_core.h"
 #include "cp_msg.h"
 
@@ -101,10 +113,18 @@
  */
 uint8_t can_mon_hw_handler_rx(CpCanMsg_ts *ptsCanMsgV, uint8_t ubBufferIdxV)
 {
+#ifdef LI_CAN_SLV_FD
+	uint8_t data[CAN_DLC_FD_MAX];
+#else
 	uint8_t data[8];
+#endif // #ifdef LI_CAN_SLV_FD
 	uint16_t canid;
 	uint8_t dlc;
 
+#ifdef LI_CAN_SLV_HW_TIMESTAMP
+	can_rx_ticks_set(CAN_RX_NODE_MON, can_hw_get_rx_ticks(ptsCanMsgV));
+#endif // #ifdef LI_CAN_SLV_HW_TIMESTAMP
+
 #ifdef LI_CAN_SLV_RECONNECT
 	if (li_can_slv_reconnect_get_state() != CAN_RECONNECT_STATE_OFF)
 	{
@@ -112,7 +132,7 @@ uint8_t can_mon_hw_handler_rx(CpCanMsg_ts *ptsCanMsgV, uint8_t ubBufferIdxV)
 	}
 #ifdef LI_CAN_SLV_RECONNECT_IGNORE_RX_AFTER_RECONNECT_FOR_A_TIME
 	/* ignore incoming frames for a time if the reconnect has finished to prevent TX-Fifo overflow */
-	if (can_port_get_system_ticks() < + can_port_msec_2_ticks((li_can_slv_reconnect_get_back_time_ms() + LI_CAN_SLV_RECONNECT_IGNORE_RX_MS)))
+	if (can_rx_ticks_get(CAN_RX_NODE_MON) < + can_port_msec_2_ticks((li_can_slv_reconnect_get_back_time_ms() + LI_CAN_SLV_RECONNECT_IGNORE_RX_MS)))
 	{
 		return (LI_CAN_SLV_ERR_OK);
 	}
@@ -121,8 +141,20 @@ uint8_t can_mon_hw_handler_rx(CpCanMsg_ts *ptsCanMsgV, uint8_t ubBufferIdxV)
 
 	canid = CpMsgGetStdId(ptsCanMsgV);
 	CpCoreBufferGetDlc(&can_port_mon, ubBufferIdxV, &dlc);
+#ifdef LI_CAN_SLV_FD
+	// the driver reports the data length code, on CAN FD frames it differs from the payload size
+	dlc = CpMsgDlcToSize(dlc);
+#endif // #ifdef LI_CAN_SLV_FD
 	CpCoreBufferGetData(&can_port_mon, ubBufferIdxV, &(data[0]), 0, dlc);
 
+#ifdef LI_CAN_SLV_QUALITY
+	can_quality_rx(CAN_QUALITY_NODE_MON, dlc);
+#endif // #ifdef LI_CAN_SLV_QUALITY
+
+#ifdef LI_CAN_SLV_ANALYZER
+	can_analyzer_rx(CAN_ANALYZER_NODE_MON, canid, dlc, data);
+#endif // #ifdef LI_CAN_SLV_ANALYZER
+
 #ifdef LI_CAN_SLV_DEBUG_CAN_MON_HW_HANDLER
 	LI_CAN_SLV_DEBUG_PRINT("rx obj: %d id: 0x%x\n", ubBufferIdxV, canid);
 #endif // #ifdef LI_CAN_SLV_DEBUG_CAN_MON_HW_HANDLER
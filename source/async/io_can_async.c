@@ -63,6 +63,9 @@
 /* include files                                                            */
 /*--------------------------------------------------------------------------*/
 #include <li_can_slv/async/io_can_async.h>
+#ifdef LI_CAN_SLV_ASYNC_ISOTP
+#include <li_can_slv/async/io_can_async_isotp.h>
+#endif // #ifdef LI_CAN_SLV_ASYNC_ISOTP
 #ifdef LI_CAN_SLV_DLOAD
 #include <li_can_slv/xload/li_can_slv_xload.h>
 #endif // #ifdef LI_CAN_SLV_DLOAD
@@ -71,9 +74,15 @@
 #include <li_can_slv/config/li_can_slv_config_defines.h>
 
 #include <li_can_slv/error/io_can_errno.h>
+#if defined(CAN_ASYNC_CTRL_RX_QUEUE) && defined(LI_CAN_SLV_SYS_MODULE_ERROR)
+#include <li_can_slv/error/io_can_error.h>
+#endif // #if defined(CAN_ASYNC_CTRL_RX_QUEUE) && defined(LI_CAN_SLV_SYS_MODULE_ERROR)
 
 #include <li_can_slv/core/io_can_main.h>
 #include <li_can_slv/core/io_can.h>
+#ifdef CAN_ASYNC_TX_SHAPER
+#include <li_can_slv/sync/io_can_sync.h>
+#endif // #ifdef CAN_ASYNC_TX_SHAPER
 
 #include "io_can_async_hw.h"
 #include "io_can_main_hw.h"
@@ -91,13 +100,94 @@
 /*--------------------------------------------------------------------------*/
 /* general definitions (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
+#ifdef CAN_ASYNC_CTRL_RX_QUEUE
+#if (CAN_ASYNC_CTRL_RX_QUEUE_LENGTH & (CAN_ASYNC_CTRL_RX_QUEUE_LENGTH - 1)) != 0
+#error CAN_ASYNC_CTRL_RX_QUEUE_LENGTH must be a power of two
+#endif
+#define CAN_ASYNC_CTRL_RX_QUEUE_MASK	(CAN_ASYNC_CTRL_RX_QUEUE_LENGTH - 1) /**< */
+#ifndef CAN_ASYNC_CTRL_RX_QUEUE_BATCH
+#define CAN_ASYNC_CTRL_RX_QUEUE_BATCH	(CAN_ASYNC_CTRL_RX_QUEUE_LENGTH) /**< maximum number of objects processed per call of can_async_handle_async_ctrl_rx_queue() */
+#endif // #ifndef CAN_ASYNC_CTRL_RX_QUEUE_BATCH
+#endif // #ifdef CAN_ASYNC_CTRL_RX_QUEUE
+
 #ifdef LI_CAN_SLV_ASYNC_TUNNEL
 /* CAN asynchronous tunnel definitions */
-#define CAN_ASYNC_TNL_PARTLYFILLES_TXOBJ_DELAY_MS	50 /*!< Time in msec that a partly filled TX asynchronous data object is delayed until it is transmitted to the TX queue */
+#ifndef CAN_ASYNC_TNL_PARTLYFILLES_TXOBJ_DELAY_MS
+#define CAN_ASYNC_TNL_PARTLYFILLES_TXOBJ_DELAY_MS	50 /*!< Time in msec from the first byte that a partly filled TX asynchronous data object is delayed at most while tunnel data is transmitted */
+#endif // #ifndef CAN_ASYNC_TNL_PARTLYFILLES_TXOBJ_DELAY_MS
 #endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL
 
 #if defined(OUTER) || defined(OUTER_APP)
-#define CAN_ASYNC_DATA_TX_QUEUE_LENGTH		4 /**< */
+#ifndef CAN_ASYNC_DATA_TX_QUEUE_LENGTH
+#define CAN_ASYNC_DATA_TX_QUEUE_LENGTH		4 /**< number of asynchronous data objects buffered, must be a power of two */
+#endif // #ifndef CAN_ASYNC_DATA_TX_QUEUE_LENGTH
+#if ((CAN_ASYNC_DATA_TX_QUEUE_LENGTH & (CAN_ASYNC_DATA_TX_QUEUE_LENGTH - 1)) != 0) || (CAN_ASYNC_DATA_TX_QUEUE_LENGTH > 0x8000)
+#error CAN_ASYNC_DATA_TX_QUEUE_LENGTH must be a power of two up to 0x8000
+#endif
+#define CAN_ASYNC_DATA_TX_QUEUE_MASK		(CAN_ASYNC_DATA_TX_QUEUE_LENGTH - 1) /**< */
+
+#ifdef LI_CAN_SLV_ASYNC_TUNNEL
+#ifndef CAN_ASYNC_TNL_TX_HIGH_WATERMARK
+#define CAN_ASYNC_TNL_TX_HIGH_WATERMARK		((CAN_ASYNC_DATA_TX_QUEUE_LENGTH * 3) / 4) /**< number of queued data objects from which the tunnel is not writable */
+#endif // #ifndef CAN_ASYNC_TNL_TX_HIGH_WATERMARK
+#ifndef CAN_ASYNC_TNL_TX_LOW_WATERMARK
+#define CAN_ASYNC_TNL_TX_LOW_WATERMARK		(CAN_ASYNC_DATA_TX_QUEUE_LENGTH / 4) /**< number of queued data objects up to which the tunnel is writable again */
+#endif // #ifndef CAN_ASYNC_TNL_TX_LOW_WATERMARK
+#if (CAN_ASYNC_TNL_TX_LOW_WATERMARK >= CAN_ASYNC_TNL_TX_HIGH_WATERMARK) || (CAN_ASYNC_TNL_TX_HIGH_WATERMARK > CAN_ASYNC_DATA_TX_QUEUE_LENGTH)
+#error CAN_ASYNC_TNL_TX_LOW_WATERMARK must be below CAN_ASYNC_TNL_TX_HIGH_WATERMARK, which must not exceed the queue length
+#endif
+
+#ifdef LI_CAN_SLV_ASYNC_TUNNEL_RX_RING
+#ifndef CAN_ASYNC_TNL_RX_RING_SIZE
+#define CAN_ASYNC_TNL_RX_RING_SIZE	256 /**< size in bytes of the tunnel receive ring */
+#endif // #ifndef CAN_ASYNC_TNL_RX_RING_SIZE
+#if (CAN_ASYNC_TNL_RX_RING_SIZE & (CAN_ASYNC_TNL_RX_RING_SIZE - 1)) != 0 || (CAN_ASYNC_TNL_RX_RING_SIZE < (4 * CAN_CONFIG_ASYNC_DATA_TX_DLC)) || (CAN_ASYNC_TNL_RX_RING_SIZE > 0x8000)
+#error CAN_ASYNC_TNL_RX_RING_SIZE must be a power of two between 4 tunnel objects and 0x8000
+#endif
+#define CAN_ASYNC_TNL_RX_RING_MASK	(CAN_ASYNC_TNL_RX_RING_SIZE - 1) /**< mask of the free running indices of the tunnel receive ring */
+#ifndef CAN_ASYNC_TNL_RX_HIGH_WATERMARK
+#define CAN_ASYNC_TNL_RX_HIGH_WATERMARK	((CAN_ASYNC_TNL_RX_RING_SIZE * 3) / 4) /**< number of received bytes from which XOFF is sent to the tunnel partner */
+#endif // #ifndef CAN_ASYNC_TNL_RX_HIGH_WATERMARK
+#ifndef CAN_ASYNC_TNL_RX_LOW_WATERMARK
+#define CAN_ASYNC_TNL_RX_LOW_WATERMARK	(CAN_ASYNC_TNL_RX_RING_SIZE / 4) /**< number of received bytes up to which XON is sent to the tunnel partner again */
+#endif // #ifndef CAN_ASYNC_TNL_RX_LOW_WATERMARK
+#endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL_RX_RING
+#endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL
+#ifndef CAN_ASYNC_CTRL_TX_QUEUE_LENGTH
+#define CAN_ASYNC_CTRL_TX_QUEUE_LENGTH		8 /**< number of asynchronous control objects buffered per logical module while the transmit path is busy */
+#endif // #ifndef CAN_ASYNC_CTRL_TX_QUEUE_LENGTH
+#ifndef CAN_ASYNC_CTRL_TX_WEIGHT
+#define CAN_ASYNC_CTRL_TX_WEIGHT	1 /**< default weight of a logical module in the scheduling of the asynchronous transmit ctrl queues */
+#endif // #ifndef CAN_ASYNC_CTRL_TX_WEIGHT
+#if (CAN_ASYNC_CTRL_TX_WEIGHT < 1) || (CAN_ASYNC_CTRL_TX_WEIGHT > 255)
+#error CAN_ASYNC_CTRL_TX_WEIGHT must be between 1 and 255
+#endif
+#ifdef LI_CAN_SLV_XLOAD_FD
+#define CAN_ASYNC_CTRL_TX_QUANTUM	CAN_DLC_FD_MAX /**< bytes credited to a logical module per weight and round, covers one CAN FD object */
+#else // #ifdef LI_CAN_SLV_XLOAD_FD
+#define CAN_ASYNC_CTRL_TX_QUANTUM	CAN_CONFIG_ASYNC_CTRL_TX_DLC /**< bytes credited to a logical module per weight and round */
+#endif // #ifdef LI_CAN_SLV_XLOAD_FD
+#ifdef CAN_ASYNC_TX_SHAPER
+#ifndef CAN_ASYNC_TX_SHAPER_SHARE
+#define CAN_ASYNC_TX_SHAPER_SHARE	30 /**< bus share in percent of the asynchronous transmit objects */
+#endif // #ifndef CAN_ASYNC_TX_SHAPER_SHARE
+#if (CAN_ASYNC_TX_SHAPER_SHARE < 1) || (CAN_ASYNC_TX_SHAPER_SHARE > 100)
+#error CAN_ASYNC_TX_SHAPER_SHARE must be between 1 and 100
+#endif
+#ifndef CAN_ASYNC_TX_SHAPER_GUARD_MS
+#define CAN_ASYNC_TX_SHAPER_GUARD_MS	0 /**< time in ms before the predicted process request in which no asynchronous objects are sent */
+#endif // #ifndef CAN_ASYNC_TX_SHAPER_GUARD_MS
+/**
+ * bits of a classic base frame with dlc data bytes including interframe space and an average bit stuffing, CAN FD
+ * objects are accounted as if they were sent with the nominal bit rate
+ */
+#define CAN_ASYNC_TX_SHAPER_FRAME_BITS(dlc)	(55 + ((int32_t)(dlc) * 9))
+#endif // #ifdef CAN_ASYNC_TX_SHAPER
+#ifdef LI_CAN_SLV_XLOAD_FD
+#define CAN_ASYNC_CTRL_TX_QUEUE_DLC			CAN_CONFIG_ASYNC_CTRL_FD_DLC /**< data size of an element of the asynchronous transmit ctrl queue */
+#else // #ifdef LI_CAN_SLV_XLOAD_FD
+#define CAN_ASYNC_CTRL_TX_QUEUE_DLC			CAN_CONFIG_ASYNC_CTRL_TX_DLC /**< data size of an element of the asynchronous transmit ctrl queue */
+#endif // #ifdef LI_CAN_SLV_XLOAD_FD
 #endif // #if defined(OUTER) || defined(OUTER_APP)
 
 /*--------------------------------------------------------------------------*/
@@ -114,6 +204,28 @@ typedef struct
 	byte_t dlc; /**< data length code */
 	byte_t data[CAN_CONFIG_ASYNC_DATA_TX_DLC]; /**< data */
 } can_async_data_tx_queue_t;
+
+/**
+ * @brief define an element of the asynchronous ctrl tx queue
+ */
+typedef struct
+{
+	uint16_t can_id; /**< identifier */
+	byte_t dlc; /**< data length code */
+	byte_t data[CAN_ASYNC_CTRL_TX_QUEUE_DLC]; /**< data */
+} can_async_ctrl_tx_queue_t;
+
+/**
+ * @brief asynchronous ctrl tx queue of a logical module
+ */
+typedef struct
+{
+	uint16_t write; /**< write pointer */
+	uint16_t read; /**< read pointer */
+	uint16_t state; /**< number of objects in the queue */
+	uint16_t deficit; /**< number of bytes the queue may still send in the current round */
+	can_async_ctrl_tx_queue_t obj[CAN_ASYNC_CTRL_TX_QUEUE_LENGTH]; /**< objects */
+} can_async_ctrl_tx_module_queue_t;
 #endif	// #if defined(OUTER) || defined(OUTER_APP)
 #endif // #ifdef LI_CAN_SLV_ASYNC
 
@@ -145,9 +257,7 @@ typedef struct can_async_tmpdata_tag
 {
 	byte_t data[CAN_CONFIG_ASYNC_DATA_TX_DLC]; /**< data*/
 	volatile uint16_t used; /**< used*/
-#ifdef LI_CAN_SLV_ASYNC_TUNNEL_TIME_STAMP
-	volatile uint32_t lastadd; /**< last add*/
-#endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL_TIME_STAMP
+	volatile uint32_t firstadd; /**< system ticks when the first byte was added */
 } can_async_tmpdata_t;
 #endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL
 
@@ -156,11 +266,23 @@ typedef struct can_async_tmpdata_tag
 /*--------------------------------------------------------------------------*/
 #ifdef LI_CAN_SLV_ASYNC
 #if defined(OUTER) || defined(OUTER_APP)
-// asynchronous transmit data queue
-static volatile uint16_t can_async_data_tx_queue_write = 0; /*!< write pointer of the asynchronous transmit data queue */
-static volatile uint16_t can_async_data_tx_queue_read = 0; /*!< read pointer of the asynchronous transmit data queue */
-volatile uint16_t can_async_data_tx_queue_state = 0; /*!< state of the asynchronous transmit data queue */
+// asynchronous transmit data queue, single producer/single consumer ring with free running indices
+static volatile uint16_t can_async_data_tx_queue_head = 0; /*!< write index of the asynchronous transmit data queue, only written by the producer */
+static volatile uint16_t can_async_data_tx_queue_tail = 0; /*!< read index of the asynchronous transmit data queue, only written by the consumer */
 static volatile can_async_data_tx_queue_t can_async_data_tx_queue[CAN_ASYNC_DATA_TX_QUEUE_LENGTH]; /*!< asynchronous transmit data queue */
+
+// asynchronous transmit ctrl queues, one per logical module, drained by a deficit round robin scheduler
+volatile uint16_t can_async_ctrl_tx_queue_state = 0; /*!< number of objects in all asynchronous transmit ctrl queues */
+static volatile can_async_ctrl_tx_module_queue_t can_async_ctrl_tx_queue[LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES]; /*!< asynchronous transmit ctrl queues */
+static uint8_t can_async_ctrl_tx_queue_weight[LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES]; /*!< weight of the logical modules, 0 for #CAN_ASYNC_CTRL_TX_WEIGHT */
+static uint16_t can_async_ctrl_tx_queue_sched = 0; /*!< queue which is currently served by the scheduler */
+static uint8_t can_async_ctrl_tx_queue_credited = FALSE; /*!< TRUE if the served queue already got the credit of the current round, cleared when the scheduler moves on to the next queue */
+
+#ifdef CAN_ASYNC_TX_SHAPER
+// token bucket of all asynchronous transmit objects, only used by the transmit queue handlers
+static int32_t can_async_tx_shaper_tokens = 0; /*!< bits which may still be sent, negative after an object exceeded the budget */
+static uint32_t can_async_tx_shaper_timestamp = 0; /*!< time of the last refill in ticks */
+#endif // #ifdef CAN_ASYNC_TX_SHAPER
 #endif // #if defined(OUTER) || defined(OUTER_APP)
 #endif // #ifdef LI_CAN_SLV_ASYNC
 
@@ -181,42 +303,61 @@ volatile can_async_tunnel_t can_async_tunnel =
 /* function prototypes (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
 #if defined(OUTER) || defined(OUTER_APP)
+static void can_async_data_tx_queue_fill(uint16_t head, li_can_slv_module_nr_t module_nr, byte_t dlc, const byte_t *src);
+static void can_async_data_tx_queue_trigger(void);
 #ifdef LI_CAN_SLV_ASYNC_TUNNEL
 static li_can_slv_errorcode_t can_async_tnl_ctl_response(can_async_tnl_response_t response, li_can_slv_module_nr_t modnr_prim, li_can_slv_module_nr_t modnr_own, uint16_t data);
 static li_can_slv_errorcode_t can_async_xoff(void);
 static li_can_slv_errorcode_t can_async_xon(void);
 static li_can_slv_errorcode_t can_async_tnl_reset_port(void);
 static li_can_slv_errorcode_t can_async_tunnel_putc(char_t dat);
+static uint16_t can_async_tunnel_write_obj(const byte_t *src, uint16_t len);
+static uint16_t can_async_tunnel_tmpobj_add(const byte_t *src, uint16_t len);
+static li_can_slv_errorcode_t can_async_tunnel_tmpobj_flush(void);
+static void can_async_tnl_flow_reset(void);
+static void can_async_tnl_check_high_watermark(void);
+static void can_async_tnl_check_low_watermark(void);
 #endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL
+static void can_async_ctrl_tx_queue_next(void);
+static li_can_slv_errorcode_t can_async_send_msg(uint16_t can_id, uint16_t dlc, const volatile byte_t *src);
+#ifdef CAN_ASYNC_TX_SHAPER
+static uint16_t can_async_tx_shaper_admit(void);
+#endif // #ifdef CAN_ASYNC_TX_SHAPER
 #endif	// #if defined(OUTER) || defined(OUTER_APP)
+static li_can_slv_errorcode_t can_async_ctrl_tx_queue_add(li_can_slv_module_nr_t module_nr, can_async_ctrl_tx_type_t type, byte_t dlc, const byte_t *src);
 
 /*--------------------------------------------------------------------------*/
 /* global variables (private/not exported)                                  */
 /*--------------------------------------------------------------------------*/
 #ifdef CAN_ASYNC_CTRL_RX_QUEUE
-// asynchronous message receive queue
-static volatile uint16_t can_async_rx_queue_write = 0; /**< write pointer of the queue */
-volatile uint16_t can_async_rx_queue_read = 0; /**< read pointer of the queue */
-volatile uint16_t can_async_rx_queue_state = 0; /**< state of the asynchronous message receive queue */
-volatile can_async_rx_queue_t can_async_ctrl_rx_queue[CAN_ASYNC_CTRL_RX_QUEUE_LENGTH]; /**< asynchronous message receive queue */
+// asynchronous message receive queue, single producer (receive interrupt) / single consumer (task) with free running indices
+static volatile uint16_t can_async_ctrl_rx_queue_head = 0; /**< write index of the queue, only written by the receive interrupt */
+static volatile uint16_t can_async_ctrl_rx_queue_tail = 0; /**< read index of the queue, only written by can_async_handle_async_ctrl_rx_queue() */
+static volatile uint16_t can_async_ctrl_rx_queue_lock = 0; /**< can_async_handle_async_ctrl_rx_queue() lock/unlock */
+static volatile can_async_rx_queue_t can_async_ctrl_rx_queue[CAN_ASYNC_CTRL_RX_QUEUE_LENGTH]; /**< asynchronous message receive queue */
 #endif // #ifdef CAN_ASYNC_CTRL_RX_QUEUE
 
 #ifdef LI_CAN_SLV_ASYNC_TUNNEL
-#ifdef LI_CAN_SLV_ASYNC_TUNNEL_TIME_STAMP
 static can_async_tmpdata_t can_async_tunnel_tmpTXobj =
 {
 	{0},
 	0,
 	0
 }; /**< temporary asynchronous data object */
-#else // #ifdef LI_CAN_SLV_ASYNC_TUNNEL_TIME_STAMP
-static can_async_tmpdata_t can_async_tunnel_tmpTXobj =
-{
-	{0},
-	0
-}; /**< temporary asynchronous data object */
-#endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL_TIME_STAMP
 static volatile uint16_t can_async_tnl_lock = 0; /**< tunnel lock/unlock */
+#if defined(OUTER) || defined(OUTER_APP)
+static volatile uint16_t can_async_tnl_tx_stopped = FALSE; /**< transmission of tunnel data stopped by a XOFF of the tunnel partner */
+static volatile uint16_t can_async_tnl_writable = TRUE; /**< tunnel data TX queue is below the high watermark */
+static void (*can_async_tnl_writable_cbk)(void) = NULL; /**< called when the tunnel data TX queue falls to the low watermark */
+#ifdef LI_CAN_SLV_ASYNC_TUNNEL_RX_RING
+// tunnel receive ring, single producer (receive interrupt) / single consumer (application) with free running indices
+static volatile uint16_t can_async_tnl_rx_head = 0; /**< write index of the tunnel receive ring, only written by the receive interrupt */
+static volatile uint16_t can_async_tnl_rx_tail = 0; /**< read index of the tunnel receive ring, only written by the application */
+static volatile uint16_t can_async_tnl_rx_xoff_sent = FALSE; /**< XOFF has been sent to the tunnel partner */
+static byte_t can_async_tnl_rx_ring[CAN_ASYNC_TNL_RX_RING_SIZE]; /**< tunnel receive ring */
+static void (*can_async_tnl_readable_cbk)(void) = NULL; /**< called when the tunnel receive ring gets data */
+#endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL_RX_RING
+#endif // #if defined(OUTER) || defined(OUTER_APP)
 #endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL
 
 #ifdef LI_CAN_SLV_ASYNC_TUNNEL
@@ -235,16 +376,17 @@ static can_async_tunnel_open_handle_funcp_t can_async_tunnel_open_handle_funcp =
 #ifdef CAN_ASYNC_CTRL_RX_QUEUE
 /****************************************************************************/
 /*!
- * \brief initializes the asynchronous can receive task
+ * \brief initializes the asynchronous ctrl RX queue
  * \return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
  */
 li_can_slv_errorcode_t can_async_init(void)
 {
-	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
-
-	err = can_async_hw_init();
+	CAN_PORT_DISABLE_IRQ();
+	can_async_ctrl_rx_queue_head = 0;
+	can_async_ctrl_rx_queue_tail = 0;
+	CAN_PORT_ENABLE_IRQ();
 
-	return (err);
+	return (LI_CAN_SLV_ERR_OK);
 }
 #endif // #ifdef CAN_ASYNC_CTRL_RX_QUEUE
 
@@ -253,18 +395,21 @@ li_can_slv_errorcode_t can_async_init(void)
 /****************************************************************************/
 /*!
  * \brief add data to the asynchronous ctrl RX queue
+ * \remarks Called from the receive interrupt, the queue is processed by can_async_handle_async_ctrl_rx_queue().
  * \param module_nr module number
+ * \param dlc data length code of the received object
  * \param[in] src source pointer of data
  * \return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
  */
-li_can_slv_errorcode_t can_async_send_data_to_async_ctrl_rx_queue(li_can_slv_module_nr_t module_nr, byte_t const *src)
+li_can_slv_errorcode_t can_async_send_data_to_async_ctrl_rx_queue(li_can_slv_module_nr_t module_nr, uint16_t dlc, byte_t const *src)
 {
-	li_can_slv_errorcode_t err;
-	uint16_t table_pos, module_found = 0, table_end = 0;
+	uint16_t table_pos, module_found = 0;
 	can_config_module_silent_t module_silent;
+	volatile can_async_rx_queue_t *entry;
+	uint16_t head;
 
 	/* find module position in configuration table */
-	err = can_config_module_nr_valid(module_nr, &table_pos, &module_silent, &module_found);
+	(void) can_config_module_nr_valid(module_nr, &table_pos, &module_silent, &module_found);
 	if (!module_found)
 	{
 		return LI_CAN_SLV_ERR_OK;
@@ -275,62 +420,122 @@ li_can_slv_errorcode_t can_async_send_data_to_async_ctrl_rx_queue(li_can_slv_mod
 		return LI_CAN_SLV_ERR_OK;
 	}
 
-	if (!(can_async_rx_queue_state < CAN_ASYNC_CTRL_RX_QUEUE_LENGTH))
+	head = can_async_ctrl_rx_queue_head;
+	if ((uint16_t)(head - can_async_ctrl_rx_queue_tail) >= CAN_ASYNC_CTRL_RX_QUEUE_LENGTH)
 	{
 		return (ERR_MSG_CAN_ASYNC_RX_QUEUE_OVERFLOW);
 	}
 
-	can_async_ctrl_rx_queue[can_async_rx_queue_write].module_nr = module_nr;
+	entry = &can_async_ctrl_rx_queue[head & CAN_ASYNC_CTRL_RX_QUEUE_MASK];
+	entry->module_nr = module_nr;
+	entry->dlc = dlc;
 
-#ifdef LI_CAN_SLV_BOOT
+#ifdef LI_CAN_SLV_XLOAD_FD
+	// CAN FD download data objects are longer than a classic object
+	can_port_memory_cpy((byte_t *)&entry->data[0], src, (dlc > CAN_CONFIG_ASYNC_MSG_DLC) ? dlc : CAN_CONFIG_ASYNC_MSG_DLC);
+#elif defined(LI_CAN_SLV_BOOT)
 	//use for code size optimization following code
-	can_port_memory_cpy(&can_async_ctrl_rx_queue[can_async_rx_queue_write].data[0], src, CAN_CONFIG_ASYNC_MSG_DLC);
-#else // #ifdef LI_CAN_SLV_BOOT
+	can_port_memory_cpy((byte_t *)&entry->data[0], src, CAN_CONFIG_ASYNC_MSG_DLC);
+#else // #ifdef LI_CAN_SLV_XLOAD_FD
 	//use for speed optimization following code - no standard functions
-	can_async_ctrl_rx_queue[can_async_rx_queue_write].data[0] = *src;
-	src++;
-	can_async_ctrl_rx_queue[can_async_rx_queue_write].data[1] = *src;
-	src++;
-	can_async_ctrl_rx_queue[can_async_rx_queue_write].data[2] = *src;
-	src++;
-	can_async_ctrl_rx_queue[can_async_rx_queue_write].data[3] = *src;
-	src++;
-	can_async_ctrl_rx_queue[can_async_rx_queue_write].data[4] = *src;
-	src++;
-	can_async_ctrl_rx_queue[can_async_rx_queue_write].data[5] = *src;
-	src++;
-	can_async_ctrl_rx_queue[can_async_rx_queue_write].data[6] = *src;
-	src++;
-	can_async_ctrl_rx_queue[can_async_rx_queue_write].data[7] = *src;
-#endif // #ifdef LI_CAN_SLV_BOOT
-	if (can_async_rx_queue_write < (CAN_ASYNC_CTRL_RX_QUEUE_LENGTH - 1))
-	{
-		can_async_rx_queue_write++;
-	}
-	else
-	{
-		can_async_rx_queue_write = 0;
-	}
-
-	can_async_rx_queue_state++;
+	entry->data[0] = src[0];
+	entry->data[1] = src[1];
+	entry->data[2] = src[2];
+	entry->data[3] = src[3];
+	entry->data[4] = src[4];
+	entry->data[5] = src[5];
+	entry->data[6] = src[6];
+	entry->data[7] = src[7];
+#endif // #ifdef LI_CAN_SLV_XLOAD_FD
+
+	// publish the entry after it is written
+	can_port_memory_barrier();
+	can_async_ctrl_rx_queue_head = (uint16_t)(head + 1);
 
 	// trigger queue handling
 	can_port_trigger_can_async_ctrl_rx_queue();
 
 	return (LI_CAN_SLV_ERR_OK);
 }
+
+/****************************************************************************/
+/*!
+ * \brief processes the received objects of the asynchronous ctrl RX queue
+ * \remarks Called by li_can_slv_process() or by the task triggered with li_can_slv_port_trigger_async_ctrl_rx_queue().
+ * At most #CAN_ASYNC_CTRL_RX_QUEUE_BATCH objects are processed per call.
+ * \return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_async_handle_async_ctrl_rx_queue(void)
+{
+	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
+	li_can_slv_errorcode_t err_rx;
+	volatile can_async_rx_queue_t *entry;
+	uint16_t head;
+	uint16_t tail;
+	uint16_t n = 0;
+	uint16_t lock;
+
+	// the lock is taken from the task and from the interrupt which triggers the queue handling
+	CAN_PORT_DISABLE_IRQ();
+	can_async_ctrl_rx_queue_lock++;
+	lock = can_async_ctrl_rx_queue_lock;
+	CAN_PORT_ENABLE_IRQ();
+
+	if (lock == 1)
+	{
+		head = can_async_ctrl_rx_queue_head;
+		tail = can_async_ctrl_rx_queue_tail;
+		// read the entries only after the write index
+		can_port_memory_barrier();
+
+		while ((tail != head) && (n < CAN_ASYNC_CTRL_RX_QUEUE_BATCH))
+		{
+			entry = &can_async_ctrl_rx_queue[tail & CAN_ASYNC_CTRL_RX_QUEUE_MASK];
+			err_rx = can_async_rx(entry->module_nr, entry->dlc, (byte_t const *)&entry->data[0]);
+			if (err_rx != LI_CAN_SLV_ERR_OK)
+			{
+				err = err_rx;
+#ifdef LI_CAN_SLV_SYS_MODULE_ERROR
+				error_syserr_send(err_rx, ERR_LVL_INFO, entry->module_nr, ERR_LVL_INFO);
+#endif // #ifdef LI_CAN_SLV_SYS_MODULE_ERROR
+			}
+
+			// free the entry for the receive interrupt as soon as it is processed
+			tail++;
+			can_port_memory_barrier();
+			can_async_ctrl_rx_queue_tail = tail;
+			n++;
+		}
+	}
+
+	CAN_PORT_DISABLE_IRQ();
+	can_async_ctrl_rx_queue_lock--;
+	CAN_PORT_ENABLE_IRQ();
+	return (err);
+}
+
+/****************************************************************************/
+/*!
+ * \brief get the number of received objects in the asynchronous ctrl RX queue
+ * \return number of objects
+ */
+uint16_t can_async_ctrl_rx_queue_get_nr_of_objs(void)
+{
+	return ((uint16_t)(can_async_ctrl_rx_queue_head - can_async_ctrl_rx_queue_tail));
+}
 #else // #ifdef CAN_ASYNC_CTRL_RX_QUEUE
 
 /**
  * @brief send data to asynchronous control RX queue
  * @param module_nr: given module number
+ * @param dlc: data length code of the received object
  * @param src: pointer to the received data
  * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
  */
-li_can_slv_errorcode_t can_async_send_data_to_async_ctrl_rx_queue(li_can_slv_module_nr_t module_nr, byte_t const *src)
+li_can_slv_errorcode_t can_async_send_data_to_async_ctrl_rx_queue(li_can_slv_module_nr_t module_nr, uint16_t dlc, byte_t const *src)
 {
 	li_can_slv_errorcode_t err;
-	err = can_async_rx(module_nr, src);
+	err = can_async_rx(module_nr, dlc, src);
 	return (err);
 }
 #endif // #ifdef CAN_ASYNC_CTRL_RX_QUEUE
@@ -338,10 +543,11 @@ li_can_slv_errorcode_t can_async_send_data_to_async_ctrl_rx_queue(li_can_slv_mod
 /**
  * @brief
  * @param module_nr: given module number
+ * @param dlc: data length code of the received object
  * @param data: given data of the module
  * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
  */
-li_can_slv_errorcode_t can_async_rx(li_can_slv_module_nr_t module_nr, byte_t const *data)
+li_can_slv_errorcode_t can_async_rx(li_can_slv_module_nr_t module_nr, uint16_t dlc, byte_t const *data)
 {
 	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
 	uint16_t module_found = 0;
@@ -359,6 +565,10 @@ li_can_slv_errorcode_t can_async_rx(li_can_slv_module_nr_t module_nr, byte_t con
 #endif // #if defined(OUTER) || defined(OUTER_APP)
 #endif // #if defined(LI_CAN_SLV_ASYNC_TUNNEL)
 
+#ifndef LI_CAN_SLV_DLOAD
+	dlc = dlc; //dummy assignment
+#endif // #ifndef LI_CAN_SLV_DLOAD
+
 #ifdef LI_CAN_SLV_MAIN_MON
 	if (can_mainmon_type == CAN_MAINMON_TYPE_MON)
 	{
@@ -414,9 +624,15 @@ li_can_slv_errorcode_t can_async_rx(li_can_slv_module_nr_t module_nr, byte_t con
 			break;
 
 		case CAN_ASYNC_DL_DATA:
-			err = li_can_slv_dload_data(module_nr, data);
+			err = li_can_slv_dload_data(module_nr, dlc, data);
 			break;
 
+#ifdef LI_CAN_SLV_DLOAD_LZ
+		case CAN_ASYNC_DL_DATA_LZ:
+			err = li_can_slv_dload_data_lz(module_nr, dlc, data);
+			break;
+#endif // #ifdef LI_CAN_SLV_DLOAD_LZ
+
 		case CAN_ASYNC_DL_DATA_BLOCK_END:
 			err = li_can_slv_dload_data_block_end(module_nr, data);
 			break;
@@ -432,6 +648,8 @@ li_can_slv_errorcode_t can_async_rx(li_can_slv_module_nr_t module_nr, byte_t con
 			//check if the asynchronous tunnel is open; if yes, resume transmission
 			if ((can_async_tunnel.state == LI_CAN_SLV_ASYNC_TUNNEL_ACTIVE) && (can_async_tunnel.prim_modnr == (li_can_slv_module_nr_t) data[1]))
 			{
+				can_async_tnl_tx_stopped = FALSE;
+				can_async_data_tx_queue_trigger();
 				li_can_slv_port_async_tunnel_xon_rx_handle();
 			}
 			break;
@@ -440,6 +658,8 @@ li_can_slv_errorcode_t can_async_rx(li_can_slv_module_nr_t module_nr, byte_t con
 			//check if the asynchronous tunnel is open; if yes, stop transmission
 			if ((can_async_tunnel.state == LI_CAN_SLV_ASYNC_TUNNEL_ACTIVE) && (can_async_tunnel.prim_modnr == (li_can_slv_module_nr_t)data[1]))
 			{
+				// queued tunnel data is held back until the partner sends XON
+				can_async_tnl_tx_stopped = TRUE;
 				li_can_slv_port_async_tunnel_xoff_rx_handle();
 			}
 			break;
@@ -459,6 +679,7 @@ li_can_slv_errorcode_t can_async_rx(li_can_slv_module_nr_t module_nr, byte_t con
 					can_async_tunnel.mod_own = module_nr;
 					can_async_tunnel.prim_modnr = module_nr_tunnel;
 					can_async_tunnel.sec_modnr = can_async_tunnel.mod_own;
+					can_async_tnl_flow_reset();
 					can_async_tunnel.state = LI_CAN_SLV_ASYNC_TUNNEL_ACTIVE;
 					can_async_tunnel.connection_type = data[4];
 					can_async_tunnel.async_data_delay = (((uint16_t)data[5]) << 8) + (uint16_t)(data[6]);
@@ -477,6 +698,14 @@ li_can_slv_errorcode_t can_async_rx(li_can_slv_module_nr_t module_nr, byte_t con
 							can_async_tnl_ctl_response(CAN_ASYNC_TNL_OPEN_ACK, module_nr_tunnel, module_nr, 0);
 							break;
 
+#ifdef LI_CAN_SLV_ASYNC_ISOTP
+						case CAN_ASYNC_CONNECTION_TYPE_UDS_PROTOCOL:
+							can_async_isotp_reset();
+							can_main_define_msg_obj(CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_DATA_RX, ((can_async_tunnel.mod_own - 1) * CAN_CONFIG_NR_OF_MODULE_OBJS + CAN_CONFIG_ASYNC_DATA_RX_SLAVE_ID), CAN_CONFIG_ACCEPTANCE_ONE_ID, CAN_CONFIG_ASYNC_DATA_RX_DLC, CAN_CONFIG_DIR_RX, CAN_MAIN_ASYNC_SERVICE_ID_RX, CAN_OBJECT_NOT_SYNC);
+							can_async_tnl_ctl_response(CAN_ASYNC_TNL_OPEN_ACK, module_nr_tunnel, module_nr, 0);
+							break;
+#endif // #ifdef LI_CAN_SLV_ASYNC_ISOTP
+
 						default:
 							/* call download handle */
 							if (NULL != can_async_tunnel_open_handle_funcp)
@@ -639,34 +868,32 @@ li_can_slv_errorcode_t can_async_rx(li_can_slv_module_nr_t module_nr, byte_t con
  */
 li_can_slv_errorcode_t can_async_send_data_to_async_ctrl_tx_queue(li_can_slv_module_nr_t module_nr, can_async_ctrl_tx_type_t type, const byte_t *src)
 {
-	word_t can_id;
+	return (can_async_ctrl_tx_queue_add(module_nr, type, CAN_CONFIG_ASYNC_CTRL_TX_DLC, src));
+}
 
-	/**
-	 * @todo change implementation of can_id with error handling
-	 */
-	// calculation of CAN identifier
-	switch (type)
+#ifdef LI_CAN_SLV_XLOAD_FD
+/*!
+ * \brief add a CAN FD object of an up/download to the asynchronous ctrl TX queue
+ * \param module_nr module number
+ * \param type asynchronous ctrl transmit
+ * \param dlc payload length of the object, lengths above #CAN_DLC_MAX are sent as CAN FD frame
+ * \param[in] src source pointer of data
+ * \return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_async_send_fd_data_to_async_ctrl_tx_queue(li_can_slv_module_nr_t module_nr, can_async_ctrl_tx_type_t type, byte_t dlc, const byte_t *src)
+{
+	if (dlc > CAN_CONFIG_ASYNC_CTRL_FD_DLC)
 	{
-		case CAN_ASYNC_CTRL_TX_TYPE_SLAVE:
-			can_id = CAN_CONFIG_ASYNC_CTRL_TX_SLAVE_ID + ((module_nr - 1) << 2);
-			break;
-
-		case CAN_ASYNC_CTRL_TX_TYPE_MASTER:
-			can_id = CAN_CONFIG_ASYNC_CTRL_TX_MASTER_ID + ((module_nr - 1) << 2);
-			break;
-
-		default:
-			can_id = CAN_CONFIG_ID_NULL;
-			break;
+		return (ERR_MSG_CAN_ASYNC_DATA_TX_QUEUE_DLC);
 	}
-
-	(void) can_main_hw_send_msg(can_id, CAN_CONFIG_ASYNC_CTRL_TX_DLC, src);
-
-	return (LI_CAN_SLV_ERR_OK);
+	return (can_async_ctrl_tx_queue_add(module_nr, type, dlc, src));
 }
+#endif // #ifdef LI_CAN_SLV_XLOAD_FD
 
 #if defined(OUTER) || defined(OUTER_APP)
 /*!
+ * \remarks The asynchronous data TX queue is a single producer/single consumer ring. All producers (e.g. the tunnel)
+ * must be serialized, the consumer is can_async_handle_async_data_tx_queue().
  * \param module_nr module number
  * \param type asynchronous ctrl transmit type
  * \param dlc data length code of object
@@ -675,49 +902,102 @@ li_can_slv_errorcode_t can_async_send_data_to_async_ctrl_tx_queue(li_can_slv_mod
  */
 li_can_slv_errorcode_t can_async_send_data_to_async_data_tx_queue(li_can_slv_module_nr_t module_nr, can_async_data_tx_type_t type, byte_t dlc, const byte_t *src)
 {
-	if (!(can_async_data_tx_queue_state < CAN_ASYNC_DATA_TX_QUEUE_LENGTH))
-	{
-		return (ERR_MSG_CAN_ASYNC_DATA_TX_QUEUE_OVERFLOW);
-	}
+	uint16_t head;
 
 	if (dlc > CAN_CONFIG_ASYNC_DATA_TX_DLC)
 	{
 		return (ERR_MSG_CAN_ASYNC_DATA_TX_QUEUE_DLC);
 	}
 
-	can_port_memory_cpy((can_async_data_tx_queue_t *)&can_async_data_tx_queue[can_async_data_tx_queue_write].data[0], src, dlc);
-
-	can_async_data_tx_queue[can_async_data_tx_queue_write].dlc = dlc;
+	if (CAN_ASYNC_DATA_TX_TYPE_SLAVE != type)
+	{
+		return (ERR_MSG_CAN_NOT_IMPLEMENTED);
+	}
 
-	switch (type)
+	head = can_async_data_tx_queue_head;
+	if ((uint16_t)(head - can_async_data_tx_queue_tail) >= CAN_ASYNC_DATA_TX_QUEUE_LENGTH)
 	{
-		case CAN_ASYNC_DATA_TX_TYPE_SLAVE:
-			can_async_data_tx_queue[can_async_data_tx_queue_write].can_id = CAN_CONFIG_ASYNC_DATA_TX_SLAVE_ID + ((module_nr - 1) << 2);
-			break;
+		return (ERR_MSG_CAN_ASYNC_DATA_TX_QUEUE_OVERFLOW);
+	}
 
-		case CAN_ASYNC_DATA_TX_TYPE_MASTER:
-			return (ERR_MSG_CAN_NOT_IMPLEMENTED);
-			break;
+	can_async_data_tx_queue_fill(head, module_nr, dlc, src);
 
-		default:
-			break;
+	// publish the object after it is completely written
+	can_port_memory_barrier();
+	can_async_data_tx_queue_head = head + 1;
+
+	can_async_data_tx_queue_trigger();
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+/*!
+ * \brief adds a data stream as full objects to the asynchronous data TX queue
+ * \remarks The objects are published together and the transmission is triggered once. Only the last object could
+ * be partly filled. Bytes which do not fit into the queue are not accepted, the function never waits.
+ * \param module_nr module number
+ * \param type asynchronous ctrl transmit type
+ * \param[in] src source pointer of data
+ * \param len number of bytes
+ * \param[out] accepted number of bytes added to the queue
+ * \return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_async_send_bulk_to_async_data_tx_queue(li_can_slv_module_nr_t module_nr, can_async_data_tx_type_t type, const byte_t *src, uint16_t len, uint16_t *accepted)
+{
+	uint16_t head;
+	uint16_t nr_of_free;
+	uint16_t dlc;
+	uint16_t n = 0;
+
+	*accepted = 0;
+
+	if (CAN_ASYNC_DATA_TX_TYPE_SLAVE != type)
+	{
+		return (ERR_MSG_CAN_NOT_IMPLEMENTED);
 	}
 
-	if (can_async_data_tx_queue_write < (CAN_ASYNC_DATA_TX_QUEUE_LENGTH - 1))
+	head = can_async_data_tx_queue_head;
+	nr_of_free = (uint16_t)(CAN_ASYNC_DATA_TX_QUEUE_LENGTH - (uint16_t)(head - can_async_data_tx_queue_tail));
+
+	while ((n < len) && (nr_of_free > 0))
 	{
-		can_async_data_tx_queue_write++;
+		dlc = len - n;
+		if (dlc > CAN_CONFIG_ASYNC_DATA_TX_DLC)
+		{
+			dlc = CAN_CONFIG_ASYNC_DATA_TX_DLC;
+		}
+		can_async_data_tx_queue_fill(head, module_nr, (byte_t) dlc, &src[n]);
+		head++;
+		nr_of_free--;
+		n += dlc;
 	}
-	else
+
+	if (n > 0)
 	{
-		can_async_data_tx_queue_write = 0;
+		can_port_memory_barrier();
+		can_async_data_tx_queue_head = head;
+		can_async_data_tx_queue_trigger();
 	}
 
-	can_async_data_tx_queue_state++;
+	*accepted = n;
+	return (LI_CAN_SLV_ERR_OK);
+}
 
-	// trigger queue handling
-	can_port_trigger_can_main_async_data_tx_queue();
+/*!
+ * \brief get the number of objects in the asynchronous data TX queue
+ * \return number of objects
+ */
+uint16_t can_async_data_tx_queue_get_nr_of_objs(void)
+{
+	return ((uint16_t)(can_async_data_tx_queue_head - can_async_data_tx_queue_tail));
+}
 
-	return (LI_CAN_SLV_ERR_OK);
+/*!
+ * \brief get the number of free objects in the asynchronous data TX queue
+ * \return number of free objects
+ */
+uint16_t can_async_data_tx_queue_get_nr_of_free_objs(void)
+{
+	return ((uint16_t)(CAN_ASYNC_DATA_TX_QUEUE_LENGTH - (uint16_t)(can_async_data_tx_queue_head - can_async_data_tx_queue_tail)));
 }
 #endif // #if defined(OUTER) || defined(OUTER_APP)
 
@@ -725,140 +1005,540 @@ li_can_slv_errorcode_t can_async_send_data_to_async_data_tx_queue(li_can_slv_mod
 #if defined(OUTER) || defined(OUTER_APP)
 /**
  * @brief can_main_hndl_queue_async_data_tx handles the asynchronous transmit data queue
+ *
+ * Objects are passed to the hardware until the queue is empty or the transmit path is busy. A busy
+ * transmit path is no error, the remaining objects are sent from the transmit complete handler.
+ * The write index is read once and the read index is published once after all sent objects.
  * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
  */
 li_can_slv_errorcode_t can_async_handle_async_data_tx_queue(void)
 {
 	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
+	volatile can_async_data_tx_queue_t *obj;
+	uint16_t head;
+	uint16_t tail;
 
-	if (can_async_data_tx_queue_state > 0)
+#ifdef LI_CAN_SLV_ASYNC_TUNNEL
+	if (can_async_tnl_tx_stopped != FALSE)
 	{
-		/**
-		 * @todo fix this volatile problem here
-		 */
-		err = can_main_hw_send_msg(can_async_data_tx_queue[can_async_data_tx_queue_read].can_id, (uint16_t)(can_async_data_tx_queue[can_async_data_tx_queue_read].dlc), &can_async_data_tx_queue[can_async_data_tx_queue_read].data[0]);
+		return (LI_CAN_SLV_ERR_OK);
+	}
+#endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL
 
-		if (err == LI_CAN_SLV_ERR_OK)
+	tail = can_async_data_tx_queue_tail;
+	head = can_async_data_tx_queue_head;
+	// read the objects not before the write index
+	can_port_memory_barrier();
+
+	while (tail != head)
+	{
+		obj = &can_async_data_tx_queue[tail & CAN_ASYNC_DATA_TX_QUEUE_MASK];
+		err = can_async_send_msg(obj->can_id, (uint16_t)(obj->dlc), &obj->data[0]);
+		if (err != LI_CAN_SLV_ERR_OK)
 		{
-			// service read pointer
-			if (can_async_data_tx_queue_read < (CAN_ASYNC_DATA_TX_QUEUE_LENGTH - 1))
-			{
-				can_async_data_tx_queue_read++;
-			}
-			else
-			{
-				can_async_data_tx_queue_read = 0;
-			}
-			can_async_data_tx_queue_state--;
+			break;
 		}
+		tail++;
 	}
-	return (err);
-}
-#endif // #if defined(OUTER) || defined(OUTER_APP)
-
-/*--------------------------------------------------------------------------*/
-/* function definition (private/not exported)                               */
-/*--------------------------------------------------------------------------*/
-#if defined(OUTER) || defined(OUTER_APP)
-#ifdef LI_CAN_SLV_ASYNC_TUNNEL
-/**
- * @brief sends out an control message for asynchronous tunnel protocol
- * @remarks Handles all control message sending occurrences for the asynchronous CAN tunnel
- * @param[in] response type of response to prepare
- * @param[in] modnr_prim number of primary module that initiated the original request
- * @param[in] modnr_own number of own logical module that should answer
- * @param data data of the module
- * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
- */
-static li_can_slv_errorcode_t can_async_tnl_ctl_response(can_async_tnl_response_t response, li_can_slv_module_nr_t modnr_prim,
-        li_can_slv_module_nr_t modnr_own, uint16_t data)
-{
-	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
-	byte_t snd_data[CAN_CONFIG_ASYNC_CTRL_TX_DLC] = {0};
-	uint32_t datal;
 
-	switch (response)
+	if (tail != can_async_data_tx_queue_tail)
 	{
-		case CAN_ASYNC_TNL_OPEN_ACK:
-			snd_data[0] = LI_CAN_SLV_ASYNC_TUNNEL_OPEN_ACK;
-			snd_data[1] = (byte_t) modnr_prim;
-			snd_data[5] = (byte_t)(can_async_tunnel.async_data_delay >> 8);
-			snd_data[6] = (byte_t)(can_async_tunnel.async_data_delay & 0x00FF);
-			break;
-		case CAN_ASYNC_TNL_CLOSE:
-			snd_data[0] = LI_CAN_SLV_ASYNC_TUNNEL_CLOSE;
-			snd_data[1] = (byte_t) modnr_prim;
-			break;
-		case CAN_ASYNC_TNL_CLOSE_ACK:
-			snd_data[0] = LI_CAN_SLV_ASYNC_TUNNEL_CLOSE_ACK;
-			snd_data[1] = (byte_t) modnr_prim;
-			break;
-		case CAN_ASYNC_TNL_LOGIN_ACK:
-			snd_data[0] = LI_CAN_SLV_ASYNC_TUNNEL_LOGIN_ACK;
-			snd_data[1] = (byte_t) modnr_prim;
-			//login in ID
-			snd_data[2] = (byte_t)(data >> 8);
-			snd_data[3] = (byte_t)(data & 0x00FF);
-			break;
-		case CAN_ASYNC_TNL_OPEN_DENY:
-			snd_data[0] = LI_CAN_SLV_ASYNC_TUNNEL_OPEN_DENY;
-			snd_data[1] = (byte_t) modnr_prim;
-			datal = (uint32_t) data;
-			snd_data[4] = (byte_t)(datal >> 24);
-			snd_data[5] = (byte_t)((datal >> 16) & 0x000000FF);
-			snd_data[6] = (byte_t)((datal >> 8) & 0x000000FF);
-			snd_data[7] = (byte_t)(datal & 0x000000FF);
-			break;
-		case CAN_ASYNC_TNL_CLOSE_DENY:
-			snd_data[0] = LI_CAN_SLV_ASYNC_TUNNEL_CLOSE_DENY;
-			snd_data[1] = (byte_t) modnr_prim;
-			//add error number
-			datal = (uint32_t) data;
-			snd_data[4] = (byte_t)(datal >> 24);
-			snd_data[5] = (byte_t)((datal >> 16) & 0x000000FF);
-			snd_data[6] = (byte_t)((datal >> 8) & 0x000000FF);
-			snd_data[7] = (byte_t)(datal & 0x000000FF);
-			break;
-		case CAN_ASYNC_TNL_LOGIN_DENY:
-			snd_data[0] = LI_CAN_SLV_ASYNC_TUNNEL_LOGIN_DENY;
-			snd_data[1] = (byte_t) modnr_prim;
-			//add error number
-			datal = (uint32_t) data;
-			snd_data[4] = (byte_t)(datal >> 24);
-			snd_data[5] = (byte_t)((datal >> 16) & 0x000000FF);
-			snd_data[6] = (byte_t)((datal >> 8) & 0x000000FF);
-			snd_data[7] = (byte_t)(datal & 0x000000FF);
-			break;
-		default:
-			err = ERR_MSG_CAN_ASYNC_TNL_INVALID_COMMAND;
-			break;
+		// release the objects after they are completely read
+		can_port_memory_barrier();
+		can_async_data_tx_queue_tail = tail;
+#ifdef LI_CAN_SLV_ASYNC_TUNNEL
+		can_async_tnl_check_low_watermark();
+#endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL
 	}
-	if (err == LI_CAN_SLV_ERR_OK)
+
+	if (err == ERR_MSG_CAN_MSG_SEND_BUSY)
 	{
-		err = can_async_send_data_to_async_ctrl_tx_queue(modnr_own, CAN_ASYNC_CTRL_TX_TYPE_SLAVE, &snd_data[0]);
+		err = LI_CAN_SLV_ERR_OK;
 	}
 	return (err);
 }
-#endif //#ifdef LI_CAN_SLV_ASYNC_TUNNEL
-
 
-#ifdef LI_CAN_SLV_ASYNC_TUNNEL
 /**
- * @brief empties the serial RX queue and resets the XON/XOFF state to XON
- * @remarks used to make the flow going on again on a hanging tunnel
+ * @brief handles the asynchronous transmit ctrl queues
+ *
+ * The queues of the logical modules are served by a deficit round robin scheduler. In every round a queue is credited
+ * with its weight times #CAN_ASYNC_CTRL_TX_QUANTUM bytes and sends objects as long as the credit covers them, so an
+ * upload of one module cannot starve the acknowledges and tunnel responses of the other modules. Objects are passed
+ * to the hardware until all queues are empty or the transmit path is busy. A busy transmit path is no error, the
+ * remaining objects are sent from the transmit complete handler.
  * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
  */
-static li_can_slv_errorcode_t can_async_tnl_reset_port(void)
+li_can_slv_errorcode_t can_async_handle_async_ctrl_tx_queue(void)
 {
 	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
+	volatile can_async_ctrl_tx_module_queue_t *queue;
+	volatile can_async_ctrl_tx_queue_t *obj;
+	uint16_t weight;
 
-	if (can_async_tunnel.state == LI_CAN_SLV_ASYNC_TUNNEL_ACTIVE)
+	while (can_async_ctrl_tx_queue_state > 0)
 	{
-		err = li_can_slv_port_async_tunnel_clear_rx_buffer_handle();
-
-		if (err == LI_CAN_SLV_ERR_OK)
+		queue = &can_async_ctrl_tx_queue[can_async_ctrl_tx_queue_sched];
+		if (queue->state == 0)
 		{
-			li_can_slv_port_async_tunnel_xon_rx_handle();
+			// an idle queue does not save credit for later rounds
+			queue->deficit = 0;
+			can_async_ctrl_tx_queue_next();
+			continue;
+		}
+
+		if (can_async_ctrl_tx_queue_credited == FALSE)
+		{
+			weight = can_async_ctrl_tx_queue_weight[can_async_ctrl_tx_queue_sched];
+			if (weight == 0)
+			{
+				weight = CAN_ASYNC_CTRL_TX_WEIGHT;
+			}
+			queue->deficit += weight * CAN_ASYNC_CTRL_TX_QUANTUM;
+			can_async_ctrl_tx_queue_credited = TRUE;
+		}
+
+		obj = &queue->obj[queue->read];
+		if (obj->dlc > queue->deficit)
+		{
+			// credit of this round used up, the remaining credit is kept for the next round
+			can_async_ctrl_tx_queue_next();
+			continue;
+		}
+
+		err = can_async_send_msg(obj->can_id, obj->dlc, &obj->data[0]);
+
+		if (err != LI_CAN_SLV_ERR_OK)
+		{
+			break;
+		}
+
+		queue->deficit -= obj->dlc;
+
+		// service read pointer
+		if (queue->read < (CAN_ASYNC_CTRL_TX_QUEUE_LENGTH - 1))
+		{
+			queue->read++;
+		}
+		else
+		{
+			queue->read = 0;
+		}
+		queue->state--;
+		can_async_ctrl_tx_queue_state--;
+
+		if (queue->state == 0)
+		{
+			queue->deficit = 0;
+			can_async_ctrl_tx_queue_next();
+		}
+	}
+
+	if (err == ERR_MSG_CAN_MSG_SEND_BUSY)
+	{
+		err = LI_CAN_SLV_ERR_OK;
+	}
+	return (err);
+}
+
+/**
+ * @brief sets the weight of a logical module in the scheduling of the asynchronous transmit ctrl queues
+ *
+ * A module with weight 2 may send twice as many bytes per round as a module with weight 1 while both have objects
+ * queued.
+ * @param module_nr module number
+ * @param weight weight of the module from 1 to 255, 0 restores #CAN_ASYNC_CTRL_TX_WEIGHT
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_async_ctrl_tx_queue_set_weight(li_can_slv_module_nr_t module_nr, uint8_t weight)
+{
+	uint16_t table_pos, module_found = 0;
+	can_config_module_silent_t module_silent;
+
+	(void) can_config_module_nr_valid(module_nr, &table_pos, &module_silent, &module_found);
+	if (!module_found)
+	{
+		return (ERR_MSG_CAN_CONFIG_MODULE_NOT_FOUND);
+	}
+
+	can_async_ctrl_tx_queue_weight[table_pos] = weight;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+/**
+ * @brief drops all objects of the asynchronous transmit ctrl queues
+ * @remarks Called when the reconnect starts. The node does not transmit during the reconnect, so acknowledges and
+ * responses would only be sent late after it or fill up the queues.
+ */
+void can_async_ctrl_tx_queue_clear(void)
+{
+	uint16_t i;
+
+	CAN_PORT_DISABLE_IRQ();
+	for (i = 0; i < LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES; i++)
+	{
+		can_async_ctrl_tx_queue[i].read = 0;
+		can_async_ctrl_tx_queue[i].write = 0;
+		can_async_ctrl_tx_queue[i].state = 0;
+		can_async_ctrl_tx_queue[i].deficit = 0;
+	}
+	can_async_ctrl_tx_queue_state = 0;
+	can_async_ctrl_tx_queue_sched = 0;
+	can_async_ctrl_tx_queue_credited = FALSE;
+	CAN_PORT_ENABLE_IRQ();
+}
+
+#ifdef CAN_ASYNC_TX_SHAPER
+/**
+ * @brief sends the asynchronous transmit objects which have been held back by the shaper
+ * @remarks Called by li_can_slv_process() and on every received process request, objects above the budget are only
+ * sent by the transmit complete handler or by this function.
+ */
+void can_async_tx_shaper_process(void)
+{
+	if ((can_async_ctrl_tx_queue_state > 0) || (can_async_data_tx_queue_get_nr_of_objs() > 0))
+	{
+		can_async_data_tx_queue_trigger();
+	}
+}
+#endif // #ifdef CAN_ASYNC_TX_SHAPER
+#endif // #if defined(OUTER) || defined(OUTER_APP)
+
+/*--------------------------------------------------------------------------*/
+/* function definition (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+/*!
+ * \param module_nr module number
+ * \param type asynchronous ctrl transmit
+ * \param dlc data length code of object
+ * \param[in] src source pointer of data
+ * \return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+static li_can_slv_errorcode_t can_async_ctrl_tx_queue_add(li_can_slv_module_nr_t module_nr, can_async_ctrl_tx_type_t type, byte_t dlc, const byte_t *src)
+{
+	word_t can_id;
+#if defined(OUTER) || defined(OUTER_APP)
+	uint16_t table_pos, module_found = 0;
+	can_config_module_silent_t module_silent;
+	volatile can_async_ctrl_tx_module_queue_t *queue;
+#endif // #if defined(OUTER) || defined(OUTER_APP)
+
+	/**
+	 * @todo change implementation of can_id with error handling
+	 */
+	// calculation of CAN identifier
+	switch (type)
+	{
+		case CAN_ASYNC_CTRL_TX_TYPE_SLAVE:
+			can_id = CAN_CONFIG_ASYNC_CTRL_TX_SLAVE_ID + ((module_nr - 1) << 2);
+			break;
+
+		case CAN_ASYNC_CTRL_TX_TYPE_MASTER:
+			can_id = CAN_CONFIG_ASYNC_CTRL_TX_MASTER_ID + ((module_nr - 1) << 2);
+			break;
+
+		default:
+			can_id = CAN_CONFIG_ID_NULL;
+			break;
+	}
+
+#if defined(OUTER) || defined(OUTER_APP)
+	// every logical module has its own queue, objects of unknown modules are queued for the first module
+	(void) can_config_module_nr_valid(module_nr, &table_pos, &module_silent, &module_found);
+	if (!module_found)
+	{
+		table_pos = 0;
+	}
+	queue = &can_async_ctrl_tx_queue[table_pos];
+
+#ifdef LI_CAN_SLV_RECONNECT
+	// the node does not transmit during the reconnect, the object is lost like a direct transmission
+	if (li_can_slv_reconnect_get_state() == CAN_RECONNECT_STATE_ON)
+	{
+		return (LI_CAN_SLV_ERR_OK);
+	}
+#endif // #ifdef LI_CAN_SLV_RECONNECT
+
+	CAN_PORT_DISABLE_IRQ();
+	if (!(queue->state < CAN_ASYNC_CTRL_TX_QUEUE_LENGTH))
+	{
+		CAN_PORT_ENABLE_IRQ();
+		return (ERR_MSG_CAN_ASYNC_CTRL_TX_QUEUE_OVERFLOW);
+	}
+
+	can_port_memory_cpy((byte_t *)&queue->obj[queue->write].data[0], src, dlc);
+	queue->obj[queue->write].dlc = dlc;
+	queue->obj[queue->write].can_id = can_id;
+
+	if (queue->write < (CAN_ASYNC_CTRL_TX_QUEUE_LENGTH - 1))
+	{
+		queue->write++;
+	}
+	else
+	{
+		queue->write = 0;
+	}
+
+	queue->state++;
+	can_async_ctrl_tx_queue_state++;
+
+	// trigger queue handling, further objects are sent from the transmit complete handler
+	can_port_trigger_can_main_async_data_tx_queue();
+	CAN_PORT_ENABLE_IRQ();
+#else // #if defined(OUTER) || defined(OUTER_APP)
+	(void) can_main_hw_send_msg_class(CAN_MAIN_TX_CLASS_ASYNC, can_id, dlc, src);
+#endif // #if defined(OUTER) || defined(OUTER_APP)
+
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+#if defined(OUTER) || defined(OUTER_APP)
+/**
+ * @brief passes an asynchronous object to the hardware if the shaper admits it
+ * @param can_id identifier
+ * @param dlc data length code
+ * @param[in] src source pointer of data
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful, #ERR_MSG_CAN_MSG_SEND_BUSY if the object is
+ * held back
+ */
+static li_can_slv_errorcode_t can_async_send_msg(uint16_t can_id, uint16_t dlc, const volatile byte_t *src)
+{
+	li_can_slv_errorcode_t err;
+
+#ifdef CAN_ASYNC_TX_SHAPER
+	if (can_async_tx_shaper_admit() == FALSE)
+	{
+		return (ERR_MSG_CAN_MSG_SEND_BUSY);
+	}
+#endif // #ifdef CAN_ASYNC_TX_SHAPER
+
+	err = can_main_hw_send_msg_class(CAN_MAIN_TX_CLASS_ASYNC, can_id, dlc, src);
+
+#ifdef CAN_ASYNC_TX_SHAPER
+	if (err == LI_CAN_SLV_ERR_OK)
+	{
+		can_async_tx_shaper_tokens -= CAN_ASYNC_TX_SHAPER_FRAME_BITS(dlc);
+	}
+#endif // #ifdef CAN_ASYNC_TX_SHAPER
+	return (err);
+}
+
+#ifdef CAN_ASYNC_TX_SHAPER
+/**
+ * @brief refills the token bucket and decides if an asynchronous object may be sent now
+ *
+ * The bucket is refilled every ms with the bus share of the current baud rate and holds at most the budget of one
+ * measured process period. An object is admitted as long as the bucket is not empty, so objects larger than the
+ * remaining budget are not blocked forever but borrow from the next refill.
+ * @return TRUE if the object may be sent, otherwise FALSE
+ */
+static uint16_t can_async_tx_shaper_admit(void)
+{
+	uint32_t now, periode, elapsed;
+	int32_t rate, depth;
+	can_config_bdr_t baudrate;
+
+	now = can_port_get_system_ticks();
+	periode = can_sync.pr_periode;
+	if (periode > LI_CAN_SLV_SYNC_PROCESS_PERIODE_MAX)
+	{
+		periode = LI_CAN_SLV_SYNC_PROCESS_PERIODE_MAX;
+	}
+	if (periode == 0)
+	{
+		periode = 1;
+	}
+
+#if CAN_ASYNC_TX_SHAPER_GUARD_MS > 0
+	// hold back the objects shortly before the predicted process request, a late process request does not block
+	if (periode > CAN_ASYNC_TX_SHAPER_GUARD_MS)
+	{
+		elapsed = can_port_ticks_2_msec(now - can_sync.main_pr_timestamp);
+		if ((elapsed < periode) && ((elapsed + CAN_ASYNC_TX_SHAPER_GUARD_MS) >= periode))
+		{
+			return (FALSE);
+		}
+	}
+#endif // #if CAN_ASYNC_TX_SHAPER_GUARD_MS > 0
+
+	// bits per ms from the baud rate in kbit/s
+	(void) can_config_get_baudrate(&baudrate);
+	rate = ((int32_t)baudrate * CAN_ASYNC_TX_SHAPER_SHARE) / 100;
+	depth = rate * (int32_t)periode;
+
+	elapsed = can_port_ticks_2_msec(now - can_async_tx_shaper_timestamp);
+	if (elapsed >= periode)
+	{
+		can_async_tx_shaper_tokens = depth;
+		can_async_tx_shaper_timestamp = now;
+	}
+	else if (elapsed > 0)
+	{
+		can_async_tx_shaper_tokens += rate * (int32_t)elapsed;
+		if (can_async_tx_shaper_tokens > depth)
+		{
+			can_async_tx_shaper_tokens = depth;
+		}
+		can_async_tx_shaper_timestamp += can_port_msec_2_ticks(elapsed);
+	}
+
+	if (can_async_tx_shaper_tokens > 0)
+	{
+		return (TRUE);
+	}
+	return (FALSE);
+}
+#endif // #ifdef CAN_ASYNC_TX_SHAPER
+
+/**
+ * @brief passes the scheduler of the asynchronous transmit ctrl queues on to the queue of the next logical module
+ */
+static void can_async_ctrl_tx_queue_next(void)
+{
+	if (can_async_ctrl_tx_queue_sched < (LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES - 1))
+	{
+		can_async_ctrl_tx_queue_sched++;
+	}
+	else
+	{
+		can_async_ctrl_tx_queue_sched = 0;
+	}
+	can_async_ctrl_tx_queue_credited = FALSE;
+}
+#endif // #if defined(OUTER) || defined(OUTER_APP)
+
+#if defined(OUTER) || defined(OUTER_APP)
+/**
+ * @brief writes an object of the asynchronous data TX queue, the object is not published
+ * @param head write index of the object
+ * @param module_nr module number
+ * @param dlc data length code of object
+ * @param[in] src source pointer of data
+ */
+static void can_async_data_tx_queue_fill(uint16_t head, li_can_slv_module_nr_t module_nr, byte_t dlc, const byte_t *src)
+{
+	volatile can_async_data_tx_queue_t *obj;
+
+	obj = &can_async_data_tx_queue[head & CAN_ASYNC_DATA_TX_QUEUE_MASK];
+	can_port_memory_cpy((byte_t *)&obj->data[0], src, dlc);
+	obj->dlc = dlc;
+	obj->can_id = CAN_CONFIG_ASYNC_DATA_TX_SLAVE_ID + ((module_nr - 1) << 2);
+}
+
+/**
+ * @brief triggers the handling of the asynchronous data TX queue, further objects are sent from the transmit
+ * complete handler
+ */
+static void can_async_data_tx_queue_trigger(void)
+{
+	// the consumer also runs in the transmit complete interrupt, the triggered call must not be interrupted by it
+	CAN_PORT_DISABLE_IRQ();
+	can_port_trigger_can_main_async_data_tx_queue();
+	CAN_PORT_ENABLE_IRQ();
+}
+#endif // #if defined(OUTER) || defined(OUTER_APP)
+
+#if defined(OUTER) || defined(OUTER_APP)
+#ifdef LI_CAN_SLV_ASYNC_TUNNEL
+/**
+ * @brief sends out an control message for asynchronous tunnel protocol
+ * @remarks Handles all control message sending occurrences for the asynchronous CAN tunnel
+ * @param[in] response type of response to prepare
+ * @param[in] modnr_prim number of primary module that initiated the original request
+ * @param[in] modnr_own number of own logical module that should answer
+ * @param data data of the module
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+static li_can_slv_errorcode_t can_async_tnl_ctl_response(can_async_tnl_response_t response, li_can_slv_module_nr_t modnr_prim,
+        li_can_slv_module_nr_t modnr_own, uint16_t data)
+{
+	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
+	byte_t snd_data[CAN_CONFIG_ASYNC_CTRL_TX_DLC] = {0};
+	uint32_t datal;
+
+	switch (response)
+	{
+		case CAN_ASYNC_TNL_OPEN_ACK:
+			snd_data[0] = LI_CAN_SLV_ASYNC_TUNNEL_OPEN_ACK;
+			snd_data[1] = (byte_t) modnr_prim;
+			snd_data[5] = (byte_t)(can_async_tunnel.async_data_delay >> 8);
+			snd_data[6] = (byte_t)(can_async_tunnel.async_data_delay & 0x00FF);
+			break;
+		case CAN_ASYNC_TNL_CLOSE:
+			snd_data[0] = LI_CAN_SLV_ASYNC_TUNNEL_CLOSE;
+			snd_data[1] = (byte_t) modnr_prim;
+			break;
+		case CAN_ASYNC_TNL_CLOSE_ACK:
+			snd_data[0] = LI_CAN_SLV_ASYNC_TUNNEL_CLOSE_ACK;
+			snd_data[1] = (byte_t) modnr_prim;
+			break;
+		case CAN_ASYNC_TNL_LOGIN_ACK:
+			snd_data[0] = LI_CAN_SLV_ASYNC_TUNNEL_LOGIN_ACK;
+			snd_data[1] = (byte_t) modnr_prim;
+			//login in ID
+			snd_data[2] = (byte_t)(data >> 8);
+			snd_data[3] = (byte_t)(data & 0x00FF);
+			break;
+		case CAN_ASYNC_TNL_OPEN_DENY:
+			snd_data[0] = LI_CAN_SLV_ASYNC_TUNNEL_OPEN_DENY;
+			snd_data[1] = (byte_t) modnr_prim;
+			datal = (uint32_t) data;
+			snd_data[4] = (byte_t)(datal >> 24);
+			snd_data[5] = (byte_t)((datal >> 16) & 0x000000FF);
+			snd_data[6] = (byte_t)((datal >> 8) & 0x000000FF);
+			snd_data[7] = (byte_t)(datal & 0x000000FF);
+			break;
+		case CAN_ASYNC_TNL_CLOSE_DENY:
+			snd_data[0] = LI_CAN_SLV_ASYNC_TUNNEL_CLOSE_DENY;
+			snd_data[1] = (byte_t) modnr_prim;
+			//add error number
+			datal = (uint32_t) data;
+			snd_data[4] = (byte_t)(datal >> 24);
+			snd_data[5] = (byte_t)((datal >> 16) & 0x000000FF);
+			snd_data[6] = (byte_t)((datal >> 8) & 0x000000FF);
+			snd_data[7] = (byte_t)(datal & 0x000000FF);
+			break;
+		case CAN_ASYNC_TNL_LOGIN_DENY:
+			snd_data[0] = LI_CAN_SLV_ASYNC_TUNNEL_LOGIN_DENY;
+			snd_data[1] = (byte_t) modnr_prim;
+			//add error number
+			datal = (uint32_t) data;
+			snd_data[4] = (byte_t)(datal >> 24);
+			snd_data[5] = (byte_t)((datal >> 16) & 0x000000FF);
+			snd_data[6] = (byte_t)((datal >> 8) & 0x000000FF);
+			snd_data[7] = (byte_t)(datal & 0x000000FF);
+			break;
+		default:
+			err = ERR_MSG_CAN_ASYNC_TNL_INVALID_COMMAND;
+			break;
+	}
+	if (err == LI_CAN_SLV_ERR_OK)
+	{
+		err = can_async_send_data_to_async_ctrl_tx_queue(modnr_own, CAN_ASYNC_CTRL_TX_TYPE_SLAVE, &snd_data[0]);
+	}
+	return (err);
+}
+#endif //#ifdef LI_CAN_SLV_ASYNC_TUNNEL
+
+
+#ifdef LI_CAN_SLV_ASYNC_TUNNEL
+/**
+ * @brief empties the serial RX queue and resets the XON/XOFF state to XON
+ * @remarks used to make the flow going on again on a hanging tunnel
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+static li_can_slv_errorcode_t can_async_tnl_reset_port(void)
+{
+	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
+
+	if (can_async_tunnel.state == LI_CAN_SLV_ASYNC_TUNNEL_ACTIVE)
+	{
+		err = li_can_slv_port_async_tunnel_clear_rx_buffer_handle();
+
+		if (err == LI_CAN_SLV_ERR_OK)
+		{
+			can_async_tnl_flow_reset();
+			can_async_data_tx_queue_trigger();
+			li_can_slv_port_async_tunnel_xon_rx_handle();
 		}
 	}
 	else
@@ -933,24 +1613,239 @@ static li_can_slv_errorcode_t can_async_tunnel_putc(char_t dat)
 		//check if tunnel is active
 		if (can_async_tunnel.state == LI_CAN_SLV_ASYNC_TUNNEL_ACTIVE)
 		{
-			can_async_tunnel_tmpTXobj.data[can_async_tunnel_tmpTXobj.used] = dat;
-			can_async_tunnel_tmpTXobj.used++;
-#ifdef LI_CAN_SLV_ASYNC_TUNNEL_TIME_STAMP
-			can_async_tunnel_tmpTXobj.lastadd = can_port_get_system_ticks();
-#endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL_TIME_STAMP
-			if (can_async_tunnel_tmpTXobj.used == sizeof(can_async_tunnel_tmpTXobj.data))
+			// a full queue is reported instead of waiting, the character must be written again
+			if (can_async_tunnel_write_obj((const byte_t *) &dat, 1) == 0)
 			{
-				//add the data to the real asynchronous data TX queue
-				do
-				{
-					err = can_async_send_data_to_async_data_tx_queue(can_async_tunnel.mod_own, CAN_ASYNC_DATA_TX_TYPE_SLAVE, can_async_tunnel_tmpTXobj.used, can_async_tunnel_tmpTXobj.data);
-				}
-				while (err != LI_CAN_SLV_ERR_OK);
+				err = ERR_MSG_CAN_ASYNC_DATA_TX_QUEUE_OVERFLOW;
+			}
+		}
+		else
+		{
+			err = ERR_MSG_CAN_ASYNC_TNL_WRONG_STATE;
+		}
+	}
+	else
+	{
+		err = ERR_MSG_CAN_ASYNC_TNL_BUSY; //queue is already busy....abort
+	}
+	can_async_tnl_lock--;
+	return (err);
+}
 
-				if (err == LI_CAN_SLV_ERR_OK)
+/**
+ * @brief adds data bytes to the asynchronous data TX queue, must be called with the tunnel lock
+ * @param[in] src data bytes
+ * @param len number of data bytes
+ * @return number of accepted data bytes
+ */
+static uint16_t can_async_tunnel_write_obj(const byte_t *src, uint16_t len)
+{
+	li_can_slv_errorcode_t err;
+	uint16_t n = 0;
+	uint16_t full;
+	uint16_t accepted;
+
+	// the bytes of the temporary object are sent first
+	if (can_async_tunnel_tmpTXobj.used > 0)
+	{
+		n = can_async_tunnel_tmpobj_add(src, len);
+		if (can_async_tunnel_tmpTXobj.used < sizeof(can_async_tunnel_tmpTXobj.data))
+		{
+			return (n);
+		}
+
+		err = can_async_tunnel_tmpobj_flush();
+		if (err != LI_CAN_SLV_ERR_OK)
+		{
+			return (n);
+		}
+	}
+
+	// full objects are added directly, repeated as long as the transmission frees objects of the queue
+	do
+	{
+		accepted = 0;
+		full = (uint16_t)(((len - n) / sizeof(can_async_tunnel_tmpTXobj.data)) * sizeof(can_async_tunnel_tmpTXobj.data));
+		if (full > 0)
+		{
+			(void) can_async_send_bulk_to_async_data_tx_queue(can_async_tunnel.mod_own, CAN_ASYNC_DATA_TX_TYPE_SLAVE, &src[n], full, &accepted);
+			n += accepted;
+		}
+	}
+	while (accepted > 0);
+
+	// the remaining bytes wait in the temporary object, it is sent at once if no tunnel data is pending
+	n += can_async_tunnel_tmpobj_add(&src[n], len - n);
+	if ((can_async_tunnel_tmpTXobj.used > 0) && (can_async_data_tx_queue_get_nr_of_objs() == 0))
+	{
+		(void) can_async_tunnel_tmpobj_flush();
+	}
+
+	can_async_tnl_check_high_watermark();
+	return (n);
+}
+
+/**
+ * @brief adds data bytes to the temporary tx object as long as it is not full
+ * @param[in] src data bytes
+ * @param len number of data bytes
+ * @return number of added data bytes
+ */
+static uint16_t can_async_tunnel_tmpobj_add(const byte_t *src, uint16_t len)
+{
+	uint16_t n;
+
+	n = sizeof(can_async_tunnel_tmpTXobj.data) - can_async_tunnel_tmpTXobj.used;
+	if (n > len)
+	{
+		n = len;
+	}
+
+	if (n > 0)
+	{
+		if (can_async_tunnel_tmpTXobj.used == 0)
+		{
+			can_async_tunnel_tmpTXobj.firstadd = can_port_get_system_ticks();
+		}
+		can_port_memory_cpy(&can_async_tunnel_tmpTXobj.data[can_async_tunnel_tmpTXobj.used], src, n);
+		can_async_tunnel_tmpTXobj.used += n;
+	}
+	return (n);
+}
+
+/**
+ * @brief adds the temporary tx object to the asynchronous data TX queue
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+static li_can_slv_errorcode_t can_async_tunnel_tmpobj_flush(void)
+{
+	li_can_slv_errorcode_t err;
+
+	err = can_async_send_data_to_async_data_tx_queue(can_async_tunnel.mod_own, CAN_ASYNC_DATA_TX_TYPE_SLAVE, (byte_t) can_async_tunnel_tmpTXobj.used, &can_async_tunnel_tmpTXobj.data[0]);
+	if (err == LI_CAN_SLV_ERR_OK)
+	{
+		//signal that the temporary object is free if the adding was successful
+		can_async_tunnel_tmpTXobj.used = 0;
+	}
+	return (err);
+}
+
+/**
+ * @brief resets the flow control of the tunnel, the tunnel is writable and the transmission is not stopped
+ */
+static void can_async_tnl_flow_reset(void)
+{
+	can_async_tnl_tx_stopped = FALSE;
+	can_async_tnl_writable = TRUE;
+#ifdef LI_CAN_SLV_ASYNC_TUNNEL_RX_RING
+	CAN_PORT_DISABLE_IRQ();
+	can_async_tnl_rx_tail = can_async_tnl_rx_head;
+	can_async_tnl_rx_xoff_sent = FALSE;
+	CAN_PORT_ENABLE_IRQ();
+#endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL_RX_RING
+}
+
+/**
+ * @brief clears the writable flag if the tunnel data TX queue reached the high watermark, called by the producer
+ */
+static void can_async_tnl_check_high_watermark(void)
+{
+	if ((can_async_tnl_writable != FALSE) && (can_async_data_tx_queue_get_nr_of_objs() >= CAN_ASYNC_TNL_TX_HIGH_WATERMARK))
+	{
+		can_async_tnl_writable = FALSE;
+		// the queue could have been emptied before the flag was cleared, then no transmission reports it
+		if (can_async_data_tx_queue_get_nr_of_objs() <= CAN_ASYNC_TNL_TX_LOW_WATERMARK)
+		{
+			can_async_tnl_writable = TRUE;
+		}
+	}
+}
+
+/**
+ * @brief sets the writable flag and calls the writable callback if the tunnel data TX queue fell to the low
+ * watermark, called by the consumer
+ */
+static void can_async_tnl_check_low_watermark(void)
+{
+	if ((can_async_tnl_writable == FALSE) && (can_async_data_tx_queue_get_nr_of_objs() <= CAN_ASYNC_TNL_TX_LOW_WATERMARK))
+	{
+		can_async_tnl_writable = TRUE;
+		if (NULL != can_async_tnl_writable_cbk)
+		{
+			can_async_tnl_writable_cbk();
+		}
+	}
+}
+
+
+/**
+ * @brief adds data bytes to the tunnel
+ * @remarks Full objects are added directly to the asynchronous data TX queue, the remaining bytes are kept in the
+ * temporary object until it is full or flushed by can_async_tunnel_process_tx_data(). The function never waits, bytes
+ * which do not fit into the queue are not accepted and must be written again.
+ * @param[in] src data bytes
+ * @param len number of data bytes
+ * @param[out] accepted number of accepted data bytes
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_async_tunnel_write(const byte_t *src, uint16_t len, uint16_t *accepted)
+{
+	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
+
+	*accepted = 0;
+
+	can_async_tnl_lock++;
+
+	if (can_async_tnl_lock == 1)
+	{
+		if (can_async_tunnel.state == LI_CAN_SLV_ASYNC_TUNNEL_ACTIVE)
+		{
+			*accepted = can_async_tunnel_write_obj(src, len);
+		}
+		else
+		{
+			err = ERR_MSG_CAN_ASYNC_TNL_WRONG_STATE;
+		}
+	}
+	else
+	{
+		err = ERR_MSG_CAN_ASYNC_TNL_BUSY;
+	}
+
+	can_async_tnl_lock--;
+	return (err);
+}
+
+/**
+ * @brief adds the data bytes of several buffers to the tunnel
+ * @remarks The buffers are packed into objects like one continuous buffer. Writing stops at the first buffer which
+ * is not accepted completely, see can_async_tunnel_write().
+ * @param[in] iov table of buffers
+ * @param iovcnt number of buffers
+ * @param[out] accepted number of accepted data bytes of all buffers
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_async_tunnel_writev(const can_async_tunnel_iovec_t *iov, uint16_t iovcnt, uint16_t *accepted)
+{
+	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
+	uint16_t i;
+	uint16_t n;
+
+	*accepted = 0;
+
+	can_async_tnl_lock++;
+
+	if (can_async_tnl_lock == 1)
+	{
+		if (can_async_tunnel.state == LI_CAN_SLV_ASYNC_TUNNEL_ACTIVE)
+		{
+			for (i = 0; i < iovcnt; i++)
+			{
+				n = can_async_tunnel_write_obj(iov[i].data, iov[i].len);
+				*accepted += n;
+				if (n < iov[i].len)
 				{
-					//signal that the temporary object is free if the adding was successful
-					can_async_tunnel_tmpTXobj.used = 0;
+					break;
 				}
 			}
 		}
@@ -961,12 +1856,214 @@ static li_can_slv_errorcode_t can_async_tunnel_putc(char_t dat)
 	}
 	else
 	{
-		err = ERR_MSG_CAN_ASYNC_TNL_BUSY; //queue is already busy....abort
+		err = ERR_MSG_CAN_ASYNC_TNL_BUSY;
+	}
+
+	can_async_tnl_lock--;
+	return (err);
+}
+
+/**
+ * @brief sets the callback which is called when the tunnel is writable again
+ * @remarks The callback is called from the transmit complete interrupt or from the task which triggers the
+ * transmission, it should only signal the producer.
+ * @param pfnc callback, NULL to remove it
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_async_tunnel_set_writable_cbk(void (*pfnc)(void))
+{
+	can_async_tnl_writable_cbk = pfnc;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+/**
+ * @brief get the writable flag of the tunnel
+ * @remarks The flag is cleared when the tunnel data TX queue reaches the high watermark and set again when the
+ * transmission emptied the queue to the low watermark.
+ * @return TRUE if the tunnel is writable, FALSE if the producer should wait
+ */
+uint16_t can_async_tunnel_is_writable(void)
+{
+	return (can_async_tnl_writable);
+}
+
+/**
+ * @brief adds one complete object to the asynchronous data TX queue, bypassing the temporary tx object
+ * @remarks Used by protocols on top of the tunnel which build their own frames, e.g. ISO-TP.
+ * @param[in] src data bytes of the object
+ * @param dlc data length code of the object
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_async_tunnel_send_obj(const byte_t *src, byte_t dlc)
+{
+	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
+
+	can_async_tnl_lock++;
+
+	if (can_async_tnl_lock == 1)
+	{
+		if (can_async_tunnel.state == LI_CAN_SLV_ASYNC_TUNNEL_ACTIVE)
+		{
+			err = can_async_send_data_to_async_data_tx_queue(can_async_tunnel.mod_own, CAN_ASYNC_DATA_TX_TYPE_SLAVE, dlc, src);
+			if (err == LI_CAN_SLV_ERR_OK)
+			{
+				can_async_tnl_check_high_watermark();
+			}
+		}
+		else
+		{
+			err = ERR_MSG_CAN_ASYNC_TNL_WRONG_STATE;
+		}
 	}
+	else
+	{
+		err = ERR_MSG_CAN_ASYNC_TNL_BUSY;
+	}
+
 	can_async_tnl_lock--;
 	return (err);
 }
 
+#ifdef LI_CAN_SLV_ASYNC_TUNNEL_RX_RING
+/**
+ * @brief adds received tunnel data to the tunnel receive ring
+ * @remarks Called from the receive interrupt. XOFF is sent to the tunnel partner when the ring reaches the high
+ * watermark, the readable callback is called when the ring was empty before.
+ * @param[in] src received data bytes
+ * @param len number of received data bytes
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_async_tunnel_data_rx(const byte_t *src, uint16_t len)
+{
+	uint16_t head;
+	uint16_t used;
+	uint16_t n;
+
+	if (can_async_tunnel.state != LI_CAN_SLV_ASYNC_TUNNEL_ACTIVE)
+	{
+		return (ERR_MSG_CAN_ASYNC_TNL_WRONG_STATE);
+	}
+
+	head = can_async_tnl_rx_head;
+	used = (uint16_t)(head - can_async_tnl_rx_tail);
+	if (len > (uint16_t)(CAN_ASYNC_TNL_RX_RING_SIZE - used))
+	{
+		// the tunnel partner ignored the XOFF, the object is dropped as a whole
+		return (ERR_MSG_CAN_ASYNC_TNL_RX_OVERFLOW);
+	}
+
+	// copy in at most two parts because of the wrap around
+	n = CAN_ASYNC_TNL_RX_RING_SIZE - (head & CAN_ASYNC_TNL_RX_RING_MASK);
+	if (n > len)
+	{
+		n = len;
+	}
+	can_port_memory_cpy(&can_async_tnl_rx_ring[head & CAN_ASYNC_TNL_RX_RING_MASK], src, n);
+	if (n < len)
+	{
+		can_port_memory_cpy(&can_async_tnl_rx_ring[0], &src[n], len - n);
+	}
+
+	// publish the bytes after they are written
+	can_port_memory_barrier();
+	can_async_tnl_rx_head = (uint16_t)(head + len);
+
+	if ((can_async_tnl_rx_xoff_sent == FALSE) && ((uint16_t)(used + len) >= CAN_ASYNC_TNL_RX_HIGH_WATERMARK))
+	{
+		if (can_async_xoff() == LI_CAN_SLV_ERR_OK)
+		{
+			can_async_tnl_rx_xoff_sent = TRUE;
+		}
+	}
+
+	if ((used == 0) && (len > 0) && (NULL != can_async_tnl_readable_cbk))
+	{
+		can_async_tnl_readable_cbk();
+	}
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+/**
+ * @brief get the received tunnel data without copying it
+ * @remarks The returned bytes are contiguous, if the received data wraps around the end of the ring the remaining
+ * bytes are returned by the next call after can_async_tunnel_rx_consume().
+ * @param[out] data pointer to the first received byte
+ * @return number of contiguous received bytes, 0 if the ring is empty
+ */
+uint16_t can_async_tunnel_rx_peek(const byte_t **data)
+{
+	uint16_t tail;
+	uint16_t used;
+	uint16_t n;
+
+	tail = can_async_tnl_rx_tail;
+	used = (uint16_t)(can_async_tnl_rx_head - tail);
+	// read the bytes only after the write index
+	can_port_memory_barrier();
+
+	n = CAN_ASYNC_TNL_RX_RING_SIZE - (tail & CAN_ASYNC_TNL_RX_RING_MASK);
+	if (n > used)
+	{
+		n = used;
+	}
+
+	*data = &can_async_tnl_rx_ring[tail & CAN_ASYNC_TNL_RX_RING_MASK];
+	return (n);
+}
+
+/**
+ * @brief releases received tunnel data returned by can_async_tunnel_rx_peek()
+ * @remarks XON is sent to the tunnel partner when the ring falls to the low watermark after a XOFF.
+ * @param len number of processed bytes
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_async_tunnel_rx_consume(uint16_t len)
+{
+	uint16_t tail;
+
+	tail = can_async_tnl_rx_tail;
+	if (len > (uint16_t)(can_async_tnl_rx_head - tail))
+	{
+		return (ERR_MSG_CAN_ASYNC_TNL_WRONG_STATE);
+	}
+
+	// the bytes must be read before they are released
+	can_port_memory_barrier();
+	can_async_tnl_rx_tail = (uint16_t)(tail + len);
+
+	if ((can_async_tnl_rx_xoff_sent != FALSE) && (can_async_tunnel_rx_get_nr_of_bytes() <= CAN_ASYNC_TNL_RX_LOW_WATERMARK))
+	{
+		// XON is repeated on the next call if it could not be sent
+		if (can_async_xon() == LI_CAN_SLV_ERR_OK)
+		{
+			can_async_tnl_rx_xoff_sent = FALSE;
+		}
+	}
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+/**
+ * @brief get the number of received tunnel data bytes in the tunnel receive ring
+ * @return number of received bytes
+ */
+uint16_t can_async_tunnel_rx_get_nr_of_bytes(void)
+{
+	return ((uint16_t)(can_async_tnl_rx_head - can_async_tnl_rx_tail));
+}
+
+/**
+ * @brief sets the callback which is called when the empty tunnel receive ring gets data
+ * @remarks The callback is called from the receive interrupt, it should only signal the application which then
+ * reads all received data with can_async_tunnel_rx_peek() and can_async_tunnel_rx_consume().
+ * @param pfnc callback, NULL to remove it
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_async_tunnel_set_readable_cbk(void (*pfnc)(void))
+{
+	can_async_tnl_readable_cbk = pfnc;
+	return (LI_CAN_SLV_ERR_OK);
+}
+#endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL_RX_RING
 
 /**
  * @brief handles partly filled asynchronous data tx objects for timeout
@@ -984,14 +2081,17 @@ li_can_slv_errorcode_t can_async_tunnel_process_tx_data(void)
 		//check if tunnel is active
 		if (can_async_tunnel.state == LI_CAN_SLV_ASYNC_TUNNEL_ACTIVE)
 		{
-			if ((can_async_tunnel_tmpTXobj.used > 0) && ((uint32_t)(can_async_tunnel_tmpTXobj.used + can_port_msec_2_ticks(CAN_ASYNC_TNL_PARTLYFILLES_TXOBJ_DELAY_MS)) < li_can_slv_port_get_system_ticks()))
+			// a partly filled object is sent at once if no tunnel data is pending, while tunnel data is transmitted
+			// it is filled up to a full object but at most until the delay from its first byte elapsed
+			if ((can_async_tunnel_tmpTXobj.used > 0)
+			        && ((can_async_data_tx_queue_get_nr_of_objs() == 0)
+			            || ((uint32_t)(can_port_get_system_ticks() - can_async_tunnel_tmpTXobj.firstadd) >= (uint32_t) can_port_msec_2_ticks(CAN_ASYNC_TNL_PARTLYFILLES_TXOBJ_DELAY_MS))))
 			{
 				//transmit entry to asynchronous data tx queue
-				err = can_async_send_data_to_async_data_tx_queue(can_async_tunnel.mod_own, CAN_ASYNC_DATA_TX_TYPE_SLAVE, can_async_tunnel_tmpTXobj.used, &can_async_tunnel_tmpTXobj.data[0]);
+				err = can_async_tunnel_tmpobj_flush();
 				if (err == LI_CAN_SLV_ERR_OK)
 				{
-					//signal that the temporary object is free if the adding was successful
-					can_async_tunnel_tmpTXobj.used = 0;
+					can_async_tnl_check_high_watermark();
 				}
 			}
 		}
@@ -40,6 +40,14 @@
 #include <li_can_slv/error/io_can_error.h>
 #include <li_can_slv/error/io_can_errno.h>
 
+#ifdef LI_CAN_SLV_TRAFFIC
+#include <li_can_slv/util/io_can_traffic.h>
+#endif // #ifdef LI_CAN_SLV_TRAFFIC
+
+#ifdef LI_CAN_SLV_ASYNC_ISOTP
+#include <li_can_slv/async/io_can_async_isotp.h>
+#endif // #ifdef LI_CAN_SLV_ASYNC_ISOTP
+
 #ifdef LI_CAN_SLV_DEBUG
 #include "li_can_slv_debug.h"
 #endif // #ifdef LI_CAN_SLV_DEBUG
@@ -79,7 +87,6 @@ uint8_t can_async_handler_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid, uint
 	li_can_slv_module_nr_t module_nr;
 	uint32_t rxi;
 
-	dlc = dlc;
 	rxi = msg_obj;
 
 	module_nr = ((canid - CAN_CONFIG_ASYNC_CTRL_RX_SLAVE_ID) >> 2) + 1;
@@ -97,7 +104,7 @@ uint8_t can_async_handler_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid, uint
 		if ((rxi == (can_config_async_ctrl_rx_objs[CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_CTRL1_RX])))
 		{
 			msg_obj = can_config_async_ctrl_rx_objs[CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_CTRL1_RX];
-			err = can_async_send_data_to_async_ctrl_rx_queue(module_nr, &data[0]);
+			err = can_async_send_data_to_async_ctrl_rx_queue(module_nr, dlc, &data[0]);
 
 #ifdef LI_CAN_SLV_SYS_MODULE_ERROR
 			if (err != LI_CAN_SLV_ERR_OK)
@@ -116,7 +123,7 @@ uint8_t can_async_handler_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid, uint
 		if ((rxi == (can_config_async_ctrl_rx_objs[CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_CTRL2_RX])))
 		{
 			msg_obj = can_config_async_ctrl_rx_objs[CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_CTRL2_RX];
-			err = can_async_send_data_to_async_ctrl_rx_queue(module_nr, &data[0]);
+			err = can_async_send_data_to_async_ctrl_rx_queue(module_nr, dlc, &data[0]);
 #ifdef LI_CAN_SLV_SYS_MODULE_ERROR
 			if (err != LI_CAN_SLV_ERR_OK)
 			{
@@ -133,7 +140,7 @@ uint8_t can_async_handler_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid, uint
 		if ((rxi == (can_config_async_ctrl_rx_objs[CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_CTRL3_RX])))
 		{
 			msg_obj = can_config_async_ctrl_rx_objs[CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_CTRL3_RX];
-			err = can_async_send_data_to_async_ctrl_rx_queue(module_nr, &data[0]);
+			err = can_async_send_data_to_async_ctrl_rx_queue(module_nr, dlc, &data[0]);
 #ifdef LI_CAN_SLV_SYS_MODULE_ERROR
 			if (err != LI_CAN_SLV_ERR_OK)
 			{
@@ -150,7 +157,7 @@ uint8_t can_async_handler_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid, uint
 		if ((rxi == (can_config_async_ctrl_rx_objs[CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_CTRL4_RX])))
 		{
 			msg_obj = can_config_async_ctrl_rx_objs[CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_CTRL4_RX];
-			err = can_async_send_data_to_async_ctrl_rx_queue(module_nr, &data[0]);
+			err = can_async_send_data_to_async_ctrl_rx_queue(module_nr, dlc, &data[0]);
 #ifdef LI_CAN_SLV_SYS_MODULE_ERROR
 			if (err != LI_CAN_SLV_ERR_OK)
 			{
@@ -167,7 +174,7 @@ uint8_t can_async_handler_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid, uint
 		if ((rxi == (can_config_async_ctrl_rx_objs[CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_CTRL5_RX])))
 		{
 			msg_obj = can_config_async_ctrl_rx_objs[CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_CTRL5_RX];
-			err = can_async_send_data_to_async_ctrl_rx_queue(module_nr, &data[0]);
+			err = can_async_send_data_to_async_ctrl_rx_queue(module_nr, dlc, &data[0]);
 #ifdef LI_CAN_SLV_SYS_MODULE_ERROR
 			if (err != LI_CAN_SLV_ERR_OK)
 			{
@@ -184,7 +191,7 @@ uint8_t can_async_handler_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid, uint
 		if ((rxi == (can_config_async_ctrl_rx_objs[CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_CTRL6_RX])))
 		{
 			msg_obj = can_config_async_ctrl_rx_objs[CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_CTRL6_RX];
-			err = can_async_send_data_to_async_ctrl_rx_queue(module_nr, &data[0]);
+			err = can_async_send_data_to_async_ctrl_rx_queue(module_nr, dlc, &data[0]);
 #ifdef LI_CAN_SLV_SYS_MODULE_ERROR
 			if (err != LI_CAN_SLV_ERR_OK)
 			{
@@ -201,7 +208,7 @@ uint8_t can_async_handler_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid, uint
 		if ((rxi == (can_config_async_ctrl_rx_objs[CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_CTRL7_RX])))
 		{
 			msg_obj = can_config_async_ctrl_rx_objs[CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_CTRL7_RX];
-			err = can_async_send_data_to_async_ctrl_rx_queue(module_nr, &data[0]);
+			err = can_async_send_data_to_async_ctrl_rx_queue(module_nr, dlc, &data[0]);
 #ifdef LI_CAN_SLV_SYS_MODULE_ERROR
 			if (err != LI_CAN_SLV_ERR_OK)
 			{
@@ -218,7 +225,7 @@ uint8_t can_async_handler_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid, uint
 		if ((rxi == (can_config_async_ctrl_rx_objs[CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_CTRL8_RX])))
 		{
 			msg_obj = can_config_async_ctrl_rx_objs[CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_CTRL8_RX];
-			err = can_async_send_data_to_async_ctrl_rx_queue(module_nr, &data[0]);
+			err = can_async_send_data_to_async_ctrl_rx_queue(module_nr, dlc, &data[0]);
 #ifdef LI_CAN_SLV_SYS_MODULE_ERROR
 			if (err != LI_CAN_SLV_ERR_OK)
 			{
@@ -231,6 +238,10 @@ uint8_t can_async_handler_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid, uint
 #if LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 9
 #warning LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES out of range!
 #endif // #if LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES
+
+#ifdef LI_CAN_SLV_TRAFFIC
+		can_traffic_rx(CAN_TRAFFIC_NODE_MAIN, canid, can_traffic_reason(err));
+#endif // #ifdef LI_CAN_SLV_TRAFFIC
 	}
 	return 0;
 }
@@ -249,7 +260,23 @@ uint8_t can_async_handler_data_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid,
 	/* asynchronous data received */
 	if (rxi == CAN_CONFIG_MSG_MAIN_OBJ_ASYNC_DATA_RX)
 	{
-		li_can_slv_port_async_tunnel_data_rx_handle((byte_t *)data, dlc);
+#ifdef LI_CAN_SLV_ASYNC_ISOTP
+		if (can_async_tunnel.connection_type == CAN_ASYNC_CONNECTION_TYPE_UDS_PROTOCOL)
+		{
+			err = can_async_isotp_rx((const byte_t *)data, dlc);
+		}
+		else
+#endif // #ifdef LI_CAN_SLV_ASYNC_ISOTP
+		{
+#ifdef LI_CAN_SLV_ASYNC_TUNNEL_RX_RING
+			err = can_async_tunnel_data_rx((const byte_t *)data, dlc);
+#else // #ifdef LI_CAN_SLV_ASYNC_TUNNEL_RX_RING
+			li_can_slv_port_async_tunnel_data_rx_handle((byte_t *)data, dlc);
+#endif // #ifdef LI_CAN_SLV_ASYNC_TUNNEL_RX_RING
+		}
+#ifdef LI_CAN_SLV_TRAFFIC
+		can_traffic_rx(CAN_TRAFFIC_NODE_MAIN, canid, can_traffic_reason(err));
+#endif // #ifdef LI_CAN_SLV_TRAFFIC
 	}
 
 	return (err);
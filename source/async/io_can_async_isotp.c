@@ -0,0 +1,689 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/*!
+ * \remarks ISO-TP (ISO 15765-2) transport for the UDS connection type of the asynchronous tunnel\n
+ * - <b>frames</b>\n
+ * The single, first, consecutive and flow control frames are exchanged as tunnel data objects, normal addressing
+ * is used, so the whole object except the protocol control information carries data. Frames are not padded.
+ *
+ * - <b>reception</b>\n
+ * The frames are copied by the receive interrupt directly into the buffer provided by
+ * can_async_isotp_set_rx_buffer(). The flow control frame with #CAN_ASYNC_ISOTP_BS and #CAN_ASYNC_ISOTP_STMIN is
+ * sent by can_async_isotp_process(), a message longer than the buffer is rejected with an overflow flow control.
+ *
+ * - <b>transmission</b>\n
+ * can_async_isotp_send() starts the transmission of a message without copying it. The consecutive frames are added
+ * to the asynchronous data TX queue by can_async_isotp_process() as far as the block size and the separation time of
+ * the receiver allow it.
+ */
+
+/**
+ * @file io_can_async_isotp.c
+ * @brief ISO-TP transport of the asynchronous tunnel
+ * @addtogroup can_async_isotp
+ * @{
+ */
+
+/*--------------------------------------------------------------------------*/
+/* include files                                                            */
+/*--------------------------------------------------------------------------*/
+#include <li_can_slv/async/io_can_async_isotp.h>
+#include <li_can_slv/async/io_can_async.h>
+#include <li_can_slv/error/io_can_errno.h>
+
+#include "io_can_port.h"
+
+#ifdef LI_CAN_SLV_ASYNC_ISOTP
+/*--------------------------------------------------------------------------*/
+/* general definitions (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+#ifndef CAN_ASYNC_ISOTP_BS
+#define CAN_ASYNC_ISOTP_BS	(0) /**< block size sent in the flow control, 0 for no further flow control */
+#endif // #ifndef CAN_ASYNC_ISOTP_BS
+
+#ifndef CAN_ASYNC_ISOTP_STMIN
+#define CAN_ASYNC_ISOTP_STMIN	(0) /**< minimum separation time sent in the flow control */
+#endif // #ifndef CAN_ASYNC_ISOTP_STMIN
+
+#if (CAN_ASYNC_ISOTP_BS > 0xFF) || (CAN_ASYNC_ISOTP_STMIN > 0xFF)
+#error CAN_ASYNC_ISOTP_BS and CAN_ASYNC_ISOTP_STMIN must fit into one byte
+#endif
+
+#ifndef CAN_ASYNC_ISOTP_TIMEOUT_MS
+#define CAN_ASYNC_ISOTP_TIMEOUT_MS	(1000) /**< timeout N_Bs and N_Cr in ms */
+#endif // #ifndef CAN_ASYNC_ISOTP_TIMEOUT_MS
+
+#ifndef CAN_ASYNC_ISOTP_WFT_MAX
+#define CAN_ASYNC_ISOTP_WFT_MAX	(8) /**< maximum number of consecutive wait flow controls */
+#endif // #ifndef CAN_ASYNC_ISOTP_WFT_MAX
+
+#define CAN_ASYNC_ISOTP_PCI_MASK	(0xF0u) /**< frame type in the upper nibble of the protocol control information */
+#define CAN_ASYNC_ISOTP_PCI_SF	(0x00u) /**< single frame */
+#define CAN_ASYNC_ISOTP_PCI_FF	(0x10u) /**< first frame */
+#define CAN_ASYNC_ISOTP_PCI_CF	(0x20u) /**< consecutive frame */
+#define CAN_ASYNC_ISOTP_PCI_FC	(0x30u) /**< flow control */
+
+#define CAN_ASYNC_ISOTP_FS_CTS	(0x00u) /**< flow status continue to send */
+#define CAN_ASYNC_ISOTP_FS_WAIT	(0x01u) /**< flow status wait */
+#define CAN_ASYNC_ISOTP_FS_OVFLW	(0x02u) /**< flow status overflow */
+#define CAN_ASYNC_ISOTP_FS_NONE	(0xFFu) /**< no flow control pending */
+
+#define CAN_ASYNC_ISOTP_DLC	(CAN_CONFIG_ASYNC_DATA_TX_DLC) /**< data length code of a full frame */
+#define CAN_ASYNC_ISOTP_SF_MAX_LEN	(CAN_ASYNC_ISOTP_DLC - 1) /**< maximum number of data bytes of a single frame */
+#define CAN_ASYNC_ISOTP_FF_LEN	(CAN_ASYNC_ISOTP_DLC - 2) /**< number of data bytes of a first frame */
+#define CAN_ASYNC_ISOTP_CF_LEN	(CAN_ASYNC_ISOTP_DLC - 1) /**< maximum number of data bytes of a consecutive frame */
+#define CAN_ASYNC_ISOTP_FC_DLC	(3) /**< data length code of a flow control, flow status, block size and separation time */
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions (private/not exported)                        */
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief states of the transmission
+ * @enum can_async_isotp_tx_state_t
+ */
+typedef enum
+{
+	CAN_ASYNC_ISOTP_TX_IDLE, /**< no transmission */
+	CAN_ASYNC_ISOTP_TX_START, /**< single or first frame to send */
+	CAN_ASYNC_ISOTP_TX_WAIT_FC, /**< waiting for the flow control */
+	CAN_ASYNC_ISOTP_TX_CF /**< sending consecutive frames */
+} can_async_isotp_tx_state_t;
+
+/**
+ * @brief transmission
+ * @struct can_async_isotp_tx_t
+ */
+typedef struct
+{
+	volatile can_async_isotp_tx_state_t state; /**< state of the transmission */
+	const byte_t *data; /**< message */
+	uint16_t len; /**< length of the message */
+	uint16_t pos; /**< number of sent bytes */
+	byte_t sn; /**< sequence number of the next consecutive frame */
+	byte_t bs; /**< block size of the receiver */
+	byte_t bs_cnt; /**< consecutive frames until the next flow control */
+	uint16_t wft_cnt; /**< number of received wait flow controls */
+	uint32_t stmin; /**< separation time of the receiver in ticks */
+	uint32_t last; /**< system ticks of the last sent frame */
+	volatile uint16_t fc_rx; /**< flow control received */
+	volatile byte_t fc_fs; /**< received flow status */
+	volatile byte_t fc_bs; /**< received block size */
+	volatile byte_t fc_stmin; /**< received separation time */
+} can_async_isotp_tx_t;
+
+/**
+ * @brief reception
+ * @struct can_async_isotp_rx_t
+ */
+typedef struct
+{
+	volatile uint16_t active; /**< consecutive frames expected */
+	byte_t *buf; /**< receive buffer of the application */
+	uint16_t size; /**< size of the receive buffer */
+	uint16_t len; /**< length of the message */
+	uint16_t pos; /**< number of received bytes */
+	byte_t sn; /**< expected sequence number */
+	byte_t bs_cnt; /**< consecutive frames until the next flow control */
+	uint32_t last; /**< system ticks of the last received frame */
+	volatile byte_t fc_pending; /**< flow status to send, #CAN_ASYNC_ISOTP_FS_NONE if none */
+} can_async_isotp_rx_t;
+
+/*--------------------------------------------------------------------------*/
+/* global variables (public/exported)                                       */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (private/not exported)                                  */
+/*--------------------------------------------------------------------------*/
+static can_async_isotp_tx_t can_async_isotp_tx; /**< running transmission */
+static can_async_isotp_rx_t can_async_isotp_rx_info = {FALSE, NULL, 0, 0, 0, 0, 0, 0, CAN_ASYNC_ISOTP_FS_NONE}; /**< running reception */
+static volatile uint16_t can_async_isotp_lock = 0; /**< can_async_isotp_process() lock/unlock */
+static void (*can_async_isotp_rx_cbk)(li_can_slv_errorcode_t err, byte_t *data, uint16_t len) = NULL; /**< callback of a complete or aborted reception */
+static void (*can_async_isotp_tx_cbk)(li_can_slv_errorcode_t err) = NULL; /**< callback of a complete or aborted transmission */
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+static li_can_slv_errorcode_t can_async_isotp_rx_cf(const byte_t *data, uint16_t dlc);
+static void can_async_isotp_rx_end(li_can_slv_errorcode_t err);
+static li_can_slv_errorcode_t can_async_isotp_process_rx(void);
+static li_can_slv_errorcode_t can_async_isotp_process_tx(void);
+static li_can_slv_errorcode_t can_async_isotp_send_cf(void);
+static void can_async_isotp_tx_end(li_can_slv_errorcode_t err);
+static uint32_t can_async_isotp_stmin_2_ticks(byte_t stmin);
+
+/*--------------------------------------------------------------------------*/
+/* function definition (public/exported)                                    */
+/*--------------------------------------------------------------------------*/
+void can_async_isotp_reset(void)
+{
+	CAN_PORT_DISABLE_IRQ();
+	can_async_isotp_tx.state = CAN_ASYNC_ISOTP_TX_IDLE;
+	can_async_isotp_tx.fc_rx = FALSE;
+	can_async_isotp_rx_info.active = FALSE;
+	can_async_isotp_rx_info.fc_pending = CAN_ASYNC_ISOTP_FS_NONE;
+	CAN_PORT_ENABLE_IRQ();
+}
+
+li_can_slv_errorcode_t can_async_isotp_rx(const byte_t *data, uint16_t dlc)
+{
+	can_async_isotp_rx_t *rx = &can_async_isotp_rx_info;
+	uint16_t len;
+
+	if (dlc < 1)
+	{
+		return (ERR_MSG_CAN_ASYNC_ISOTP_PROTOCOL);
+	}
+
+	switch (data[0] & CAN_ASYNC_ISOTP_PCI_MASK)
+	{
+		case CAN_ASYNC_ISOTP_PCI_SF:
+			len = data[0] & 0x0Fu;
+			if ((len == 0) || (len > (dlc - 1)))
+			{
+				return (ERR_MSG_CAN_ASYNC_ISOTP_PROTOCOL);
+			}
+			// a new message terminates the running reception
+			if (rx->active != FALSE)
+			{
+				can_async_isotp_rx_end(ERR_MSG_CAN_ASYNC_ISOTP_PROTOCOL);
+			}
+			if ((rx->buf == NULL) || (len > rx->size))
+			{
+				return (ERR_MSG_CAN_ASYNC_ISOTP_OVERFLOW);
+			}
+			can_port_memory_cpy(rx->buf, &data[1], len);
+			rx->len = len;
+			rx->pos = len;
+			can_async_isotp_rx_end(LI_CAN_SLV_ERR_OK);
+			break;
+
+		case CAN_ASYNC_ISOTP_PCI_FF:
+			if (dlc < CAN_ASYNC_ISOTP_DLC)
+			{
+				return (ERR_MSG_CAN_ASYNC_ISOTP_PROTOCOL);
+			}
+			len = (uint16_t)(((uint16_t)(data[0] & 0x0Fu) << 8) | data[1]);
+			if (len <= CAN_ASYNC_ISOTP_SF_MAX_LEN)
+			{
+				return (ERR_MSG_CAN_ASYNC_ISOTP_PROTOCOL);
+			}
+			if (rx->active != FALSE)
+			{
+				can_async_isotp_rx_end(ERR_MSG_CAN_ASYNC_ISOTP_PROTOCOL);
+			}
+			if ((rx->buf == NULL) || (len > rx->size))
+			{
+				rx->fc_pending = CAN_ASYNC_ISOTP_FS_OVFLW;
+				return (ERR_MSG_CAN_ASYNC_ISOTP_OVERFLOW);
+			}
+			can_port_memory_cpy(rx->buf, &data[2], CAN_ASYNC_ISOTP_FF_LEN);
+			rx->len = len;
+			rx->pos = CAN_ASYNC_ISOTP_FF_LEN;
+			rx->sn = 1;
+			rx->bs_cnt = CAN_ASYNC_ISOTP_BS;
+			rx->last = can_port_get_system_ticks();
+			rx->active = TRUE;
+			rx->fc_pending = CAN_ASYNC_ISOTP_FS_CTS;
+			break;
+
+		case CAN_ASYNC_ISOTP_PCI_CF:
+			return (can_async_isotp_rx_cf(data, dlc));
+
+		case CAN_ASYNC_ISOTP_PCI_FC:
+			if (dlc < CAN_ASYNC_ISOTP_FC_DLC)
+			{
+				return (ERR_MSG_CAN_ASYNC_ISOTP_PROTOCOL);
+			}
+			// evaluated by can_async_isotp_process()
+			if (can_async_isotp_tx.state == CAN_ASYNC_ISOTP_TX_WAIT_FC)
+			{
+				can_async_isotp_tx.fc_fs = data[0] & 0x0Fu;
+				can_async_isotp_tx.fc_bs = data[1];
+				can_async_isotp_tx.fc_stmin = data[2];
+				can_async_isotp_tx.fc_rx = TRUE;
+			}
+			break;
+
+		default:
+			return (ERR_MSG_CAN_ASYNC_ISOTP_PROTOCOL);
+	}
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+li_can_slv_errorcode_t can_async_isotp_process(void)
+{
+	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
+
+	can_async_isotp_lock++;
+
+	if (can_async_isotp_lock == 1)
+	{
+		if ((can_async_tunnel.state == LI_CAN_SLV_ASYNC_TUNNEL_ACTIVE) && (can_async_tunnel.connection_type == CAN_ASYNC_CONNECTION_TYPE_UDS_PROTOCOL))
+		{
+			err = can_async_isotp_process_rx();
+			if (err == LI_CAN_SLV_ERR_OK)
+			{
+				err = can_async_isotp_process_tx();
+			}
+		}
+		else if (can_async_isotp_tx.state != CAN_ASYNC_ISOTP_TX_IDLE)
+		{
+			can_async_isotp_tx_end(ERR_MSG_CAN_ASYNC_TNL_WRONG_STATE);
+		}
+	}
+	else
+	{
+		err = ERR_MSG_CAN_ASYNC_ISOTP_BUSY;
+	}
+
+	can_async_isotp_lock--;
+	return (err);
+}
+
+li_can_slv_errorcode_t can_async_isotp_set_rx_buffer(byte_t *buf, uint16_t size)
+{
+	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
+
+	CAN_PORT_DISABLE_IRQ();
+	if (can_async_isotp_rx_info.active != FALSE)
+	{
+		err = ERR_MSG_CAN_ASYNC_ISOTP_BUSY;
+	}
+	else
+	{
+		can_async_isotp_rx_info.buf = buf;
+		can_async_isotp_rx_info.size = (buf != NULL) ? size : 0;
+	}
+	CAN_PORT_ENABLE_IRQ();
+
+	return (err);
+}
+
+li_can_slv_errorcode_t can_async_isotp_set_rx_cbk(void (*pfnc)(li_can_slv_errorcode_t err, byte_t *data, uint16_t len))
+{
+	can_async_isotp_rx_cbk = pfnc;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+li_can_slv_errorcode_t can_async_isotp_send(const byte_t *data, uint16_t len)
+{
+	if ((len == 0) || (len > CAN_ASYNC_ISOTP_MAX_LEN))
+	{
+		return (ERR_MSG_CAN_ASYNC_ISOTP_INVALID_LENGTH);
+	}
+
+	if ((can_async_tunnel.state != LI_CAN_SLV_ASYNC_TUNNEL_ACTIVE) || (can_async_tunnel.connection_type != CAN_ASYNC_CONNECTION_TYPE_UDS_PROTOCOL))
+	{
+		return (ERR_MSG_CAN_ASYNC_TNL_WRONG_STATE);
+	}
+
+	if (can_async_isotp_tx.state != CAN_ASYNC_ISOTP_TX_IDLE)
+	{
+		return (ERR_MSG_CAN_ASYNC_ISOTP_BUSY);
+	}
+
+	can_async_isotp_tx.data = data;
+	can_async_isotp_tx.len = len;
+	can_async_isotp_tx.pos = 0;
+	can_async_isotp_tx.state = CAN_ASYNC_ISOTP_TX_START;
+
+	// the first frame is sent at once if can_async_isotp_process() is not running
+	(void) can_async_isotp_process();
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+li_can_slv_errorcode_t can_async_isotp_set_tx_cbk(void (*pfnc)(li_can_slv_errorcode_t err))
+{
+	can_async_isotp_tx_cbk = pfnc;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+/*--------------------------------------------------------------------------*/
+/* function definition (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief handles a received consecutive frame, called from the receive interrupt
+ * @param[in] data received object
+ * @param dlc data length code of the object
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+static li_can_slv_errorcode_t can_async_isotp_rx_cf(const byte_t *data, uint16_t dlc)
+{
+	can_async_isotp_rx_t *rx = &can_async_isotp_rx_info;
+	uint16_t n;
+
+	if (rx->active == FALSE)
+	{
+		// consecutive frames of a rejected or aborted message are ignored
+		return (LI_CAN_SLV_ERR_OK);
+	}
+
+	if ((data[0] & 0x0Fu) != rx->sn)
+	{
+		can_async_isotp_rx_end(ERR_MSG_CAN_ASYNC_ISOTP_WRONG_SN);
+		return (ERR_MSG_CAN_ASYNC_ISOTP_WRONG_SN);
+	}
+
+	n = rx->len - rx->pos;
+	if (n > CAN_ASYNC_ISOTP_CF_LEN)
+	{
+		n = CAN_ASYNC_ISOTP_CF_LEN;
+	}
+	if (n > (dlc - 1))
+	{
+		can_async_isotp_rx_end(ERR_MSG_CAN_ASYNC_ISOTP_PROTOCOL);
+		return (ERR_MSG_CAN_ASYNC_ISOTP_PROTOCOL);
+	}
+
+	can_port_memory_cpy(&rx->buf[rx->pos], &data[1], n);
+	rx->pos += n;
+	rx->sn = (rx->sn + 1) & 0x0Fu;
+	rx->last = can_port_get_system_ticks();
+
+	if (rx->pos >= rx->len)
+	{
+		can_async_isotp_rx_end(LI_CAN_SLV_ERR_OK);
+	}
+	else if (CAN_ASYNC_ISOTP_BS != 0)
+	{
+		rx->bs_cnt--;
+		if (rx->bs_cnt == 0)
+		{
+			rx->bs_cnt = CAN_ASYNC_ISOTP_BS;
+			rx->fc_pending = CAN_ASYNC_ISOTP_FS_CTS;
+		}
+	}
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+/**
+ * @brief ends the reception and reports it, a complete message releases the receive buffer
+ * @param err #LI_CAN_SLV_ERR_OK for a complete message or the reason of the abort
+ */
+static void can_async_isotp_rx_end(li_can_slv_errorcode_t err)
+{
+	can_async_isotp_rx_t *rx = &can_async_isotp_rx_info;
+	byte_t *buf;
+
+	rx->active = FALSE;
+	buf = rx->buf;
+	if (err == LI_CAN_SLV_ERR_OK)
+	{
+		rx->buf = NULL;
+		rx->size = 0;
+	}
+
+	if (NULL != can_async_isotp_rx_cbk)
+	{
+		can_async_isotp_rx_cbk(err, buf, (err == LI_CAN_SLV_ERR_OK) ? rx->len : 0);
+	}
+}
+
+/**
+ * @brief sends a pending flow control and supervises the consecutive frames of the reception
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+static li_can_slv_errorcode_t can_async_isotp_process_rx(void)
+{
+	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
+	byte_t fc[CAN_ASYNC_ISOTP_FC_DLC];
+	byte_t fs;
+	uint16_t timeout = FALSE;
+
+	fs = can_async_isotp_rx_info.fc_pending;
+	if (fs != CAN_ASYNC_ISOTP_FS_NONE)
+	{
+		fc[0] = CAN_ASYNC_ISOTP_PCI_FC | fs;
+		fc[1] = CAN_ASYNC_ISOTP_BS;
+		fc[2] = CAN_ASYNC_ISOTP_STMIN;
+		err = can_async_tunnel_send_obj(&fc[0], CAN_ASYNC_ISOTP_FC_DLC);
+		if (err == LI_CAN_SLV_ERR_OK)
+		{
+			CAN_PORT_DISABLE_IRQ();
+			// a flow control requested meanwhile is sent with the next call
+			if (can_async_isotp_rx_info.fc_pending == fs)
+			{
+				can_async_isotp_rx_info.fc_pending = CAN_ASYNC_ISOTP_FS_NONE;
+			}
+			CAN_PORT_ENABLE_IRQ();
+		}
+		else if (err == ERR_MSG_CAN_ASYNC_DATA_TX_QUEUE_OVERFLOW)
+		{
+			// retried with the next call
+			err = LI_CAN_SLV_ERR_OK;
+		}
+	}
+
+	CAN_PORT_DISABLE_IRQ();
+	if ((can_async_isotp_rx_info.active != FALSE) && ((uint32_t)(can_port_get_system_ticks() - can_async_isotp_rx_info.last) >= (uint32_t) can_port_msec_2_ticks(CAN_ASYNC_ISOTP_TIMEOUT_MS)))
+	{
+		can_async_isotp_rx_info.active = FALSE;
+		timeout = TRUE;
+	}
+	CAN_PORT_ENABLE_IRQ();
+
+	if ((timeout != FALSE) && (NULL != can_async_isotp_rx_cbk))
+	{
+		can_async_isotp_rx_cbk(ERR_MSG_CAN_ASYNC_ISOTP_TIMEOUT, can_async_isotp_rx_info.buf, 0);
+	}
+	return (err);
+}
+
+/**
+ * @brief sends the frames of the running transmission as far as the flow control allows it
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+static li_can_slv_errorcode_t can_async_isotp_process_tx(void)
+{
+	can_async_isotp_tx_t *tx = &can_async_isotp_tx;
+	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
+	byte_t frame[CAN_ASYNC_ISOTP_DLC];
+
+	switch (tx->state)
+	{
+		case CAN_ASYNC_ISOTP_TX_START:
+			if (tx->len <= CAN_ASYNC_ISOTP_SF_MAX_LEN)
+			{
+				frame[0] = CAN_ASYNC_ISOTP_PCI_SF | (byte_t) tx->len;
+				can_port_memory_cpy(&frame[1], tx->data, tx->len);
+				err = can_async_tunnel_send_obj(&frame[0], (byte_t)(tx->len + 1));
+				if (err == LI_CAN_SLV_ERR_OK)
+				{
+					can_async_isotp_tx_end(LI_CAN_SLV_ERR_OK);
+				}
+			}
+			else
+			{
+				frame[0] = CAN_ASYNC_ISOTP_PCI_FF | (byte_t)(tx->len >> 8);
+				frame[1] = (byte_t) tx->len;
+				can_port_memory_cpy(&frame[2], tx->data, CAN_ASYNC_ISOTP_FF_LEN);
+				// the flow control is accepted from now on, it may be received before the first frame is reported as sent
+				tx->fc_rx = FALSE;
+				tx->wft_cnt = 0;
+				tx->state = CAN_ASYNC_ISOTP_TX_WAIT_FC;
+				err = can_async_tunnel_send_obj(&frame[0], CAN_ASYNC_ISOTP_DLC);
+				if (err == LI_CAN_SLV_ERR_OK)
+				{
+					tx->pos = CAN_ASYNC_ISOTP_FF_LEN;
+					tx->sn = 1;
+					tx->last = can_port_get_system_ticks();
+				}
+				else
+				{
+					tx->state = CAN_ASYNC_ISOTP_TX_START;
+				}
+			}
+			break;
+
+		case CAN_ASYNC_ISOTP_TX_WAIT_FC:
+			if (tx->fc_rx != FALSE)
+			{
+				tx->fc_rx = FALSE;
+				switch (tx->fc_fs)
+				{
+					case CAN_ASYNC_ISOTP_FS_CTS:
+						tx->bs = tx->fc_bs;
+						tx->bs_cnt = tx->fc_bs;
+						tx->stmin = can_async_isotp_stmin_2_ticks(tx->fc_stmin);
+						// the first consecutive frame is sent without separation time
+						tx->last = can_port_get_system_ticks() - tx->stmin - 1;
+						tx->state = CAN_ASYNC_ISOTP_TX_CF;
+						err = can_async_isotp_send_cf();
+						break;
+
+					case CAN_ASYNC_ISOTP_FS_WAIT:
+						tx->wft_cnt++;
+						if (tx->wft_cnt > CAN_ASYNC_ISOTP_WFT_MAX)
+						{
+							can_async_isotp_tx_end(ERR_MSG_CAN_ASYNC_ISOTP_TIMEOUT);
+						}
+						else
+						{
+							tx->last = can_port_get_system_ticks();
+						}
+						break;
+
+					case CAN_ASYNC_ISOTP_FS_OVFLW:
+						can_async_isotp_tx_end(ERR_MSG_CAN_ASYNC_ISOTP_OVERFLOW);
+						break;
+
+					default:
+						can_async_isotp_tx_end(ERR_MSG_CAN_ASYNC_ISOTP_PROTOCOL);
+						break;
+				}
+			}
+			else if ((uint32_t)(can_port_get_system_ticks() - tx->last) >= (uint32_t) can_port_msec_2_ticks(CAN_ASYNC_ISOTP_TIMEOUT_MS))
+			{
+				can_async_isotp_tx_end(ERR_MSG_CAN_ASYNC_ISOTP_TIMEOUT);
+			}
+			break;
+
+		case CAN_ASYNC_ISOTP_TX_CF:
+			err = can_async_isotp_send_cf();
+			break;
+
+		default:
+			break;
+	}
+
+	if (err == ERR_MSG_CAN_ASYNC_DATA_TX_QUEUE_OVERFLOW)
+	{
+		// retried with the next call
+		err = LI_CAN_SLV_ERR_OK;
+	}
+	return (err);
+}
+
+/**
+ * @brief sends consecutive frames until the queue is full, the block ends or the separation time is running
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+static li_can_slv_errorcode_t can_async_isotp_send_cf(void)
+{
+	can_async_isotp_tx_t *tx = &can_async_isotp_tx;
+	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
+	byte_t frame[CAN_ASYNC_ISOTP_DLC];
+	uint16_t n;
+
+	while (tx->state == CAN_ASYNC_ISOTP_TX_CF)
+	{
+		if (tx->stmin != 0)
+		{
+			// the separation time is kept on the bus only if no frame is waiting in the queue
+			if (((uint32_t)(can_port_get_system_ticks() - tx->last) <= tx->stmin) || (can_async_data_tx_queue_get_nr_of_objs() > 0))
+			{
+				break;
+			}
+		}
+
+		n = tx->len - tx->pos;
+		if (n > CAN_ASYNC_ISOTP_CF_LEN)
+		{
+			n = CAN_ASYNC_ISOTP_CF_LEN;
+		}
+		frame[0] = CAN_ASYNC_ISOTP_PCI_CF | tx->sn;
+		can_port_memory_cpy(&frame[1], &tx->data[tx->pos], n);
+		err = can_async_tunnel_send_obj(&frame[0], (byte_t)(n + 1));
+		if (err != LI_CAN_SLV_ERR_OK)
+		{
+			break;
+		}
+
+		tx->pos += n;
+		tx->sn = (tx->sn + 1) & 0x0Fu;
+		tx->last = can_port_get_system_ticks();
+
+		if (tx->pos >= tx->len)
+		{
+			can_async_isotp_tx_end(LI_CAN_SLV_ERR_OK);
+		}
+		else if (tx->bs != 0)
+		{
+			tx->bs_cnt--;
+			if (tx->bs_cnt == 0)
+			{
+				tx->fc_rx = FALSE;
+				tx->wft_cnt = 0;
+				tx->state = CAN_ASYNC_ISOTP_TX_WAIT_FC;
+			}
+		}
+	}
+	return (err);
+}
+
+/**
+ * @brief ends the transmission and reports it
+ * @param err #LI_CAN_SLV_ERR_OK if the message has been sent or the reason of the abort
+ */
+static void can_async_isotp_tx_end(li_can_slv_errorcode_t err)
+{
+	can_async_isotp_tx.state = CAN_ASYNC_ISOTP_TX_IDLE;
+
+	if (NULL != can_async_isotp_tx_cbk)
+	{
+		can_async_isotp_tx_cbk(err);
+	}
+}
+
+/**
+ * @brief converts the separation time of a flow control to system ticks
+ * @param stmin separation time, 0x00..0x7F ms or 0xF1..0xF9 100..900 us
+ * @return separation time in ticks, values below 1 ms are rounded up to 1 ms
+ */
+static uint32_t can_async_isotp_stmin_2_ticks(byte_t stmin)
+{
+	if (stmin <= 0x7Fu)
+	{
+		return ((uint32_t) can_port_msec_2_ticks(stmin));
+	}
+
+	if ((stmin >= 0xF1u) && (stmin <= 0xF9u))
+	{
+		return ((uint32_t) can_port_msec_2_ticks(1));
+	}
+
+	// reserved values are handled as the longest separation time
+	return ((uint32_t) can_port_msec_2_ticks(0x7F));
+}
+#endif // #ifdef LI_CAN_SLV_ASYNC_ISOTP
+
+/** @} */
@@ -84,6 +84,10 @@
 #include <li_can_slv/xload/li_can_slv_xload_defines.h>
 #endif // #ifdef LI_CAN_SLV_MODULE_IO_CONFIG
 
+#ifndef LI_CAN_SLV_NO_XLOAD_INFO
+#include <li_can_slv/xload/li_can_slv_xload_info.h>
+#endif // #ifndef LI_CAN_SLV_NO_XLOAD_INFO
+
 #include "io_can_hw.h"
 #include <li_can_slv/core/io_can_main.h>
 #include "io_can_main_hw.h"
@@ -120,6 +124,17 @@
 /*--------------------------------------------------------------------------*/
 /* general definitions (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
+#ifdef LI_CAN_SLV_SYNC_FD
+/* in CAN FD mode only object 0 of a logical module owns a message object, the frame carries all objects */
+#define CAN_CONFIG_SYNC_MSG_OBJ_USED(obj)	((obj) == 0u)
+#define CAN_CONFIG_SYNC_RX_MSG_OBJ_DLC(table_pos, obj)	(can_config_module_tab[(table_pos)].rx_dlc_fd)
+#define CAN_CONFIG_SYNC_TX_MSG_OBJ_DLC(table_pos, obj)	(can_config_module_tab[(table_pos)].tx_dlc_fd)
+#else
+#define CAN_CONFIG_SYNC_MSG_OBJ_USED(obj)	(1)
+#define CAN_CONFIG_SYNC_RX_MSG_OBJ_DLC(table_pos, obj)	(can_config_module_tab[(table_pos)].rx_dlc[(obj)])
+#define CAN_CONFIG_SYNC_TX_MSG_OBJ_DLC(table_pos, obj)	(can_config_module_tab[(table_pos)].tx_dlc[(obj)])
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
+
 static li_can_slv_config_bdr_t can_config_bdr_startup;
 
 /*--------------------------------------------------------------------------*/
@@ -193,6 +208,10 @@ li_can_slv_config_module_t can_config_module_tab[LI_CAN_SLV_MAX_NR_OF_LOGICAL_MO
 		{NULL, NULL, NULL, NULL},
 		{NULL, NULL, NULL, NULL},
 #endif // #ifdef LI_CAN_SLV_MON
+#ifdef LI_CAN_SLV_SYNC_FD
+		LI_CAN_SLV_CONFIG_DLC_USED_0,
+		LI_CAN_SLV_CONFIG_DLC_USED_0,
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
 	},
 #endif //LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 1
 #if LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 2
@@ -239,6 +258,10 @@ li_can_slv_config_module_t can_config_module_tab[LI_CAN_SLV_MAX_NR_OF_LOGICAL_MO
 		{NULL, NULL, NULL, NULL},
 		{NULL, NULL, NULL, NULL},
 #endif // #ifdef LI_CAN_SLV_MON
+#ifdef LI_CAN_SLV_SYNC_FD
+		LI_CAN_SLV_CONFIG_DLC_USED_0,
+		LI_CAN_SLV_CONFIG_DLC_USED_0,
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
 	},
 #endif //LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 2
 #if LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 3
@@ -285,6 +308,10 @@ li_can_slv_config_module_t can_config_module_tab[LI_CAN_SLV_MAX_NR_OF_LOGICAL_MO
 		{NULL, NULL, NULL, NULL},
 		{NULL, NULL, NULL, NULL},
 #endif // #ifdef LI_CAN_SLV_MON
+#ifdef LI_CAN_SLV_SYNC_FD
+		LI_CAN_SLV_CONFIG_DLC_USED_0,
+		LI_CAN_SLV_CONFIG_DLC_USED_0,
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
 	},
 #endif //LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 3
 #if LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 4
@@ -331,6 +358,10 @@ li_can_slv_config_module_t can_config_module_tab[LI_CAN_SLV_MAX_NR_OF_LOGICAL_MO
 		{NULL, NULL, NULL, NULL},
 		{NULL, NULL, NULL, NULL},
 #endif // #ifdef LI_CAN_SLV_MON
+#ifdef LI_CAN_SLV_SYNC_FD
+		LI_CAN_SLV_CONFIG_DLC_USED_0,
+		LI_CAN_SLV_CONFIG_DLC_USED_0,
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
 	},
 #endif //LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 4
 #if LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 5
@@ -377,6 +408,10 @@ li_can_slv_config_module_t can_config_module_tab[LI_CAN_SLV_MAX_NR_OF_LOGICAL_MO
 		{NULL, NULL, NULL, NULL},
 		{NULL, NULL, NULL, NULL},
 #endif // #ifdef LI_CAN_SLV_MON
+#ifdef LI_CAN_SLV_SYNC_FD
+		LI_CAN_SLV_CONFIG_DLC_USED_0,
+		LI_CAN_SLV_CONFIG_DLC_USED_0,
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
 	},
 #endif //LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 5
 #if LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 6
@@ -423,6 +458,10 @@ li_can_slv_config_module_t can_config_module_tab[LI_CAN_SLV_MAX_NR_OF_LOGICAL_MO
 		{NULL, NULL, NULL, NULL},
 		{NULL, NULL, NULL, NULL},
 #endif // #ifdef LI_CAN_SLV_MON
+#ifdef LI_CAN_SLV_SYNC_FD
+		LI_CAN_SLV_CONFIG_DLC_USED_0,
+		LI_CAN_SLV_CONFIG_DLC_USED_0,
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
 	},
 #endif //LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 6
 #if LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 7
@@ -469,6 +508,10 @@ li_can_slv_config_module_t can_config_module_tab[LI_CAN_SLV_MAX_NR_OF_LOGICAL_MO
 		{NULL, NULL, NULL, NULL},
 		{NULL, NULL, NULL, NULL},
 #endif // #ifdef LI_CAN_SLV_MON
+#ifdef LI_CAN_SLV_SYNC_FD
+		LI_CAN_SLV_CONFIG_DLC_USED_0,
+		LI_CAN_SLV_CONFIG_DLC_USED_0,
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
 	},
 #endif //LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 7
 #if LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 8
@@ -515,6 +558,10 @@ li_can_slv_config_module_t can_config_module_tab[LI_CAN_SLV_MAX_NR_OF_LOGICAL_MO
 		{NULL, NULL, NULL, NULL},
 		{NULL, NULL, NULL, NULL},
 #endif // #ifdef LI_CAN_SLV_MON
+#ifdef LI_CAN_SLV_SYNC_FD
+		LI_CAN_SLV_CONFIG_DLC_USED_0,
+		LI_CAN_SLV_CONFIG_DLC_USED_0,
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
 	},
 #endif //LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 8
 #if LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 9
@@ -698,6 +745,10 @@ static li_can_slv_config_module_t can_config_ukwn_module =
 	{ NULL, NULL, NULL, NULL},
 	{ NULL, NULL, NULL, NULL},
 #endif // #ifdef LI_CAN_SLV_MON
+#ifdef LI_CAN_SLV_SYNC_FD
+	LI_CAN_SLV_CONFIG_DLC_USED_0,
+	LI_CAN_SLV_CONFIG_DLC_USED_0,
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
 };
 #endif // #ifdef LI_CAN_SLV_UNKNOWN_MODULE
 
@@ -725,6 +776,11 @@ static li_can_slv_errorcode_t rx_mon_dummy(byte_t *can, void *app, uint16_t dlc)
 #ifdef LI_CAN_SLV_ASYNC
 static li_can_slv_errorcode_t can_config_get_async_ctrl_rx_obj(uint16_t table_pos, uint16_t *msg_obj_nr);
 #endif // #ifdef LI_CAN_SLV_ASYNC
+
+#ifdef LI_CAN_SLV_SYNC_FD
+static void can_config_set_dlc_fd(uint16_t table_pos);
+static byte_t can_config_get_dlc_fd(byte_t nr_of_objs, const byte_t *dlc);
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
 #endif // #if defined(OUTER) || defined(OUTER_APP)
 
 #ifndef LI_CAN_SLV_BOOT
@@ -1099,6 +1155,11 @@ li_can_slv_errorcode_t can_config_set_active(char_t *type)
 	/*----------------------------------------------------------------------*/
 	for (i = 0; i < can_config_module_tab[table_pos].tx_obj; i++)
 	{
+		if (!CAN_CONFIG_SYNC_MSG_OBJ_USED(i))
+		{
+			continue;
+		}
+
 		msg_obj = can_config_module_tab[table_pos].tx_msg_obj_mon[i];
 		err = can_msg_obj_init(msg_obj);
 		if (err != LI_CAN_SLV_ERR_OK)
@@ -1113,6 +1174,11 @@ li_can_slv_errorcode_t can_config_set_active(char_t *type)
 	/*----------------------------------------------------------------------*/
 	for (i = 0; i < can_config_module_tab[table_pos].rx_obj; i++)
 	{
+		if (!CAN_CONFIG_SYNC_MSG_OBJ_USED(i))
+		{
+			continue;
+		}
+
 		msg_obj = can_config_module_tab[table_pos].rx_msg_obj_main[i];
 		err = can_msg_obj_init(msg_obj);
 		if (err != LI_CAN_SLV_ERR_OK)
@@ -1161,6 +1227,11 @@ li_can_slv_errorcode_t can_config_set_critical(char_t *type)
 	/*----------------------------------------------------------------------*/
 	for (i = 0; i < can_config_module_tab[table_pos].tx_obj; i++)
 	{
+		if (!CAN_CONFIG_SYNC_MSG_OBJ_USED(i))
+		{
+			continue;
+		}
+
 		msg_obj = can_config_module_tab[table_pos].tx_msg_obj_mon[i];
 		err = can_msg_obj_init(msg_obj);
 		if (err != LI_CAN_SLV_ERR_OK)
@@ -1175,6 +1246,11 @@ li_can_slv_errorcode_t can_config_set_critical(char_t *type)
 	/*----------------------------------------------------------------------*/
 	for (i = 0; i < can_config_module_tab[table_pos].rx_obj; i++)
 	{
+		if (!CAN_CONFIG_SYNC_MSG_OBJ_USED(i))
+		{
+			continue;
+		}
+
 		msg_obj = can_config_module_tab[table_pos].rx_msg_obj_main[i];
 		err = can_msg_obj_init(msg_obj);
 		if (err != LI_CAN_SLV_ERR_OK)
@@ -1811,10 +1887,15 @@ li_can_slv_errorcode_t li_can_slv_config_change_module_nr_and_identifiers(char_t
 				return (err);
 			}
 
+			if (!CAN_CONFIG_SYNC_MSG_OBJ_USED(i))
+			{
+				continue;
+			}
+
 #if defined(LI_CAN_SLV_MON)
 			/* define CAN message object for receiving synchronous data from main CAN Node on monitor CAN Node on the Main CPU */
 			msg_obj = can_config_module_tab[table_pos].tx_msg_obj_mon[i];
-			err = can_mon_define_msg_obj(msg_obj, can_id + i, CAN_CONFIG_ACCEPTANCE_ONE_ID, can_config_module_tab[table_pos].tx_dlc[i], CAN_CONFIG_DIR_RX, CAN_MON_ISR_ID_RX_MAIN, CAN_OBJECT_IS_SYNC);
+			err = can_mon_define_msg_obj(msg_obj, can_id + i, CAN_CONFIG_ACCEPTANCE_ONE_ID, CAN_CONFIG_SYNC_TX_MSG_OBJ_DLC(table_pos, i), CAN_CONFIG_DIR_RX, CAN_MON_ISR_ID_RX_MAIN, CAN_OBJECT_IS_SYNC);
 			if (err != LI_CAN_SLV_ERR_OK)
 			{
 				return (err);
@@ -1832,9 +1913,14 @@ li_can_slv_errorcode_t li_can_slv_config_change_module_nr_and_identifiers(char_t
 		for (i = 0; i < can_config_module_tab[table_pos].tx_obj; i++)
 		{
 
+			if (!CAN_CONFIG_SYNC_MSG_OBJ_USED(i))
+			{
+				continue;
+			}
+
 			/* set used message object */
 			msg_obj = can_config_module_tab[table_pos].tx_main_rx_msg_obj_mon[i];
-			err = can_main_define_msg_obj(msg_obj, can_id + i, CAN_CONFIG_ACCEPTANCE_ONE_ID, can_config_module_tab[table_pos].tx_dlc[i], CAN_CONFIG_DIR_RX, CAN_MAIN_SERVICE_ID_RX, CAN_OBJECT_IS_SYNC);
+			err = can_main_define_msg_obj(msg_obj, can_id + i, CAN_CONFIG_ACCEPTANCE_ONE_ID, CAN_CONFIG_SYNC_TX_MSG_OBJ_DLC(table_pos, i), CAN_CONFIG_DIR_RX, CAN_MAIN_SERVICE_ID_RX, CAN_OBJECT_IS_SYNC);
 			if (err != LI_CAN_SLV_ERR_OK)
 			{
 				return (err);
@@ -1848,8 +1934,13 @@ li_can_slv_errorcode_t li_can_slv_config_change_module_nr_and_identifiers(char_t
 
 	for (i = 0; i < can_config_module_tab[table_pos].rx_obj; i++)
 	{
+		if (!CAN_CONFIG_SYNC_MSG_OBJ_USED(i))
+		{
+			continue;
+		}
+
 		msg_obj = can_config_module_tab[table_pos].rx_msg_obj_main[i];
-		err = can_main_define_msg_obj(msg_obj, can_id + i, CAN_CONFIG_ACCEPTANCE_ONE_ID, can_config_module_tab[table_pos].rx_dlc[i], CAN_CONFIG_DIR_RX, CAN_MAIN_SERVICE_ID_RX, CAN_OBJECT_IS_SYNC);
+		err = can_main_define_msg_obj(msg_obj, can_id + i, CAN_CONFIG_ACCEPTANCE_ONE_ID, CAN_CONFIG_SYNC_RX_MSG_OBJ_DLC(table_pos, i), CAN_CONFIG_DIR_RX, CAN_MAIN_SERVICE_ID_RX, CAN_OBJECT_IS_SYNC);
 		if (err != LI_CAN_SLV_ERR_OK)
 		{
 			return (err);
@@ -1858,7 +1949,7 @@ li_can_slv_errorcode_t li_can_slv_config_change_module_nr_and_identifiers(char_t
 #ifdef LI_CAN_SLV_MON
 		/* monitor CAN node */
 		msg_obj = can_config_module_tab[table_pos].rx_msg_obj_mon[i];
-		err = can_mon_define_msg_obj(msg_obj, can_id + i, CAN_CONFIG_ACCEPTANCE_ONE_ID, can_config_module_tab[table_pos].rx_dlc[i], CAN_CONFIG_DIR_RX, CAN_MON_ISR_ID_RX, CAN_OBJECT_IS_SYNC);
+		err = can_mon_define_msg_obj(msg_obj, can_id + i, CAN_CONFIG_ACCEPTANCE_ONE_ID, CAN_CONFIG_SYNC_RX_MSG_OBJ_DLC(table_pos, i), CAN_CONFIG_DIR_RX, CAN_MON_ISR_ID_RX, CAN_OBJECT_IS_SYNC);
 		if (err != LI_CAN_SLV_ERR_OK)
 		{
 			return (err);
@@ -2031,6 +2122,10 @@ li_can_slv_errorcode_t can_config_change_module_type(uint16_t table_pos, char_t
 #endif // #ifdef LI_CAN_SLV_MON
 			}
 
+#ifdef LI_CAN_SLV_SYNC_FD
+			can_config_set_dlc_fd(table_pos);
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
+
 			can_main_sync_process_tx_data_ctrl.send_reg = 0x00000000UL;
 			can_main_sync_process_tx_data_ctrl.send_end = 0x00000000UL;
 
@@ -2194,6 +2289,10 @@ static li_can_slv_errorcode_t can_config_set_module(uint16_t table_pos, const li
 
 	can_config_module_tab[table_pos].module_nr = module_nr;
 
+#ifdef LI_CAN_SLV_SYNC_FD
+	can_config_set_dlc_fd(table_pos);
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
+
 	// set receive application data pointers
 	can_config_module_tab[table_pos].rx[0] = rx0;
 	can_config_module_tab[table_pos].rx[1] = rx1;
@@ -2230,6 +2329,11 @@ static li_can_slv_errorcode_t can_config_set_module(uint16_t table_pos, const li
 				return (err);
 			}
 
+			if (!CAN_CONFIG_SYNC_MSG_OBJ_USED(i))
+			{
+				continue;
+			}
+
 #if defined(LI_CAN_SLV_MON)
 			/* define CAN message object for receiving synchronous data from main CAN Node on monitor CAN Node on the Main CPU */
 			err = can_mon_get_next_free_msg_obj(&msg_obj);
@@ -2240,7 +2344,7 @@ static li_can_slv_errorcode_t can_config_set_module(uint16_t table_pos, const li
 
 			// set used message object
 			can_config_module_tab[table_pos].tx_msg_obj_mon[i] = msg_obj;
-			err = can_mon_define_msg_obj(msg_obj, can_id + i, CAN_CONFIG_ACCEPTANCE_ONE_ID, can_config_module_tab[table_pos].tx_dlc[i], CAN_CONFIG_DIR_RX, CAN_MON_ISR_ID_RX_MAIN, CAN_OBJECT_IS_SYNC);
+			err = can_mon_define_msg_obj(msg_obj, can_id + i, CAN_CONFIG_ACCEPTANCE_ONE_ID, CAN_CONFIG_SYNC_TX_MSG_OBJ_DLC(table_pos, i), CAN_CONFIG_DIR_RX, CAN_MON_ISR_ID_RX_MAIN, CAN_OBJECT_IS_SYNC);
 			if (err != LI_CAN_SLV_ERR_OK)
 			{
 				return (err);
@@ -2265,6 +2369,11 @@ static li_can_slv_errorcode_t can_config_set_module(uint16_t table_pos, const li
 		{
 			can_config_module_tab[table_pos].tx_dlc_sync[i] = can_config_module_tab[table_pos].tx_dlc[i];
 
+			if (!CAN_CONFIG_SYNC_MSG_OBJ_USED(i))
+			{
+				continue;
+			}
+
 			err = can_main_get_next_free_msg_obj(&msg_obj);
 			if (err != LI_CAN_SLV_ERR_OK)
 			{
@@ -2274,7 +2383,7 @@ static li_can_slv_errorcode_t can_config_set_module(uint16_t table_pos, const li
 			/* set used message object */
 			can_config_module_tab[table_pos].tx_main_rx_msg_obj_mon[i] = msg_obj;
 
-			err = can_main_define_msg_obj(msg_obj, can_id + i, CAN_CONFIG_ACCEPTANCE_ONE_ID, can_config_module_tab[table_pos].tx_dlc[i], CAN_CONFIG_DIR_RX, CAN_MAIN_SERVICE_ID_RX, CAN_OBJECT_IS_SYNC);
+			err = can_main_define_msg_obj(msg_obj, can_id + i, CAN_CONFIG_ACCEPTANCE_ONE_ID, CAN_CONFIG_SYNC_TX_MSG_OBJ_DLC(table_pos, i), CAN_CONFIG_DIR_RX, CAN_MAIN_SERVICE_ID_RX, CAN_OBJECT_IS_SYNC);
 			if (err != LI_CAN_SLV_ERR_OK)
 			{
 				return (err);
@@ -2297,6 +2406,11 @@ static li_can_slv_errorcode_t can_config_set_module(uint16_t table_pos, const li
 	{
 		can_config_module_tab[table_pos].rx_dlc_sync[i] = can_config_module_tab[table_pos].rx_dlc[i];
 
+		if (!CAN_CONFIG_SYNC_MSG_OBJ_USED(i))
+		{
+			continue;
+		}
+
 		/* main CAN node */
 		err = can_main_get_next_free_msg_obj(&msg_obj);
 		if (err != LI_CAN_SLV_ERR_OK)
@@ -2305,7 +2419,7 @@ static li_can_slv_errorcode_t can_config_set_module(uint16_t table_pos, const li
 		}
 
 		can_config_module_tab[table_pos].rx_msg_obj_main[i] = msg_obj;
-		err = can_main_define_msg_obj(msg_obj, can_id + i, CAN_CONFIG_ACCEPTANCE_ONE_ID, can_config_module_tab[table_pos].rx_dlc[i], CAN_CONFIG_DIR_RX, CAN_MAIN_SERVICE_ID_RX, CAN_OBJECT_IS_SYNC);
+		err = can_main_define_msg_obj(msg_obj, can_id + i, CAN_CONFIG_ACCEPTANCE_ONE_ID, CAN_CONFIG_SYNC_RX_MSG_OBJ_DLC(table_pos, i), CAN_CONFIG_DIR_RX, CAN_MAIN_SERVICE_ID_RX, CAN_OBJECT_IS_SYNC);
 		if (err != LI_CAN_SLV_ERR_OK)
 		{
 			return (err);
@@ -2326,7 +2440,7 @@ static li_can_slv_errorcode_t can_config_set_module(uint16_t table_pos, const li
 		}
 
 		can_config_module_tab[table_pos].rx_msg_obj_mon[i] = msg_obj;
-		err = can_mon_define_msg_obj(msg_obj, can_id + i, CAN_CONFIG_ACCEPTANCE_ONE_ID, can_config_module_tab[table_pos].rx_dlc[i], CAN_CONFIG_DIR_RX, CAN_MON_ISR_ID_RX, CAN_OBJECT_IS_SYNC);
+		err = can_mon_define_msg_obj(msg_obj, can_id + i, CAN_CONFIG_ACCEPTANCE_ONE_ID, CAN_CONFIG_SYNC_RX_MSG_OBJ_DLC(table_pos, i), CAN_CONFIG_DIR_RX, CAN_MON_ISR_ID_RX, CAN_OBJECT_IS_SYNC);
 		if (err != LI_CAN_SLV_ERR_OK)
 		{
 			return (err);
@@ -2497,6 +2611,44 @@ static li_can_slv_errorcode_t can_config_get_async_ctrl_rx_obj(uint16_t table_po
 #endif // #if defined(OUTER) || defined(OUTER_APP)
 #endif // #ifdef LI_CAN_SLV_ASYNC
 
+#if defined(OUTER) || defined(OUTER_APP)
+#ifdef LI_CAN_SLV_SYNC_FD
+/**
+ * @brief calculate the CAN FD frame lengths of the synchronous objects of a module
+ * @param table_pos position in configuration table
+ */
+static void can_config_set_dlc_fd(uint16_t table_pos)
+{
+	can_config_module_tab[table_pos].rx_dlc_fd = can_config_get_dlc_fd(can_config_module_tab[table_pos].rx_obj, &can_config_module_tab[table_pos].rx_dlc[0]);
+	can_config_module_tab[table_pos].tx_dlc_fd = can_config_get_dlc_fd(can_config_module_tab[table_pos].tx_obj, &can_config_module_tab[table_pos].tx_dlc[0]);
+}
+
+/**
+ * @brief get the payload length of a CAN FD frame carrying the given objects
+ * @remarks every object uses a slot of #CAN_DLC_MAX bytes, the payload is rounded up to the next valid CAN FD length
+ * @param nr_of_objs number of objects
+ * @param dlc data length codes of the objects
+ * @return payload length of the CAN FD frame
+ */
+static byte_t can_config_get_dlc_fd(byte_t nr_of_objs, const byte_t *dlc)
+{
+	static const byte_t fd_length[] = {12u, 16u, 20u, 24u, 32u, 48u, CAN_DLC_FD_MAX};
+	uint16_t length = 0;
+	uint16_t i;
+
+	if (nr_of_objs > 0)
+	{
+		length = ((nr_of_objs - 1u) * CAN_DLC_MAX) + dlc[nr_of_objs - 1u];
+	}
+
+	for (i = 0; (i < ((sizeof(fd_length) / sizeof(fd_length[0])) - 1u)) && (length > fd_length[i]); i++)
+	{
+	}
+	return (fd_length[i]);
+}
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
+#endif // #if defined(OUTER) || defined(OUTER_APP)
+
 #ifndef LI_CAN_SLV_BOOT
 /**
  *
@@ -58,6 +58,26 @@
 #include <li_can_slv/async/io_can_async.h>
 #endif // #ifdef LI_CAN_SLV_ASYNC
 
+#ifdef LI_CAN_SLV_QUALITY
+#include <li_can_slv/util/io_can_quality.h>
+#endif // #ifdef LI_CAN_SLV_QUALITY
+
+#ifdef LI_CAN_SLV_ANALYZER
+#include <li_can_slv/util/io_can_analyzer.h>
+#endif // #ifdef LI_CAN_SLV_ANALYZER
+
+#ifdef LI_CAN_SLV_TRAFFIC
+#include <li_can_slv/util/io_can_traffic.h>
+#endif // #ifdef LI_CAN_SLV_TRAFFIC
+
+#ifdef LI_CAN_SLV_ASYNC_ISOTP
+#include <li_can_slv/async/io_can_async_isotp.h>
+#endif // #ifdef LI_CAN_SLV_ASYNC_ISOTP
+
+#ifdef LI_CAN_SLV_ULOAD
+#include <li_can_slv/xload/li_can_slv_xload.h>
+#endif // #ifdef LI_CAN_SLV_ULOAD
+
 #include "io_can_port.h"
 
 #ifdef LI_CAN_SLV_DEBUG
@@ -83,6 +103,12 @@ static li_can_slv_node_mode_t li_can_slv_mode = LI_CAN_SLV_MODE_INIT;
 /*--------------------------------------------------------------------------*/
 can_mainmon_type_t can_mainmon_type = CAN_MAINMON_TYPE_UNDEF;
 
+#ifdef LI_CAN_SLV_HW_TIMESTAMP
+static volatile uint32_t can_rx_ticks[CAN_RX_NR_OF_NODES]; /**< receive time of the currently processed message */
+static volatile uint32_t can_rx_latency; /**< interrupt latency of the last received message in system ticks */
+static volatile uint32_t can_rx_latency_max; /**< maximum interrupt latency since initialization in system ticks */
+#endif // #ifdef LI_CAN_SLV_HW_TIMESTAMP
+
 /*--------------------------------------------------------------------------*/
 /* function prototypes (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
@@ -119,6 +145,27 @@ li_can_slv_errorcode_t li_can_slv_init(can_config_bdr_t baudrate)
 		err = can_hw_init();
 	}
 
+#ifdef LI_CAN_SLV_QUALITY
+	if (err == LI_CAN_SLV_ERR_OK)
+	{
+		err = can_quality_init();
+	}
+#endif // #ifdef LI_CAN_SLV_QUALITY
+
+#ifdef LI_CAN_SLV_ANALYZER
+	if (err == LI_CAN_SLV_ERR_OK)
+	{
+		err = can_analyzer_init();
+	}
+#endif // #ifdef LI_CAN_SLV_ANALYZER
+
+#ifdef LI_CAN_SLV_TRAFFIC
+	if (err == LI_CAN_SLV_ERR_OK)
+	{
+		err = can_traffic_init();
+	}
+#endif // #ifdef LI_CAN_SLV_TRAFFIC
+
 #ifdef LI_CAN_SLV_MAIN_MON
 	if (err == LI_CAN_SLV_ERR_OK)
 	{
@@ -245,6 +292,20 @@ li_can_slv_errorcode_t li_can_slv_init(can_config_bdr_t baudrate)
 	}
 #endif	// #if defined(OUTER) || defined(OUTER_APP)
 
+	if (err == LI_CAN_SLV_ERR_OK)
+	{
+		// define message object for system and error message transmission
+		err = can_main_define_msg_obj(CAN_CONFIG_MSG_MAIN_OBJ_TX_SYS, CAN_CONFIG_SYS_TX_MASK, CAN_CONFIG_ACCEPTANCE_ONE_ID, CAN_CONFIG_SYS_MSG_DLC, CAN_CONFIG_DIR_TX, CAN_MAIN_SERVICE_ID_TX, CAN_OBJECT_NOT_SYNC);
+	}
+
+#ifdef LI_CAN_SLV_ASYNC
+	if (err == LI_CAN_SLV_ERR_OK)
+	{
+		// define message object for asynchronous control and data transmission
+		err = can_main_define_msg_obj(CAN_CONFIG_MSG_MAIN_OBJ_TX_ASYNC, CAN_CONFIG_ASYNC_CTRL_TX_SLAVE_ID, CAN_CONFIG_ACCEPTANCE_ONE_ID, CAN_CONFIG_ASYNC_CTRL_TX_DLC, CAN_CONFIG_DIR_TX, CAN_MAIN_ASYNC_SERVICE_ID_TX, CAN_OBJECT_NOT_SYNC);
+	}
+#endif // #ifdef LI_CAN_SLV_ASYNC
+
 #if defined(OUTER) || defined(OUTER_APP)
 	if (err == LI_CAN_SLV_ERR_OK)
 	{
@@ -306,6 +367,15 @@ li_can_slv_errorcode_t li_can_slv_process(void)
 
 	can_main_hw_handler_error();
 
+#ifdef LI_CAN_SLV_QUALITY
+	(void) can_quality_process();
+#endif // #ifdef LI_CAN_SLV_QUALITY
+
+#ifdef CAN_ASYNC_CTRL_RX_QUEUE
+	// process the received asynchronous control objects outside of the receive interrupt
+	(void) can_async_handle_async_ctrl_rx_queue();
+#endif // #ifdef CAN_ASYNC_CTRL_RX_QUEUE
+
 #ifdef LI_CAN_SLV_DEBUG_PRCOCESS
 	tick = can_port_get_system_ticks();
 	if (tick >= next_print_tick)
@@ -322,6 +392,18 @@ li_can_slv_errorcode_t li_can_slv_process(void)
 	// process partly filled async tx data objects for a timed sending
 	can_async_tunnel_process_tx_data();
 #endif // #if defined(LI_CAN_SLV_ASYNC_TUNNEL)
+#ifdef LI_CAN_SLV_ASYNC_ISOTP
+	// send ISO-TP flow control and consecutive frames
+	(void) can_async_isotp_process();
+#endif // #ifdef LI_CAN_SLV_ASYNC_ISOTP
+#ifdef CAN_ASYNC_TX_SHAPER
+	// send the objects held back by the asynchronous transmit shaper
+	can_async_tx_shaper_process();
+#endif // #ifdef CAN_ASYNC_TX_SHAPER
+#ifdef LI_CAN_SLV_ULOAD
+	// send the data objects of a running upload block
+	li_can_slv_uload_process();
+#endif // #ifdef LI_CAN_SLV_ULOAD
 #endif // #ifdef LI_CAN_SLV_ASYNC
 #endif // #if defined(OUTER) || defined(OUTER_APP)
 	return LI_CAN_SLV_ERR_OK;
@@ -345,6 +427,47 @@ li_can_slv_node_mode_t li_can_slv_get_node_mode(void)
 	return li_can_slv_mode;
 }
 
+#ifdef LI_CAN_SLV_HW_TIMESTAMP
+void can_rx_ticks_set(uint16_t node, uint32_t ticks)
+{
+	uint32_t latency;
+
+	if (node < CAN_RX_NR_OF_NODES)
+	{
+		can_rx_ticks[node] = ticks;
+	}
+
+	// a time stamp ahead of the system time is a clock mismatch and not counted as latency
+	latency = can_port_get_system_ticks() - ticks;
+	if (latency > 0x7FFFFFFFuL)
+	{
+		latency = 0;
+	}
+
+	can_rx_latency = latency;
+	if (latency > can_rx_latency_max)
+	{
+		can_rx_latency_max = latency;
+	}
+}
+
+uint32_t can_rx_ticks_get(uint16_t node)
+{
+	if (node < CAN_RX_NR_OF_NODES)
+	{
+		return (can_rx_ticks[node]);
+	}
+	return (can_port_get_system_ticks());
+}
+
+li_can_slv_errorcode_t li_can_slv_get_rx_latency(uint32_t *latency, uint32_t *latency_max)
+{
+	*latency = can_rx_latency;
+	*latency_max = can_rx_latency_max;
+	return (LI_CAN_SLV_ERR_OK);
+}
+#endif // #ifdef LI_CAN_SLV_HW_TIMESTAMP
+
 void lcsa_set_state(lcsa_state_t new_state)
 {
 	li_can_slv_state = new_state;
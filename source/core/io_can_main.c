@@ -462,11 +462,23 @@ li_can_slv_errorcode_t can_main_sync_process_tx_data_cnfg(uint16_t table_pos, ui
 		return (ERR_MSG_CAN_MAIN_OVER_OBJECT_NR);
 	}
 
+#ifdef LI_CAN_SLV_SYNC_FD
+	/* all transmit objects of a module are sent with the frame of object 0 */
+	if (obj != 0)
+	{
+		return (LI_CAN_SLV_ERR_OK);
+	}
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
+
 	/* calculation of the transmit identifier */
 	can_id = CAN_CONFIG_DATA_TX_MASK + ((module_nr - 1) << 2) + obj;
 
 	can_main_sync_process_tx_data_ctrl.id[table_pos][obj] = can_id;
+#ifdef LI_CAN_SLV_SYNC_FD
+	can_main_sync_process_tx_data_ctrl.dlc[table_pos][obj] = can_config_module_tab[table_pos].tx_dlc_fd;
+#else
 	can_main_sync_process_tx_data_ctrl.dlc[table_pos][obj] = can_config_module_tab[table_pos].tx_dlc[obj];
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
 
 	/* set corresponding flag in the send register */
 	send = 0x00000001L << obj;
@@ -486,6 +498,13 @@ void can_main_synchron_tx_data_off(uint16_t table_pos, uint16_t obj)
 {
 	dword_t send;
 
+#ifdef LI_CAN_SLV_SYNC_FD
+	if (obj != 0)
+	{
+		return;
+	}
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
+
 	/* set corresponding flag in the send register */
 	send = 0x00000001L << obj;
 	can_main_sync_process_tx_data_ctrl.send_reg &= ~(send << (CAN_CONFIG_NR_OF_MODULE_OBJS * table_pos));
@@ -501,6 +520,13 @@ void can_main_synchron_tx_data_on(uint16_t table_pos, uint16_t obj)
 {
 	dword_t send;
 
+#ifdef LI_CAN_SLV_SYNC_FD
+	if (obj != 0)
+	{
+		return;
+	}
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
+
 	/* set corresponding flag in the send register */
 	send = 0x00000001L << obj;
 	can_main_sync_process_tx_data_ctrl.send_reg |= (send << (CAN_CONFIG_NR_OF_MODULE_OBJS * table_pos));
@@ -558,7 +584,7 @@ li_can_slv_errorcode_t can_main_send_queue_system_tx(li_can_slv_module_nr_t modu
 	{
 		/* calculation of CAN identifier */
 		can_id = CAN_CONFIG_SYS_TX_MASK + ((module_nr - 1) << 2);
-		can_main_hw_send_msg(can_id, CAN_CONFIG_SYS_MSG_DLC, src);
+		can_main_hw_send_msg_class(CAN_MAIN_TX_CLASS_SYS, can_id, CAN_CONFIG_SYS_MSG_DLC, src);
 	}
 	return (LI_CAN_SLV_ERR_OK);
 }
@@ -609,7 +635,12 @@ li_can_slv_errorcode_t can_main_disable(void)
 void can_main_sync_send_process_data(void)
 {
 	li_can_slv_errorcode_t err;
+#ifdef LI_CAN_SLV_SYNC_FD
+	uint8_t data[CAN_DLC_FD_MAX];
+	uint16_t i;
+#else
 	uint8_t data[8];
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
 	uint16_t table_pos, obj;
 	uint16_t dlc;
 	uint32_t send; /**< send flags for synchronous process data */
@@ -663,13 +694,24 @@ void can_main_sync_send_process_data(void)
 			LI_CAN_SLV_DEBUG_PRINT("ctrl.send %08lx\n", can_main_sync_process_tx_data_ctrl.send);
 #endif /* #ifdef LI_CAN_SLV_DEBUG_MAIN_SYNC_PROCESS_TX_DATA */
 
+#ifdef LI_CAN_SLV_SYNC_FD
+			/* pack all transmit objects of the module into one frame, one slot of CAN_DLC_MAX bytes per object */
+			can_port_memory_set(data, 0x00, sizeof(data));
+			err = LI_CAN_SLV_ERR_OK;
+			for (i = 0; (i < can_config_module_tab[table_pos].tx_obj_sync) && (err == LI_CAN_SLV_ERR_OK); i++)
+			{
+				dlc = (uint16_t) can_config_module_tab[table_pos].tx_dlc[i];
+				err = can_sync_tx_data_main(table_pos, i, dlc, &data[i * CAN_DLC_MAX]);
+			}
+#else
 			/* call synchrony transmit routine of main CAN controller to prepare data to send via can, also capture data for monitor controller */
 			dlc = (uint16_t) can_config_module_tab[table_pos].tx_dlc[obj];
 			err = can_sync_tx_data_main(table_pos, obj, dlc, data);
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
 
 			if (err == LI_CAN_SLV_ERR_OK)
 			{
-				err = can_main_hw_send_msg(can_main_sync_process_tx_data_ctrl.id[table_pos][obj], can_main_sync_process_tx_data_ctrl.dlc[table_pos][obj], data);
+				err = can_main_hw_send_msg_class(CAN_MAIN_TX_CLASS_SYNC, can_main_sync_process_tx_data_ctrl.id[table_pos][obj], can_main_sync_process_tx_data_ctrl.dlc[table_pos][obj], data);
 			}
 			else
 			{
@@ -717,7 +759,11 @@ li_can_slv_errorcode_t can_main_define_msg_obj(uint16_t msg_obj, uint16_t can_id
 		return (ERR_MSG_CAN_DEFINE_OBJ_INVALID_ID);
 	}
 
+#ifdef LI_CAN_SLV_FD
+	if ((dlc < CAN_DLC_MIN) || (dlc > CAN_DLC_FD_MAX))
+#else
 	if ((dlc < CAN_DLC_MIN) || (dlc > CAN_DLC_MAX))
+#endif // #ifdef LI_CAN_SLV_FD
 	{
 		return (ERR_MSG_CAN_DEFINE_OBJ_INVALID_DLC);
 	}
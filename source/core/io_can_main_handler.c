@@ -103,10 +103,24 @@ uint8_t can_main_handler_tx(uint16_t caller_idx)
 
 #ifdef LI_CAN_SLV_ASYNC
 #if defined(OUTER) || defined(OUTER_APP)
+		/*----------------------------------------------------------------------*/
+		/* check if any asynchronous control data should be transmitted         */
+		/*----------------------------------------------------------------------*/
+		if (can_async_ctrl_tx_queue_state > 0)
+		{
+			err = can_async_handle_async_ctrl_tx_queue();
+#ifdef LI_CAN_SLV_SYS_MODULE_ERROR
+			if (err != LI_CAN_SLV_ERR_OK)
+			{
+				error_syserr_send(err, ERR_LVL_INFO,  can_config_get_module_nr_main(), ERR_LVL_INFO);
+			}
+#endif // #ifdef LI_CAN_SLV_SYS_MODULE_ERROR
+		}
+
 		/*----------------------------------------------------------------------*/
 		/* check if any asynchronous data should be transmitted                 */
 		/*----------------------------------------------------------------------*/
-		if (can_async_data_tx_queue_state > 0)
+		if (can_async_data_tx_queue_get_nr_of_objs() > 0)
 		{
 			err = can_async_handle_async_data_tx_queue();
 #ifdef LI_CAN_SLV_SYS_MODULE_ERROR
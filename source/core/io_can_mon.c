@@ -381,7 +381,11 @@ li_can_slv_errorcode_t can_mon_define_msg_obj(uint16_t msg_obj, uint16_t can_id,
 		return (ERR_MSG_CAN_DEFINE_OBJ_INVALID_ID);
 	}
 
+#ifdef LI_CAN_SLV_FD
+	if ((dlc < CAN_DLC_MIN) || (dlc > CAN_DLC_FD_MAX))
+#else
 	if ((dlc < CAN_DLC_MIN) || (dlc > CAN_DLC_MAX))
+#endif // #ifdef LI_CAN_SLV_FD
 	{
 		return (ERR_MSG_CAN_DEFINE_OBJ_INVALID_DLC);
 	}
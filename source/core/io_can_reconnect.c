@@ -115,6 +115,16 @@
 
 #include <li_can_slv/config/io_can_config.h>
 
+#ifdef LI_CAN_SLV_ASYNC
+#if defined(OUTER) || defined(OUTER_APP)
+#include <li_can_slv/async/io_can_async.h>
+#endif // #if defined(OUTER) || defined(OUTER_APP)
+#endif // #ifdef LI_CAN_SLV_ASYNC
+
+#ifdef LI_CAN_SLV_ANALYZER
+#include <li_can_slv/util/io_can_analyzer.h>
+#endif // #ifdef LI_CAN_SLV_ANALYZER
+
 #ifdef LI_CAN_SLV_DEBUG
 #include "li_can_slv_debug.h"
 #endif // #ifdef LI_CAN_SLV_DEBUG
@@ -804,12 +814,23 @@ static li_can_slv_errorcode_t can_reconnect_on(uint16_t id)
 
 	lcsa_set_state(LI_CAN_SLV_STATE_RECONNECT);
 
+#ifdef LI_CAN_SLV_ANALYZER
+	can_analyzer_trigger(CAN_ANALYZER_TRIGGER_RECONNECT);
+#endif // #ifdef LI_CAN_SLV_ANALYZER
+
 #ifdef LI_CAN_SLV_DEBUG_CAN_RECONNECT
 	LI_CAN_SLV_DEBUG_PRINT("cr on %d, %d\n", id, lcsa_get_baudrate());
 #endif // #ifdef LI_CAN_SLV_DEBUG_CAN_RECONNECT
 
 	can_reconnect.lec_cnt_bit0 = 0;
 	can_reconnect.id_on = id;
+
+#ifdef LI_CAN_SLV_ASYNC
+#if defined(OUTER) || defined(OUTER_APP)
+	// queued acknowledges and responses are outdated after the reconnect
+	can_async_ctrl_tx_queue_clear();
+#endif // #if defined(OUTER) || defined(OUTER_APP)
+#endif // #ifdef LI_CAN_SLV_ASYNC
 	switch (id)
 	{
 		case 1: /* li_can_slv_reconnect_startup */
@@ -892,6 +913,15 @@ static li_can_slv_errorcode_t can_reconnect_off(uint16_t id)
 	can_reconnect.state = CAN_RECONNECT_STATE_OFF;
 	can_reconnect.id_off = id;
 
+#ifdef LI_CAN_SLV_ASYNC
+#if defined(OUTER) || defined(OUTER_APP)
+	// restart the transmission of the asynchronous objects queued during the reconnect
+	CAN_PORT_DISABLE_IRQ();
+	can_port_trigger_can_main_async_data_tx_queue();
+	CAN_PORT_ENABLE_IRQ();
+#endif // #if defined(OUTER) || defined(OUTER_APP)
+#endif // #ifdef LI_CAN_SLV_ASYNC
+
 	// increment reconnect number
 	can_reconnect.nr++;
 
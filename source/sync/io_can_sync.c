@@ -52,6 +52,10 @@
 #include <li_can_slv/core/io_can_main.h>
 #include <li_can_slv/core/io_can_mon.h>
 
+#ifdef LI_CAN_SLV_ANALYZER
+#include <li_can_slv/util/io_can_analyzer.h>
+#endif // #ifdef LI_CAN_SLV_ANALYZER
+
 #ifdef SHOW_CAN_SYNC
 #include "io_var.h"
 #ifdef TESTSYS_SYSTEM
@@ -70,6 +74,12 @@
 /*--------------------------------------------------------------------------*/
 /* structure/type definitions (private/not exported)                        */
 /*--------------------------------------------------------------------------*/
+#ifdef LI_CAN_SLV_SYNC_FD
+/**
+ * @brief per object handler called for every object packed into one CAN FD frame
+ */
+typedef li_can_slv_errorcode_t (*can_sync_obj_fnc_t)(uint16_t table_pos, uint16_t can_id, uint16_t dlc, byte_t *can);
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
 
 /*--------------------------------------------------------------------------*/
 /* global variables (public/exported)                                       */
@@ -367,7 +377,11 @@ static const testsys_var_t can_sync_err_node_ab_testsys[] = /**< */
 /* function prototypes (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
 static void li_can_slv_sync_clear_process_image(void);
-static li_can_slv_errorcode_t li_can_slv_sync_check_process_image_module(uint16_t table_pos);
+static li_can_slv_errorcode_t li_can_slv_sync_check_process_image_module(uint16_t table_pos, uint32_t pr_ticks);
+
+#ifdef LI_CAN_SLV_SYNC_FD
+static li_can_slv_errorcode_t can_sync_data_fd(uint16_t table_pos, uint16_t can_id, uint16_t dlc, byte_t *can, byte_t nr_of_objs, const byte_t *dlc_sync, byte_t dlc_fd, can_sync_obj_fnc_t fnc, li_can_slv_errorcode_t err_dlc);
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
 
 #if LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 1
 static uint32_t can_sync_get_pr_time_valid_module1(void);
@@ -468,15 +482,18 @@ li_can_slv_errorcode_t can_sync_init(void)
 li_can_slv_errorcode_t can_sync_rx_process_main(uint16_t dlc, byte_t const *can)
 {
 	uint32_t tmp;
+	uint32_t rx_ticks;
 #ifdef CAN_MAIN_DIAGNOSE
 	can_main_diagnose.pr++;
 #endif // #ifdef CAN_MAIN_DIAGNOSE
 
 	can = can; // suppress warning
 
-	tmp = can_port_get_system_ticks() - can_sync.main_pr_timestamp;
+	// the period is measured between the receive times of the process requests
+	rx_ticks = can_rx_ticks_get(CAN_RX_NODE_MAIN);
+	tmp = rx_ticks - can_sync.main_pr_timestamp;
 	can_sync.pr_periode = can_port_ticks_2_msec(tmp);
-	can_sync.main_pr_timestamp = can_port_get_system_ticks();
+	can_sync.main_pr_timestamp = rx_ticks;
 
 	can_sync.main_pr_cnt_all++;
 	
@@ -600,6 +617,32 @@ li_can_slv_errorcode_t can_sync_rx_data_main(uint16_t table_pos, uint16_t can_id
 	return (err);
 }
 
+#ifdef LI_CAN_SLV_SYNC_FD
+/**
+ * @brief receive a CAN FD frame carrying all synchronous receive objects of a logical module
+ * @remarks The objects are packed in slots of #CAN_DLC_MAX bytes, each slot is passed to
+ * #can_sync_rx_data_main with the identifier and data length code of the object.
+ * @param table_pos is the position in the CAN configuration module table
+ * @param can_id is the 11bit CAN identifier of the CAN message (identifier of object 0)
+ * @param dlc is the payload length of the received frame
+ * @param[in] can is the data pointer of the used CAN message object
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_sync_rx_data_main_fd(uint16_t table_pos, uint16_t can_id, uint16_t dlc, byte_t *can)
+{
+#ifdef LI_CAN_SLV_MAIN_MON
+	if ((can_mainmon_type == CAN_MAINMON_TYPE_MON) && ((can_id & CAN_CONFIG_DATA_RX_MASK) != CAN_CONFIG_DATA_RX_MASK))
+	{
+		/* frame transmitted by the main CPU */
+		return can_sync_data_fd(table_pos, can_id, dlc, can, can_config_module_tab[table_pos].tx_obj, &can_config_module_tab[table_pos].tx_dlc_sync[0],
+		                        can_config_module_tab[table_pos].tx_dlc_fd, &can_sync_rx_data_main, ERR_MSG_CAN_MAIN_RX_WRONG_DLC);
+	}
+#endif // #ifdef LI_CAN_SLV_MAIN_MON
+	return can_sync_data_fd(table_pos, can_id, dlc, can, can_config_module_tab[table_pos].rx_obj, &can_config_module_tab[table_pos].rx_dlc_sync[0],
+	                        can_config_module_tab[table_pos].rx_dlc_fd, &can_sync_rx_data_main, ERR_MSG_CAN_MAIN_RX_WRONG_DLC);
+}
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
+
 /**
  * @brief synchronous data transmission to the master via main CAN-controller
  * @remarks The function has to be called by the process request the of master.\n
@@ -690,7 +733,7 @@ li_can_slv_errorcode_t can_sync_rx_process_mon(uint16_t dlc, byte_t const *can)
 
 	can = can; // suppress warning
 
-	can_sync.mon_pr_timestamp = can_port_get_system_ticks();
+	can_sync.mon_pr_timestamp = can_rx_ticks_get(CAN_RX_NODE_MON);
 
 	can_sync.mon_pr_cnt_all++;
     
@@ -904,6 +947,38 @@ li_can_slv_errorcode_t can_sync_tx_data_mon(uint16_t table_pos, uint16_t can_id,
 }
 #endif // #ifdef LI_CAN_SLV_MON
 
+#if defined(LI_CAN_SLV_MON) && defined(LI_CAN_SLV_SYNC_FD)
+/**
+ * @brief receive a CAN FD frame from the master via monitor CAN-controller
+ * @remarks see #can_sync_rx_data_main_fd, each slot is passed to #can_sync_rx_data_mon
+ * @param table_pos is the position in the CAN configuration module table
+ * @param can_id is the 11bit CAN identifier of the CAN message (identifier of object 0)
+ * @param dlc is the payload length of the received frame
+ * @param[in] can is the data pointer of the used CAN message object
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_sync_rx_data_mon_fd(uint16_t table_pos, uint16_t can_id, uint16_t dlc, byte_t *can)
+{
+	return can_sync_data_fd(table_pos, can_id, dlc, can, can_config_module_tab[table_pos].rx_obj, &can_config_module_tab[table_pos].rx_dlc_sync[0],
+	                        can_config_module_tab[table_pos].rx_dlc_fd, &can_sync_rx_data_mon, ERR_MSG_CAN_MON_RX_WRONG_DLC);
+}
+
+/**
+ * @brief check the CAN FD frame transmitted by the main CAN-controller via monitor CAN-controller
+ * @remarks see #can_sync_rx_data_main_fd, each slot is passed to #can_sync_tx_data_mon
+ * @param table_pos is the position in the CAN configuration module table
+ * @param can_id is the 11bit CAN identifier of the CAN message (identifier of object 0)
+ * @param dlc is the payload length of the received frame
+ * @param[in] can is the data pointer of the used CAN message object
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t can_sync_tx_data_mon_fd(uint16_t table_pos, uint16_t can_id, uint16_t dlc, byte_t *can)
+{
+	return can_sync_data_fd(table_pos, can_id, dlc, can, can_config_module_tab[table_pos].tx_obj, &can_config_module_tab[table_pos].tx_dlc_sync[0],
+	                        can_config_module_tab[table_pos].tx_dlc_fd, &can_sync_tx_data_mon, ERR_MSG_CAN_MON_TX_WRONG_DLC);
+}
+#endif // #if defined(LI_CAN_SLV_MON) && defined(LI_CAN_SLV_SYNC_FD)
+
 /**
  * @brief clear the synchronous receive data
  * @param table_pos module position
@@ -971,8 +1046,9 @@ li_can_slv_errorcode_t can_sync_clr_rx_data_main_mon(uint16_t table_pos)
  * of the received object via the monitor CAN-controller must be exactly the same.
  * 	- The contents of the transmitted data via main CAN-controller and then received by the monitor CAN-controller
  * (loop back) must be identical in consideration of the main TX-conversion-code and the monitor TX-conversion-code.\n
+ * @param pr_ticks receive time of the process request, taken as time stamp of a valid process image
  */
-void li_can_slv_sync_check_process_image(void)
+void li_can_slv_sync_check_process_image(uint32_t pr_ticks)
 {
 	li_can_slv_errorcode_t err;
 	uint16_t process_image_valid = 1;
@@ -1025,7 +1101,7 @@ void li_can_slv_sync_check_process_image(void)
 		// check the process image (rx/tx data of each used logical module
 		for (i = 0; i < can_config_nr_of_modules; i++)
 		{
-			err = li_can_slv_sync_check_process_image_module(i);
+			err = li_can_slv_sync_check_process_image_module(i, pr_ticks);
 			if (err != LI_CAN_SLV_ERR_OK)
 			{
 				li_can_sync_evaluate_error(i, err); /* TODO: check */
@@ -1034,6 +1110,9 @@ void li_can_slv_sync_check_process_image(void)
 			if (can_sync_error_flags[i] != LI_CAN_SLV_SYNC_ERR_FLAG_NO_ERR)
 			{
 				can_sync.image_valid[i] = FALSE;
+#ifdef LI_CAN_SLV_ANALYZER
+				can_analyzer_trigger(CAN_ANALYZER_TRIGGER_IMAGE_NOT_VALID);
+#endif // #ifdef LI_CAN_SLV_ANALYZER
 
 				// call the process call function if the image is not valid
 				if (can_sync_process_image_not_valid_cbk_table[i] != NULL)
@@ -1060,7 +1139,7 @@ void li_can_slv_sync_check_process_image(void)
 		// whole process image correct with all logical modules
 		if (process_image_valid == 1)
 		{
-			can_sync.pr_time_valid = can_port_get_system_ticks();
+			can_sync.pr_time_valid = pr_ticks;
 			if (can_sync_process_call != NULL)
 			{
 				can_sync_process_call();
@@ -1343,6 +1422,9 @@ void li_can_sync_evaluate_error(uint16_t table_pos, li_can_slv_errorcode_t err)
 			break;
 		case ERR_MSG_CAN_MAIN_MON_DATA_RX:
 			lcsa_err = LI_CAN_SLV_SYNC_ERR_FLAG_MAIN_MON_RX_DATA;
+#ifdef LI_CAN_SLV_ANALYZER
+			can_analyzer_trigger(CAN_ANALYZER_TRIGGER_MAIN_MON_DATA_RX);
+#endif // #ifdef LI_CAN_SLV_ANALYZER
 			break;
 		case ERR_MSG_CAN_MAIN_MON_DATA_TX:
 			lcsa_err = LI_CAN_SLV_SYNC_ERR_FLAG_MAIN_MON_TX_DATA;
@@ -1414,9 +1496,10 @@ static void li_can_slv_sync_clear_process_image(void)
  * @brief checks the process image of the logical module at the current table position.
  * @param table_pos is the position in the CAN configuration module table (maximum  defined
  * logical modules are #LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES)
+ * @param pr_ticks receive time of the process request
  * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
  */
-static li_can_slv_errorcode_t li_can_slv_sync_check_process_image_module(uint16_t table_pos)
+static li_can_slv_errorcode_t li_can_slv_sync_check_process_image_module(uint16_t table_pos, uint32_t pr_ticks)
 {
 	uint16_t i;
 
@@ -1510,7 +1593,7 @@ static li_can_slv_errorcode_t li_can_slv_sync_check_process_image_module(uint16_
 #endif // #ifdef LI_CAN_SLV_MON
 	}
 
-	can_sync.pr_time_valid_module[table_pos] = can_port_get_system_ticks();
+	can_sync.pr_time_valid_module[table_pos] = pr_ticks;
 	return (LI_CAN_SLV_ERR_OK);
 }
 
@@ -1602,4 +1685,40 @@ static uint32_t can_sync_get_pr_time_valid_module8(void)
 }
 #endif // #if LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES >= 8
 
+#ifdef LI_CAN_SLV_SYNC_FD
+/**
+ * @brief split a CAN FD frame into the objects of a logical module
+ * @param table_pos is the position in the CAN configuration module table
+ * @param can_id is the 11bit CAN identifier of object 0
+ * @param dlc is the payload length of the received frame
+ * @param[in] can is the data pointer of the received frame
+ * @param nr_of_objs number of objects packed into the frame
+ * @param dlc_sync data length codes of the packed objects
+ * @param dlc_fd expected payload length of the frame
+ * @param fnc handler called for each object
+ * @param err_dlc error returned on a wrong payload length
+ * @return #li_can_slv_errorcode_t or #LI_CAN_SLV_ERR_OK if successful
+ */
+static li_can_slv_errorcode_t can_sync_data_fd(uint16_t table_pos, uint16_t can_id, uint16_t dlc, byte_t *can, byte_t nr_of_objs, const byte_t *dlc_sync, byte_t dlc_fd, can_sync_obj_fnc_t fnc, li_can_slv_errorcode_t err_dlc)
+{
+	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
+	uint16_t obj;
+
+	if (can_config_module_sync_deactivated_tab[table_pos] != 0x00)
+	{
+		return (LI_CAN_SLV_ERR_OK);
+	}
+	if (dlc != dlc_fd)
+	{
+		return (err_dlc);
+	}
+
+	for (obj = 0; (obj < nr_of_objs) && (err == LI_CAN_SLV_ERR_OK); obj++)
+	{
+		err = fnc(table_pos, can_id + obj, dlc_sync[obj], &can[obj * CAN_DLC_MAX]);
+	}
+	return (err);
+}
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
+
 /** @} */
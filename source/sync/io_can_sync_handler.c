@@ -55,6 +55,14 @@
 #include <li_can_slv/arch/io_can_mon_hw_inline.h>
 #endif // #ifdef LI_CAN_SLV_MON
 
+#ifdef LI_CAN_SLV_TRAFFIC
+#include <li_can_slv/util/io_can_traffic.h>
+#endif // #ifdef LI_CAN_SLV_TRAFFIC
+
+#ifdef LI_CAN_SLV_ASYNC_ISOTP
+#include <li_can_slv/async/io_can_async_isotp.h>
+#endif // #ifdef LI_CAN_SLV_ASYNC_ISOTP
+
 #ifdef LI_CAN_SLV_DEBUG
 #include "li_can_slv_debug.h"
 #endif // #ifdef LI_CAN_SLV_DEBUG
@@ -110,6 +118,7 @@ uint8_t can_sync_handler_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid, uint8
 
 #if defined(OUTER) || defined(OUTER_APP)
 	uint16_t table_pos;
+	uint32_t pr_ticks;
 #ifdef LI_CAN_SLV_SYS_MODULE_ERROR
 	msg_code_t errnum;
 	err_prio_t priority;
@@ -147,7 +156,14 @@ uint8_t can_sync_handler_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid, uint8
 #endif // #ifdef LI_CAN_SLV_DEBUG_SYNC_RX_EXTENDED
 
 			// call synchrony receive routine of main CAN controller
+#ifdef LI_CAN_SLV_SYNC_FD
+			err = can_sync_rx_data_main_fd(table_pos, canid, dlc, data);
+#else
 			err = can_sync_rx_data_main(table_pos, canid, dlc, data);
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
+#ifdef LI_CAN_SLV_TRAFFIC
+			can_traffic_rx_sync(CAN_TRAFFIC_NODE_MAIN, table_pos, canid, ((err == LI_CAN_SLV_ERR_OK) && (can_config_module_sync_deactivated_tab[table_pos] != 0x00)) ? CAN_TRAFFIC_REASON_DEACTIVATED : can_traffic_reason(err));
+#endif // #ifdef LI_CAN_SLV_TRAFFIC
 			if (err != LI_CAN_SLV_ERR_OK)
 			{
 				li_can_sync_evaluate_error(table_pos, err);
@@ -166,6 +182,12 @@ uint8_t can_sync_handler_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid, uint8
 			LI_CAN_SLV_DEBUG_PRINT("\n");
 #endif // #ifdef LI_CAN_SLV_DEBUG_SYNC_RX_DATA
 		}
+#ifdef LI_CAN_SLV_TRAFFIC
+		else
+		{
+			can_traffic_rx(CAN_TRAFFIC_NODE_MAIN, canid, CAN_TRAFFIC_REASON_DROPPED);
+		}
+#endif // #ifdef LI_CAN_SLV_TRAFFIC
 
 #ifdef LI_CAN_SLV_DEBUG_SYNC_RX
 		LI_CAN_SLV_DEBUG_PRINT("\n\n");
@@ -184,8 +206,10 @@ uint8_t can_sync_handler_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid, uint8
 
 		msg_obj = CAN_CONFIG_MSG_MAIN_OBJ_RX_PROCESS;
 
+		// the receive time is taken before the callbacks of the application are called
+		pr_ticks = can_rx_ticks_get(CAN_RX_NODE_MAIN);
 		li_can_slv_sync_process_request_rx();
-		li_can_slv_sync_check_process_image();
+		li_can_slv_sync_check_process_image(pr_ticks);
 
 #ifdef LI_CAN_SLV_MAIN_MON
 		if (can_mainmon_type == CAN_MAINMON_TYPE_MAIN)
@@ -197,6 +221,9 @@ uint8_t can_sync_handler_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid, uint8
 #endif // #ifdef LI_CAN_SLV_MAIN_MON
 
 		can_sync_rx_process_main(dlc, data);
+#ifdef LI_CAN_SLV_TRAFFIC
+		can_traffic_rx(CAN_TRAFFIC_NODE_MAIN, canid, CAN_TRAFFIC_REASON_ACCEPTED);
+#endif // #ifdef LI_CAN_SLV_TRAFFIC
 
 #ifdef LI_CAN_SLV_SYS_MODULE_ERROR
 		// send system error if valid, one error per process, (sending only one error -> hold synchrony process)
@@ -241,6 +268,9 @@ uint8_t can_sync_handler_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid, uint8
 #endif // #if LI_CAN_SLV_DEBUG_MAIN_SYS_HANDLER_EXTENDED
 
 			err = can_sys_msg_rx(module_nr, dlc, data);
+#ifdef LI_CAN_SLV_TRAFFIC
+			can_traffic_rx(CAN_TRAFFIC_NODE_MAIN, canid, can_traffic_reason(err));
+#endif // #ifdef LI_CAN_SLV_TRAFFIC
 
 #ifdef LI_CAN_SLV_SYS_MODULE_ERROR
 			if (err != LI_CAN_SLV_ERR_OK)
@@ -270,7 +300,7 @@ uint8_t can_sync_handler_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid, uint8
 		// recalculate module_nr for ASYNC
 		module_nr = ((canid - CAN_CONFIG_ASYNC_CTRL_RX_SLAVE_ID) >> 2) + 1;
 
-		err = can_async_send_data_to_async_ctrl_rx_queue(module_nr, data);
+		err = can_async_send_data_to_async_ctrl_rx_queue(module_nr, dlc, data);
 
 #ifdef LI_CAN_SLV_SYS_MODULE_ERROR
 		if (err != LI_CAN_SLV_ERR_OK)
@@ -287,6 +317,14 @@ uint8_t can_sync_handler_rx(uint16_t msg_obj, uint8_t dlc, uint16_t canid, uint8
 	// process partly filled async tx data objects for a timed sending
 	can_async_tunnel_process_tx_data();
 #endif // #if defined(LI_CAN_SLV_ASYNC_TUNNEL)
+#ifdef LI_CAN_SLV_ASYNC_ISOTP
+	// send ISO-TP flow control and consecutive frames
+	(void) can_async_isotp_process();
+#endif // #ifdef LI_CAN_SLV_ASYNC_ISOTP
+#ifdef CAN_ASYNC_TX_SHAPER
+	// send the objects held back by the asynchronous transmit shaper
+	can_async_tx_shaper_process();
+#endif // #ifdef CAN_ASYNC_TX_SHAPER
 #endif // #ifdef LI_CAN_SLV_ASYNC
 #endif // #if defined(OUTER) || defined(OUTER_APP)
 	return 0;
@@ -334,7 +372,14 @@ uint8_t can_sync_handler_rx_mon(uint16_t msg_obj, uint8_t dlc, uint16_t canid, u
 #endif // #ifdef LI_CAN_SLV_DEBUG_MON_SYNC_RX_EXTENDED
 
 			// call synchronous receive routine of don CAN controller
+#ifdef LI_CAN_SLV_SYNC_FD
+			err = can_sync_rx_data_mon_fd(table_pos, canid, dlc, data);
+#else
 			err = can_sync_rx_data_mon(table_pos, canid, dlc, data);
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
+#ifdef LI_CAN_SLV_TRAFFIC
+			can_traffic_rx_sync(CAN_TRAFFIC_NODE_MON, table_pos, canid, ((err == LI_CAN_SLV_ERR_OK) && (can_config_module_sync_deactivated_tab[table_pos] != 0x00)) ? CAN_TRAFFIC_REASON_DEACTIVATED : can_traffic_reason(err));
+#endif // #ifdef LI_CAN_SLV_TRAFFIC
 			if (err != LI_CAN_SLV_ERR_OK)
 			{
 				li_can_sync_evaluate_error(table_pos, err);
@@ -349,6 +394,12 @@ uint8_t can_sync_handler_rx_mon(uint16_t msg_obj, uint8_t dlc, uint16_t canid, u
 			LI_CAN_SLV_DEBUG_PRINT("\n");
 #endif // #ifdef LI_CAN_SLV_DEBUG_MON_SYNC_RX_DATA
 		}
+#ifdef LI_CAN_SLV_TRAFFIC
+		else
+		{
+			can_traffic_rx(CAN_TRAFFIC_NODE_MON, canid, CAN_TRAFFIC_REASON_DROPPED);
+		}
+#endif // #ifdef LI_CAN_SLV_TRAFFIC
 
 #ifdef LI_CAN_SLV_DEBUG_MON_SYNC_RX
 		LI_CAN_SLV_DEBUG_PRINT("\n");
@@ -376,7 +427,14 @@ uint8_t can_sync_handler_rx_mon(uint16_t msg_obj, uint8_t dlc, uint16_t canid, u
 #endif // #ifdef LI_CAN_SLV_DEBUG_MON_SYNC_RX_FROM_MAIN_EXTENDED
 
 			// call synchrony receive routine of mon CAN controller
+#ifdef LI_CAN_SLV_SYNC_FD
+			err = can_sync_tx_data_mon_fd(table_pos, canid, dlc, data);
+#else
 			err = can_sync_tx_data_mon(table_pos, canid, dlc, data);
+#endif // #ifdef LI_CAN_SLV_SYNC_FD
+#ifdef LI_CAN_SLV_TRAFFIC
+			can_traffic_rx_sync(CAN_TRAFFIC_NODE_MON, table_pos, canid, can_traffic_reason(err));
+#endif // #ifdef LI_CAN_SLV_TRAFFIC
 			if (err != LI_CAN_SLV_ERR_OK)
 			{
 				li_can_sync_evaluate_error(table_pos, err);
@@ -391,6 +449,12 @@ uint8_t can_sync_handler_rx_mon(uint16_t msg_obj, uint8_t dlc, uint16_t canid, u
 			LI_CAN_SLV_DEBUG_PRINT("\n");
 #endif // #ifdef LI_CAN_SLV_DEBUG_MON_SYNC_RX_FROM_MAIN_DATA
 		}
+#ifdef LI_CAN_SLV_TRAFFIC
+		else
+		{
+			can_traffic_rx(CAN_TRAFFIC_NODE_MON, canid, CAN_TRAFFIC_REASON_DROPPED);
+		}
+#endif // #ifdef LI_CAN_SLV_TRAFFIC
 	}
 #endif // #ifndef CAN_NODE_B_USED_FOR_RECONNECT_ONLY
 
@@ -415,8 +479,11 @@ uint8_t can_sync_handler_rx_mon(uint16_t msg_obj, uint8_t dlc, uint16_t canid, u
 #endif // #ifdef LI_CAN_SLV_DEBUG_MON_PROCESS_HANDLER
 
 #ifndef CAN_NODE_B_USED_FOR_RECONNECT_ONLY
-		li_can_slv_sync_check_process_image();
+		li_can_slv_sync_check_process_image(can_rx_ticks_get(CAN_RX_NODE_MON));
 		can_sync_rx_process_mon(dlc, data);
+#ifdef LI_CAN_SLV_TRAFFIC
+		can_traffic_rx(CAN_TRAFFIC_NODE_MON, canid, CAN_TRAFFIC_REASON_ACCEPTED);
+#endif // #ifdef LI_CAN_SLV_TRAFFIC
 #endif // #ifndef CAN_NODE_B_USED_FOR_RECONNECT_ONLY
 
 #ifdef LI_CAN_SLV_DEBUG_MON_PROCESS_HANDLER
@@ -21,6 +21,23 @@
 /*!
  * \remarks CAN analyzer\n
  * - <b>initialization</b>\n
+ * With initialization the analyzer is switched off and the trace is cleared.
+ *
+ * - <b>recording</b>\n
+ * After can_analyzer_start() every message received on the main and monitor CAN-controller and every message
+ * transmitted on the main CAN-controller is recorded with its time stamp, direction and CAN-controller in a ring of
+ * #LI_CAN_SLV_ANALYZER_SIZE entries. The oldest entries are overwritten, so the ring always holds the pre trigger window.
+ *
+ * - <b>trigger</b>\n
+ * The stack reports an invalid process image, different received data on main and monitor
+ * (ERR_MSG_CAN_MAIN_MON_DATA_RX) and the start of a reconnect as trigger, the application could trigger with
+ * #CAN_ANALYZER_TRIGGER_USER. After a trigger of the trigger mask #LI_CAN_SLV_ANALYZER_POST_TRIGGER further messages are
+ * recorded (post trigger window), then the recording stops.
+ *
+ * - <b>readout</b>\n
+ * A stopped trace is frozen and could be read entry by entry without locking. Recording messages only reserves the
+ * entry with disabled interrupts, the copy of the message is done with enabled interrupts. So the trace should be read
+ * from the context of li_can_slv_process() or the transmitting task.
  */
 
 /**
@@ -34,10 +51,30 @@
 /* include files                                                            */
 /*--------------------------------------------------------------------------*/
 #include <li_can_slv/util/io_can_analyzer.h>
+#include <li_can_slv/error/io_can_errno.h>
+
+#include "io_can_port.h"
 
 /*--------------------------------------------------------------------------*/
 /* general definitions (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
+#ifndef LI_CAN_SLV_ANALYZER_SIZE
+#define LI_CAN_SLV_ANALYZER_SIZE	(64)
+#endif // #ifndef LI_CAN_SLV_ANALYZER_SIZE
+
+#ifndef LI_CAN_SLV_ANALYZER_POST_TRIGGER
+#define LI_CAN_SLV_ANALYZER_POST_TRIGGER	(LI_CAN_SLV_ANALYZER_SIZE / 2)
+#endif // #ifndef LI_CAN_SLV_ANALYZER_POST_TRIGGER
+
+#if ((LI_CAN_SLV_ANALYZER_SIZE & (LI_CAN_SLV_ANALYZER_SIZE - 1)) != 0) || (LI_CAN_SLV_ANALYZER_SIZE > 0x8000)
+#error LI_CAN_SLV_ANALYZER_SIZE must be a power of two up to 0x8000
+#endif
+
+#if (LI_CAN_SLV_ANALYZER_POST_TRIGGER > LI_CAN_SLV_ANALYZER_SIZE)
+#error LI_CAN_SLV_ANALYZER_POST_TRIGGER must not exceed LI_CAN_SLV_ANALYZER_SIZE
+#endif
+
+#define CAN_ANALYZER_MASK	(LI_CAN_SLV_ANALYZER_SIZE - 1) /**< */
 
 /*--------------------------------------------------------------------------*/
 /* structure/type definitions (private/not exported)                        */
@@ -50,16 +87,200 @@
 /*--------------------------------------------------------------------------*/
 /* global variables (private/not exported)                                  */
 /*--------------------------------------------------------------------------*/
+static can_analyzer_entry_t can_analyzer_ring[LI_CAN_SLV_ANALYZER_SIZE]; /**< */
+static volatile can_analyzer_state_t can_analyzer_state = CAN_ANALYZER_STATE_OFF; /**< */
+static volatile uint16_t can_analyzer_head; /**< free running number of the next entry */
+static volatile uint16_t can_analyzer_cnt; /**< number of recorded entries, limited to the ring size */
+static volatile uint16_t can_analyzer_post_cnt; /**< remaining entries of the post trigger window */
+static uint16_t can_analyzer_trigger_mask; /**< */
+static uint16_t can_analyzer_trigger_source; /**< */
+static uint16_t can_analyzer_trigger_head; /**< number of the first entry after the trigger */
 
 /*--------------------------------------------------------------------------*/
 /* function prototypes (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
+static void can_analyzer_record(uint8_t flags, uint16_t canid, uint16_t dlc, const volatile uint8_t *data);
 
 /*--------------------------------------------------------------------------*/
 /* function definition (public/exported)                                    */
 /*--------------------------------------------------------------------------*/
+li_can_slv_errorcode_t can_analyzer_init(void)
+{
+	li_can_slv_port_disable_irq();
+	can_analyzer_state = CAN_ANALYZER_STATE_OFF;
+	can_analyzer_head = 0;
+	can_analyzer_cnt = 0;
+	can_analyzer_post_cnt = 0;
+	can_analyzer_trigger_mask = 0;
+	can_analyzer_trigger_source = 0;
+	can_analyzer_trigger_head = 0;
+	li_can_slv_port_enable_irq();
+
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+li_can_slv_errorcode_t can_analyzer_start(uint16_t trigger_mask)
+{
+	li_can_slv_port_disable_irq();
+	can_analyzer_head = 0;
+	can_analyzer_cnt = 0;
+	can_analyzer_post_cnt = 0;
+	can_analyzer_trigger_mask = trigger_mask;
+	can_analyzer_trigger_source = 0;
+	can_analyzer_trigger_head = 0;
+	can_analyzer_state = CAN_ANALYZER_STATE_ARMED;
+	li_can_slv_port_enable_irq();
+
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+li_can_slv_errorcode_t can_analyzer_stop(void)
+{
+	li_can_slv_port_disable_irq();
+	if (can_analyzer_state != CAN_ANALYZER_STATE_OFF)
+	{
+		if (can_analyzer_state == CAN_ANALYZER_STATE_ARMED)
+		{
+			can_analyzer_trigger_head = can_analyzer_head;
+		}
+		can_analyzer_state = CAN_ANALYZER_STATE_STOPPED;
+	}
+	li_can_slv_port_enable_irq();
+
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+void can_analyzer_trigger(uint16_t source)
+{
+	li_can_slv_port_disable_irq();
+	if ((can_analyzer_state == CAN_ANALYZER_STATE_ARMED) && ((can_analyzer_trigger_mask & source) != 0))
+	{
+		can_analyzer_trigger_source = source;
+		can_analyzer_trigger_head = can_analyzer_head;
+		can_analyzer_post_cnt = LI_CAN_SLV_ANALYZER_POST_TRIGGER;
+		if (can_analyzer_post_cnt == 0)
+		{
+			can_analyzer_state = CAN_ANALYZER_STATE_STOPPED;
+		}
+		else
+		{
+			can_analyzer_state = CAN_ANALYZER_STATE_TRIGGERED;
+		}
+	}
+	li_can_slv_port_enable_irq();
+}
+
+void can_analyzer_rx(uint16_t node, uint16_t canid, uint16_t dlc, const volatile uint8_t *data)
+{
+	can_analyzer_record((node == CAN_ANALYZER_NODE_MON) ? CAN_ANALYZER_FLAG_MON : 0, canid, dlc, data);
+}
+
+void can_analyzer_tx(uint16_t node, uint16_t canid, uint16_t dlc, const volatile uint8_t *data)
+{
+	can_analyzer_record((node == CAN_ANALYZER_NODE_MON) ? (CAN_ANALYZER_FLAG_TX | CAN_ANALYZER_FLAG_MON) : CAN_ANALYZER_FLAG_TX, canid, dlc, data);
+}
+
+can_analyzer_state_t can_analyzer_get_state(void)
+{
+	return (can_analyzer_state);
+}
+
+li_can_slv_errorcode_t can_analyzer_get_trigger(uint16_t *source, uint16_t *entry_nr)
+{
+	if (can_analyzer_state != CAN_ANALYZER_STATE_STOPPED)
+	{
+		return (ERR_MSG_CAN_ANALYZER_NOT_STOPPED);
+	}
+
+	*source = can_analyzer_trigger_source;
+	*entry_nr = (uint16_t)(can_analyzer_trigger_head - (uint16_t)(can_analyzer_head - can_analyzer_cnt));
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+li_can_slv_errorcode_t can_analyzer_get_nr_of_entries(uint16_t *nr_of_entries)
+{
+	if (can_analyzer_state != CAN_ANALYZER_STATE_STOPPED)
+	{
+		return (ERR_MSG_CAN_ANALYZER_NOT_STOPPED);
+	}
+
+	*nr_of_entries = can_analyzer_cnt;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+li_can_slv_errorcode_t can_analyzer_read(uint16_t entry_nr, can_analyzer_entry_t *entry)
+{
+	uint16_t idx;
+
+	if (can_analyzer_state != CAN_ANALYZER_STATE_STOPPED)
+	{
+		return (ERR_MSG_CAN_ANALYZER_NOT_STOPPED);
+	}
+
+	if (entry_nr >= can_analyzer_cnt)
+	{
+		return (ERR_MSG_CAN_ANALYZER_NO_ENTRY);
+	}
+
+	idx = (uint16_t)(can_analyzer_head - can_analyzer_cnt + entry_nr) & CAN_ANALYZER_MASK;
+	can_port_memory_cpy(entry, &can_analyzer_ring[idx], sizeof(can_analyzer_entry_t));
+	return (LI_CAN_SLV_ERR_OK);
+}
 
 /*--------------------------------------------------------------------------*/
 /* function definition (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
+/**
+ * @brief records one message, called from the receive handlers and the transmit path
+ * @param flags #CAN_ANALYZER_FLAG_TX, #CAN_ANALYZER_FLAG_MON
+ * @param canid CAN identifier
+ * @param dlc number of data bytes
+ * @param data data of the message
+ */
+static void can_analyzer_record(uint8_t flags, uint16_t canid, uint16_t dlc, const volatile uint8_t *data)
+{
+	can_analyzer_entry_t *entry;
+	uint16_t len;
+	uint16_t i;
+
+	// cheap check without locking, the analyzer is usually armed or stopped
+	if ((can_analyzer_state != CAN_ANALYZER_STATE_ARMED) && (can_analyzer_state != CAN_ANALYZER_STATE_TRIGGERED))
+	{
+		return;
+	}
+
+	// reserve the entry
+	li_can_slv_port_disable_irq();
+	if ((can_analyzer_state != CAN_ANALYZER_STATE_ARMED) && (can_analyzer_state != CAN_ANALYZER_STATE_TRIGGERED))
+	{
+		li_can_slv_port_enable_irq();
+		return;
+	}
+	entry = &can_analyzer_ring[can_analyzer_head & CAN_ANALYZER_MASK];
+	can_analyzer_head++;
+	if (can_analyzer_cnt < LI_CAN_SLV_ANALYZER_SIZE)
+	{
+		can_analyzer_cnt++;
+	}
+	if (can_analyzer_state == CAN_ANALYZER_STATE_TRIGGERED)
+	{
+		can_analyzer_post_cnt--;
+		if (can_analyzer_post_cnt == 0)
+		{
+			// the last entry of the post trigger window freezes the trace
+			can_analyzer_state = CAN_ANALYZER_STATE_STOPPED;
+		}
+	}
+	li_can_slv_port_enable_irq();
+
+	entry->time = can_port_get_system_ticks();
+	entry->canid = canid;
+	entry->dlc = (uint8_t)dlc;
+	entry->flags = flags;
+	len = (dlc > CAN_ANALYZER_DATA_SIZE) ? CAN_ANALYZER_DATA_SIZE : dlc;
+	for (i = 0; i < len; i++)
+	{
+		entry->data[i] = data[i];
+	}
+}
 /** @} */
@@ -34,8 +34,17 @@
  \arg	crc error counter\n\n
 
  - <b>message and byte counters</b>\n
- With every received CAN message a message counter is incremented. Also the DLC of the\n
- CAN message is calculate and increments the byte counter by its value.
+ With every received and transmitted CAN message a message counter is incremented. Also the DLC of the\n
+ CAN message is calculate and increments the byte counter by its value. The counters are kept separately\n
+ for the main and the monitor CAN-controller.
+
+ - <b>node load</b>\n
+ Every counted message adds its length in bits to the quality window. The length includes the worst case\n
+ number of stuff bits, the data phase of CAN FD frames is scaled to the nominal bit time. The node load\n
+ (0 to 1000 per mill) is the sum of the bits in the quality window related to the bits the current baud\n
+ rate can transfer in the window. Only messages received by the message objects of the node (i.e. passing\n
+ the acceptance filters) and messages transmitted by the node are counted, so the node load is a lower\n
+ bound of the bus load and not the load of the whole bus.
 
  - <b>quality</b>\n
  With the knowledge of LEC counters and the successfully transmitted messages a\n
@@ -46,7 +55,8 @@
  The current quality (0 to 1000 per mill) gives the quality of the CAN line at the moment.\n
  To calculate the current quality the LECs and the successfully transmitted messages are counted\n
  in a defined time (quality window). The current quality represents the CAN quality of the CAN\n
- line in the time slot.
+ line in the time slot. The quality window (#LI_CAN_SLV_QUALITY_WINDOW_MS) is divided into\n
+ #CAN_QUALITY_NR_OF_SLOTS slots and moved slot by slot from can_quality_process().
 
  - <b>CAN error warning</b>\n
  A reconnect routine is starting. See therefore io_can_reconnect.
@@ -65,35 +75,52 @@
 /* include files                                                            */
 /*--------------------------------------------------------------------------*/
 #include <li_can_slv/util/io_can_quality.h>
+#include <li_can_slv/config/io_can_config.h>
 #include <li_can_slv/error/io_can_errno.h>
 
+#include "io_can_port.h"
+
 /*--------------------------------------------------------------------------*/
 /* general definitions (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
-#define CAN_MAIN_NR_OF_LEC	6 /**< */
+#ifndef LI_CAN_SLV_QUALITY_WINDOW_MS
+#define LI_CAN_SLV_QUALITY_WINDOW_MS	(1000)
+#endif // #ifndef LI_CAN_SLV_QUALITY_WINDOW_MS
+
+#ifndef LI_CAN_SLV_QUALITY_FD_BITRATE_FACTOR
+#define LI_CAN_SLV_QUALITY_FD_BITRATE_FACTOR	(4)
+#endif // #ifndef LI_CAN_SLV_QUALITY_FD_BITRATE_FACTOR
+
+#define CAN_QUALITY_NR_OF_SLOTS	8 /**< number of slots of the quality window */
+#define CAN_QUALITY_SLOT_MS	(LI_CAN_SLV_QUALITY_WINDOW_MS / CAN_QUALITY_NR_OF_SLOTS) /**< length of one slot in ms */
+
+#define CAN_QUALITY_PER_MILL	(1000u) /**< */
+#define CAN_QUALITY_PER_MILL_MAX_BASE	(0x00400000uL) /**< largest base which could be multiplied by #CAN_QUALITY_PER_MILL */
+
+#define CAN_QUALITY_FRAME_STUFFED_BITS	34 /**< SOF up to the CRC of a classic frame without data, subject to bit stuffing */
+#define CAN_QUALITY_FRAME_TRAILER_BITS	13 /**< CRC delimiter, ACK, ACK delimiter, EOF and intermission */
+#define CAN_QUALITY_FD_ARBITRATION_BITS	17 /**< SOF up to BRS of a CAN FD frame, subject to bit stuffing */
+#define CAN_QUALITY_FD_CONTROL_BITS	5 /**< ESI and DLC of a CAN FD frame, subject to bit stuffing */
+#define CAN_QUALITY_FD_CRC17_BITS	27 /**< stuff count and CRC 17 including the fixed stuff bits */
+#define CAN_QUALITY_FD_CRC21_BITS	32 /**< stuff count and CRC 21 including the fixed stuff bits */
 
 /*--------------------------------------------------------------------------*/
 /* structure/type definitions (private/not exported)                        */
 /*--------------------------------------------------------------------------*/
-
 /**
- * @brief can_quality structure
- * @struct can_quality_t
+ * @brief quality measurement of one CAN node
+ * @struct can_quality_node_t
  */
 typedef struct
 {
-	uint32_t msg_cnt; /**< */
-	uint32_t byte_cnt; /**< */
-	uint32_t cnt_lec[CAN_MAIN_NR_OF_LEC]; /**< */
-	/* 0...stuff       */
-	/* 1...form        */
-	/* 2...acknowledge */
-	/* 3...bit1        */
-	/* 4...bit0        */
-	/* 5...crc         */
-	uint16_t current_quality; /**< */
-	uint16_t quality; /**< */
-} can_quality_t;
+	can_quality_t statistic; /**< counters and calculated values */
+	uint32_t bits; /**< bits counted since the last slot change */
+	uint32_t msgs; /**< messages counted since the last slot change */
+	uint32_t errs; /**< errors counted since the last slot change */
+	uint32_t slot_bits[CAN_QUALITY_NR_OF_SLOTS]; /**< bits of the finished slots */
+	uint32_t slot_msgs[CAN_QUALITY_NR_OF_SLOTS]; /**< messages of the finished slots */
+	uint32_t slot_errs[CAN_QUALITY_NR_OF_SLOTS]; /**< errors of the finished slots */
+} can_quality_node_t;
 
 /*--------------------------------------------------------------------------*/
 /* global variables (public/exported)                                       */
@@ -102,43 +129,267 @@ typedef struct
 /*--------------------------------------------------------------------------*/
 /* global variables (private/not exported)                                  */
 /*--------------------------------------------------------------------------*/
-//static can_quality_t can_quality; /**< */
+static can_quality_node_t can_quality[CAN_QUALITY_NR_OF_NODES]; /**< */
+static uint16_t can_quality_slot; /**< next slot of the quality window */
+static uint32_t can_quality_slot_tick; /**< start of the current slot */
 
 /*--------------------------------------------------------------------------*/
 /* function prototypes (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
+static uint16_t can_quality_frame_bits(uint16_t dlc);
+static uint16_t can_quality_per_mill(uint32_t part, uint32_t base);
+static void can_quality_node_process(can_quality_node_t *q, uint16_t nr_of_slots, uint32_t capacity);
 
 /*--------------------------------------------------------------------------*/
 /* function definition (public/exported)                                    */
 /*--------------------------------------------------------------------------*/
 li_can_slv_errorcode_t can_quality_init(void)
 {
-	return (ERR_MSG_CAN_NOT_IMPLEMENTED);
+	uint16_t node;
+
+	li_can_slv_port_disable_irq();
+	can_port_memory_set(&can_quality[0], 0x00, sizeof(can_quality));
+	for (node = 0; node < CAN_QUALITY_NR_OF_NODES; node++)
+	{
+		can_quality[node].statistic.current_quality = CAN_QUALITY_PER_MILL;
+		can_quality[node].statistic.quality = CAN_QUALITY_PER_MILL;
+	}
+	can_quality_slot = 0;
+	can_quality_slot_tick = can_port_get_system_ticks();
+	li_can_slv_port_enable_irq();
+
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+void can_quality_rx(uint16_t node, uint16_t dlc)
+{
+	if (node < CAN_QUALITY_NR_OF_NODES)
+	{
+		can_quality[node].statistic.rx_msg_cnt++;
+		can_quality[node].statistic.rx_byte_cnt += dlc;
+		can_quality[node].bits += can_quality_frame_bits(dlc);
+		can_quality[node].msgs++;
+	}
+}
+
+void can_quality_tx(uint16_t node, uint16_t dlc)
+{
+	if (node < CAN_QUALITY_NR_OF_NODES)
+	{
+		can_quality[node].statistic.tx_msg_cnt++;
+		can_quality[node].statistic.tx_byte_cnt += dlc;
+		can_quality[node].bits += can_quality_frame_bits(dlc);
+		can_quality[node].msgs++;
+	}
 }
 
-li_can_slv_errorcode_t can_quality_process(uint16_t obj_nr, uint16_t interrupt_id, uint16_t can_status)
+void can_quality_lec(uint16_t node, uint16_t lec)
 {
-	obj_nr = obj_nr;
-	interrupt_id = interrupt_id;
-	can_status = can_status;
+	if ((node < CAN_QUALITY_NR_OF_NODES) && (lec < CAN_QUALITY_NR_OF_LEC))
+	{
+		can_quality[node].statistic.cnt_lec[lec]++;
+		can_quality[node].errs++;
+	}
+}
+
+li_can_slv_errorcode_t can_quality_process(void)
+{
+	uint32_t tick;
+	uint32_t slot_ticks;
+	uint32_t elapsed;
+	uint16_t nr_of_slots;
+	uint16_t node;
+	can_config_bdr_t baudrate;
+
+	slot_ticks = can_port_msec_2_ticks(CAN_QUALITY_SLOT_MS);
+	tick = can_port_get_system_ticks();
+	elapsed = (uint32_t)(tick - can_quality_slot_tick);
+	if ((slot_ticks == 0) || (elapsed < slot_ticks))
+	{
+		return (LI_CAN_SLV_ERR_OK);
+	}
+
+	// process calls may be delayed, the slots without a call are taken as idle
+	if (elapsed >= (slot_ticks * CAN_QUALITY_NR_OF_SLOTS))
+	{
+		nr_of_slots = CAN_QUALITY_NR_OF_SLOTS;
+		can_quality_slot_tick = tick;
+	}
+	else
+	{
+		nr_of_slots = (uint16_t)(elapsed / slot_ticks);
+		can_quality_slot_tick += (uint32_t)nr_of_slots * slot_ticks;
+	}
+
+	// the baud rate is given in kBaud which is the number of bits per ms
+	(void) can_config_get_baudrate(&baudrate);
+
+	for (node = 0; node < CAN_QUALITY_NR_OF_NODES; node++)
+	{
+		can_quality_node_process(&can_quality[node], nr_of_slots, (uint32_t)baudrate * LI_CAN_SLV_QUALITY_WINDOW_MS);
+	}
+
+	can_quality_slot = (uint16_t)((can_quality_slot + nr_of_slots) % CAN_QUALITY_NR_OF_SLOTS);
 
-	return (ERR_MSG_CAN_NOT_IMPLEMENTED);
+	return (LI_CAN_SLV_ERR_OK);
 }
 
 li_can_slv_errorcode_t can_quality_current_get(uint16_t *current_quality)
 {
-	current_quality = current_quality;
-	return (ERR_MSG_CAN_NOT_IMPLEMENTED);
+	*current_quality = can_quality[CAN_QUALITY_NODE_MAIN].statistic.current_quality;
+	return (LI_CAN_SLV_ERR_OK);
 }
 
 li_can_slv_errorcode_t can_quality_get(uint16_t *quality)
 {
-	quality = quality;
-	return (ERR_MSG_CAN_NOT_IMPLEMENTED);
+	*quality = can_quality[CAN_QUALITY_NODE_MAIN].statistic.quality;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+li_can_slv_errorcode_t can_quality_node_load_get(uint16_t node, uint16_t *node_load)
+{
+	if (node >= CAN_QUALITY_NR_OF_NODES)
+	{
+		return (ERR_MSG_CAN_QUALITY_INVALID_NODE);
+	}
+
+	*node_load = can_quality[node].statistic.node_load;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+li_can_slv_errorcode_t can_quality_statistic_get(uint16_t node, can_quality_t *statistic)
+{
+	if (node >= CAN_QUALITY_NR_OF_NODES)
+	{
+		return (ERR_MSG_CAN_QUALITY_INVALID_NODE);
+	}
+
+	li_can_slv_port_disable_irq();
+	can_port_memory_cpy(statistic, &can_quality[node].statistic, sizeof(can_quality_t));
+	li_can_slv_port_enable_irq();
+
+	return (LI_CAN_SLV_ERR_OK);
 }
 
 /*--------------------------------------------------------------------------*/
 /* function definition (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
-/** @} */
+/**
+ * @brief length of a frame with standard identifier in nominal bit times including the worst case number of stuff bits
+ * @param dlc number of data bytes
+ * @return length in bits
+ */
+static uint16_t can_quality_frame_bits(uint16_t dlc)
+{
+	uint16_t bits;
+#ifdef LI_CAN_SLV_FD
+	uint16_t data_bits;
+#endif // #ifdef LI_CAN_SLV_FD
+
+#ifdef LI_CAN_SLV_FD
+	if (dlc > CAN_DLC_MAX)
+	{
+		bits = CAN_QUALITY_FD_ARBITRATION_BITS;
+		bits += (bits - 1u) / 4u;
+		bits += CAN_QUALITY_FRAME_TRAILER_BITS;
+
+		data_bits = CAN_QUALITY_FD_CONTROL_BITS + (8u * dlc);
+		data_bits += (data_bits - 1u) / 4u;
+		data_bits += (dlc > 16u) ? CAN_QUALITY_FD_CRC21_BITS : CAN_QUALITY_FD_CRC17_BITS;
+
+		// the data phase is transmitted with the data bit rate
+		bits += (data_bits + (LI_CAN_SLV_QUALITY_FD_BITRATE_FACTOR - 1u)) / LI_CAN_SLV_QUALITY_FD_BITRATE_FACTOR;
+		return (bits);
+	}
+#endif // #ifdef LI_CAN_SLV_FD
+
+	bits = CAN_QUALITY_FRAME_STUFFED_BITS + (8u * dlc);
+	bits += (bits - 1u) / 4u;
+	bits += CAN_QUALITY_FRAME_TRAILER_BITS;
+	return (bits);
+}
+
+/**
+ * @brief calculates part related to base in per mill, large values are scaled down to prevent an overflow
+ * @param part
+ * @param base
+ * @return per mill limited to 1000
+ */
+static uint16_t can_quality_per_mill(uint32_t part, uint32_t base)
+{
+	if (base == 0)
+	{
+		return (0);
+	}
 
+	if (part >= base)
+	{
+		return (CAN_QUALITY_PER_MILL);
+	}
+
+	while (base >= CAN_QUALITY_PER_MILL_MAX_BASE)
+	{
+		part >>= 1;
+		base >>= 1;
+	}
+
+	return ((uint16_t)((part * CAN_QUALITY_PER_MILL) / base));
+}
+
+/**
+ * @brief finishes the current slot of a node and calculates node load and quality of the node
+ * @param q quality measurement of the node
+ * @param nr_of_slots number of elapsed slots
+ * @param capacity number of bits the current baud rate can transfer in the quality window
+ */
+static void can_quality_node_process(can_quality_node_t *q, uint16_t nr_of_slots, uint32_t capacity)
+{
+	uint16_t slot;
+	uint16_t i;
+	uint32_t bits;
+	uint32_t msgs;
+	uint32_t errs;
+	uint32_t msg_cnt;
+	uint32_t err_cnt;
+
+	slot = can_quality_slot;
+
+	li_can_slv_port_disable_irq();
+	q->slot_bits[slot] = q->bits;
+	q->slot_msgs[slot] = q->msgs;
+	q->slot_errs[slot] = q->errs;
+	q->bits = 0;
+	q->msgs = 0;
+	q->errs = 0;
+	msg_cnt = q->statistic.rx_msg_cnt + q->statistic.tx_msg_cnt;
+	err_cnt = 0;
+	for (i = 0; i < CAN_QUALITY_NR_OF_LEC; i++)
+	{
+		err_cnt += q->statistic.cnt_lec[i];
+	}
+	li_can_slv_port_enable_irq();
+
+	// skipped slots are idle
+	for (i = 1; i < nr_of_slots; i++)
+	{
+		slot = (uint16_t)((slot + 1u) % CAN_QUALITY_NR_OF_SLOTS);
+		q->slot_bits[slot] = 0;
+		q->slot_msgs[slot] = 0;
+		q->slot_errs[slot] = 0;
+	}
+
+	bits = 0;
+	msgs = 0;
+	errs = 0;
+	for (i = 0; i < CAN_QUALITY_NR_OF_SLOTS; i++)
+	{
+		bits += q->slot_bits[i];
+		msgs += q->slot_msgs[i];
+		errs += q->slot_errs[i];
+	}
+
+	q->statistic.node_load = can_quality_per_mill(bits, capacity);
+	q->statistic.current_quality = (uint16_t)(CAN_QUALITY_PER_MILL - can_quality_per_mill(errs, msgs + errs));
+	q->statistic.quality = (uint16_t)(CAN_QUALITY_PER_MILL - can_quality_per_mill(err_cnt, msg_cnt + err_cnt));
+}
+/** @} */
@@ -0,0 +1,334 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/*!
+ * \remarks CAN traffic counters\n
+ * - <b>counting</b>\n
+ * Every message handled by the synchronous, system and asynchronous receive handlers is counted per CAN-controller,
+ * CAN identifier and reason (accepted, wrong data length code, wrong module number, deactivated, dropped). The
+ * synchronous process data of the configured logical modules is counted in a fixed entry per table position and
+ * object which the receive handler already resolved, see can_traffic_rx_sync(). All other identifiers are stored on
+ * first reception in an open addressed table of #LI_CAN_SLV_TRAFFIC_SIZE entries, so only the identifiers seen on
+ * the bus use memory. The search is limited to #CAN_TRAFFIC_MAX_PROBE entries to keep the interrupt lock short,
+ * messages of identifiers without a free entry in this range are counted as overflow.
+ *
+ * - <b>readout</b>\n
+ * can_traffic_snapshot() copies the table entry by entry with disabled interrupts, can_traffic_reset() clears the
+ * table. Both should be called from the context of li_can_slv_process() or a task.
+ */
+
+/**
+ * @file io_can_traffic.c
+ * @brief
+ * @addtogroup can_traffic
+ * @{
+ */
+
+/*--------------------------------------------------------------------------*/
+/* include files                                                            */
+/*--------------------------------------------------------------------------*/
+#include <li_can_slv/util/io_can_traffic.h>
+#include <li_can_slv/error/io_can_errno.h>
+#include <li_can_slv/config/li_can_slv_config_defines.h>
+
+#include "io_can_port.h"
+
+/*--------------------------------------------------------------------------*/
+/* general definitions (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+#ifndef LI_CAN_SLV_TRAFFIC_SIZE
+#define LI_CAN_SLV_TRAFFIC_SIZE	(32)
+#endif // #ifndef LI_CAN_SLV_TRAFFIC_SIZE
+
+#if ((LI_CAN_SLV_TRAFFIC_SIZE & (LI_CAN_SLV_TRAFFIC_SIZE - 1)) != 0) || (LI_CAN_SLV_TRAFFIC_SIZE > 0x1000)
+#error LI_CAN_SLV_TRAFFIC_SIZE must be a power of two up to 0x1000
+#endif
+
+#define CAN_TRAFFIC_MASK	(LI_CAN_SLV_TRAFFIC_SIZE - 1) /**< */
+#define CAN_TRAFFIC_ID_MASK	(0x07FFu) /**< 11bit CAN identifier */
+#define CAN_TRAFFIC_NODE_SHIFT	(11) /**< */
+#define CAN_TRAFFIC_MAX_PROBE	(8u) /**< maximum number of entries searched for an identifier */
+#define CAN_TRAFFIC_SYNC_OBJ_MASK	(0x0003u) /**< object number of synchronous process data */
+
+#define CAN_TRAFFIC_SYNC_MAIN_RX	0 /**< synchronous data of the master received on the main node */
+#define CAN_TRAFFIC_SYNC_MON_RX	1 /**< synchronous data of the master received on the monitor node */
+#define CAN_TRAFFIC_SYNC_MON_TX	2 /**< synchronous data of the main node received on the monitor node */
+#ifdef LI_CAN_SLV_MON
+#define CAN_TRAFFIC_NR_OF_SYNC_GROUPS	3 /**< */
+#else // #ifdef LI_CAN_SLV_MON
+#define CAN_TRAFFIC_NR_OF_SYNC_GROUPS	1 /**< */
+#endif // #ifdef LI_CAN_SLV_MON
+#define CAN_TRAFFIC_NR_OF_SYNC_SLOTS	(CAN_TRAFFIC_NR_OF_SYNC_GROUPS * LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES * CAN_CONFIG_NR_OF_MODULE_OBJS) /**< */
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions (private/not exported)                        */
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief entry of the counter table
+ * @struct can_traffic_slot_t
+ */
+typedef struct
+{
+	uint16_t key; /**< node and CAN identifier plus one, 0 is a free entry */
+	uint32_t cnt[CAN_TRAFFIC_NR_OF_REASONS]; /**< */
+} can_traffic_slot_t;
+
+/*--------------------------------------------------------------------------*/
+/* global variables (public/exported)                                       */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (private/not exported)                                  */
+/*--------------------------------------------------------------------------*/
+static can_traffic_slot_t can_traffic_table[LI_CAN_SLV_TRAFFIC_SIZE]; /**< */
+static can_traffic_slot_t can_traffic_sync_table[CAN_TRAFFIC_NR_OF_SYNC_SLOTS]; /**< synchronous process data of the configured logical modules */
+static uint32_t can_traffic_overflow; /**< messages not counted because of a full table */
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+static void can_traffic_clear(void);
+static void can_traffic_clear_slot(can_traffic_slot_t *slot);
+static uint16_t can_traffic_copy_slot(const can_traffic_slot_t *slot, can_traffic_entry_t *entry);
+
+/*--------------------------------------------------------------------------*/
+/* function definition (public/exported)                                    */
+/*--------------------------------------------------------------------------*/
+li_can_slv_errorcode_t can_traffic_init(void)
+{
+	li_can_slv_port_disable_irq();
+	can_traffic_clear();
+	li_can_slv_port_enable_irq();
+
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+void can_traffic_rx(uint16_t node, uint16_t canid, uint16_t reason)
+{
+	can_traffic_slot_t *slot;
+	uint16_t key;
+	uint16_t pos;
+	uint16_t i;
+
+	if (reason >= CAN_TRAFFIC_NR_OF_REASONS)
+	{
+		reason = CAN_TRAFFIC_REASON_DROPPED;
+	}
+
+	key = (uint16_t)((((node & 0x0001u) << CAN_TRAFFIC_NODE_SHIFT) | (canid & CAN_TRAFFIC_ID_MASK)) + 1u);
+	// the lower bits of the identifiers hold the module number, fold in the upper bits to spread the table
+	pos = (uint16_t)(key ^ (key >> 7));
+
+	li_can_slv_port_disable_irq();
+	for (i = 0; (i < CAN_TRAFFIC_MAX_PROBE) && (i < LI_CAN_SLV_TRAFFIC_SIZE); i++)
+	{
+		slot = &can_traffic_table[(pos + i) & CAN_TRAFFIC_MASK];
+		if (slot->key == key)
+		{
+			slot->cnt[reason]++;
+			break;
+		}
+		if (slot->key == 0)
+		{
+			slot->key = key;
+			slot->cnt[reason] = 1;
+			break;
+		}
+	}
+
+	if ((i == CAN_TRAFFIC_MAX_PROBE) || (i == LI_CAN_SLV_TRAFFIC_SIZE))
+	{
+		can_traffic_overflow++;
+	}
+	li_can_slv_port_enable_irq();
+}
+
+void can_traffic_rx_sync(uint16_t node, uint16_t table_pos, uint16_t canid, uint16_t reason)
+{
+	can_traffic_slot_t *slot;
+	uint16_t key;
+	uint16_t group;
+
+	if (table_pos >= LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES)
+	{
+		can_traffic_rx(node, canid, reason);
+		return;
+	}
+
+	if (reason >= CAN_TRAFFIC_NR_OF_REASONS)
+	{
+		reason = CAN_TRAFFIC_REASON_DROPPED;
+	}
+
+	group = CAN_TRAFFIC_SYNC_MAIN_RX;
+#ifdef LI_CAN_SLV_MON
+	if (node == CAN_TRAFFIC_NODE_MON)
+	{
+		group = ((canid & CAN_CONFIG_DATA_TX_MASK) != 0) ? CAN_TRAFFIC_SYNC_MON_TX : CAN_TRAFFIC_SYNC_MON_RX;
+	}
+#endif // #ifdef LI_CAN_SLV_MON
+
+	key = (uint16_t)((((node & 0x0001u) << CAN_TRAFFIC_NODE_SHIFT) | (canid & CAN_TRAFFIC_ID_MASK)) + 1u);
+	slot = &can_traffic_sync_table[((group * LI_CAN_SLV_MAX_NR_OF_LOGICAL_MODULES) + table_pos) * CAN_CONFIG_NR_OF_MODULE_OBJS + (canid & CAN_TRAFFIC_SYNC_OBJ_MASK)];
+
+	li_can_slv_port_disable_irq();
+	if (slot->key == key)
+	{
+		slot->cnt[reason]++;
+		li_can_slv_port_enable_irq();
+		return;
+	}
+	if (slot->key == 0)
+	{
+		slot->key = key;
+		slot->cnt[reason] = 1;
+		li_can_slv_port_enable_irq();
+		return;
+	}
+	li_can_slv_port_enable_irq();
+
+	// the entry is used by the identifier of the module before a reconfiguration
+	can_traffic_rx(node, canid, reason);
+}
+
+uint16_t can_traffic_reason(li_can_slv_errorcode_t err)
+{
+	switch (err)
+	{
+		case LI_CAN_SLV_ERR_OK:
+			return (CAN_TRAFFIC_REASON_ACCEPTED);
+
+		case ERR_MSG_CAN_MAIN_RX_WRONG_DLC:
+		case ERR_MSG_CAN_MON_RX_WRONG_DLC:
+		case ERR_MSG_CAN_MON_TX_WRONG_DLC:
+			return (CAN_TRAFFIC_REASON_WRONG_DLC);
+
+		case ERR_MSG_CAN_MAIN_RX_WRONG_MODULE_NR:
+		case ERR_MSG_CAN_MON_RX_WRONG_MODULE_NR:
+		case ERR_MSG_CAN_MON_TX_WRONG_MODULE_NR:
+			return (CAN_TRAFFIC_REASON_WRONG_MODULE_NR);
+
+		default:
+			return (CAN_TRAFFIC_REASON_DROPPED);
+	}
+}
+
+li_can_slv_errorcode_t can_traffic_snapshot(can_traffic_entry_t *entries, uint16_t size, uint16_t *nr_of_entries)
+{
+	uint16_t i;
+	uint16_t n = 0;
+
+	// copy entry by entry to keep the interrupt lock short
+	for (i = 0; (i < CAN_TRAFFIC_NR_OF_SYNC_SLOTS) && (n < size); i++)
+	{
+		n += can_traffic_copy_slot(&can_traffic_sync_table[i], &entries[n]);
+	}
+
+	for (i = 0; (i < LI_CAN_SLV_TRAFFIC_SIZE) && (n < size); i++)
+	{
+		n += can_traffic_copy_slot(&can_traffic_table[i], &entries[n]);
+	}
+
+	*nr_of_entries = n;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+li_can_slv_errorcode_t can_traffic_get_overflow(uint32_t *overflow)
+{
+	li_can_slv_port_disable_irq();
+	*overflow = can_traffic_overflow;
+	li_can_slv_port_enable_irq();
+
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+li_can_slv_errorcode_t can_traffic_reset(void)
+{
+	li_can_slv_port_disable_irq();
+	can_traffic_clear();
+	li_can_slv_port_enable_irq();
+
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+/*--------------------------------------------------------------------------*/
+/* function definition (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief clears the counter table, must be called with disabled interrupts
+ */
+static void can_traffic_clear(void)
+{
+	uint16_t i;
+
+	for (i = 0; i < LI_CAN_SLV_TRAFFIC_SIZE; i++)
+	{
+		can_traffic_clear_slot(&can_traffic_table[i]);
+	}
+	for (i = 0; i < CAN_TRAFFIC_NR_OF_SYNC_SLOTS; i++)
+	{
+		can_traffic_clear_slot(&can_traffic_sync_table[i]);
+	}
+	can_traffic_overflow = 0;
+}
+
+/**
+ * @brief clears one entry of a counter table
+ * @param slot entry to clear
+ */
+static void can_traffic_clear_slot(can_traffic_slot_t *slot)
+{
+	uint16_t j;
+
+	slot->key = 0;
+	for (j = 0; j < CAN_TRAFFIC_NR_OF_REASONS; j++)
+	{
+		slot->cnt[j] = 0;
+	}
+}
+
+/**
+ * @brief copies one entry of a counter table with disabled interrupts
+ * @param slot entry of the counter table
+ * @param[out] entry copy of the entry
+ * @return 1 if the entry was used and copied, otherwise 0
+ */
+static uint16_t can_traffic_copy_slot(const can_traffic_slot_t *slot, can_traffic_entry_t *entry)
+{
+	uint16_t j;
+	uint16_t used = 0;
+
+	li_can_slv_port_disable_irq();
+	if (slot->key != 0)
+	{
+		entry->canid = (uint16_t)((slot->key - 1u) & CAN_TRAFFIC_ID_MASK);
+		entry->node = (uint16_t)((slot->key - 1u) >> CAN_TRAFFIC_NODE_SHIFT);
+		for (j = 0; j < CAN_TRAFFIC_NR_OF_REASONS; j++)
+		{
+			entry->cnt[j] = slot->cnt[j];
+		}
+		used = 1;
+	}
+	li_can_slv_port_enable_irq();
+
+	return (used);
+}
+
+/** @} */
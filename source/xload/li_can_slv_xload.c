@@ -94,6 +94,11 @@
 #include <li_can_slv/config/io_can_config.h>
 
 #include <li_can_slv/xload/li_can_slv_xload_buffer.h>
+#include <li_can_slv/xload/li_can_slv_xload_crc16.h>
+#include <li_can_slv/xload/li_can_slv_xload_lz.h>
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+#include <li_can_slv/xload/li_can_slv_xload_info.h>
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
 #include <li_can_slv/core/li_can_slv_core_defines.h>
 
 #ifdef LI_CAN_SLV_DEBUG
@@ -106,6 +111,29 @@
 #define ULOAD_STATE_END				(0)
 #define ULOAD_STATE_FILL_BUFFER		(1)
 #define ULOAD_STATE_SEND_MESSAGE	(2)
+#define ULOAD_STATE_BLOCK_END		(3)
+
+#if defined(LI_CAN_SLV_DLOAD_RESUME) && !defined(LI_CAN_SLV_DLOAD_CRC_CHECK)
+#error LI_CAN_SLV_USE_ASYNC_DOWNLOAD_RESUME needs LI_CAN_SLV_USE_DOWNLOAD_CRC_CHECK to verify the resumed component
+#endif
+
+#ifdef LI_CAN_SLV_DLOAD_PIPELINE
+#ifndef LI_CAN_SLV_XLOAD_PIPELINE_BLOCKS
+#define LI_CAN_SLV_XLOAD_PIPELINE_BLOCKS	(2) /**< number of block buffers of the pipelined download */
+#endif // #ifndef LI_CAN_SLV_XLOAD_PIPELINE_BLOCKS
+#if LI_CAN_SLV_XLOAD_PIPELINE_BLOCKS < 2
+#error LI_CAN_SLV_XLOAD_PIPELINE_BLOCKS must be at least 2
+#endif
+#endif // #ifdef LI_CAN_SLV_DLOAD_PIPELINE
+
+#ifdef LI_CAN_SLV_DLOAD_WINDOW
+#ifndef LI_CAN_SLV_XLOAD_WINDOW_BLOCKS
+#define LI_CAN_SLV_XLOAD_WINDOW_BLOCKS	(4) /**< number of blocks in flight of the windowed download */
+#endif // #ifndef LI_CAN_SLV_XLOAD_WINDOW_BLOCKS
+#if (LI_CAN_SLV_XLOAD_WINDOW_BLOCKS < 2) || (LI_CAN_SLV_XLOAD_WINDOW_BLOCKS > 127)
+#error LI_CAN_SLV_XLOAD_WINDOW_BLOCKS must be in the range of 2 to 127
+#endif
+#endif // #ifdef LI_CAN_SLV_DLOAD_WINDOW
 
 /*--------------------------------------------------------------------------*/
 /* structure/type definitions (private/not exported)                        */
@@ -132,17 +160,97 @@ static li_can_slv_dload_end_handle_funcp_t dload_end_handle_funcp = NULL;
 static li_can_slv_uload_info_request_handle_funcp_t uload_info_request_handle_funcp = NULL;
 static li_can_slv_uload_start_request_handle_funcp_t uload_start_request_handle_funcp = NULL;
 static li_can_slv_uload_block_ack_handle_funcp_t uload_block_ack_handle_funcp = NULL;
+static li_can_slv_uload_progress_handle_funcp_t uload_progress_handle_funcp = NULL;
+static li_can_slv_uload_block_sent_handle_funcp_t uload_block_sent_handle_funcp = NULL;
 #endif // #ifdef LI_CAN_SLV_ULOAD
 
 static li_can_slv_xload_progress_t xload_in_progress = LI_CAN_SLV_XLOAD_IDLE;
 
+#ifdef LI_CAN_SLV_DLOAD_PIPELINE
+static li_can_slv_dload_block_commit_handle_funcp_t dload_block_commit_handle_funcp = NULL;
+// block buffers of the pipelined download, the block at the read index is committed by the application
+static byte_t dload_pipeline_block[LI_CAN_SLV_XLOAD_PIPELINE_BLOCKS][LI_CAN_SLV_XLOAD_BLOCK_BUFFER_SIZE_DLOAD]; /**< block buffers */
+static uint16_t dload_pipeline_len[LI_CAN_SLV_XLOAD_PIPELINE_BLOCKS]; /**< number of bytes of the block buffers */
+static volatile uint16_t dload_pipeline_write = 0; /**< next free block buffer */
+static volatile uint16_t dload_pipeline_read = 0; /**< block buffer which is committed */
+static volatile uint16_t dload_pipeline_cnt = 0; /**< number of used block buffers */
+static volatile uint16_t dload_pipeline_ackn_pending = FALSE; /**< a received block waits for a free block buffer */
+static volatile uint16_t dload_pipeline_end_pending = FALSE; /**< the download end waits for the commit of all blocks */
+static volatile li_can_slv_errorcode_t dload_pipeline_err = LI_CAN_SLV_ERR_OK; /**< first error of a commit */
+static volatile uint16_t dload_pipeline_stale = FALSE; /**< the running commit belongs to a terminated download */
+static volatile uint16_t dload_pipeline_committing = FALSE; /**< the block commit handle is called */
+static volatile uint16_t dload_pipeline_commit_again = FALSE; /**< the next commit is requested within the block commit handle */
+static li_can_slv_module_nr_t dload_pipeline_module_nr; /**< module number of the running download */
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+static uint16_t dload_pipeline_crc[LI_CAN_SLV_XLOAD_PIPELINE_BLOCKS]; /**< running CRC after the block buffers */
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+#endif // #ifdef LI_CAN_SLV_DLOAD_PIPELINE
+
+#ifdef LI_CAN_SLV_DLOAD_WINDOW
+static uint16_t dload_window_active = FALSE; /**< the master numbers the blocks of the running download */
+static uint16_t dload_window_first = TRUE; /**< the first block of the download decides about the windowed mode */
+static byte_t dload_window_seq = 0; /**< number of the next expected block */
+static uint16_t dload_window_retransmit_pending = FALSE; /**< the retransmission of the expected block is requested */
+#endif // #ifdef LI_CAN_SLV_DLOAD_WINDOW
+
+#ifdef LI_CAN_SLV_DLOAD_CRC_CHECK
+static uint16_t dload_crc; /**< CRC16 of the received blocks of the running download */
+#endif // #ifdef LI_CAN_SLV_DLOAD_CRC_CHECK
+
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+static uint32_t dload_resume_start = 0; /**< offset at which the running download continues */
+static uint16_t dload_resume_crc = 0; /**< running CRC at the start offset */
+static uint32_t dload_resume_offset = 0; /**< number of programmed bytes of the running download */
+static uint16_t dload_resume_requested = FALSE; /**< the master opted in to the resume with the version request long */
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+
+#if defined(LI_CAN_SLV_ULOAD) && defined(LI_CAN_SLV_XLOAD_FD)
+static byte_t uload_fd = FALSE; /**< the master requested CAN FD data objects for the upload */
+#endif // #if defined(LI_CAN_SLV_ULOAD) && defined(LI_CAN_SLV_XLOAD_FD)
+
+#ifdef LI_CAN_SLV_ULOAD
+// state of the upload block which is sent by li_can_slv_uload_process()
+static volatile uint16_t uload_state = ULOAD_STATE_END; /**< state of the running upload block */
+static volatile uint16_t uload_lock = FALSE; /**< prevents a nested call of li_can_slv_uload_process() */
+static li_can_slv_errorcode_t uload_block_err = LI_CAN_SLV_ERR_OK; /**< result of the last finished upload block */
+static const uint8_t *uload_data = NULL; /**< data of the component if it is sent from a buffer */
+static li_can_slv_uload_read_funcp_t uload_read_funcp = NULL; /**< source of the component if it is read in pieces */
+static uint16_t uload_data_length; /**< number of bytes of the component at the end of the block */
+static uint16_t uload_obj_len = CAN_DLC_MAX; /**< length of the data objects */
+static uint32_t uload_systick_old; /**< ticks of the last sent data object */
+#ifdef LI_CAN_SLV_XLOAD_FD
+static byte_t uload_obj[CAN_DLC_FD_MAX]; /**< data object waiting for the transmission */
+#else // #ifdef LI_CAN_SLV_XLOAD_FD
+static byte_t uload_obj[CAN_DLC_MAX]; /**< data object waiting for the transmission */
+#endif // #ifdef LI_CAN_SLV_XLOAD_FD
+#endif // #ifdef LI_CAN_SLV_ULOAD
+
 /*--------------------------------------------------------------------------*/
 /* function prototypes (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
 static li_can_slv_errorcode_t dload_version_request_pre_handle(li_can_slv_module_nr_t module_nr);
 static li_can_slv_errorcode_t dload_block_ackn(li_can_slv_module_nr_t module_nr);
+#ifdef LI_CAN_SLV_DLOAD_PIPELINE
+static li_can_slv_errorcode_t dload_pipeline_block_end(li_can_slv_module_nr_t module_nr);
+static li_can_slv_errorcode_t dload_pipeline_push(li_can_slv_module_nr_t module_nr);
+static void dload_pipeline_commit(void);
+static void dload_pipeline_abort(void);
+#endif // #ifdef LI_CAN_SLV_DLOAD_PIPELINE
+#ifdef LI_CAN_SLV_DLOAD_WINDOW
+static li_can_slv_errorcode_t dload_window_drop_block(li_can_slv_module_nr_t module_nr, byte_t seq, uint16_t len);
+static li_can_slv_errorcode_t dload_window_ackn(li_can_slv_module_nr_t module_nr, byte_t flags, byte_t seq);
+#endif // #ifdef LI_CAN_SLV_DLOAD_WINDOW
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+static void dload_resume_check(const li_can_slv_xload_component_t *component);
+static void dload_resume_store(const li_can_slv_xload_component_t *component);
+static void dload_resume_commit(uint16_t len, uint16_t crc);
+static li_can_slv_errorcode_t dload_resume_ackn(li_can_slv_module_nr_t module_nr);
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
 #ifdef LI_CAN_SLV_ULOAD
 static li_can_slv_errorcode_t uload_info_request_pre_handle(li_can_slv_module_nr_t module_nr);
+static li_can_slv_errorcode_t uload_block_start(const uint8_t *data, li_can_slv_uload_read_funcp_t read, uint16_t data_length);
+static void uload_send(void);
+static void uload_block_finish(li_can_slv_errorcode_t err);
 #endif // #ifdef LI_CAN_SLV_ULOAD
 /*--------------------------------------------------------------------------*/
 /* function definition (public/exported)                                    */
@@ -171,18 +279,80 @@ li_can_slv_errorcode_t li_can_slv_dload_start_ackn(li_can_slv_module_nr_t module
 	dload_buffer.nr_bytes = 0;
 #endif // #ifdef LI_CAN_SLV_DLOAD_BUFFER_INTERNAL
 
+#ifdef LI_CAN_SLV_DLOAD_PIPELINE
+	// the blocks of a previous download are dropped, only a running commit keeps its block buffer until it is reported
+	dload_pipeline_abort();
+	CAN_PORT_DISABLE_IRQ();
+	if (dload_pipeline_cnt == 0)
+	{
+		dload_pipeline_read = 0;
+		dload_pipeline_write = 0;
+	}
+	dload_pipeline_err = LI_CAN_SLV_ERR_OK;
+	CAN_PORT_ENABLE_IRQ();
+#endif // #ifdef LI_CAN_SLV_DLOAD_PIPELINE
+
+#ifdef LI_CAN_SLV_DLOAD_WINDOW
+	/* the windowed mode is used when the master numbers the first data block end */
+	dload_window_active = FALSE;
+	dload_window_first = TRUE;
+	dload_window_seq = 0;
+	dload_window_retransmit_pending = FALSE;
+#endif // #ifdef LI_CAN_SLV_DLOAD_WINDOW
+
+#ifdef LI_CAN_SLV_DLOAD_CRC_CHECK
+	dload_crc = li_can_slv_xload_crc16_init();
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+	if (dload_resume_start > 0)
+	{
+		// the CRC continues with the programmed bytes of the interrupted download
+		dload_crc = dload_resume_crc;
+	}
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+#endif // #ifdef LI_CAN_SLV_DLOAD_CRC_CHECK
+
+#ifdef LI_CAN_SLV_DLOAD_LZ
+	dload_lz_init(max_bytes_per_block);
+#endif // #ifdef LI_CAN_SLV_DLOAD_LZ
+
 	acknowledge_buffer[0] = CAN_ASYNC_DL_START_ACKN;
 	acknowledge_buffer[1] = (byte_t)((max_bytes_per_block & 0xFF00u) >> 8);
 	acknowledge_buffer[2] = (byte_t)(max_bytes_per_block & 0x00FFu);
 	acknowledge_buffer[3] = (byte_t) t_delay_objs;
 
 	can_port_memory_set(&acknowledge_buffer[4], 0x00, 4);
+#ifdef LI_CAN_SLV_XLOAD_FD
+	// announce that the data objects of the download may be sent as CAN FD frames
+	acknowledge_buffer[4] = XLOAD_FLAG_FD;
+#endif // #ifdef LI_CAN_SLV_XLOAD_FD
+#ifdef LI_CAN_SLV_DLOAD_WINDOW
+	// announce the number of blocks which may be sent without waiting for the block acknowledge
+	acknowledge_buffer[4] |= XLOAD_FLAG_WINDOW;
+	acknowledge_buffer[5] = LI_CAN_SLV_XLOAD_WINDOW_BLOCKS;
+#endif // #ifdef LI_CAN_SLV_DLOAD_WINDOW
+#ifdef LI_CAN_SLV_DLOAD_LZ
+	// announce the compressed data objects and the window size in units of 256 bytes
+	acknowledge_buffer[4] |= XLOAD_FLAG_LZ;
+	acknowledge_buffer[6] = (byte_t)(LI_CAN_SLV_XLOAD_LZ_WINDOW >> 8);
+#endif // #ifdef LI_CAN_SLV_DLOAD_LZ
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+	// announce the resume, a master opts in with the version request long and gets the offset in a block acknowledge
+	acknowledge_buffer[4] |= XLOAD_FLAG_RESUME;
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
 
 #ifdef LI_CAN_SLV_DEBUG_DLOAD_START
 	LI_CAN_SLV_DEBUG_PRINT("\nlcsdl_start_ackn");
 #endif // #ifdef LI_CAN_SLV_DEBUG_DLOAD_START
 
 	rc = can_async_send_data_to_async_ctrl_tx_queue(module_nr, CAN_ASYNC_CTRL_TX_TYPE_SLAVE, acknowledge_buffer);
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+	if ((rc == LI_CAN_SLV_ERR_OK) && (dload_resume_requested == TRUE))
+	{
+		// only a master which opted in expects the offset, it is also sent for a download starting at 0
+		dload_resume_requested = FALSE;
+		rc = dload_resume_ackn(module_nr);
+	}
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
 	return rc;
 }
 
@@ -281,6 +451,140 @@ li_can_slv_errorcode_t li_can_slv_dload_set_end_handle(li_can_slv_dload_end_hand
 	return err;
 }
 
+#ifdef LI_CAN_SLV_DLOAD_PIPELINE
+/**
+ * @brief sets the handle which starts the commit of a block of the pipelined download
+ * @remarks The handle gets the data of one block and must not wait for the end of the programming, the application
+ * reports the end with li_can_slv_dload_block_committed(). The data is valid until then. A NULL handle removes the
+ * handle again, which is only possible while no block is committed.
+ * @param handle handle function for the block commit or NULL
+ * @return ERR_MSG_CAN_DLOAD_ADD_HANDLE or LI_CAN_SLV_ERR_OK
+ */
+li_can_slv_errorcode_t li_can_slv_dload_set_block_commit_handle(li_can_slv_dload_block_commit_handle_funcp_t handle)
+{
+	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
+
+	CAN_PORT_DISABLE_IRQ();
+	if ((NULL == handle) && (dload_pipeline_cnt == 0))
+	{
+		dload_block_commit_handle_funcp = NULL;
+	}
+	else if ((NULL != handle) && (NULL == dload_block_commit_handle_funcp))
+	{
+		dload_block_commit_handle_funcp = handle;
+	}
+	else
+	{
+		err = ERR_MSG_CAN_DLOAD_ADD_HANDLE;
+	}
+	CAN_PORT_ENABLE_IRQ();
+	return err;
+}
+
+/**
+ * @brief reports the end of the commit of the oldest block of the pipelined download
+ * @remarks The commit of the next block is started, a block waiting for a free block buffer is acknowledged and a
+ * pending download end is handled, so the function sends on the asynchronous control channel and calls the block
+ * commit handle and the download end handle. It must be called from the context of the asynchronous CAN receive
+ * handling or from a context which cannot interrupt it, e.g. the main loop with the CAN interrupts disabled, and it
+ * may be called from within the block commit handle. An error terminates the download at the next block boundary.
+ * The commit of a terminated download only frees its block buffer.
+ * @param err result of the commit, LI_CAN_SLV_ERR_OK if the block is programmed
+ * @return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t li_can_slv_dload_block_committed(li_can_slv_errorcode_t err)
+{
+	uint16_t more, ackn, end, stale;
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+	uint16_t len, crc;
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+
+	CAN_PORT_DISABLE_IRQ();
+	if (dload_pipeline_cnt == 0)
+	{
+		CAN_PORT_ENABLE_IRQ();
+		return (ERR_MSG_CAN_DLOAD_BUF_UNDERFLOW);
+	}
+
+	// the result of the commit of a terminated download does not belong to the running download
+	stale = dload_pipeline_stale;
+	dload_pipeline_stale = FALSE;
+	if ((stale == FALSE) && (err != LI_CAN_SLV_ERR_OK) && (dload_pipeline_err == LI_CAN_SLV_ERR_OK))
+	{
+		dload_pipeline_err = err;
+	}
+
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+	// the block buffer may be used again after the read index is moved
+	len = dload_pipeline_len[dload_pipeline_read];
+	crc = dload_pipeline_crc[dload_pipeline_read];
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+	if (dload_pipeline_read < (LI_CAN_SLV_XLOAD_PIPELINE_BLOCKS - 1))
+	{
+		dload_pipeline_read++;
+	}
+	else
+	{
+		dload_pipeline_read = 0;
+	}
+	dload_pipeline_cnt--;
+
+	more = (dload_pipeline_cnt > 0);
+	ackn = dload_pipeline_ackn_pending;
+	dload_pipeline_ackn_pending = FALSE;
+	end = ((more == FALSE) && (dload_pipeline_end_pending != FALSE));
+	if (end)
+	{
+		dload_pipeline_end_pending = FALSE;
+	}
+	CAN_PORT_ENABLE_IRQ();
+
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+	if ((stale == FALSE) && (dload_pipeline_err == LI_CAN_SLV_ERR_OK))
+	{
+		dload_resume_commit(len, crc);
+	}
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+
+	if (more)
+	{
+		dload_pipeline_commit();
+	}
+
+	if (ackn)
+	{
+		if (dload_pipeline_err != LI_CAN_SLV_ERR_OK)
+		{
+			li_can_slv_dload_termination(dload_pipeline_module_nr, dload_pipeline_err);
+		}
+		else
+		{
+			(void) dload_pipeline_push(dload_pipeline_module_nr);
+		}
+	}
+
+	if (end)
+	{
+		(void) li_can_slv_dload_end(dload_pipeline_module_nr);
+	}
+	return (LI_CAN_SLV_ERR_OK);
+}
+#endif // #ifdef LI_CAN_SLV_DLOAD_PIPELINE
+
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+/**
+ * @brief returns the offset at which the running download continues
+ * @remarks Valid from the call of the download start request handle or the download start handle. The data of the
+ * first block is programmed at this offset of the component, the bytes in front of it are already programmed and
+ * must not be erased. It is only above 0 if the master opted in to the resume.
+ * @return number of programmed bytes of an interrupted download or 0 for a new download
+ */
+uint32_t li_can_slv_dload_get_resume_offset(void)
+{
+	return (dload_resume_start);
+}
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+
 #ifdef LI_CAN_SLV_ULOAD
 /**
  * @param handle handle function for upload info request
@@ -338,6 +642,44 @@ li_can_slv_errorcode_t li_can_slv_uload_set_uload_block_ack_handle(li_can_slv_ul
 	}
 	return err;
 }
+
+/**
+ * @param handle handle function called after each sent data object of an upload block
+ * @return #li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t li_can_slv_uload_set_progress_handle(li_can_slv_uload_progress_handle_funcp_t handle)
+{
+	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
+
+	if (NULL == uload_progress_handle_funcp)
+	{
+		uload_progress_handle_funcp = handle;
+	}
+	else
+	{
+		err = ERR_MSG_CAN_ULOAD_ADD_HANDLE;
+	}
+	return err;
+}
+
+/**
+ * @param handle handle function called when an upload block is sent or aborted by an error
+ * @return #li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t li_can_slv_uload_set_block_sent_handle(li_can_slv_uload_block_sent_handle_funcp_t handle)
+{
+	li_can_slv_errorcode_t err = LI_CAN_SLV_ERR_OK;
+
+	if (NULL == uload_block_sent_handle_funcp)
+	{
+		uload_block_sent_handle_funcp = handle;
+	}
+	else
+	{
+		err = ERR_MSG_CAN_ULOAD_ADD_HANDLE;
+	}
+	return err;
+}
 #endif // #ifdef LI_CAN_SLV_ULOAD
 
 /**
@@ -397,6 +739,10 @@ li_can_slv_errorcode_t li_can_slv_dload_version_request_short(li_can_slv_module_
 	xload_component_version_request.name[7] = (char_t)(0x20U + (src[7] & 0x3FU));
 	xload_component_version_request.name[8] = '\0';
 
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+	dload_resume_requested = FALSE;
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+
 #ifdef LI_CAN_SLV_DEBUG_DLOAD_VERSION
 	LI_CAN_SLV_DEBUG_PRINT("\nlcsdl_ver_req short");
 #endif // #ifdef LI_CAN_SLV_DEBUG_DLOAD_VERSION
@@ -436,6 +782,8 @@ li_can_slv_errorcode_t li_can_slv_dload_version_request_long1(li_can_slv_module_
  * in the private data structure. The crc and the download_id of the given	component is calculated and the private function
  * li_can_slv_dload_version_answer is called.
  * @remarks byte 1 of source data is the identifier of the object. the identifier is not checked in this function.
+ * With LI_CAN_SLV_USE_ASYNC_DOWNLOAD_RESUME a master opts in to the resume of the following download start request
+ * with #XLOAD_FLAG_RESUME in byte 8 and 0 in bytes 5 to 7.
  * @param module_nr number of the module for the download
  * @param[in] src pointer to the source of the download data
  * @return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
@@ -452,6 +800,18 @@ li_can_slv_errorcode_t li_can_slv_dload_version_request_long2(li_can_slv_module_
 	xload_component_version_request.name[7] = src[3];
 	xload_component_version_request.name[8] = '\0';
 
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+	// older masters leave the free bytes 0, so only the exact opt-in enables the resume
+	if ((src[4] == 0) && (src[5] == 0) && (src[6] == 0) && (src[7] == XLOAD_FLAG_RESUME))
+	{
+		dload_resume_requested = TRUE;
+	}
+	else
+	{
+		dload_resume_requested = FALSE;
+	}
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+
 #ifdef LI_CAN_SLV_DEBUG_DLOAD_VERSION
 	LI_CAN_SLV_DEBUG_PRINT("\nlcsdl_ver_req long2");
 #endif // #ifdef LI_CAN_SLV_DEBUG_DLOAD_VERSION
@@ -553,6 +913,10 @@ li_can_slv_errorcode_t li_can_slv_dload_start_request2(li_can_slv_module_nr_t mo
 			return rc;
 		}
 
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+		dload_resume_check(&xload_component);
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+
 		// call handle
 		if (NULL != dload_start_request_handle_funcp)
 		{
@@ -565,6 +929,13 @@ li_can_slv_errorcode_t li_can_slv_dload_start_request2(li_can_slv_module_nr_t mo
 		{
 			rc = ERR_MSG_CAN_DLOAD_UNKNOWN_COMPONENT;
 		}
+
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+		if (rc == LI_CAN_SLV_ERR_OK)
+		{
+			dload_resume_store(&xload_component);
+		}
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
 	}
 	else
 	{
@@ -583,35 +954,63 @@ li_can_slv_errorcode_t li_can_slv_dload_start_request2(li_can_slv_module_nr_t mo
  * @brief function receives the data block and stores it in the data structure and increments counter for bytes
  * per block and the counter for CAN objects\n
  * @remarks byte 1 of source data is the identifier of the object. the identifier is not checked in this function.
+ * With an external download buffer the port may define li_can_slv_port_dload_add_bytes_to_buffer(src, len) to take
+ * the payload of an object at once instead of calling li_can_slv_port_dload_add_byte_to_buffer() for every byte.
  * @param module_nr number of the module for the download
+ * @param dlc data length code of the received object
  * @param[in] src pointer to the source of the download data
  * @return	li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
  */
-li_can_slv_errorcode_t li_can_slv_dload_data(li_can_slv_module_nr_t module_nr, const byte_t *src)
+li_can_slv_errorcode_t li_can_slv_dload_data(li_can_slv_module_nr_t module_nr, uint16_t dlc, const byte_t *src)
 {
+#if !defined(LI_CAN_SLV_DLOAD_BUFFER_INTERNAL) && !defined(li_can_slv_port_dload_add_bytes_to_buffer)
 	uint16_t i;
+#endif // #if !defined(LI_CAN_SLV_DLOAD_BUFFER_INTERNAL) && !defined(li_can_slv_port_dload_add_bytes_to_buffer)
+	uint16_t obj_len = CAN_DLC_MAX;
 	li_can_slv_errorcode_t rc = LI_CAN_SLV_ERR_OK;
 
 #ifdef LI_CAN_SLV_DEBUG_DLOAD_DATA_EXTENDED
 	LI_CAN_SLV_DEBUG_PRINT("\nlcsdl_data in o:%u b:%u", dload_buffer.nr_of_can_objs, dload_buffer.bytes_cnt_of_block);
 #endif // #ifdef LI_CAN_SLV_DEBUG_DLOAD_DATA_EXTENDED
 
-	for (i = 1; i < CAN_DLC_MAX; i++)
+#ifdef LI_CAN_SLV_XLOAD_FD
+	// a CAN FD data object carries up to 63 bytes of download data
+	if (dlc > CAN_DLC_MAX)
 	{
+		obj_len = dlc;
+	}
+#else // #ifdef LI_CAN_SLV_XLOAD_FD
+	dlc = dlc; //dummy assignment
+#endif // #ifdef LI_CAN_SLV_XLOAD_FD
+
+#ifdef LI_CAN_SLV_DLOAD_LZ
+	// a block is either sent as compressed or as uncompressed data objects
+	if (dload_lz_get_len() > 0)
+	{
+		li_can_slv_dload_termination(module_nr, ERR_MSG_CAN_DLOAD_LZ_FORMAT);
+		return (ERR_MSG_CAN_DLOAD_LZ_FORMAT);
+	}
+#endif // #ifdef LI_CAN_SLV_DLOAD_LZ
+
+	// the payload follows the identifier byte and is added as one span
 #ifdef LI_CAN_SLV_DLOAD_BUFFER_INTERNAL
-		rc = dload_add_byte_to_buffer(src[i]);
+	rc = dload_add_bytes_to_buffer(&src[1], obj_len - 1);
+#elif defined(li_can_slv_port_dload_add_bytes_to_buffer)
+	rc = li_can_slv_port_dload_add_bytes_to_buffer(&src[1], obj_len - 1);
 #else // #ifdef LI_CAN_SLV_DLOAD_BUFFER_INTERNAL
+	for (i = 1; (i < obj_len) && (rc == LI_CAN_SLV_ERR_OK); i++)
+	{
 		rc = li_can_slv_port_dload_add_byte_to_buffer(src[i]);
+	}
 #endif // #ifdef LI_CAN_SLV_DLOAD_BUFFER_INTERNAL
-		if (rc != LI_CAN_SLV_ERR_OK)
-		{
-			// terminate download if an error occurred in the dload buffer internal or external management
-			li_can_slv_dload_termination(module_nr, rc);
-			return (rc);
-		}
+	if (rc != LI_CAN_SLV_ERR_OK)
+	{
+		// terminate download if an error occurred in the dload buffer internal or external management
+		li_can_slv_dload_termination(module_nr, rc);
+		return (rc);
 	}
 	dload_buffer.nr_of_can_objs++;
-	dload_buffer.bytes_cnt_of_block += (CAN_DLC_MAX - 1);
+	dload_buffer.bytes_cnt_of_block += (obj_len - 1);
 
 #ifdef LI_CAN_SLV_DEBUG_DLOAD_DATA_EXTENDED
 	LI_CAN_SLV_DEBUG_PRINT("\nlcsdl_data out o:%u b:%u", dload_buffer.nr_of_can_objs, dload_buffer.bytes_cnt_of_block);
@@ -619,11 +1018,61 @@ li_can_slv_errorcode_t li_can_slv_dload_data(li_can_slv_module_nr_t module_nr, c
 	return rc;
 }
 
+#ifdef LI_CAN_SLV_DLOAD_LZ
+/**
+ * @brief function receives a compressed data object and keeps its payload until the data block end
+ * @remarks byte 1 of source data is the identifier of the object. the identifier is not checked in this function.
+ * The counters of the block count the compressed bytes and objects like li_can_slv_dload_data().
+ * @param module_nr number of the module for the download
+ * @param dlc data length code of the received object
+ * @param[in] src pointer to the source of the download data
+ * @return	li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t li_can_slv_dload_data_lz(li_can_slv_module_nr_t module_nr, uint16_t dlc, const byte_t *src)
+{
+	uint16_t obj_len = CAN_DLC_MAX;
+	li_can_slv_errorcode_t rc;
+
+#ifdef LI_CAN_SLV_XLOAD_FD
+	if (dlc > CAN_DLC_MAX)
+	{
+		obj_len = dlc;
+	}
+#else // #ifdef LI_CAN_SLV_XLOAD_FD
+	dlc = dlc; //dummy assignment
+#endif // #ifdef LI_CAN_SLV_XLOAD_FD
+
+	// a block is either sent as compressed or as uncompressed data objects
+	if (dload_lz_get_len() != dload_buffer.bytes_cnt_of_block)
+	{
+		rc = ERR_MSG_CAN_DLOAD_LZ_FORMAT;
+	}
+	else
+	{
+		rc = dload_lz_add_bytes(&src[1], obj_len - 1);
+	}
+
+	if (rc != LI_CAN_SLV_ERR_OK)
+	{
+		li_can_slv_dload_termination(module_nr, rc);
+		return (rc);
+	}
+	dload_buffer.nr_of_can_objs++;
+	dload_buffer.bytes_cnt_of_block += (obj_len - 1);
+	return rc;
+}
+#endif // #ifdef LI_CAN_SLV_DLOAD_LZ
+
 /**
  * @brief Function receives the number of bytes per block and the number of CAN objects and compares the values with
  * the values stored in the data structure. Private function dload_prog_data is called. after programming the block
  * to the destination, the acknowledge is sent in the dload_block_ack function.
  * @remarks byte 1 of source data is the identifier of the object. the identifier is not checked in this function.
+ * In the windowed download byte 6 is the number of the block and byte 7 holds #XLOAD_FLAG_WINDOW. The master opts
+ * in with the first data block end of the download, which must carry exactly #XLOAD_FLAG_WINDOW and the number 0,
+ * otherwise bytes 6 and 7 are ignored for the whole download. A block with an unexpected number or a wrong number
+ * of CAN objects is dropped and its retransmission is requested.
+ * A block of compressed data objects is decompressed to the download buffer before it is handled.
  * @param module_nr number of the module for the download
  * @param[in] src pointer to the source of the download data
  * @return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
@@ -647,8 +1096,50 @@ li_can_slv_errorcode_t li_can_slv_dload_data_block_end(li_can_slv_module_nr_t mo
 	LI_CAN_SLV_DEBUG_PRINT("\nlcsdl_data_block_end nr_of_can_objs:%u nr_of_obj_cnt:%u", dload_buffer.nr_of_can_objs, dload_buffer.nr_of_can_objs);
 #endif // #ifdef LI_CAN_SLV_DEBUG_DLOAD_DATA_EXTENDED
 
+#ifdef LI_CAN_SLV_DLOAD_WINDOW
+	if (dload_window_first == TRUE)
+	{
+		// a stop-and-wait master may send any padding, so only the exact opt-in switches to the windowed mode
+		dload_window_first = FALSE;
+		if ((src[6] == XLOAD_FLAG_WINDOW) && (src[5] == 0))
+		{
+			dload_window_active = TRUE;
+		}
+	}
+
+	if (dload_window_active == TRUE)
+	{
+		if ((src[5] != dload_window_seq) || (nr_of_can_objs != dload_buffer.nr_of_can_objs))
+		{
+			return (dload_window_drop_block(module_nr, src[5], dload_buffer.bytes_cnt_of_block));
+		}
+#ifdef LI_CAN_SLV_DLOAD_PIPELINE
+		// the master does not wait for the acknowledge, without a free block buffer the block is requested again
+		if ((NULL != dload_block_commit_handle_funcp) && (dload_pipeline_cnt >= LI_CAN_SLV_XLOAD_PIPELINE_BLOCKS))
+		{
+			return (dload_window_drop_block(module_nr, src[5], dload_buffer.bytes_cnt_of_block));
+		}
+#endif // #ifdef LI_CAN_SLV_DLOAD_PIPELINE
+		dload_window_retransmit_pending = FALSE;
+	}
+#endif // #ifdef LI_CAN_SLV_DLOAD_WINDOW
+
 	if (nr_of_can_objs == dload_buffer.nr_of_can_objs)
 	{
+#ifdef LI_CAN_SLV_DLOAD_LZ
+		if (dload_lz_get_len() > 0)
+		{
+			// the decompressed block has no dummy bytes, the block size is the number of decompressed bytes
+			rc = dload_lz_block_end(dload_bytes_of_block, &dload_bytes_of_block);
+			if (rc != LI_CAN_SLV_ERR_OK)
+			{
+				li_can_slv_dload_termination(module_nr, rc);
+				return rc;
+			}
+			dload_buffer.bytes_cnt_of_block = dload_bytes_of_block;
+		}
+#endif // #ifdef LI_CAN_SLV_DLOAD_LZ
+
 		// it is possible that the master sends the whole block of data. As an example if
 		dload_buffer.nr_bytes_end = (dload_buffer.bytes_cnt_of_block - dload_bytes_of_block);
 
@@ -664,6 +1155,18 @@ li_can_slv_errorcode_t li_can_slv_dload_data_block_end(li_can_slv_module_nr_t mo
 			dload_buffer.nr_bytes_end = 0;
 		}
 
+#ifdef LI_CAN_SLV_DLOAD_CRC_CHECK
+		// the block is still in the download buffer, so the CRC is updated before it is programmed
+		dload_crc = dload_crc16_update_last_bytes(dload_crc, dload_bytes_of_block);
+#endif // #ifdef LI_CAN_SLV_DLOAD_CRC_CHECK
+
+#ifdef LI_CAN_SLV_DLOAD_PIPELINE
+		if (NULL != dload_block_commit_handle_funcp)
+		{
+			return (dload_pipeline_block_end(module_nr));
+		}
+#endif // #ifdef LI_CAN_SLV_DLOAD_PIPELINE
+
 		// call handle
 		if (NULL != dload_data_block_end_handle_funcp)
 		{
@@ -679,6 +1182,9 @@ li_can_slv_errorcode_t li_can_slv_dload_data_block_end(li_can_slv_module_nr_t mo
 
 		if (rc == LI_CAN_SLV_ERR_OK)
 		{
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+			dload_resume_commit(dload_bytes_of_block, dload_crc);
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
 			dload_block_ackn(module_nr);
 			dload_buffer.bytes_cnt_of_block = 0;
 			dload_buffer.nr_of_can_objs = 0;
@@ -703,6 +1209,8 @@ li_can_slv_errorcode_t li_can_slv_dload_data_block_end(li_can_slv_module_nr_t mo
  * file download_id is programmed and the acknowledge is sent, otherwise a program_termination is send. The acknowledge is sent
  * after resetting the module to RUNNING mode.
  * @remarks byte 1 of source data is the identifier of the object. the identifier is not checked in this function.
+ * With LI_CAN_SLV_USE_DOWNLOAD_CRC_CHECK the crc calculated while receiving the blocks is compared before the end
+ * handle is called.
  * @param module_nr number of the module for the download
  * @return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
  */
@@ -731,6 +1239,42 @@ li_can_slv_errorcode_t li_can_slv_dload_end(li_can_slv_module_nr_t module_nr)
 		return rc;
 	}
 
+#ifdef LI_CAN_SLV_DLOAD_CRC_CHECK
+	if (dload_crc != xload_component.crc)
+	{
+		rc = ERR_MSG_CAN_DLOAD_BAD_CRC;
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+		// the programmed data is wrong, the next download starts from the beginning
+		li_can_slv_xload_info_set_dload_resume(0, 0);
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+		li_can_slv_dload_termination(module_nr, rc);
+		return rc;
+	}
+#endif // #ifdef LI_CAN_SLV_DLOAD_CRC_CHECK
+
+#ifdef LI_CAN_SLV_DLOAD_PIPELINE
+	if (NULL != dload_block_commit_handle_funcp)
+	{
+		// the end is handled by li_can_slv_dload_block_committed() after the commit of the last block
+		dload_pipeline_module_nr = module_nr;
+		CAN_PORT_DISABLE_IRQ();
+		if (dload_pipeline_cnt > 0)
+		{
+			dload_pipeline_end_pending = TRUE;
+			CAN_PORT_ENABLE_IRQ();
+			return (LI_CAN_SLV_ERR_OK);
+		}
+		CAN_PORT_ENABLE_IRQ();
+
+		rc = dload_pipeline_err;
+		if (rc != LI_CAN_SLV_ERR_OK)
+		{
+			li_can_slv_dload_termination(module_nr, rc);
+			return rc;
+		}
+	}
+#endif // #ifdef LI_CAN_SLV_DLOAD_PIPELINE
+
 	// call handle
 	if (NULL != dload_end_handle_funcp)
 	{
@@ -746,6 +1290,10 @@ li_can_slv_errorcode_t li_can_slv_dload_end(li_can_slv_module_nr_t module_nr)
 
 	if (rc == LI_CAN_SLV_ERR_OK)
 	{
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+		// the component is complete, a new start request of the component starts from the beginning
+		li_can_slv_xload_info_set_dload_resume(0, 0);
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
 #ifndef LI_CAN_SLV_BOOT
 		if (LI_CAN_SLV_XLOAD_STACK_END_HANDLING == end_handle_status)
 		{
@@ -783,6 +1331,10 @@ li_can_slv_errorcode_t li_can_slv_dload_start(li_can_slv_xload_component_t *dloa
 		return rc;
 	}
 
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+	dload_resume_check(dload_component);
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+
 	// call handle
 	if (NULL != dload_start_handle_funcp)
 	{
@@ -796,6 +1348,13 @@ li_can_slv_errorcode_t li_can_slv_dload_start(li_can_slv_xload_component_t *dloa
 		rc = ERR_MSG_CAN_DLOAD_UNKNOWN_COMPONENT;
 	}
 
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+	if (rc == LI_CAN_SLV_ERR_OK)
+	{
+		dload_resume_store(dload_component);
+	}
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+
 	/*----------------------------------------------------------------------*/
 	/* send download program start acknowledge								*/
 	/*----------------------------------------------------------------------*/
@@ -867,6 +1426,13 @@ li_can_slv_errorcode_t li_can_slv_dload_termination(li_can_slv_module_nr_t modul
 	acknowledge_buffer[7] = (byte_t)((MSG_GROUP_CAN >> 24) | (MSG_SG_EXTRACT(error)));
 	rc = can_async_send_data_to_async_ctrl_tx_queue(module_nr, CAN_ASYNC_CTRL_TX_TYPE_SLAVE, acknowledge_buffer);
 	xload_in_progress = LI_CAN_SLV_XLOAD_IDLE; // download terminated
+#ifdef LI_CAN_SLV_DLOAD_PIPELINE
+	dload_pipeline_abort();
+#endif // #ifdef LI_CAN_SLV_DLOAD_PIPELINE
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+	// the opt-in belongs to a single download start
+	dload_resume_requested = FALSE;
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
 	return rc;
 }
 
@@ -987,6 +1553,9 @@ li_can_slv_errorcode_t li_can_slv_uload_start_request2(li_can_slv_module_nr_t mo
 		dload_buffer.max_bytes_per_block = src[2] << 8;
 		dload_buffer.max_bytes_per_block += src[3];
 		dload_buffer.delay_between_objs_msec = src[4];
+#ifdef LI_CAN_SLV_XLOAD_FD
+		uload_fd = ((src[5] & XLOAD_FLAG_FD) != 0) ? TRUE : FALSE;
+#endif // #ifdef LI_CAN_SLV_XLOAD_FD
 
 		// call handle
 		if (NULL != uload_start_request_handle_funcp)
@@ -1014,100 +1583,81 @@ li_can_slv_errorcode_t li_can_slv_uload_start_request2(li_can_slv_module_nr_t mo
 }
 
 /**
- * @param data
- * @param data_length
+ * @brief sends an upload block from a buffer
+ * @remarks The function blocks until all data objects and the data block end of the block are queued, like before the
+ * upload was sent by li_can_slv_uload_process(). Use li_can_slv_uload_data_from_buffer_start() to send the block in
+ * the background. The buffer is indexed with the number of bytes sent since the upload start request.
+ * @param data data of the component
+ * @param data_length number of bytes of the component sent at the end of the block
  * @return #li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
  */
 li_can_slv_errorcode_t li_can_slv_uload_data_from_buffer(uint8_t *data, uint16_t data_length)
 {
-	li_can_slv_errorcode_t rc = LI_CAN_SLV_ERR_OK;
-	uint16_t i;
-	uint16_t state;
-	uint32_t systick_old;
-	byte_t buffer[8];
-
-	dload_buffer.nr_of_can_objs = 0;
-
-	state = ULOAD_STATE_FILL_BUFFER;
+	li_can_slv_errorcode_t rc;
 
-	systick_old = li_can_slv_port_get_system_ticks();
+	rc = uload_block_start(data, NULL, data_length);
+	if (rc != LI_CAN_SLV_ERR_OK)
+	{
+		return rc;
+	}
 
-	while (state != ULOAD_STATE_END)
+	while (uload_state != ULOAD_STATE_END)
 	{
-		switch (state)
-		{
-			case ULOAD_STATE_FILL_BUFFER:
-				for (i = 1; i < CAN_DLC_MAX; i++)
-				{
-					if (dload_buffer.bytes_cnt_of_block < data_length)
-					{
-						/* fill data bytes */
-						buffer[i] = data[dload_buffer.bytes_cnt_of_block];
-						dload_buffer.bytes_cnt_of_block++;
-					}
-					else
-					{
-						/* fill dummy bytes for last message */
-						buffer[i] = 0x00;
-					}
-				}
-				state = ULOAD_STATE_SEND_MESSAGE;
-				break;
+		uload_send();
+	}
+	return uload_block_err;
+}
 
-			case ULOAD_STATE_SEND_MESSAGE:
-				if (li_can_slv_port_get_system_ticks() > (systick_old + dload_buffer.delay_between_objs_msec))
-				{
+/**
+ * @brief starts the transmission of an upload block from a buffer
+ * @remarks The function does not block, the data objects are sent by li_can_slv_uload_process().
+ * The buffer is indexed with the number of bytes sent since the upload start request, it is not
+ * copied and must be valid until the block sent handle is called.
+ * @param data data of the component
+ * @param data_length number of bytes of the component sent at the end of the block
+ * @return #li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t li_can_slv_uload_data_from_buffer_start(const uint8_t *data, uint16_t data_length)
+{
+	return uload_block_start(data, NULL, data_length);
+}
 
-					buffer[0] = CAN_ASYNC_DL_DATA;
+/**
+ * @brief starts the transmission of an upload block read from a source
+ * @remarks The function does not block, the data objects are sent by li_can_slv_uload_process().
+ * The source is read in pieces of one data object, so the component must not be staged in RAM.
+ * @param read function which copies the next bytes of the component
+ * @param data_length number of bytes of the component sent at the end of the block
+ * @return #li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t li_can_slv_uload_data_from_source(li_can_slv_uload_read_funcp_t read, uint16_t data_length)
+{
+	if (NULL == read)
+	{
+		return ERR_MSG_CAN_ULOAD_ADD_HANDLE;
+	}
+	return uload_block_start(NULL, read, data_length);
+}
 
-					/* send data as asynchronous control message */
-					rc = can_async_send_data_to_async_ctrl_tx_queue(xload_component.module_nr, CAN_ASYNC_CTRL_TX_TYPE_SLAVE, buffer);
+/**
+ * @brief sends the data objects and the data block end of a started upload block
+ * @remarks Called by li_can_slv_process(), the function returns when the asynchronous control transmit queue
+ * is full or the delay between the objects requested by the master is not elapsed.
+ */
+void li_can_slv_uload_process(void)
+{
+	uint16_t locked;
 
-					if (rc == ERR_MSG_CAN_ASYNC_CTRL_TX_QUEUE_OVERFLOW)
-					{
-						/* overflow detected -> clear error and try one more */
-						rc = LI_CAN_SLV_ERR_OK;
-					}
-					else
-					{
-						/* in case of any error return */
-						if (rc != LI_CAN_SLV_ERR_OK)
-						{
-							return (rc);
-						}
-						else
-						{
-							/* success of can object transmission */
-							dload_buffer.nr_of_can_objs++;
-
-							/* check end of transmission */
-							if (dload_buffer.bytes_cnt_of_block < data_length)
-							{
-								/* more data valid */
-								state = ULOAD_STATE_FILL_BUFFER;
-							}
-							else
-							{
-								/* end of transmission reached */
-
-								if (rc == LI_CAN_SLV_ERR_OK)
-								{
-									rc = li_can_slv_uload_data_block_end(xload_component.module_nr);
-								}
-
-								state = ULOAD_STATE_END;
-							}
-						}
-					}
-					systick_old = li_can_slv_port_get_system_ticks();
-				}
-				break;
+	CAN_PORT_DISABLE_IRQ();
+	locked = uload_lock;
+	uload_lock = TRUE;
+	CAN_PORT_ENABLE_IRQ();
 
-			default:
-				break;
-		}
+	if (locked == FALSE)
+	{
+		uload_send();
+		uload_lock = FALSE;
 	}
-	return rc;
 }
 
 /**
@@ -1150,6 +1700,7 @@ li_can_slv_errorcode_t li_can_slv_uload_end_ackn(li_can_slv_module_nr_t module_n
 {
 	module_nr = module_nr; //dummy assignment
 	src = src; //dummy assignment
+	uload_state = ULOAD_STATE_END;
 	xload_in_progress = LI_CAN_SLV_XLOAD_IDLE;
 	return LI_CAN_SLV_ERR_OK;
 }
@@ -1168,6 +1719,7 @@ li_can_slv_errorcode_t li_can_slv_uload_termination(li_can_slv_module_nr_t modul
 	src = src; //dummy assignment
 	error = error; //dummy assignment
 	dload_buffer.block_status = DLOAD_END;
+	uload_state = ULOAD_STATE_END;
 	xload_in_progress = LI_CAN_SLV_XLOAD_IDLE;
 	return LI_CAN_SLV_ERR_OK;
 }
@@ -1200,7 +1752,9 @@ li_can_slv_errorcode_t li_can_slv_uload_end(li_can_slv_module_nr_t module_nr)
 
 #ifdef LI_CAN_SLV_ULOAD
 /**
- * @param module_nr
+ * @brief sends the data block end of an upload block to the async TX Queue
+ * @remarks The function does not retry, on #ERR_MSG_CAN_ASYNC_CTRL_TX_QUEUE_OVERFLOW it must be called again.
+ * @param module_nr number of the module for the upload
  * @return #li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
  */
 li_can_slv_errorcode_t li_can_slv_uload_data_block_end(li_can_slv_module_nr_t module_nr)
@@ -1216,12 +1770,7 @@ li_can_slv_errorcode_t li_can_slv_uload_data_block_end(li_can_slv_module_nr_t mo
 
 	can_port_memory_set(&buffer[5], 0x00, 3);
 
-	do
-	{
-		rc = can_async_send_data_to_async_ctrl_tx_queue(module_nr, CAN_ASYNC_CTRL_TX_TYPE_SLAVE, buffer);
-	}
-	while (rc != LI_CAN_SLV_ERR_OK);
-
+	rc = can_async_send_data_to_async_ctrl_tx_queue(module_nr, CAN_ASYNC_CTRL_TX_TYPE_SLAVE, buffer);
 	return rc;
 }
 #endif // #ifdef LI_CAN_SLV_ULOAD
@@ -1303,6 +1852,16 @@ static li_can_slv_errorcode_t dload_block_ackn(li_can_slv_module_nr_t module_nr)
 	byte_t acknowledge_buffer[8];
 	li_can_slv_errorcode_t rc;
 
+#ifdef LI_CAN_SLV_DLOAD_WINDOW
+	if (dload_window_active == TRUE)
+	{
+		// the blocks are acknowledged in order, so the acknowledge always carries the expected number
+		rc = dload_window_ackn(module_nr, XLOAD_FLAG_WINDOW, dload_window_seq);
+		dload_window_seq++;
+		return rc;
+	}
+#endif // #ifdef LI_CAN_SLV_DLOAD_WINDOW
+
 	acknowledge_buffer[0] = CAN_ASYNC_DL_BLOCK_ACKN;
 
 	can_port_memory_set(&acknowledge_buffer[1], 0x00, 7);
@@ -1311,6 +1870,308 @@ static li_can_slv_errorcode_t dload_block_ackn(li_can_slv_module_nr_t module_nr)
 	return rc;
 }
 
+#ifdef LI_CAN_SLV_DLOAD_WINDOW
+/**
+ * @brief drops a received block of the windowed download from the download buffer
+ * @remarks A block sent again after a lost acknowledge is acknowledged again. For the expected block the
+ * retransmission is requested, the blocks the master sent after it are dropped until it is received again.
+ * @param module_nr number of the module for the download
+ * @param seq number of the received block
+ * @param len number of bytes of the block in the download buffer
+ * @return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+static li_can_slv_errorcode_t dload_window_drop_block(li_can_slv_module_nr_t module_nr, byte_t seq, uint16_t len)
+{
+	li_can_slv_errorcode_t rc;
+	byte_t distance;
+
+#ifdef LI_CAN_SLV_DLOAD_LZ
+	if (dload_lz_get_len() > 0)
+	{
+		// a compressed block is not yet in the download buffer
+		dload_lz_drop_block();
+		len = 0;
+	}
+#endif // #ifdef LI_CAN_SLV_DLOAD_LZ
+
+	rc = dload_remove_bytes(len);
+	if (rc != LI_CAN_SLV_ERR_OK)
+	{
+		li_can_slv_dload_termination(module_nr, rc);
+		return rc;
+	}
+	dload_buffer.bytes_cnt_of_block = 0;
+	dload_buffer.nr_of_can_objs = 0;
+
+	distance = (byte_t)(dload_window_seq - seq);
+	if ((distance != 0) && (distance <= LI_CAN_SLV_XLOAD_WINDOW_BLOCKS))
+	{
+		// already programmed, the acknowledge was lost
+		rc = dload_window_ackn(module_nr, XLOAD_FLAG_WINDOW, (byte_t)(dload_window_seq - 1));
+	}
+	else if ((distance == 0) || (dload_window_retransmit_pending == FALSE))
+	{
+		dload_window_retransmit_pending = TRUE;
+		rc = dload_window_ackn(module_nr, XLOAD_FLAG_WINDOW | XLOAD_FLAG_RETRANSMIT, dload_window_seq);
+	}
+	return rc;
+}
+
+/**
+ * @brief sends a block acknowledge or a retransmit request of the windowed download
+ * @param module_nr number of the module for the download
+ * @param flags #XLOAD_FLAG_WINDOW, with #XLOAD_FLAG_RETRANSMIT for a retransmit request
+ * @param seq number of the acknowledged or requested block
+ * @return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+static li_can_slv_errorcode_t dload_window_ackn(li_can_slv_module_nr_t module_nr, byte_t flags, byte_t seq)
+{
+	byte_t acknowledge_buffer[8];
+
+	acknowledge_buffer[0] = CAN_ASYNC_DL_BLOCK_ACKN;
+	acknowledge_buffer[1] = flags;
+	acknowledge_buffer[2] = seq;
+	can_port_memory_set(&acknowledge_buffer[3], 0x00, 5);
+
+	return (can_async_send_data_to_async_ctrl_tx_queue(module_nr, CAN_ASYNC_CTRL_TX_TYPE_SLAVE, acknowledge_buffer));
+}
+#endif // #ifdef LI_CAN_SLV_DLOAD_WINDOW
+
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+/**
+ * @brief compares the component of a download start with the component of the xload_info
+ * @remarks If the master opted in and module, component name, CRC and download ID are the same, the download
+ * continues at the stored offset, otherwise it starts at 0. The xload_info is not changed, see dload_resume_store().
+ * @param[in] component component of the download start
+ */
+static void dload_resume_check(const li_can_slv_xload_component_t *component)
+{
+	li_can_slv_xload_component_t stored;
+	uint32_t offset;
+	uint16_t crc;
+
+	li_can_slv_xload_info_get_dload_component(&stored);
+	li_can_slv_xload_info_get_dload_resume(&offset, &crc);
+
+	if ((dload_resume_requested == TRUE) && (offset > 0) && (stored.module_nr == component->module_nr) && (stored.crc == component->crc)
+	        && (stored.download_id == component->download_id) && (can_port_memory_cmp(stored.name, component->name, DLOAD_COMPONENT_NAME_LENGTH) == 0))
+	{
+		dload_resume_start = offset;
+		dload_resume_crc = crc;
+	}
+	else
+	{
+		dload_resume_start = 0;
+		dload_resume_crc = 0;
+	}
+	dload_resume_offset = dload_resume_start;
+}
+
+/**
+ * @brief stores the component of an accepted download start in the xload_info
+ * @remarks Called after the download start (request) handle returned successfully, so a rejected download start keeps
+ * the progress of the interrupted download. A download starting at 0 clears the stored progress.
+ * @param[in] component component of the download start
+ */
+static void dload_resume_store(const li_can_slv_xload_component_t *component)
+{
+	if (dload_resume_start == 0)
+	{
+		li_can_slv_xload_info_set_dload_component(component);
+		li_can_slv_xload_info_set_dload_resume(0, 0);
+	}
+}
+
+/**
+ * @brief stores the progress of the download after a block is programmed
+ * @param len number of bytes of the block
+ * @param crc running CRC after the block
+ */
+static void dload_resume_commit(uint16_t len, uint16_t crc)
+{
+	dload_resume_offset += len;
+	li_can_slv_xload_info_set_dload_resume(dload_resume_offset, crc);
+}
+
+/**
+ * @brief sends the offset and the running CRC of a resumed download after the download start acknowledge
+ * @remarks The master continues with the data at this offset, the blocks are numbered from 0 again.
+ * @param module_nr number of the module for the download
+ * @return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+static li_can_slv_errorcode_t dload_resume_ackn(li_can_slv_module_nr_t module_nr)
+{
+	byte_t acknowledge_buffer[8];
+
+	acknowledge_buffer[0] = CAN_ASYNC_DL_BLOCK_ACKN;
+	acknowledge_buffer[1] = XLOAD_FLAG_RESUME;
+	acknowledge_buffer[2] = (byte_t)((dload_resume_start & 0xFF000000) >> 24);
+	acknowledge_buffer[3] = (byte_t)((dload_resume_start & 0x00FF0000) >> 16);
+	acknowledge_buffer[4] = (byte_t)((dload_resume_start & 0x0000FF00) >> 8);
+	acknowledge_buffer[5] = (byte_t)(dload_resume_start & 0x000000FF);
+	acknowledge_buffer[6] = (byte_t)((dload_resume_crc & 0xFF00u) >> 8);
+	acknowledge_buffer[7] = (byte_t)(dload_resume_crc & 0x00FFu);
+
+	return (can_async_send_data_to_async_ctrl_tx_queue(module_nr, CAN_ASYNC_CTRL_TX_TYPE_SLAVE, acknowledge_buffer));
+}
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+
+#ifdef LI_CAN_SLV_DLOAD_PIPELINE
+/**
+ * @brief handles the end of a received block of the pipelined download
+ * @remarks The block is acknowledged at once if a block buffer is free, otherwise after the next commit.
+ * @param module_nr number of the module for the download
+ * @return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+static li_can_slv_errorcode_t dload_pipeline_block_end(li_can_slv_module_nr_t module_nr)
+{
+	li_can_slv_errorcode_t rc;
+
+	// a failed commit of a previous block terminates the download at this block boundary
+	rc = dload_pipeline_err;
+	if (rc != LI_CAN_SLV_ERR_OK)
+	{
+		li_can_slv_dload_termination(module_nr, rc);
+		return rc;
+	}
+
+	dload_pipeline_module_nr = module_nr;
+	CAN_PORT_DISABLE_IRQ();
+	if (dload_pipeline_cnt >= LI_CAN_SLV_XLOAD_PIPELINE_BLOCKS)
+	{
+		// the master waits for the acknowledge, so the block stays untouched in the download buffer
+		dload_pipeline_ackn_pending = TRUE;
+		CAN_PORT_ENABLE_IRQ();
+		return (LI_CAN_SLV_ERR_OK);
+	}
+	CAN_PORT_ENABLE_IRQ();
+
+	return (dload_pipeline_push(module_nr));
+}
+
+/**
+ * @brief moves the received block to a free block buffer, acknowledges it and starts its commit if no other block
+ * is committed
+ * @param module_nr number of the module for the download
+ * @return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+static li_can_slv_errorcode_t dload_pipeline_push(li_can_slv_module_nr_t module_nr)
+{
+	li_can_slv_errorcode_t rc;
+	uint16_t len;
+	uint16_t start;
+
+	len = dload_buffer.nr_bytes;
+	if (len > LI_CAN_SLV_XLOAD_BLOCK_BUFFER_SIZE_DLOAD)
+	{
+		rc = ERR_MSG_CAN_DLOAD_BUF_OVERFLOW;
+	}
+	else
+	{
+		rc = xload_buffer_get_bytes(&dload_pipeline_block[dload_pipeline_write][0], len);
+	}
+
+	if (rc != LI_CAN_SLV_ERR_OK)
+	{
+		li_can_slv_dload_termination(module_nr, rc);
+		return rc;
+	}
+
+	dload_pipeline_len[dload_pipeline_write] = len;
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+	dload_pipeline_crc[dload_pipeline_write] = dload_crc;
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+	dload_buffer.bytes_cnt_of_block = 0;
+	dload_buffer.nr_of_can_objs = 0;
+
+	CAN_PORT_DISABLE_IRQ();
+	if (dload_pipeline_write < (LI_CAN_SLV_XLOAD_PIPELINE_BLOCKS - 1))
+	{
+		dload_pipeline_write++;
+	}
+	else
+	{
+		dload_pipeline_write = 0;
+	}
+	dload_pipeline_cnt++;
+	start = (dload_pipeline_cnt == 1);
+	CAN_PORT_ENABLE_IRQ();
+
+	rc = dload_block_ackn(module_nr);
+
+	if (start)
+	{
+		dload_pipeline_commit();
+	}
+	return rc;
+}
+
+/**
+ * @brief hands the oldest block of the pipelined download to the application
+ * @remarks A commit completed within the block commit handle only requests the commit of the next block, which is
+ * started by the loop of the outer call, so the stack depth does not grow with the number of blocks.
+ */
+static void dload_pipeline_commit(void)
+{
+	li_can_slv_errorcode_t rc;
+	uint16_t idx;
+
+	CAN_PORT_DISABLE_IRQ();
+	if (dload_pipeline_committing != FALSE)
+	{
+		dload_pipeline_commit_again = TRUE;
+		CAN_PORT_ENABLE_IRQ();
+		return;
+	}
+	dload_pipeline_committing = TRUE;
+	CAN_PORT_ENABLE_IRQ();
+
+	do
+	{
+		dload_pipeline_commit_again = FALSE;
+		idx = dload_pipeline_read;
+		rc = dload_block_commit_handle_funcp(&xload_component, &dload_pipeline_block[idx][0], dload_pipeline_len[idx]);
+		if (rc != LI_CAN_SLV_ERR_OK)
+		{
+			// the commit could not be started, the block is completed with the error
+			(void) li_can_slv_dload_block_committed(rc);
+		}
+	}
+	while (dload_pipeline_commit_again != FALSE);
+
+	dload_pipeline_committing = FALSE;
+}
+
+/**
+ * @brief drops the blocks of a terminated download which are not yet handed to the application
+ * @remarks A running commit keeps its block buffer until it is reported by li_can_slv_dload_block_committed(), which
+ * then only frees the block buffer.
+ */
+static void dload_pipeline_abort(void)
+{
+	CAN_PORT_DISABLE_IRQ();
+	dload_pipeline_ackn_pending = FALSE;
+	dload_pipeline_end_pending = FALSE;
+	if (dload_pipeline_cnt > 0)
+	{
+		dload_pipeline_stale = TRUE;
+	}
+	if (dload_pipeline_cnt > 1)
+	{
+		dload_pipeline_cnt = 1;
+		if (dload_pipeline_read < (LI_CAN_SLV_XLOAD_PIPELINE_BLOCKS - 1))
+		{
+			dload_pipeline_write = dload_pipeline_read + 1;
+		}
+		else
+		{
+			dload_pipeline_write = 0;
+		}
+	}
+	CAN_PORT_ENABLE_IRQ();
+}
+#endif // #ifdef LI_CAN_SLV_DLOAD_PIPELINE
+
 #ifdef LI_CAN_SLV_ULOAD
 /**
  * @brief function writes the size information to the destination buffer
@@ -1374,6 +2235,176 @@ static li_can_slv_errorcode_t uload_info_request_pre_handle(li_can_slv_module_nr
 	}
 	return (rc);
 }
+
+/**
+ * @brief sends the data objects and the data block end of the running upload block
+ * @remarks Returns when the block is finished, the asynchronous control transmit queue is full or the delay between
+ * the objects requested by the master is not elapsed.
+ */
+static void uload_send(void)
+{
+	li_can_slv_errorcode_t rc;
+	uint16_t cnt;
+	uint16_t wait = FALSE;
+
+	while ((uload_state != ULOAD_STATE_END) && (wait == FALSE))
+	{
+		switch (uload_state)
+		{
+			case ULOAD_STATE_FILL_BUFFER:
+				cnt = uload_obj_len - 1;
+				if (cnt > (uload_data_length - dload_buffer.bytes_cnt_of_block))
+				{
+					cnt = uload_data_length - dload_buffer.bytes_cnt_of_block;
+				}
+
+				/* fill data bytes */
+				rc = LI_CAN_SLV_ERR_OK;
+				if (NULL != uload_read_funcp)
+				{
+					rc = uload_read_funcp(&uload_obj[1], cnt);
+				}
+				else
+				{
+					can_port_memory_cpy(&uload_obj[1], &uload_data[dload_buffer.bytes_cnt_of_block], cnt);
+				}
+
+				if (rc != LI_CAN_SLV_ERR_OK)
+				{
+					uload_block_finish(rc);
+				}
+				else
+				{
+					/* fill dummy bytes for last message */
+					can_port_memory_set(&uload_obj[1 + cnt], 0x00, uload_obj_len - 1 - cnt);
+					dload_buffer.bytes_cnt_of_block += cnt;
+					uload_state = ULOAD_STATE_SEND_MESSAGE;
+				}
+				break;
+
+			case ULOAD_STATE_SEND_MESSAGE:
+				/* without a requested delay the objects are paced by the transmit queue */
+				if ((0 != dload_buffer.delay_between_objs_msec) && ((can_port_get_system_ticks() - uload_systick_old) <= can_port_msec_2_ticks(dload_buffer.delay_between_objs_msec)))
+				{
+					wait = TRUE;
+					break;
+				}
+
+				uload_obj[0] = CAN_ASYNC_DL_DATA;
+
+				/* send data as asynchronous control message */
+#ifdef LI_CAN_SLV_XLOAD_FD
+				rc = can_async_send_fd_data_to_async_ctrl_tx_queue(xload_component.module_nr, CAN_ASYNC_CTRL_TX_TYPE_SLAVE, (byte_t)uload_obj_len, uload_obj);
+#else // #ifdef LI_CAN_SLV_XLOAD_FD
+				rc = can_async_send_data_to_async_ctrl_tx_queue(xload_component.module_nr, CAN_ASYNC_CTRL_TX_TYPE_SLAVE, uload_obj);
+#endif // #ifdef LI_CAN_SLV_XLOAD_FD
+
+				if (rc == ERR_MSG_CAN_ASYNC_CTRL_TX_QUEUE_OVERFLOW)
+				{
+					/* overflow detected -> try again on the next call */
+					wait = TRUE;
+				}
+				else if (rc != LI_CAN_SLV_ERR_OK)
+				{
+					uload_block_finish(rc);
+				}
+				else
+				{
+					/* success of can object transmission */
+					dload_buffer.nr_of_can_objs++;
+					uload_systick_old = can_port_get_system_ticks();
+
+					if (NULL != uload_progress_handle_funcp)
+					{
+						uload_progress_handle_funcp(&xload_component, dload_buffer.bytes_cnt_of_block, uload_data_length);
+					}
+
+					/* check end of transmission */
+					if (dload_buffer.bytes_cnt_of_block < uload_data_length)
+					{
+						/* more data valid */
+						uload_state = ULOAD_STATE_FILL_BUFFER;
+					}
+					else
+					{
+						uload_state = ULOAD_STATE_BLOCK_END;
+					}
+				}
+				break;
+
+			case ULOAD_STATE_BLOCK_END:
+				rc = li_can_slv_uload_data_block_end(xload_component.module_nr);
+				if (rc == ERR_MSG_CAN_ASYNC_CTRL_TX_QUEUE_OVERFLOW)
+				{
+					wait = TRUE;
+				}
+				else
+				{
+					uload_block_finish(rc);
+				}
+				break;
+
+			default:
+				uload_state = ULOAD_STATE_END;
+				break;
+		}
+	}
+}
+
+/**
+ * @brief arms the transmission of an upload block
+ * @remarks The function is called from the upload start and block acknowledge handles of the application, which may
+ * run in the receive path. It only sets up the state, the read function, the progress and block sent handles are
+ * called from li_can_slv_uload_process() in the context of li_can_slv_process().
+ * @param data data of the component, NULL if it is read from the source
+ * @param read source of the component, NULL if it is sent from the buffer
+ * @param data_length number of bytes of the component at the end of the block
+ * @return #li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+static li_can_slv_errorcode_t uload_block_start(const uint8_t *data, li_can_slv_uload_read_funcp_t read, uint16_t data_length)
+{
+	CAN_PORT_DISABLE_IRQ();
+	if (uload_state != ULOAD_STATE_END)
+	{
+		CAN_PORT_ENABLE_IRQ();
+		return ERR_MSG_CAN_DLOAD_IN_PROGRESS;
+	}
+
+	uload_data = data;
+	uload_read_funcp = read;
+	uload_data_length = data_length;
+#ifdef LI_CAN_SLV_XLOAD_FD
+	uload_obj_len = (uload_fd == TRUE) ? CAN_DLC_FD_MAX : CAN_DLC_MAX;
+#endif // #ifdef LI_CAN_SLV_XLOAD_FD
+	uload_systick_old = can_port_get_system_ticks();
+	dload_buffer.nr_of_can_objs = 0;
+
+	if (dload_buffer.bytes_cnt_of_block < data_length)
+	{
+		uload_state = ULOAD_STATE_FILL_BUFFER;
+	}
+	else
+	{
+		uload_state = ULOAD_STATE_BLOCK_END;
+	}
+	CAN_PORT_ENABLE_IRQ();
+
+	return LI_CAN_SLV_ERR_OK;
+}
+
+/**
+ * @brief ends the running upload block and calls the block sent handle
+ * @param err error code of the upload block
+ */
+static void uload_block_finish(li_can_slv_errorcode_t err)
+{
+	uload_block_err = err;
+	uload_state = ULOAD_STATE_END;
+	if (NULL != uload_block_sent_handle_funcp)
+	{
+		uload_block_sent_handle_funcp(&xload_component, err);
+	}
+}
 #endif // #ifdef LI_CAN_SLV_ULOAD
 
 /**
@@ -30,7 +30,9 @@
 /*--------------------------------------------------------------------------*/
 #include <li_can_slv/xload/li_can_slv_xload_buffer.h>
 #include <li_can_slv/xload/li_can_slv_xload_defines.h>
+#include <li_can_slv/xload/li_can_slv_xload_crc16.h>
 #include <li_can_slv/error/io_can_errno.h>
+#include "io_can_port.h"
 #ifdef LI_CAN_SLV_DEBUG
 #include "li_can_slv_debug.h"
 #endif // #ifdef LI_CAN_SLV_DEBUG
@@ -105,6 +107,48 @@ li_can_slv_errorcode_t dload_add_byte_to_buffer(byte_t byte)
 	return (LI_CAN_SLV_ERR_OK);
 }
 
+/**
+ * @brief adds a span of bytes to the download circular buffer
+ * @remarks the span is copied with at most two copies around the end of the circular buffer, nothing is added if the
+ * span does not fit into the buffer
+ * @param[in] src data bytes added to circular buffer
+ * @param len number of bytes
+ * @return	li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t dload_add_bytes_to_buffer(const byte_t *src, uint16_t len)
+{
+	uint16_t first;
+
+	if (len > (LI_CAN_SLV_XLOAD_BUFFER_SIZE_DLOAD - dload_buffer.nr_bytes))
+	{
+#ifdef LI_CAN_SLV_SLV_DEBUG_BUFFER
+		LI_CAN_SLV_DEBUG_PRINT("\nbuffer overflow: %d\n", dload_buffer.nr_bytes);
+		li_can_slv_dload_dump_buffer();
+#endif // #ifdef LI_CAN_SLV_SLV_DEBUG_BUFFER
+		return (ERR_MSG_CAN_DLOAD_BUF_OVERFLOW);
+	}
+
+	first = LI_CAN_SLV_XLOAD_BUFFER_SIZE_DLOAD - dload_buffer.write;
+	if (first > len)
+	{
+		first = len;
+	}
+	can_port_memory_cpy(&dload_buffer.data[dload_buffer.write], src, first);
+	if (first < len)
+	{
+		can_port_memory_cpy(&dload_buffer.data[0], &src[first], len - first);
+	}
+
+	/* service write pointer */
+	dload_buffer.write += len;
+	if (dload_buffer.write >= LI_CAN_SLV_XLOAD_BUFFER_SIZE_DLOAD)
+	{
+		dload_buffer.write -= LI_CAN_SLV_XLOAD_BUFFER_SIZE_DLOAD;
+	}
+	dload_buffer.nr_bytes += len;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
 /**
  * @brief get 1 byte from the download circular buffer
  * @remarks function checks the circular buffer borders and	service the buffer pointers after reading the data.
@@ -133,25 +177,59 @@ li_can_slv_errorcode_t xload_buffer_get_byte(byte_t *data)
 	return (LI_CAN_SLV_ERR_OK);
 }
 
+/**
+ * @brief get a span of bytes from the download circular buffer
+ * @remarks the span is copied with at most two copies around the end of the circular buffer, nothing is read if the
+ * buffer holds less than len bytes
+ * @param[out] data destination of the bytes
+ * @param len number of bytes
+ * @return	li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+li_can_slv_errorcode_t xload_buffer_get_bytes(byte_t *data, uint16_t len)
+{
+	uint16_t first;
+
+	if (dload_buffer.nr_bytes < len)
+	{
+		return (ERR_MSG_CAN_DLOAD_BUF_UNDERFLOW);
+	}
+
+	first = LI_CAN_SLV_XLOAD_BUFFER_SIZE_DLOAD - dload_buffer.read;
+	if (first > len)
+	{
+		first = len;
+	}
+	can_port_memory_cpy(data, &dload_buffer.data[dload_buffer.read], first);
+	if (first < len)
+	{
+		can_port_memory_cpy(&data[first], &dload_buffer.data[0], len - first);
+	}
+
+	/* service read pointer */
+	dload_buffer.read += len;
+	if (dload_buffer.read >= LI_CAN_SLV_XLOAD_BUFFER_SIZE_DLOAD)
+	{
+		dload_buffer.read -= LI_CAN_SLV_XLOAD_BUFFER_SIZE_DLOAD;
+	}
+	dload_buffer.nr_bytes -= len;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
 /**
  * @brief get 8 bit value as string (1 character 0x30 --> '0') from download circular buffer
- * @remarks the function xload_buffer_get_byte is called to read the byte from the circular buffer
+ * @remarks the function xload_buffer_get_bytes is called to read the characters from the circular buffer
  * @param data pointer to the data
  * @return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
  */
 li_can_slv_errorcode_t dload_get_str_byte(byte_t *data)
 {
 	char_t str[2];
-	uint16_t i;
-	li_can_slv_errorcode_t rc = LI_CAN_SLV_ERR_OK;
+	li_can_slv_errorcode_t rc;
 
-	for (i = 0; i < 2; i++)
+	rc = xload_buffer_get_bytes((byte_t *) &str[0], 2);
+	if (rc != LI_CAN_SLV_ERR_OK)
 	{
-		rc = xload_buffer_get_byte((byte_t *) &str[i]);
-		if (rc != LI_CAN_SLV_ERR_OK)
-		{
-			return (rc);
-		}
+		return (rc);
 	}
 
 	*data = (byte_t) dload_hexchar_to_uint32(&str[0], 2);
@@ -160,23 +238,19 @@ li_can_slv_errorcode_t dload_get_str_byte(byte_t *data)
 
 /**
  * @brief get 16 bit value as string (2 characters 0x30 --> '0') from download circular buffer
- * @remarks the function xload_buffer_get_byte is called to read the bytes from the circular buffer
+ * @remarks the function xload_buffer_get_bytes is called to read the characters from the circular buffer
  * @param data pointer to data
  * @return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
  */
 li_can_slv_errorcode_t dload_get_str_uint16(uint16_t *data)
 {
 	char_t str[2];
-	uint16_t i;
-	li_can_slv_errorcode_t rc = LI_CAN_SLV_ERR_OK;
+	li_can_slv_errorcode_t rc;
 
-	for (i = 0; i < 2; i++)
+	rc = xload_buffer_get_bytes((byte_t *) &str[0], 2);
+	if (rc != LI_CAN_SLV_ERR_OK)
 	{
-		rc = xload_buffer_get_byte((byte_t *) &str[i]);
-		if (rc != LI_CAN_SLV_ERR_OK)
-		{
-			return (rc);
-		}
+		return (rc);
 	}
 
 	*data = (uint16_t) dload_hexchar_to_uint32(&str[0], 2);
@@ -185,23 +259,19 @@ li_can_slv_errorcode_t dload_get_str_uint16(uint16_t *data)
 
 /**
  * @brief get 32 bit value as string (4 characters 0x30 --> '0') from download circular buffer
- * @remarks the function xload_buffer_get_byte is called to read the bytes from the circular buffer
+ * @remarks the function xload_buffer_get_bytes is called to read the characters from the circular buffer
  * @param data pointer to data
  * @return	li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
  */
 li_can_slv_errorcode_t dload_get_str_uint32(uint32_t *data)
 {
 	char_t str[4];
-	uint16_t i;
-	li_can_slv_errorcode_t rc = LI_CAN_SLV_ERR_OK;
+	li_can_slv_errorcode_t rc;
 
-	for (i = 0; i < 4; i++)
+	rc = xload_buffer_get_bytes((byte_t *) &str[0], 4);
+	if (rc != LI_CAN_SLV_ERR_OK)
 	{
-		rc = xload_buffer_get_byte((byte_t *) &str[i]);
-		if (rc != LI_CAN_SLV_ERR_OK)
-		{
-			return (rc);
-		}
+		return (rc);
 	}
 
 	*data = dload_hexchar_to_uint32(&str[0], 4);
@@ -245,7 +315,7 @@ li_can_slv_errorcode_t dload_restore_buf_state(void)
 #if defined(OUTER) || defined(OUTER_APP)
 /**
  * @brief adds max_length bytes to the download circular buffer
- * @remarks it calls the function add_byte_to_buffer
+ * @remarks it calls the function dload_add_bytes_to_buffer
  * @param src data bytes add to circular buffer
  * @param max_length number of bytes add to buffer
  * @return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
@@ -253,18 +323,10 @@ li_can_slv_errorcode_t dload_restore_buf_state(void)
 li_can_slv_errorcode_t dload_add_str_to_buffer(byte_t *src, uint16_t max_length)
 {
 	li_can_slv_errorcode_t rc = LI_CAN_SLV_ERR_OK;
-	uint16_t icnt = 0;
 
 	if (max_length < (LI_CAN_SLV_XLOAD_BUFFER_SIZE_DLOAD - dload_buffer.nr_bytes))
 	{
-		for (icnt = 0; ((icnt < max_length) && (rc == LI_CAN_SLV_ERR_OK)); icnt++)
-		{
-			rc = dload_add_byte_to_buffer(*(src + icnt));
-			if (rc != LI_CAN_SLV_ERR_OK)
-			{
-				return rc;
-			}
-		}
+		rc = dload_add_bytes_to_buffer(src, max_length);
 	}
 	else
 	{
@@ -369,6 +431,43 @@ li_can_slv_errorcode_t dload_remove_bytes(uint16_t num)
 	return (LI_CAN_SLV_ERR_OK);
 }
 
+#ifdef LI_CAN_SLV_DLOAD_CRC_CHECK
+/**
+ * @brief updates a CRC16 with the bytes last added to the download circular buffer
+ * @remarks the bytes stay in the buffer, the span is passed with at most two updates around the end of the circular
+ * buffer
+ * @param crc CRC of the previous data
+ * @param num number of bytes, at most the number of bytes in the buffer
+ * @return updated CRC
+ */
+uint16_t dload_crc16_update_last_bytes(uint16_t crc, uint16_t num)
+{
+	uint16_t start;
+
+	if (num > dload_buffer.nr_bytes)
+	{
+		num = dload_buffer.nr_bytes;
+	}
+
+	if (dload_buffer.write >= num)
+	{
+		start = dload_buffer.write - num;
+	}
+	else
+	{
+		start = LI_CAN_SLV_XLOAD_BUFFER_SIZE_DLOAD - num + dload_buffer.write;
+	}
+
+	if ((start + num) > LI_CAN_SLV_XLOAD_BUFFER_SIZE_DLOAD)
+	{
+		crc = li_can_slv_xload_crc16_update(crc, &dload_buffer.data[start], LI_CAN_SLV_XLOAD_BUFFER_SIZE_DLOAD - start);
+		num -= (LI_CAN_SLV_XLOAD_BUFFER_SIZE_DLOAD - start);
+		start = 0;
+	}
+	return (li_can_slv_xload_crc16_update(crc, &dload_buffer.data[start], num));
+}
+#endif // #ifdef LI_CAN_SLV_DLOAD_CRC_CHECK
+
 /*--------------------------------------------------------------------------*/
 /* function definition (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
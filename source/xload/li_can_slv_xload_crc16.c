@@ -0,0 +1,392 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/**
+ * @file li_can_slv_xload_crc16.c
+ * @brief table driven CRC16 of the download and the xload info
+ * @addtogroup lcs_xload
+ * @{
+ */
+
+/*--------------------------------------------------------------------------*/
+/* include files                                                            */
+/*--------------------------------------------------------------------------*/
+#include <li_can_slv/xload/li_can_slv_xload_crc16.h>
+
+#ifdef LI_CAN_SLV_XLOAD_CRC16
+/*--------------------------------------------------------------------------*/
+/* general definitions (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+#define CRC16_INIT	(0xFFFFu) /**< initial value of CRC-16/CCITT-FALSE */
+
+#ifndef LI_CAN_SLV_XLOAD_CRC16_SLICE
+#define LI_CAN_SLV_XLOAD_CRC16_SLICE	(1) /**< number of bytes processed per step */
+#endif // #ifndef LI_CAN_SLV_XLOAD_CRC16_SLICE
+#if (LI_CAN_SLV_XLOAD_CRC16_SLICE != 1) && (LI_CAN_SLV_XLOAD_CRC16_SLICE != 4) && (LI_CAN_SLV_XLOAD_CRC16_SLICE != 8)
+#error LI_CAN_SLV_XLOAD_CRC16_SLICE must be 1, 4 or 8
+#endif
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions (private/not exported)                        */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (public/exported)                                       */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (private/not exported)                                  */
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief CRC of the byte value followed by the 8 bits of the previous CRC, polynomial 0x1021
+ */
+static const uint16_t crc16_table[256] =
+{
+	0x0000u, 0x1021u, 0x2042u, 0x3063u, 0x4084u, 0x50A5u, 0x60C6u, 0x70E7u,
+	0x8108u, 0x9129u, 0xA14Au, 0xB16Bu, 0xC18Cu, 0xD1ADu, 0xE1CEu, 0xF1EFu,
+	0x1231u, 0x0210u, 0x3273u, 0x2252u, 0x52B5u, 0x4294u, 0x72F7u, 0x62D6u,
+	0x9339u, 0x8318u, 0xB37Bu, 0xA35Au, 0xD3BDu, 0xC39Cu, 0xF3FFu, 0xE3DEu,
+	0x2462u, 0x3443u, 0x0420u, 0x1401u, 0x64E6u, 0x74C7u, 0x44A4u, 0x5485u,
+	0xA56Au, 0xB54Bu, 0x8528u, 0x9509u, 0xE5EEu, 0xF5CFu, 0xC5ACu, 0xD58Du,
+	0x3653u, 0x2672u, 0x1611u, 0x0630u, 0x76D7u, 0x66F6u, 0x5695u, 0x46B4u,
+	0xB75Bu, 0xA77Au, 0x9719u, 0x8738u, 0xF7DFu, 0xE7FEu, 0xD79Du, 0xC7BCu,
+	0x48C4u, 0x58E5u, 0x6886u, 0x78A7u, 0x0840u, 0x1861u, 0x2802u, 0x3823u,
+	0xC9CCu, 0xD9EDu, 0xE98Eu, 0xF9AFu, 0x8948u, 0x9969u, 0xA90Au, 0xB92Bu,
+	0x5AF5u, 0x4AD4u, 0x7AB7u, 0x6A96u, 0x1A71u, 0x0A50u, 0x3A33u, 0x2A12u,
+	0xDBFDu, 0xCBDCu, 0xFBBFu, 0xEB9Eu, 0x9B79u, 0x8B58u, 0xBB3Bu, 0xAB1Au,
+	0x6CA6u, 0x7C87u, 0x4CE4u, 0x5CC5u, 0x2C22u, 0x3C03u, 0x0C60u, 0x1C41u,
+	0xEDAEu, 0xFD8Fu, 0xCDECu, 0xDDCDu, 0xAD2Au, 0xBD0Bu, 0x8D68u, 0x9D49u,
+	0x7E97u, 0x6EB6u, 0x5ED5u, 0x4EF4u, 0x3E13u, 0x2E32u, 0x1E51u, 0x0E70u,
+	0xFF9Fu, 0xEFBEu, 0xDFDDu, 0xCFFCu, 0xBF1Bu, 0xAF3Au, 0x9F59u, 0x8F78u,
+	0x9188u, 0x81A9u, 0xB1CAu, 0xA1EBu, 0xD10Cu, 0xC12Du, 0xF14Eu, 0xE16Fu,
+	0x1080u, 0x00A1u, 0x30C2u, 0x20E3u, 0x5004u, 0x4025u, 0x7046u, 0x6067u,
+	0x83B9u, 0x9398u, 0xA3FBu, 0xB3DAu, 0xC33Du, 0xD31Cu, 0xE37Fu, 0xF35Eu,
+	0x02B1u, 0x1290u, 0x22F3u, 0x32D2u, 0x4235u, 0x5214u, 0x6277u, 0x7256u,
+	0xB5EAu, 0xA5CBu, 0x95A8u, 0x8589u, 0xF56Eu, 0xE54Fu, 0xD52Cu, 0xC50Du,
+	0x34E2u, 0x24C3u, 0x14A0u, 0x0481u, 0x7466u, 0x6447u, 0x5424u, 0x4405u,
+	0xA7DBu, 0xB7FAu, 0x8799u, 0x97B8u, 0xE75Fu, 0xF77Eu, 0xC71Du, 0xD73Cu,
+	0x26D3u, 0x36F2u, 0x0691u, 0x16B0u, 0x6657u, 0x7676u, 0x4615u, 0x5634u,
+	0xD94Cu, 0xC96Du, 0xF90Eu, 0xE92Fu, 0x99C8u, 0x89E9u, 0xB98Au, 0xA9ABu,
+	0x5844u, 0x4865u, 0x7806u, 0x6827u, 0x18C0u, 0x08E1u, 0x3882u, 0x28A3u,
+	0xCB7Du, 0xDB5Cu, 0xEB3Fu, 0xFB1Eu, 0x8BF9u, 0x9BD8u, 0xABBBu, 0xBB9Au,
+	0x4A75u, 0x5A54u, 0x6A37u, 0x7A16u, 0x0AF1u, 0x1AD0u, 0x2AB3u, 0x3A92u,
+	0xFD2Eu, 0xED0Fu, 0xDD6Cu, 0xCD4Du, 0xBDAAu, 0xAD8Bu, 0x9DE8u, 0x8DC9u,
+	0x7C26u, 0x6C07u, 0x5C64u, 0x4C45u, 0x3CA2u, 0x2C83u, 0x1CE0u, 0x0CC1u,
+	0xEF1Fu, 0xFF3Eu, 0xCF5Du, 0xDF7Cu, 0xAF9Bu, 0xBFBAu, 0x8FD9u, 0x9FF8u,
+	0x6E17u, 0x7E36u, 0x4E55u, 0x5E74u, 0x2E93u, 0x3EB2u, 0x0ED1u, 0x1EF0u
+};
+
+#if LI_CAN_SLV_XLOAD_CRC16_SLICE > 1
+/**
+ * @brief crc16_slice[k - 1][x] is the CRC of the byte value x followed by k zero bytes
+ */
+static const uint16_t crc16_slice[LI_CAN_SLV_XLOAD_CRC16_SLICE - 1][256] =
+{
+	{
+		0x0000u, 0x3331u, 0x6662u, 0x5553u, 0xCCC4u, 0xFFF5u, 0xAAA6u, 0x9997u,
+		0x89A9u, 0xBA98u, 0xEFCBu, 0xDCFAu, 0x456Du, 0x765Cu, 0x230Fu, 0x103Eu,
+		0x0373u, 0x3042u, 0x6511u, 0x5620u, 0xCFB7u, 0xFC86u, 0xA9D5u, 0x9AE4u,
+		0x8ADAu, 0xB9EBu, 0xECB8u, 0xDF89u, 0x461Eu, 0x752Fu, 0x207Cu, 0x134Du,
+		0x06E6u, 0x35D7u, 0x6084u, 0x53B5u, 0xCA22u, 0xF913u, 0xAC40u, 0x9F71u,
+		0x8F4Fu, 0xBC7Eu, 0xE92Du, 0xDA1Cu, 0x438Bu, 0x70BAu, 0x25E9u, 0x16D8u,
+		0x0595u, 0x36A4u, 0x63F7u, 0x50C6u, 0xC951u, 0xFA60u, 0xAF33u, 0x9C02u,
+		0x8C3Cu, 0xBF0Du, 0xEA5Eu, 0xD96Fu, 0x40F8u, 0x73C9u, 0x269Au, 0x15ABu,
+		0x0DCCu, 0x3EFDu, 0x6BAEu, 0x589Fu, 0xC108u, 0xF239u, 0xA76Au, 0x945Bu,
+		0x8465u, 0xB754u, 0xE207u, 0xD136u, 0x48A1u, 0x7B90u, 0x2EC3u, 0x1DF2u,
+		0x0EBFu, 0x3D8Eu, 0x68DDu, 0x5BECu, 0xC27Bu, 0xF14Au, 0xA419u, 0x9728u,
+		0x8716u, 0xB427u, 0xE174u, 0xD245u, 0x4BD2u, 0x78E3u, 0x2DB0u, 0x1E81u,
+		0x0B2Au, 0x381Bu, 0x6D48u, 0x5E79u, 0xC7EEu, 0xF4DFu, 0xA18Cu, 0x92BDu,
+		0x8283u, 0xB1B2u, 0xE4E1u, 0xD7D0u, 0x4E47u, 0x7D76u, 0x2825u, 0x1B14u,
+		0x0859u, 0x3B68u, 0x6E3Bu, 0x5D0Au, 0xC49Du, 0xF7ACu, 0xA2FFu, 0x91CEu,
+		0x81F0u, 0xB2C1u, 0xE792u, 0xD4A3u, 0x4D34u, 0x7E05u, 0x2B56u, 0x1867u,
+		0x1B98u, 0x28A9u, 0x7DFAu, 0x4ECBu, 0xD75Cu, 0xE46Du, 0xB13Eu, 0x820Fu,
+		0x9231u, 0xA100u, 0xF453u, 0xC762u, 0x5EF5u, 0x6DC4u, 0x3897u, 0x0BA6u,
+		0x18EBu, 0x2BDAu, 0x7E89u, 0x4DB8u, 0xD42Fu, 0xE71Eu, 0xB24Du, 0x817Cu,
+		0x9142u, 0xA273u, 0xF720u, 0xC411u, 0x5D86u, 0x6EB7u, 0x3BE4u, 0x08D5u,
+		0x1D7Eu, 0x2E4Fu, 0x7B1Cu, 0x482Du, 0xD1BAu, 0xE28Bu, 0xB7D8u, 0x84E9u,
+		0x94D7u, 0xA7E6u, 0xF2B5u, 0xC184u, 0x5813u, 0x6B22u, 0x3E71u, 0x0D40u,
+		0x1E0Du, 0x2D3Cu, 0x786Fu, 0x4B5Eu, 0xD2C9u, 0xE1F8u, 0xB4ABu, 0x879Au,
+		0x97A4u, 0xA495u, 0xF1C6u, 0xC2F7u, 0x5B60u, 0x6851u, 0x3D02u, 0x0E33u,
+		0x1654u, 0x2565u, 0x7036u, 0x4307u, 0xDA90u, 0xE9A1u, 0xBCF2u, 0x8FC3u,
+		0x9FFDu, 0xACCCu, 0xF99Fu, 0xCAAEu, 0x5339u, 0x6008u, 0x355Bu, 0x066Au,
+		0x1527u, 0x2616u, 0x7345u, 0x4074u, 0xD9E3u, 0xEAD2u, 0xBF81u, 0x8CB0u,
+		0x9C8Eu, 0xAFBFu, 0xFAECu, 0xC9DDu, 0x504Au, 0x637Bu, 0x3628u, 0x0519u,
+		0x10B2u, 0x2383u, 0x76D0u, 0x45E1u, 0xDC76u, 0xEF47u, 0xBA14u, 0x8925u,
+		0x991Bu, 0xAA2Au, 0xFF79u, 0xCC48u, 0x55DFu, 0x66EEu, 0x33BDu, 0x008Cu,
+		0x13C1u, 0x20F0u, 0x75A3u, 0x4692u, 0xDF05u, 0xEC34u, 0xB967u, 0x8A56u,
+		0x9A68u, 0xA959u, 0xFC0Au, 0xCF3Bu, 0x56ACu, 0x659Du, 0x30CEu, 0x03FFu
+	},
+	{
+		0x0000u, 0x3730u, 0x6E60u, 0x5950u, 0xDCC0u, 0xEBF0u, 0xB2A0u, 0x8590u,
+		0xA9A1u, 0x9E91u, 0xC7C1u, 0xF0F1u, 0x7561u, 0x4251u, 0x1B01u, 0x2C31u,
+		0x4363u, 0x7453u, 0x2D03u, 0x1A33u, 0x9FA3u, 0xA893u, 0xF1C3u, 0xC6F3u,
+		0xEAC2u, 0xDDF2u, 0x84A2u, 0xB392u, 0x3602u, 0x0132u, 0x5862u, 0x6F52u,
+		0x86C6u, 0xB1F6u, 0xE8A6u, 0xDF96u, 0x5A06u, 0x6D36u, 0x3466u, 0x0356u,
+		0x2F67u, 0x1857u, 0x4107u, 0x7637u, 0xF3A7u, 0xC497u, 0x9DC7u, 0xAAF7u,
+		0xC5A5u, 0xF295u, 0xABC5u, 0x9CF5u, 0x1965u, 0x2E55u, 0x7705u, 0x4035u,
+		0x6C04u, 0x5B34u, 0x0264u, 0x3554u, 0xB0C4u, 0x87F4u, 0xDEA4u, 0xE994u,
+		0x1DADu, 0x2A9Du, 0x73CDu, 0x44FDu, 0xC16Du, 0xF65Du, 0xAF0Du, 0x983Du,
+		0xB40Cu, 0x833Cu, 0xDA6Cu, 0xED5Cu, 0x68CCu, 0x5FFCu, 0x06ACu, 0x319Cu,
+		0x5ECEu, 0x69FEu, 0x30AEu, 0x079Eu, 0x820Eu, 0xB53Eu, 0xEC6Eu, 0xDB5Eu,
+		0xF76Fu, 0xC05Fu, 0x990Fu, 0xAE3Fu, 0x2BAFu, 0x1C9Fu, 0x45CFu, 0x72FFu,
+		0x9B6Bu, 0xAC5Bu, 0xF50Bu, 0xC23Bu, 0x47ABu, 0x709Bu, 0x29CBu, 0x1EFBu,
+		0x32CAu, 0x05FAu, 0x5CAAu, 0x6B9Au, 0xEE0Au, 0xD93Au, 0x806Au, 0xB75Au,
+		0xD808u, 0xEF38u, 0xB668u, 0x8158u, 0x04C8u, 0x33F8u, 0x6AA8u, 0x5D98u,
+		0x71A9u, 0x4699u, 0x1FC9u, 0x28F9u, 0xAD69u, 0x9A59u, 0xC309u, 0xF439u,
+		0x3B5Au, 0x0C6Au, 0x553Au, 0x620Au, 0xE79Au, 0xD0AAu, 0x89FAu, 0xBECAu,
+		0x92FBu, 0xA5CBu, 0xFC9Bu, 0xCBABu, 0x4E3Bu, 0x790Bu, 0x205Bu, 0x176Bu,
+		0x7839u, 0x4F09u, 0x1659u, 0x2169u, 0xA4F9u, 0x93C9u, 0xCA99u, 0xFDA9u,
+		0xD198u, 0xE6A8u, 0xBFF8u, 0x88C8u, 0x0D58u, 0x3A68u, 0x6338u, 0x5408u,
+		0xBD9Cu, 0x8AACu, 0xD3FCu, 0xE4CCu, 0x615Cu, 0x566Cu, 0x0F3Cu, 0x380Cu,
+		0x143Du, 0x230Du, 0x7A5Du, 0x4D6Du, 0xC8FDu, 0xFFCDu, 0xA69Du, 0x91ADu,
+		0xFEFFu, 0xC9CFu, 0x909Fu, 0xA7AFu, 0x223Fu, 0x150Fu, 0x4C5Fu, 0x7B6Fu,
+		0x575Eu, 0x606Eu, 0x393Eu, 0x0E0Eu, 0x8B9Eu, 0xBCAEu, 0xE5FEu, 0xD2CEu,
+		0x26F7u, 0x11C7u, 0x4897u, 0x7FA7u, 0xFA37u, 0xCD07u, 0x9457u, 0xA367u,
+		0x8F56u, 0xB866u, 0xE136u, 0xD606u, 0x5396u, 0x64A6u, 0x3DF6u, 0x0AC6u,
+		0x6594u, 0x52A4u, 0x0BF4u, 0x3CC4u, 0xB954u, 0x8E64u, 0xD734u, 0xE004u,
+		0xCC35u, 0xFB05u, 0xA255u, 0x9565u, 0x10F5u, 0x27C5u, 0x7E95u, 0x49A5u,
+		0xA031u, 0x9701u, 0xCE51u, 0xF961u, 0x7CF1u, 0x4BC1u, 0x1291u, 0x25A1u,
+		0x0990u, 0x3EA0u, 0x67F0u, 0x50C0u, 0xD550u, 0xE260u, 0xBB30u, 0x8C00u,
+		0xE352u, 0xD462u, 0x8D32u, 0xBA02u, 0x3F92u, 0x08A2u, 0x51F2u, 0x66C2u,
+		0x4AF3u, 0x7DC3u, 0x2493u, 0x13A3u, 0x9633u, 0xA103u, 0xF853u, 0xCF63u
+	},
+	{
+		0x0000u, 0x76B4u, 0xED68u, 0x9BDCu, 0xCAF1u, 0xBC45u, 0x2799u, 0x512Du,
+		0x85C3u, 0xF377u, 0x68ABu, 0x1E1Fu, 0x4F32u, 0x3986u, 0xA25Au, 0xD4EEu,
+		0x1BA7u, 0x6D13u, 0xF6CFu, 0x807Bu, 0xD156u, 0xA7E2u, 0x3C3Eu, 0x4A8Au,
+		0x9E64u, 0xE8D0u, 0x730Cu, 0x05B8u, 0x5495u, 0x2221u, 0xB9FDu, 0xCF49u,
+		0x374Eu, 0x41FAu, 0xDA26u, 0xAC92u, 0xFDBFu, 0x8B0Bu, 0x10D7u, 0x6663u,
+		0xB28Du, 0xC439u, 0x5FE5u, 0x2951u, 0x787Cu, 0x0EC8u, 0x9514u, 0xE3A0u,
+		0x2CE9u, 0x5A5Du, 0xC181u, 0xB735u, 0xE618u, 0x90ACu, 0x0B70u, 0x7DC4u,
+		0xA92Au, 0xDF9Eu, 0x4442u, 0x32F6u, 0x63DBu, 0x156Fu, 0x8EB3u, 0xF807u,
+		0x6E9Cu, 0x1828u, 0x83F4u, 0xF540u, 0xA46Du, 0xD2D9u, 0x4905u, 0x3FB1u,
+		0xEB5Fu, 0x9DEBu, 0x0637u, 0x7083u, 0x21AEu, 0x571Au, 0xCCC6u, 0xBA72u,
+		0x753Bu, 0x038Fu, 0x9853u, 0xEEE7u, 0xBFCAu, 0xC97Eu, 0x52A2u, 0x2416u,
+		0xF0F8u, 0x864Cu, 0x1D90u, 0x6B24u, 0x3A09u, 0x4CBDu, 0xD761u, 0xA1D5u,
+		0x59D2u, 0x2F66u, 0xB4BAu, 0xC20Eu, 0x9323u, 0xE597u, 0x7E4Bu, 0x08FFu,
+		0xDC11u, 0xAAA5u, 0x3179u, 0x47CDu, 0x16E0u, 0x6054u, 0xFB88u, 0x8D3Cu,
+		0x4275u, 0x34C1u, 0xAF1Du, 0xD9A9u, 0x8884u, 0xFE30u, 0x65ECu, 0x1358u,
+		0xC7B6u, 0xB102u, 0x2ADEu, 0x5C6Au, 0x0D47u, 0x7BF3u, 0xE02Fu, 0x969Bu,
+		0xDD38u, 0xAB8Cu, 0x3050u, 0x46E4u, 0x17C9u, 0x617Du, 0xFAA1u, 0x8C15u,
+		0x58FBu, 0x2E4Fu, 0xB593u, 0xC327u, 0x920Au, 0xE4BEu, 0x7F62u, 0x09D6u,
+		0xC69Fu, 0xB02Bu, 0x2BF7u, 0x5D43u, 0x0C6Eu, 0x7ADAu, 0xE106u, 0x97B2u,
+		0x435Cu, 0x35E8u, 0xAE34u, 0xD880u, 0x89ADu, 0xFF19u, 0x64C5u, 0x1271u,
+		0xEA76u, 0x9CC2u, 0x071Eu, 0x71AAu, 0x2087u, 0x5633u, 0xCDEFu, 0xBB5Bu,
+		0x6FB5u, 0x1901u, 0x82DDu, 0xF469u, 0xA544u, 0xD3F0u, 0x482Cu, 0x3E98u,
+		0xF1D1u, 0x8765u, 0x1CB9u, 0x6A0Du, 0x3B20u, 0x4D94u, 0xD648u, 0xA0FCu,
+		0x7412u, 0x02A6u, 0x997Au, 0xEFCEu, 0xBEE3u, 0xC857u, 0x538Bu, 0x253Fu,
+		0xB3A4u, 0xC510u, 0x5ECCu, 0x2878u, 0x7955u, 0x0FE1u, 0x943Du, 0xE289u,
+		0x3667u, 0x40D3u, 0xDB0Fu, 0xADBBu, 0xFC96u, 0x8A22u, 0x11FEu, 0x674Au,
+		0xA803u, 0xDEB7u, 0x456Bu, 0x33DFu, 0x62F2u, 0x1446u, 0x8F9Au, 0xF92Eu,
+		0x2DC0u, 0x5B74u, 0xC0A8u, 0xB61Cu, 0xE731u, 0x9185u, 0x0A59u, 0x7CEDu,
+		0x84EAu, 0xF25Eu, 0x6982u, 0x1F36u, 0x4E1Bu, 0x38AFu, 0xA373u, 0xD5C7u,
+		0x0129u, 0x779Du, 0xEC41u, 0x9AF5u, 0xCBD8u, 0xBD6Cu, 0x26B0u, 0x5004u,
+		0x9F4Du, 0xE9F9u, 0x7225u, 0x0491u, 0x55BCu, 0x2308u, 0xB8D4u, 0xCE60u,
+		0x1A8Eu, 0x6C3Au, 0xF7E6u, 0x8152u, 0xD07Fu, 0xA6CBu, 0x3D17u, 0x4BA3u
+	},
+#if LI_CAN_SLV_XLOAD_CRC16_SLICE == 8
+	{
+		0x0000u, 0xAA51u, 0x4483u, 0xEED2u, 0x8906u, 0x2357u, 0xCD85u, 0x67D4u,
+		0x022Du, 0xA87Cu, 0x46AEu, 0xECFFu, 0x8B2Bu, 0x217Au, 0xCFA8u, 0x65F9u,
+		0x045Au, 0xAE0Bu, 0x40D9u, 0xEA88u, 0x8D5Cu, 0x270Du, 0xC9DFu, 0x638Eu,
+		0x0677u, 0xAC26u, 0x42F4u, 0xE8A5u, 0x8F71u, 0x2520u, 0xCBF2u, 0x61A3u,
+		0x08B4u, 0xA2E5u, 0x4C37u, 0xE666u, 0x81B2u, 0x2BE3u, 0xC531u, 0x6F60u,
+		0x0A99u, 0xA0C8u, 0x4E1Au, 0xE44Bu, 0x839Fu, 0x29CEu, 0xC71Cu, 0x6D4Du,
+		0x0CEEu, 0xA6BFu, 0x486Du, 0xE23Cu, 0x85E8u, 0x2FB9u, 0xC16Bu, 0x6B3Au,
+		0x0EC3u, 0xA492u, 0x4A40u, 0xE011u, 0x87C5u, 0x2D94u, 0xC346u, 0x6917u,
+		0x1168u, 0xBB39u, 0x55EBu, 0xFFBAu, 0x986Eu, 0x323Fu, 0xDCEDu, 0x76BCu,
+		0x1345u, 0xB914u, 0x57C6u, 0xFD97u, 0x9A43u, 0x3012u, 0xDEC0u, 0x7491u,
+		0x1532u, 0xBF63u, 0x51B1u, 0xFBE0u, 0x9C34u, 0x3665u, 0xD8B7u, 0x72E6u,
+		0x171Fu, 0xBD4Eu, 0x539Cu, 0xF9CDu, 0x9E19u, 0x3448u, 0xDA9Au, 0x70CBu,
+		0x19DCu, 0xB38Du, 0x5D5Fu, 0xF70Eu, 0x90DAu, 0x3A8Bu, 0xD459u, 0x7E08u,
+		0x1BF1u, 0xB1A0u, 0x5F72u, 0xF523u, 0x92F7u, 0x38A6u, 0xD674u, 0x7C25u,
+		0x1D86u, 0xB7D7u, 0x5905u, 0xF354u, 0x9480u, 0x3ED1u, 0xD003u, 0x7A52u,
+		0x1FABu, 0xB5FAu, 0x5B28u, 0xF179u, 0x96ADu, 0x3CFCu, 0xD22Eu, 0x787Fu,
+		0x22D0u, 0x8881u, 0x6653u, 0xCC02u, 0xABD6u, 0x0187u, 0xEF55u, 0x4504u,
+		0x20FDu, 0x8AACu, 0x647Eu, 0xCE2Fu, 0xA9FBu, 0x03AAu, 0xED78u, 0x4729u,
+		0x268Au, 0x8CDBu, 0x6209u, 0xC858u, 0xAF8Cu, 0x05DDu, 0xEB0Fu, 0x415Eu,
+		0x24A7u, 0x8EF6u, 0x6024u, 0xCA75u, 0xADA1u, 0x07F0u, 0xE922u, 0x4373u,
+		0x2A64u, 0x8035u, 0x6EE7u, 0xC4B6u, 0xA362u, 0x0933u, 0xE7E1u, 0x4DB0u,
+		0x2849u, 0x8218u, 0x6CCAu, 0xC69Bu, 0xA14Fu, 0x0B1Eu, 0xE5CCu, 0x4F9Du,
+		0x2E3Eu, 0x846Fu, 0x6ABDu, 0xC0ECu, 0xA738u, 0x0D69u, 0xE3BBu, 0x49EAu,
+		0x2C13u, 0x8642u, 0x6890u, 0xC2C1u, 0xA515u, 0x0F44u, 0xE196u, 0x4BC7u,
+		0x33B8u, 0x99E9u, 0x773Bu, 0xDD6Au, 0xBABEu, 0x10EFu, 0xFE3Du, 0x546Cu,
+		0x3195u, 0x9BC4u, 0x7516u, 0xDF47u, 0xB893u, 0x12C2u, 0xFC10u, 0x5641u,
+		0x37E2u, 0x9DB3u, 0x7361u, 0xD930u, 0xBEE4u, 0x14B5u, 0xFA67u, 0x5036u,
+		0x35CFu, 0x9F9Eu, 0x714Cu, 0xDB1Du, 0xBCC9u, 0x1698u, 0xF84Au, 0x521Bu,
+		0x3B0Cu, 0x915Du, 0x7F8Fu, 0xD5DEu, 0xB20Au, 0x185Bu, 0xF689u, 0x5CD8u,
+		0x3921u, 0x9370u, 0x7DA2u, 0xD7F3u, 0xB027u, 0x1A76u, 0xF4A4u, 0x5EF5u,
+		0x3F56u, 0x9507u, 0x7BD5u, 0xD184u, 0xB650u, 0x1C01u, 0xF2D3u, 0x5882u,
+		0x3D7Bu, 0x972Au, 0x79F8u, 0xD3A9u, 0xB47Du, 0x1E2Cu, 0xF0FEu, 0x5AAFu
+	},
+	{
+		0x0000u, 0x45A0u, 0x8B40u, 0xCEE0u, 0x06A1u, 0x4301u, 0x8DE1u, 0xC841u,
+		0x0D42u, 0x48E2u, 0x8602u, 0xC3A2u, 0x0BE3u, 0x4E43u, 0x80A3u, 0xC503u,
+		0x1A84u, 0x5F24u, 0x91C4u, 0xD464u, 0x1C25u, 0x5985u, 0x9765u, 0xD2C5u,
+		0x17C6u, 0x5266u, 0x9C86u, 0xD926u, 0x1167u, 0x54C7u, 0x9A27u, 0xDF87u,
+		0x3508u, 0x70A8u, 0xBE48u, 0xFBE8u, 0x33A9u, 0x7609u, 0xB8E9u, 0xFD49u,
+		0x384Au, 0x7DEAu, 0xB30Au, 0xF6AAu, 0x3EEBu, 0x7B4Bu, 0xB5ABu, 0xF00Bu,
+		0x2F8Cu, 0x6A2Cu, 0xA4CCu, 0xE16Cu, 0x292Du, 0x6C8Du, 0xA26Du, 0xE7CDu,
+		0x22CEu, 0x676Eu, 0xA98Eu, 0xEC2Eu, 0x246Fu, 0x61CFu, 0xAF2Fu, 0xEA8Fu,
+		0x6A10u, 0x2FB0u, 0xE150u, 0xA4F0u, 0x6CB1u, 0x2911u, 0xE7F1u, 0xA251u,
+		0x6752u, 0x22F2u, 0xEC12u, 0xA9B2u, 0x61F3u, 0x2453u, 0xEAB3u, 0xAF13u,
+		0x7094u, 0x3534u, 0xFBD4u, 0xBE74u, 0x7635u, 0x3395u, 0xFD75u, 0xB8D5u,
+		0x7DD6u, 0x3876u, 0xF696u, 0xB336u, 0x7B77u, 0x3ED7u, 0xF037u, 0xB597u,
+		0x5F18u, 0x1AB8u, 0xD458u, 0x91F8u, 0x59B9u, 0x1C19u, 0xD2F9u, 0x9759u,
+		0x525Au, 0x17FAu, 0xD91Au, 0x9CBAu, 0x54FBu, 0x115Bu, 0xDFBBu, 0x9A1Bu,
+		0x459Cu, 0x003Cu, 0xCEDCu, 0x8B7Cu, 0x433Du, 0x069Du, 0xC87Du, 0x8DDDu,
+		0x48DEu, 0x0D7Eu, 0xC39Eu, 0x863Eu, 0x4E7Fu, 0x0BDFu, 0xC53Fu, 0x809Fu,
+		0xD420u, 0x9180u, 0x5F60u, 0x1AC0u, 0xD281u, 0x9721u, 0x59C1u, 0x1C61u,
+		0xD962u, 0x9CC2u, 0x5222u, 0x1782u, 0xDFC3u, 0x9A63u, 0x5483u, 0x1123u,
+		0xCEA4u, 0x8B04u, 0x45E4u, 0x0044u, 0xC805u, 0x8DA5u, 0x4345u, 0x06E5u,
+		0xC3E6u, 0x8646u, 0x48A6u, 0x0D06u, 0xC547u, 0x80E7u, 0x4E07u, 0x0BA7u,
+		0xE128u, 0xA488u, 0x6A68u, 0x2FC8u, 0xE789u, 0xA229u, 0x6CC9u, 0x2969u,
+		0xEC6Au, 0xA9CAu, 0x672Au, 0x228Au, 0xEACBu, 0xAF6Bu, 0x618Bu, 0x242Bu,
+		0xFBACu, 0xBE0Cu, 0x70ECu, 0x354Cu, 0xFD0Du, 0xB8ADu, 0x764Du, 0x33EDu,
+		0xF6EEu, 0xB34Eu, 0x7DAEu, 0x380Eu, 0xF04Fu, 0xB5EFu, 0x7B0Fu, 0x3EAFu,
+		0xBE30u, 0xFB90u, 0x3570u, 0x70D0u, 0xB891u, 0xFD31u, 0x33D1u, 0x7671u,
+		0xB372u, 0xF6D2u, 0x3832u, 0x7D92u, 0xB5D3u, 0xF073u, 0x3E93u, 0x7B33u,
+		0xA4B4u, 0xE114u, 0x2FF4u, 0x6A54u, 0xA215u, 0xE7B5u, 0x2955u, 0x6CF5u,
+		0xA9F6u, 0xEC56u, 0x22B6u, 0x6716u, 0xAF57u, 0xEAF7u, 0x2417u, 0x61B7u,
+		0x8B38u, 0xCE98u, 0x0078u, 0x45D8u, 0x8D99u, 0xC839u, 0x06D9u, 0x4379u,
+		0x867Au, 0xC3DAu, 0x0D3Au, 0x489Au, 0x80DBu, 0xC57Bu, 0x0B9Bu, 0x4E3Bu,
+		0x91BCu, 0xD41Cu, 0x1AFCu, 0x5F5Cu, 0x971Du, 0xD2BDu, 0x1C5Du, 0x59FDu,
+		0x9CFEu, 0xD95Eu, 0x17BEu, 0x521Eu, 0x9A5Fu, 0xDFFFu, 0x111Fu, 0x54BFu
+	},
+	{
+		0x0000u, 0xB861u, 0x60E3u, 0xD882u, 0xC1C6u, 0x79A7u, 0xA125u, 0x1944u,
+		0x93ADu, 0x2BCCu, 0xF34Eu, 0x4B2Fu, 0x526Bu, 0xEA0Au, 0x3288u, 0x8AE9u,
+		0x377Bu, 0x8F1Au, 0x5798u, 0xEFF9u, 0xF6BDu, 0x4EDCu, 0x965Eu, 0x2E3Fu,
+		0xA4D6u, 0x1CB7u, 0xC435u, 0x7C54u, 0x6510u, 0xDD71u, 0x05F3u, 0xBD92u,
+		0x6EF6u, 0xD697u, 0x0E15u, 0xB674u, 0xAF30u, 0x1751u, 0xCFD3u, 0x77B2u,
+		0xFD5Bu, 0x453Au, 0x9DB8u, 0x25D9u, 0x3C9Du, 0x84FCu, 0x5C7Eu, 0xE41Fu,
+		0x598Du, 0xE1ECu, 0x396Eu, 0x810Fu, 0x984Bu, 0x202Au, 0xF8A8u, 0x40C9u,
+		0xCA20u, 0x7241u, 0xAAC3u, 0x12A2u, 0x0BE6u, 0xB387u, 0x6B05u, 0xD364u,
+		0xDDECu, 0x658Du, 0xBD0Fu, 0x056Eu, 0x1C2Au, 0xA44Bu, 0x7CC9u, 0xC4A8u,
+		0x4E41u, 0xF620u, 0x2EA2u, 0x96C3u, 0x8F87u, 0x37E6u, 0xEF64u, 0x5705u,
+		0xEA97u, 0x52F6u, 0x8A74u, 0x3215u, 0x2B51u, 0x9330u, 0x4BB2u, 0xF3D3u,
+		0x793Au, 0xC15Bu, 0x19D9u, 0xA1B8u, 0xB8FCu, 0x009Du, 0xD81Fu, 0x607Eu,
+		0xB31Au, 0x0B7Bu, 0xD3F9u, 0x6B98u, 0x72DCu, 0xCABDu, 0x123Fu, 0xAA5Eu,
+		0x20B7u, 0x98D6u, 0x4054u, 0xF835u, 0xE171u, 0x5910u, 0x8192u, 0x39F3u,
+		0x8461u, 0x3C00u, 0xE482u, 0x5CE3u, 0x45A7u, 0xFDC6u, 0x2544u, 0x9D25u,
+		0x17CCu, 0xAFADu, 0x772Fu, 0xCF4Eu, 0xD60Au, 0x6E6Bu, 0xB6E9u, 0x0E88u,
+		0xABF9u, 0x1398u, 0xCB1Au, 0x737Bu, 0x6A3Fu, 0xD25Eu, 0x0ADCu, 0xB2BDu,
+		0x3854u, 0x8035u, 0x58B7u, 0xE0D6u, 0xF992u, 0x41F3u, 0x9971u, 0x2110u,
+		0x9C82u, 0x24E3u, 0xFC61u, 0x4400u, 0x5D44u, 0xE525u, 0x3DA7u, 0x85C6u,
+		0x0F2Fu, 0xB74Eu, 0x6FCCu, 0xD7ADu, 0xCEE9u, 0x7688u, 0xAE0Au, 0x166Bu,
+		0xC50Fu, 0x7D6Eu, 0xA5ECu, 0x1D8Du, 0x04C9u, 0xBCA8u, 0x642Au, 0xDC4Bu,
+		0x56A2u, 0xEEC3u, 0x3641u, 0x8E20u, 0x9764u, 0x2F05u, 0xF787u, 0x4FE6u,
+		0xF274u, 0x4A15u, 0x9297u, 0x2AF6u, 0x33B2u, 0x8BD3u, 0x5351u, 0xEB30u,
+		0x61D9u, 0xD9B8u, 0x013Au, 0xB95Bu, 0xA01Fu, 0x187Eu, 0xC0FCu, 0x789Du,
+		0x7615u, 0xCE74u, 0x16F6u, 0xAE97u, 0xB7D3u, 0x0FB2u, 0xD730u, 0x6F51u,
+		0xE5B8u, 0x5DD9u, 0x855Bu, 0x3D3Au, 0x247Eu, 0x9C1Fu, 0x449Du, 0xFCFCu,
+		0x416Eu, 0xF90Fu, 0x218Du, 0x99ECu, 0x80A8u, 0x38C9u, 0xE04Bu, 0x582Au,
+		0xD2C3u, 0x6AA2u, 0xB220u, 0x0A41u, 0x1305u, 0xAB64u, 0x73E6u, 0xCB87u,
+		0x18E3u, 0xA082u, 0x7800u, 0xC061u, 0xD925u, 0x6144u, 0xB9C6u, 0x01A7u,
+		0x8B4Eu, 0x332Fu, 0xEBADu, 0x53CCu, 0x4A88u, 0xF2E9u, 0x2A6Bu, 0x920Au,
+		0x2F98u, 0x97F9u, 0x4F7Bu, 0xF71Au, 0xEE5Eu, 0x563Fu, 0x8EBDu, 0x36DCu,
+		0xBC35u, 0x0454u, 0xDCD6u, 0x64B7u, 0x7DF3u, 0xC592u, 0x1D10u, 0xA571u
+	},
+	{
+		0x0000u, 0x47D3u, 0x8FA6u, 0xC875u, 0x0F6Du, 0x48BEu, 0x80CBu, 0xC718u,
+		0x1EDAu, 0x5909u, 0x917Cu, 0xD6AFu, 0x11B7u, 0x5664u, 0x9E11u, 0xD9C2u,
+		0x3DB4u, 0x7A67u, 0xB212u, 0xF5C1u, 0x32D9u, 0x750Au, 0xBD7Fu, 0xFAACu,
+		0x236Eu, 0x64BDu, 0xACC8u, 0xEB1Bu, 0x2C03u, 0x6BD0u, 0xA3A5u, 0xE476u,
+		0x7B68u, 0x3CBBu, 0xF4CEu, 0xB31Du, 0x7405u, 0x33D6u, 0xFBA3u, 0xBC70u,
+		0x65B2u, 0x2261u, 0xEA14u, 0xADC7u, 0x6ADFu, 0x2D0Cu, 0xE579u, 0xA2AAu,
+		0x46DCu, 0x010Fu, 0xC97Au, 0x8EA9u, 0x49B1u, 0x0E62u, 0xC617u, 0x81C4u,
+		0x5806u, 0x1FD5u, 0xD7A0u, 0x9073u, 0x576Bu, 0x10B8u, 0xD8CDu, 0x9F1Eu,
+		0xF6D0u, 0xB103u, 0x7976u, 0x3EA5u, 0xF9BDu, 0xBE6Eu, 0x761Bu, 0x31C8u,
+		0xE80Au, 0xAFD9u, 0x67ACu, 0x207Fu, 0xE767u, 0xA0B4u, 0x68C1u, 0x2F12u,
+		0xCB64u, 0x8CB7u, 0x44C2u, 0x0311u, 0xC409u, 0x83DAu, 0x4BAFu, 0x0C7Cu,
+		0xD5BEu, 0x926Du, 0x5A18u, 0x1DCBu, 0xDAD3u, 0x9D00u, 0x5575u, 0x12A6u,
+		0x8DB8u, 0xCA6Bu, 0x021Eu, 0x45CDu, 0x82D5u, 0xC506u, 0x0D73u, 0x4AA0u,
+		0x9362u, 0xD4B1u, 0x1CC4u, 0x5B17u, 0x9C0Fu, 0xDBDCu, 0x13A9u, 0x547Au,
+		0xB00Cu, 0xF7DFu, 0x3FAAu, 0x7879u, 0xBF61u, 0xF8B2u, 0x30C7u, 0x7714u,
+		0xAED6u, 0xE905u, 0x2170u, 0x66A3u, 0xA1BBu, 0xE668u, 0x2E1Du, 0x69CEu,
+		0xFD81u, 0xBA52u, 0x7227u, 0x35F4u, 0xF2ECu, 0xB53Fu, 0x7D4Au, 0x3A99u,
+		0xE35Bu, 0xA488u, 0x6CFDu, 0x2B2Eu, 0xEC36u, 0xABE5u, 0x6390u, 0x2443u,
+		0xC035u, 0x87E6u, 0x4F93u, 0x0840u, 0xCF58u, 0x888Bu, 0x40FEu, 0x072Du,
+		0xDEEFu, 0x993Cu, 0x5149u, 0x169Au, 0xD182u, 0x9651u, 0x5E24u, 0x19F7u,
+		0x86E9u, 0xC13Au, 0x094Fu, 0x4E9Cu, 0x8984u, 0xCE57u, 0x0622u, 0x41F1u,
+		0x9833u, 0xDFE0u, 0x1795u, 0x5046u, 0x975Eu, 0xD08Du, 0x18F8u, 0x5F2Bu,
+		0xBB5Du, 0xFC8Eu, 0x34FBu, 0x7328u, 0xB430u, 0xF3E3u, 0x3B96u, 0x7C45u,
+		0xA587u, 0xE254u, 0x2A21u, 0x6DF2u, 0xAAEAu, 0xED39u, 0x254Cu, 0x629Fu,
+		0x0B51u, 0x4C82u, 0x84F7u, 0xC324u, 0x043Cu, 0x43EFu, 0x8B9Au, 0xCC49u,
+		0x158Bu, 0x5258u, 0x9A2Du, 0xDDFEu, 0x1AE6u, 0x5D35u, 0x9540u, 0xD293u,
+		0x36E5u, 0x7136u, 0xB943u, 0xFE90u, 0x3988u, 0x7E5Bu, 0xB62Eu, 0xF1FDu,
+		0x283Fu, 0x6FECu, 0xA799u, 0xE04Au, 0x2752u, 0x6081u, 0xA8F4u, 0xEF27u,
+		0x7039u, 0x37EAu, 0xFF9Fu, 0xB84Cu, 0x7F54u, 0x3887u, 0xF0F2u, 0xB721u,
+		0x6EE3u, 0x2930u, 0xE145u, 0xA696u, 0x618Eu, 0x265Du, 0xEE28u, 0xA9FBu,
+		0x4D8Du, 0x0A5Eu, 0xC22Bu, 0x85F8u, 0x42E0u, 0x0533u, 0xCD46u, 0x8A95u,
+		0x5357u, 0x1484u, 0xDCF1u, 0x9B22u, 0x5C3Au, 0x1BE9u, 0xD39Cu, 0x944Fu
+	},
+#endif // #if LI_CAN_SLV_XLOAD_CRC16_SLICE == 8
+};
+#endif // #if LI_CAN_SLV_XLOAD_CRC16_SLICE > 1
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* function definition (public/exported)                                    */
+/*--------------------------------------------------------------------------*/
+uint16_t li_can_slv_xload_crc16_init(void)
+{
+	return (CRC16_INIT);
+}
+
+uint16_t li_can_slv_xload_crc16_update(uint16_t crc, const void *data, size_t data_len)
+{
+	const uint8_t *p = (const uint8_t *) data;
+
+#if LI_CAN_SLV_XLOAD_CRC16_SLICE > 1
+	// the CRC is combined with the first two bytes, every byte is then looked up by its distance to the end
+	while (data_len >= LI_CAN_SLV_XLOAD_CRC16_SLICE)
+	{
+		crc ^= (uint16_t)(((uint16_t) p[0] << 8) | p[1]);
+#if LI_CAN_SLV_XLOAD_CRC16_SLICE == 8
+		crc = crc16_slice[6][crc >> 8] ^ crc16_slice[5][crc & 0xFFu] ^ crc16_slice[4][p[2]] ^ crc16_slice[3][p[3]]
+		      ^ crc16_slice[2][p[4]] ^ crc16_slice[1][p[5]] ^ crc16_slice[0][p[6]] ^ crc16_table[p[7]];
+#else // #if LI_CAN_SLV_XLOAD_CRC16_SLICE == 8
+		crc = crc16_slice[2][crc >> 8] ^ crc16_slice[1][crc & 0xFFu] ^ crc16_slice[0][p[2]] ^ crc16_table[p[3]];
+#endif // #if LI_CAN_SLV_XLOAD_CRC16_SLICE == 8
+		p += LI_CAN_SLV_XLOAD_CRC16_SLICE;
+		data_len -= LI_CAN_SLV_XLOAD_CRC16_SLICE;
+	}
+#endif // #if LI_CAN_SLV_XLOAD_CRC16_SLICE > 1
+
+	while (data_len > 0)
+	{
+		crc = (uint16_t)(crc << 8) ^ crc16_table[(crc >> 8) ^ *p];
+		p++;
+		data_len--;
+	}
+	return (crc);
+}
+
+/*--------------------------------------------------------------------------*/
+/* function definition (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+#endif // #ifdef LI_CAN_SLV_XLOAD_CRC16
+
+/** @} */
+
@@ -30,6 +30,7 @@
 /*--------------------------------------------------------------------------*/
 #include <li_can_slv/xload/li_can_slv_xload_info.h>
 #include <li_can_slv/error/io_can_errno.h>
+#include <li_can_slv/xload/li_can_slv_xload_crc16.h>
 
 #ifdef LI_CAN_SLV_DEBUG
 #include "li_can_slv_debug.h"
@@ -41,6 +42,11 @@
 /*--------------------------------------------------------------------------*/
 /* general definitions (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
+#ifdef LI_CAN_SLV_XLOAD_CRC16
+// the built-in CRC16 replaces the CRC functions of the application
+#define li_can_slv_xload_info_crc16_init()	li_can_slv_xload_crc16_init()
+#define li_can_slv_xload_info_crc16_update(crc, data, data_len)	li_can_slv_xload_crc16_update(crc, data, data_len)
+#endif // #ifdef LI_CAN_SLV_XLOAD_CRC16
 
 /*--------------------------------------------------------------------------*/
 /* structure/type definitions (private/not exported)                        */
@@ -54,6 +60,10 @@ extern li_can_slv_xload_info_t xload_info;
 /*--------------------------------------------------------------------------*/
 /* function prototypes (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
+#ifndef LI_CAN_SLV_XLOAD_CRC16
+extern uint16_t li_can_slv_xload_info_crc16_init(void);
+extern uint16_t li_can_slv_xload_info_crc16_update(uint16_t crc, const void *data, size_t data_len);
+#endif // #ifndef LI_CAN_SLV_XLOAD_CRC16
 
 /*--------------------------------------------------------------------------*/
 /* global variables (private/not exported)                                  */
@@ -67,9 +77,6 @@ static void li_can_slv_xload_info_update_crc(void);
 /*--------------------------------------------------------------------------*/
 /* function definition (public/exported)                                    */
 /*--------------------------------------------------------------------------*/
-extern uint16_t li_can_slv_xload_info_crc16_init(void);
-extern uint16_t li_can_slv_xload_info_crc16_update(uint16_t crc, const void *data, size_t data_len);
-
 /**
  * @brief initialization of the xload_info memory
  * @return ERR_MSG_CAN_XLOAD_INFO_BAD_CRC or LI_CAN_SLV_ERR_OK
@@ -111,6 +118,11 @@ li_can_slv_errorcode_t li_can_slv_xload_info_init(void)
 			LI_CAN_SLV_DEBUG_PRINT("%c", xload_info.dload.module_type[tmp]);
 		}
 		LI_CAN_SLV_DEBUG_PRINT("\nxload_info.can_baudrate = %d", xload_info.can_baudrate);
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+		LI_CAN_SLV_DEBUG_PRINT("\nxload_info.resume.version = 0x%x", xload_info.resume.version);
+		LI_CAN_SLV_DEBUG_PRINT("\nxload_info.resume.offset = %lu", xload_info.resume.offset);
+		LI_CAN_SLV_DEBUG_PRINT("\nxload_info.resume.crc = 0x%x", xload_info.resume.crc);
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
 		LI_CAN_SLV_DEBUG_PRINT("\nxload_info.crc = 0x%x", xload_info.crc);
 
 #ifdef LI_CAN_SLV_XLOAD_INFO_USER
@@ -134,6 +146,11 @@ void li_can_slv_xload_info_clean(void)
 	xload_info.dload.crc = 0;
 	xload_info.dload.download_id = 0;
 	xload_info.dload.index_of_request = 0;
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+	xload_info.resume.version = LI_CAN_SLV_XLOAD_INFO_RESUME_VERSION;
+	xload_info.resume.offset = 0;
+	xload_info.resume.crc = 0;
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
 #ifdef LI_CAN_SLV_XLOAD_INFO_USER
 	xload_info.user1 = 0;
 	xload_info.user2 = 0;
@@ -254,6 +271,42 @@ void li_can_slv_xload_info_get_can_baudrate(uint16_t *can_baudrate)
 	*can_baudrate = xload_info.can_baudrate;
 }
 
+#ifdef LI_CAN_SLV_DLOAD_RESUME
+/**
+ * @brief set the progress of the download of the dload component
+ * @param offset number of programmed bytes
+ * @param crc running CRC16 of the programmed bytes
+ */
+void li_can_slv_xload_info_set_dload_resume(uint32_t offset, uint16_t crc)
+{
+	xload_info.resume.version = LI_CAN_SLV_XLOAD_INFO_RESUME_VERSION;
+	xload_info.resume.offset = offset;
+	xload_info.resume.crc = crc;
+	li_can_slv_xload_info_update_crc();
+}
+
+/**
+ * @brief get the progress of the download of the dload component
+ * @remarks A progress stored with another layout version, e.g. by a bootloader built with an older stack, reads as
+ * offset 0, so the download starts at 0.
+ * @param[out] offset number of programmed bytes
+ * @param[out] crc running CRC16 of the programmed bytes
+ */
+void li_can_slv_xload_info_get_dload_resume(uint32_t *offset, uint16_t *crc)
+{
+	if (xload_info.resume.version == LI_CAN_SLV_XLOAD_INFO_RESUME_VERSION)
+	{
+		*offset = xload_info.resume.offset;
+		*crc = xload_info.resume.crc;
+	}
+	else
+	{
+		*offset = 0;
+		*crc = 0;
+	}
+}
+#endif // #ifdef LI_CAN_SLV_DLOAD_RESUME
+
 #ifdef LI_CAN_SLV_XLOAD_INFO_USER
 /**
  * @param user1_data set the user1 data
@@ -0,0 +1,246 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/**
+ * @file li_can_slv_xload_lz.c
+ * @brief decompression of the compressed download data
+ * @addtogroup lcs_xload
+ * @{
+ *
+ * The compressed data is a sequence of groups. Each group starts with a flag byte followed by up to 8 items, bit 0
+ * of the flag byte belongs to the first item. A set bit marks a literal byte, a cleared bit a match of two bytes:
+ * the low 8 bits of the offset minus one, then the high 4 bits of the offset minus one in the upper nibble and the
+ * length minus 3 in the lower nibble. A match copies 3 to 18 bytes starting offset bytes back in the decompressed
+ * data, the offset must not exceed the window size.
+ */
+
+/*--------------------------------------------------------------------------*/
+/* include files                                                            */
+/*--------------------------------------------------------------------------*/
+#include <li_can_slv/xload/li_can_slv_xload_lz.h>
+#include <li_can_slv/xload/li_can_slv_xload_buffer.h>
+#include <li_can_slv/error/io_can_errno.h>
+#include "io_can_port.h"
+
+#ifdef LI_CAN_SLV_DLOAD_LZ
+/*--------------------------------------------------------------------------*/
+/* general definitions (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+#if (LI_CAN_SLV_XLOAD_LZ_WINDOW < 256) || (LI_CAN_SLV_XLOAD_LZ_WINDOW > 4096) || ((LI_CAN_SLV_XLOAD_LZ_WINDOW & (LI_CAN_SLV_XLOAD_LZ_WINDOW - 1)) != 0)
+#error LI_CAN_SLV_XLOAD_LZ_WINDOW must be a power of two from 256 to 4096
+#endif
+
+#define LZ_WINDOW_MASK		(LI_CAN_SLV_XLOAD_LZ_WINDOW - 1)
+#define LZ_MATCH_LEN_MIN	(3) /**< length of a match with the length nibble 0 */
+#define LZ_OUT_CHUNK		(32) /**< decompressed bytes added to the download buffer at once */
+
+#define LZ_STATE_FLAGS		(0) /**< the next byte is a flag byte */
+#define LZ_STATE_ITEM		(1) /**< the next byte is a literal or the first byte of a match */
+#define LZ_STATE_MATCH		(2) /**< the next byte is the second byte of a match */
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions (private/not exported)                        */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (public/exported)                                       */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (private/not exported)                                  */
+/*--------------------------------------------------------------------------*/
+static byte_t lz_in[LI_CAN_SLV_XLOAD_BUFFER_SIZE_DLOAD]; /**< compressed bytes of the received block */
+static uint16_t lz_in_len = 0; /**< number of compressed bytes of the received block */
+static uint16_t lz_out_max = 0; /**< maximum decompressed bytes of a block */
+
+static byte_t lz_window[LI_CAN_SLV_XLOAD_LZ_WINDOW]; /**< last decompressed bytes */
+static uint16_t lz_window_pos = 0; /**< next write position in the window */
+static uint16_t lz_window_fill = 0; /**< number of valid bytes in the window */
+static uint16_t lz_flags; /**< flags of the remaining items of the group above a stop bit */
+static uint16_t lz_state = LZ_STATE_FLAGS; /**< state of the decompression */
+static byte_t lz_match_low; /**< first byte of the current match */
+
+static byte_t lz_out[LZ_OUT_CHUNK]; /**< decompressed bytes not yet added to the download buffer */
+static uint16_t lz_out_len; /**< number of bytes in lz_out */
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+static li_can_slv_errorcode_t lz_emit(byte_t c, uint16_t *out_len);
+static void lz_next_item(void);
+
+/*--------------------------------------------------------------------------*/
+/* function definition (public/exported)                                    */
+/*--------------------------------------------------------------------------*/
+void dload_lz_init(uint16_t max_bytes_per_block)
+{
+	lz_in_len = 0;
+	lz_out_max = max_bytes_per_block;
+	lz_window_pos = 0;
+	lz_window_fill = 0;
+	lz_state = LZ_STATE_FLAGS;
+}
+
+li_can_slv_errorcode_t dload_lz_add_bytes(const byte_t *src, uint16_t len)
+{
+	if ((lz_in_len + len) > LI_CAN_SLV_XLOAD_BUFFER_SIZE_DLOAD)
+	{
+		return (ERR_MSG_CAN_DLOAD_BUF_OVERFLOW);
+	}
+	can_port_memory_cpy(&lz_in[lz_in_len], src, len);
+	lz_in_len += len;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+uint16_t dload_lz_get_len(void)
+{
+	return (lz_in_len);
+}
+
+void dload_lz_drop_block(void)
+{
+	lz_in_len = 0;
+}
+
+li_can_slv_errorcode_t dload_lz_block_end(uint16_t len, uint16_t *out_len)
+{
+	li_can_slv_errorcode_t rc = LI_CAN_SLV_ERR_OK;
+	uint16_t i, k;
+	uint16_t offset;
+	uint16_t match_len;
+	byte_t b;
+
+	*out_len = 0;
+	lz_out_len = 0;
+	if (len > lz_in_len)
+	{
+		len = lz_in_len;
+	}
+
+	for (i = 0; (i < len) && (rc == LI_CAN_SLV_ERR_OK); i++)
+	{
+		b = lz_in[i];
+		switch (lz_state)
+		{
+			case LZ_STATE_FLAGS:
+				lz_flags = 0x0100u | b;
+				lz_state = LZ_STATE_ITEM;
+				break;
+
+			case LZ_STATE_ITEM:
+				if ((lz_flags & 0x0001u) != 0)
+				{
+					rc = lz_emit(b, out_len);
+					lz_next_item();
+				}
+				else
+				{
+					lz_match_low = b;
+					lz_state = LZ_STATE_MATCH;
+				}
+				break;
+
+			case LZ_STATE_MATCH:
+				offset = ((((uint16_t) b & 0xF0u) << 4) | lz_match_low) + 1;
+				match_len = ((uint16_t) b & 0x0Fu) + LZ_MATCH_LEN_MIN;
+				if (offset > lz_window_fill)
+				{
+					rc = ERR_MSG_CAN_DLOAD_LZ_FORMAT;
+					break;
+				}
+				for (k = 0; (k < match_len) && (rc == LI_CAN_SLV_ERR_OK); k++)
+				{
+					rc = lz_emit(lz_window[(lz_window_pos - offset) & LZ_WINDOW_MASK], out_len);
+				}
+				lz_next_item();
+				break;
+
+			default:
+				rc = ERR_MSG_CAN_DLOAD_LZ_FORMAT;
+				break;
+		}
+	}
+
+	if ((rc == LI_CAN_SLV_ERR_OK) && (lz_out_len > 0))
+	{
+		rc = dload_add_bytes_to_buffer(&lz_out[0], lz_out_len);
+		*out_len += lz_out_len;
+	}
+	lz_in_len = 0;
+	return (rc);
+}
+
+/*--------------------------------------------------------------------------*/
+/* function definition (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief writes a decompressed byte to the window and collects it for the download buffer
+ * @remarks A byte beyond the maximum bytes per block is rejected.
+ * @param c decompressed byte
+ * @param[in,out] out_len number of bytes added to the download buffer
+ * @return li_can_slv_errorcode_t or LI_CAN_SLV_ERR_OK if successful
+ */
+static li_can_slv_errorcode_t lz_emit(byte_t c, uint16_t *out_len)
+{
+	li_can_slv_errorcode_t rc = LI_CAN_SLV_ERR_OK;
+
+	// the master must not send more bytes per block than announced by the download start acknowledge
+	if ((*out_len + lz_out_len) >= lz_out_max)
+	{
+		return (ERR_MSG_CAN_DLOAD_BUF_OVERFLOW);
+	}
+
+	lz_window[lz_window_pos] = c;
+	lz_window_pos = (lz_window_pos + 1) & LZ_WINDOW_MASK;
+	if (lz_window_fill < LI_CAN_SLV_XLOAD_LZ_WINDOW)
+	{
+		lz_window_fill++;
+	}
+
+	lz_out[lz_out_len] = c;
+	lz_out_len++;
+	if (lz_out_len >= LZ_OUT_CHUNK)
+	{
+		rc = dload_add_bytes_to_buffer(&lz_out[0], lz_out_len);
+		*out_len += lz_out_len;
+		lz_out_len = 0;
+	}
+	return (rc);
+}
+
+/**
+ * @brief moves to the flag of the next item, after the last item of a group the next byte is a flag byte
+ */
+static void lz_next_item(void)
+{
+	lz_flags >>= 1;
+	if (lz_flags == 0x0001u)
+	{
+		lz_state = LZ_STATE_FLAGS;
+	}
+	else
+	{
+		lz_state = LZ_STATE_ITEM;
+	}
+}
+#endif // #ifdef LI_CAN_SLV_DLOAD_LZ
+
+/** @} */
+
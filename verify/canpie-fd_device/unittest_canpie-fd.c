@@ -91,6 +91,12 @@ static CpRcvHandler_Fn pfnCan2RcvHandlerS = CPP_NULL;
 static CpTrmHandler_Fn pfnCan2TrmHandlerS = CPP_NULL;
 static CpErrHandler_Fn pfnCan2ErrHandlerS = CPP_NULL;
 
+static CpState_ts tsCan1StateS = { eCP_STATE_BUS_ACTIVE, eCP_ERR_TYPE_NONE, 0, 0 };
+static uint32_t ulCan1StateCntS = 0;
+
+/* system ticks of the stack, set by the tests which check timing */
+uint32_t unittest_system_ticks = 0;
+
 static FILE *can_main_hw_log;
 static char can_main_hw_log_file_path[FILENAME_MAX];
 
@@ -440,6 +446,12 @@ CpStatus_tv CpCoreBufferSend(CpPort_ts *ptsPortV, uint8_t ubBufferIdxV)
 					/* TODO: DO ME! */
 				}
 
+				// the data length code of a CAN FD frame differs from its payload size
+				if (CpMsgIsFdFrame(&atsCan1MsgS[ubBufferIdxV]))
+				{
+					dlc = CpMsgDlcToSize(dlc);
+				}
+
 				for (i = 0; i < dlc; i++)
 				{
 					fprintf(can_main_hw_log, "%02X ", atsCan1MsgS[ubBufferIdxV].tuMsgData.aubByte[i]);
@@ -629,8 +641,19 @@ CpStatus_tv CpCoreCanState(CpPort_ts *ptsPortV, CpState_ts *ptsStateV)
 		{
 			tvStatusT = eCP_ERR_NONE;
 
-			// first set the state of the bus
-			ptsStateV->ubCanErrState = eCP_STATE_BUS_ACTIVE;
+			if (ptsPortV->ubPhyIf == eCP_CHANNEL_1)
+			{
+				*ptsStateV = tsCan1StateS;
+				ulCan1StateCntS++;
+			}
+			else
+			{
+				// first set the state of the bus
+				ptsStateV->ubCanErrState = eCP_STATE_BUS_ACTIVE;
+				ptsStateV->ubCanErrType = eCP_ERR_TYPE_NONE;
+				ptsStateV->ubCanRcvErrCnt = 0;
+				ptsStateV->ubCanTrmErrCnt = 0;
+			}
 		}
 	}
 
@@ -1188,6 +1211,108 @@ uint32_t send_to_mon_rx_handler(uint16_t can_id, uint8_t dlc, uint8_t *data)
 }
 
 
+uint32_t send_fd_to_main_rx_handler(uint16_t can_id, uint8_t size, uint8_t *data)
+{
+	uint32_t ret = 1;
+	if (size <= CP_DATA_SIZE && data != NULL)
+	{
+		for (uint32_t buffer_id = 0; buffer_id < CP_BUFFER_MAX; buffer_id++)
+		{
+			if ((atsCan1MsgS[buffer_id].ulIdentifier == (uint32_t)can_id) && CpMsgIsFdFrame(&atsCan1MsgS[buffer_id]))
+			{
+				atsCan1MsgS[buffer_id].ubMsgDLC = CpMsgSizeToDlc(size);
+				memcpy(&atsCan1MsgS[buffer_id].tuMsgData, data, size);
+				pfnCan1RcvHandlerS(&atsCan1MsgS[buffer_id], buffer_id);
+				ret = 0;
+			}
+		}
+	}
+	return ret;
+}
+
+uint32_t send_fd_to_mon_rx_handler(uint16_t can_id, uint8_t size, uint8_t *data)
+{
+	uint32_t ret = 1;
+	if (size <= CP_DATA_SIZE && data != NULL)
+	{
+		for (uint32_t buffer_id = 0; buffer_id < CP_BUFFER_MAX; buffer_id++)
+		{
+			if ((atsCan2MsgS[buffer_id].ulIdentifier == (uint32_t)can_id) && CpMsgIsFdFrame(&atsCan2MsgS[buffer_id]))
+			{
+				atsCan2MsgS[buffer_id].ubMsgDLC = CpMsgSizeToDlc(size);
+				memcpy(&atsCan2MsgS[buffer_id].tuMsgData, data, size);
+				pfnCan2RcvHandlerS(&atsCan2MsgS[buffer_id], buffer_id);
+				ret = 0;
+			}
+		}
+	}
+	return ret;
+}
+
+void set_main_can_state(uint8_t state, uint8_t type)
+{
+	tsCan1StateS.ubCanErrState = state;
+	tsCan1StateS.ubCanErrType = type;
+}
+
+uint32_t get_main_can_state_cnt(void)
+{
+	return ulCan1StateCntS;
+}
+
+uint32_t send_main_error(uint8_t state, uint8_t type)
+{
+	CpState_ts tsStateT = { 0 };
+	uint32_t ret = 1;
+
+	if (pfnCan1ErrHandlerS != CPP_NULL)
+	{
+		tsStateT.ubCanErrState = state;
+		tsStateT.ubCanErrType = type;
+		pfnCan1ErrHandlerS(&tsStateT);
+		ret = 0;
+	}
+	return ret;
+}
+
+void set_main_tx_pending(uint8_t buffer_id)
+{
+	if (buffer_id < CP_BUFFER_MAX)
+	{
+		atsCan1MsgS[buffer_id].ulMsgUser |= CP_BUFFER_PND;
+	}
+}
+
+uint32_t complete_main_tx(uint8_t buffer_id)
+{
+	uint32_t ret = 1;
+	CpFifo_ts *ptsFifoT;
+
+	if ((buffer_id < CP_BUFFER_MAX) && (atsCan1MsgS[buffer_id].ulMsgUser & CP_BUFFER_PND))
+	{
+		ptsFifoT = aptsCan1FifoS[buffer_id];
+		if ((ptsFifoT != 0L) && (CpFifoIsEmpty(ptsFifoT) == 0))
+		{
+			/* send the next message of the fifo, the buffer stays pending */
+			memcpy(&atsCan1MsgS[buffer_id], CpFifoDataOutPtr(ptsFifoT), sizeof(CpCanMsg_ts));
+			CpFifoIncOut(ptsFifoT);
+			CpCoreBufferSend(aptsPortS[0], buffer_id);
+			atsCan1MsgS[buffer_id].ulMsgUser |= CP_BUFFER_PND;
+		}
+		else
+		{
+			atsCan1MsgS[buffer_id].ulMsgUser &= ~CP_BUFFER_PND;
+		}
+
+		if (pfnCan1TrmHandlerS != CPP_NULL)
+		{
+			pfnCan1TrmHandlerS(&atsCan1MsgS[buffer_id], buffer_id);
+		}
+		ret = 0;
+	}
+	return ret;
+}
+
 void can_main_hw_set_log_file_name(char *file_name)
 {
 	(void) strcpy(can_main_hw_log_file_path, file_name);
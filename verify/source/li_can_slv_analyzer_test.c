@@ -0,0 +1,284 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/**
+ * @file li_can_slv_analyzer_test.c
+ * @addtogroup unittest
+ * @{
+ */
+
+/*--------------------------------------------------------------------------*/
+/* include files                                                            */
+/*--------------------------------------------------------------------------*/
+#include "unity_config.h"
+#include "unity.h"
+#include "xtfw.h"
+
+#include <li_can_slv/api/li_can_slv_api.h>
+
+// add some logical modules here as c include for test only
+#include "io_app_frc2.c"
+#include "io_app_ma_w.c"
+
+#include <li_can_slv/util/io_can_analyzer.h>
+#include <li_can_slv/async/io_can_async.h>
+#include <li_can_slv/config/li_can_slv_config_defines.h>
+#include <li_can_slv/error/io_can_errno.h>
+
+/*--------------------------------------------------------------------------*/
+/* general definitions (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+#define ANALYZER_TEST_SIZE	(8) /**< recorded messages, see LI_CAN_SLV_SET_ANALYZER_SIZE of the verify configuration */
+#define ANALYZER_TEST_POST_TRIGGER	(4) /**< messages recorded after the trigger, see LI_CAN_SLV_SET_ANALYZER_POST_TRIGGER */
+#define ANALYZER_TEST_TX_OBJ	((uint8_t) CAN_CONFIG_MSG_MAIN_OBJ_TX_ASYNC) /**< message object of the asynchronous objects */
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions (private/not exported)                        */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (public/exported)                                       */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+extern uint32_t send_to_main_rx_handler(uint16_t can_id, uint8_t dlc, uint8_t *data);
+extern uint32_t send_to_mon_rx_handler(uint16_t can_id, uint8_t dlc, uint8_t *data);
+extern uint32_t complete_main_tx(uint8_t buffer_id);
+
+/*--------------------------------------------------------------------------*/
+/* global variables (private/not exported)                                  */
+/*--------------------------------------------------------------------------*/
+static lcsa_errorcode_t err = LCSA_ERROR_OK;
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+static void analyzer_test_record(uint16_t first, uint16_t nr_of_msgs);
+
+/*--------------------------------------------------------------------------*/
+/* function definition (public/exported)                                    */
+/*--------------------------------------------------------------------------*/
+// setUp will be called before each test
+void setUp(void)
+{
+	static uint8_t init_once = 0;
+
+	if (init_once != 1)
+	{
+		init_once = 1;
+
+		err = lcsa_init(LCSA_BAUD_RATE_DEFAULT);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = app_frc2_init(APP_FRC2_MODULE_NR_DEF);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = app_ma_w_init(0, APP_MA_W_MODULE_NR_DEF);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = lcsa_start();
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+	}
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_init());
+}
+
+// tearDown will be called after each test
+void tearDown(void)
+{
+	unittest_system_ticks = 0;
+
+	// no object of a test may stay in the transmit path
+	while (complete_main_tx(ANALYZER_TEST_TX_OBJ) == 0)
+	{
+	}
+}
+
+/**
+ * @test test_analyzer_trigger_freeze
+ * @brief the trace is frozen after the post trigger window, the pre trigger window keeps the newest messages
+ */
+void test_analyzer_trigger_freeze(void)
+{
+	can_analyzer_entry_t entry;
+	uint16_t nr_of_entries = 0;
+	uint16_t source = 0;
+	uint16_t entry_nr = 0;
+	uint16_t i;
+
+	XTFW_ASSERT_EQUAL_UINT(CAN_ANALYZER_STATE_OFF, can_analyzer_get_state());
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_start(CAN_ANALYZER_TRIGGER_IMAGE_NOT_VALID | CAN_ANALYZER_TRIGGER_USER));
+	XTFW_ASSERT_EQUAL_UINT(CAN_ANALYZER_STATE_ARMED, can_analyzer_get_state());
+
+	// the pre trigger window overwrites the oldest messages
+	analyzer_test_record(0, 10);
+
+	// trigger sources not part of the mask are ignored
+	can_analyzer_trigger(CAN_ANALYZER_TRIGGER_RECONNECT);
+	XTFW_ASSERT_EQUAL_UINT(CAN_ANALYZER_STATE_ARMED, can_analyzer_get_state());
+
+	can_analyzer_trigger(CAN_ANALYZER_TRIGGER_USER);
+	XTFW_ASSERT_EQUAL_UINT(CAN_ANALYZER_STATE_TRIGGERED, can_analyzer_get_state());
+
+	// a second trigger does not move the trigger point
+	can_analyzer_trigger(CAN_ANALYZER_TRIGGER_IMAGE_NOT_VALID);
+
+	analyzer_test_record(10, ANALYZER_TEST_POST_TRIGGER - 1);
+	XTFW_ASSERT_EQUAL_UINT(CAN_ANALYZER_STATE_TRIGGERED, can_analyzer_get_state());
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ANALYZER_NOT_STOPPED, can_analyzer_get_nr_of_entries(&nr_of_entries));
+
+	// the last message of the post trigger window freezes the trace, later messages are not recorded
+	analyzer_test_record(10 + ANALYZER_TEST_POST_TRIGGER - 1, 1);
+	XTFW_ASSERT_EQUAL_UINT(CAN_ANALYZER_STATE_STOPPED, can_analyzer_get_state());
+	analyzer_test_record(20, 5);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_get_nr_of_entries(&nr_of_entries));
+	XTFW_ASSERT_EQUAL_UINT16(ANALYZER_TEST_SIZE, nr_of_entries);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_get_trigger(&source, &entry_nr));
+	XTFW_ASSERT_EQUAL_UINT16(CAN_ANALYZER_TRIGGER_USER, source);
+	XTFW_ASSERT_EQUAL_UINT16(ANALYZER_TEST_SIZE - ANALYZER_TEST_POST_TRIGGER, entry_nr);
+
+	// messages 6 to 13 are recorded, the first message after the trigger is message 10
+	for (i = 0; i < ANALYZER_TEST_SIZE; i++)
+	{
+		XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_read(i, &entry));
+		XTFW_ASSERT_EQUAL_UINT16(0x100 + 6 + i, entry.canid);
+		XTFW_ASSERT_EQUAL_UINT32(1000 + 6 + i, entry.time);
+		XTFW_ASSERT_EQUAL_UINT8(8, entry.dlc);
+		XTFW_ASSERT_EQUAL_UINT8(0, entry.flags);
+		XTFW_ASSERT_EQUAL_UINT8(6 + i, entry.data[0]);
+	}
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ANALYZER_NO_ENTRY, can_analyzer_read(ANALYZER_TEST_SIZE, &entry));
+
+	// a new start clears the trace
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_start(CAN_ANALYZER_TRIGGER_USER));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_stop());
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_get_nr_of_entries(&nr_of_entries));
+	XTFW_ASSERT_EQUAL_UINT16(0, nr_of_entries);
+}
+
+/**
+ * @test test_analyzer_stop
+ * @brief without trigger mask the recording runs until it is stopped, the trigger point is the end of the trace
+ */
+void test_analyzer_stop(void)
+{
+	can_analyzer_entry_t entry;
+	uint16_t nr_of_entries = 0;
+	uint16_t source = 0xFFFF;
+	uint16_t entry_nr = 0;
+
+	// nothing is recorded before the start
+	analyzer_test_record(0, 2);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_stop());
+	XTFW_ASSERT_EQUAL_UINT(CAN_ANALYZER_STATE_OFF, can_analyzer_get_state());
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_start(0));
+	analyzer_test_record(0, 3);
+	can_analyzer_trigger(CAN_ANALYZER_TRIGGER_USER);
+	XTFW_ASSERT_EQUAL_UINT(CAN_ANALYZER_STATE_ARMED, can_analyzer_get_state());
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ANALYZER_NOT_STOPPED, can_analyzer_read(0, &entry));
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ANALYZER_NOT_STOPPED, can_analyzer_get_trigger(&source, &entry_nr));
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_stop());
+	XTFW_ASSERT_EQUAL_UINT(CAN_ANALYZER_STATE_STOPPED, can_analyzer_get_state());
+	analyzer_test_record(3, 1);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_get_nr_of_entries(&nr_of_entries));
+	XTFW_ASSERT_EQUAL_UINT16(3, nr_of_entries);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_get_trigger(&source, &entry_nr));
+	XTFW_ASSERT_EQUAL_UINT16(0, source);
+	XTFW_ASSERT_EQUAL_UINT16(3, entry_nr);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_read(2, &entry));
+	XTFW_ASSERT_EQUAL_UINT16(0x102, entry.canid);
+}
+
+/**
+ * @test test_analyzer_record_nodes
+ * @brief messages received on the main and the monitor node and transmitted messages are recorded with their flags
+ */
+void test_analyzer_record_nodes(void)
+{
+	byte_t rx_data[8] = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88 };
+	byte_t tx_data[CAN_CONFIG_ASYNC_CTRL_TX_DLC] = { 0x1A, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 };
+	byte_t fd_data[12] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+	can_analyzer_entry_t entry;
+	uint16_t nr_of_entries = 0;
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_start(0));
+
+	// output data of the logical module ma_w
+	XTFW_ASSERT_EQUAL_UINT(0, send_to_main_rx_handler(0x3C0, 8, rx_data));
+	XTFW_ASSERT_EQUAL_UINT(0, send_to_mon_rx_handler(0x3C0, 8, rx_data));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_send_data_to_async_ctrl_tx_queue(APP_FRC2_MODULE_NR_DEF, CAN_ASYNC_CTRL_TX_TYPE_SLAVE, tx_data));
+
+	// CAN FD messages are truncated
+	can_analyzer_rx(CAN_ANALYZER_NODE_MAIN, 0x123, sizeof(fd_data), fd_data);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_stop());
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_get_nr_of_entries(&nr_of_entries));
+	XTFW_ASSERT_EQUAL_UINT16(4, nr_of_entries);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_read(0, &entry));
+	XTFW_ASSERT_EQUAL_UINT16(0x3C0, entry.canid);
+	XTFW_ASSERT_EQUAL_UINT8(8, entry.dlc);
+	XTFW_ASSERT_EQUAL_UINT8(0, entry.flags);
+	XTFW_ASSERT_EQUAL_UINT8_ARRAY(rx_data, entry.data, 8);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_read(1, &entry));
+	XTFW_ASSERT_EQUAL_UINT16(0x3C0, entry.canid);
+	XTFW_ASSERT_EQUAL_UINT8(CAN_ANALYZER_FLAG_MON, entry.flags);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_read(2, &entry));
+	XTFW_ASSERT_EQUAL_UINT16(0x701, entry.canid);
+	XTFW_ASSERT_EQUAL_UINT8(8, entry.dlc);
+	XTFW_ASSERT_EQUAL_UINT8(CAN_ANALYZER_FLAG_TX, entry.flags);
+	XTFW_ASSERT_EQUAL_UINT8_ARRAY(tx_data, entry.data, 8);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_analyzer_read(3, &entry));
+	XTFW_ASSERT_EQUAL_UINT16(0x123, entry.canid);
+	XTFW_ASSERT_EQUAL_UINT8(sizeof(fd_data), entry.dlc);
+	XTFW_ASSERT_EQUAL_UINT8_ARRAY(fd_data, entry.data, CAN_ANALYZER_DATA_SIZE);
+}
+
+/*--------------------------------------------------------------------------*/
+/* function definition (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief records received messages with the identifier 0x100 + number and the number in the first data byte
+ * @param first number of the first message
+ * @param nr_of_msgs number of messages
+ */
+static void analyzer_test_record(uint16_t first, uint16_t nr_of_msgs)
+{
+	uint8_t data[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+	uint16_t i;
+
+	for (i = first; i < (first + nr_of_msgs); i++)
+	{
+		unittest_system_ticks = 1000 + i;
+		data[0] = (uint8_t) i;
+		can_analyzer_rx(CAN_ANALYZER_NODE_MAIN, 0x100 + i, 8, data);
+	}
+}
+
+/** @} */
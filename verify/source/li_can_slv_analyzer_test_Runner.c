@@ -0,0 +1,58 @@
+/* AUTOGENERATED FILE. DO NOT EDIT. */
+
+/*=======Test Runner Used To Run Each Test Below=====*/
+#define RUN_TEST(TestFunc, TestLineNum) \
+{ \
+  Unity.CurrentTestName = #TestFunc; \
+  Unity.CurrentTestLineNumber = TestLineNum; \
+  Unity.NumberOfTests++; \
+  if (TEST_PROTECT()) \
+  { \
+      setUp(); \
+      TestFunc(); \
+  } \
+  if (TEST_PROTECT()) \
+  { \
+    tearDown(); \
+  } \
+  UnityConcludeTest(); \
+}
+
+/*=======Automagically Detected Files To Include=====*/
+#include "unity.h"
+#include <setjmp.h>
+#include <stdio.h>
+#include "xtfw.h"
+#include <li_can_slv/api/li_can_slv_api.h>
+#include <li_can_slv/util/io_can_analyzer.h>
+#include <li_can_slv/async/io_can_async.h>
+#include <li_can_slv/config/li_can_slv_config_defines.h>
+#include <li_can_slv/error/io_can_errno.h>
+
+/*=======External Functions This Runner Calls=====*/
+extern void setUp(void);
+extern void tearDown(void);
+extern void test_analyzer_trigger_freeze(void);
+extern void test_analyzer_stop(void);
+extern void test_analyzer_record_nodes(void);
+
+
+/*=======Test Reset Option=====*/
+void resetTest(void);
+void resetTest(void)
+{
+  tearDown();
+  setUp();
+}
+
+
+/*=======MAIN=====*/
+int main(void)
+{
+  UnityBegin("/root/repo/verify/source/li_can_slv_analyzer_test.c");
+  RUN_TEST(test_analyzer_trigger_freeze, 117);
+  RUN_TEST(test_analyzer_stop, 180);
+  RUN_TEST(test_analyzer_record_nodes, 216);
+
+  return (UnityEnd());
+}
@@ -0,0 +1,263 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/**
+ * @file li_can_slv_async_test.c
+ * @addtogroup unittest
+ * @{
+ */
+
+/*--------------------------------------------------------------------------*/
+/* include files                                                            */
+/*--------------------------------------------------------------------------*/
+#include "unity_config.h"
+#include "unity.h"
+#include "xtfw.h"
+
+#include <li_can_slv/api/li_can_slv_api.h>
+
+// add some logical modules here as c include for test only
+#include "io_app_frc2.c"
+#include "io_app_incx.c"
+#include "io_app_inxy.c"
+#include "io_app_ma_w.c"
+
+// used for the logging of the can output
+#include "io_can_hw.h"
+#include "io_can_main_hw.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <windows.h>
+
+#include <string.h>
+
+#include <li_can_slv/async/io_can_async.h>
+#include <li_can_slv/config/li_can_slv_config_defines.h>
+#include <li_can_slv/error/io_can_errno.h>
+
+#include "unittest_canpie-fd.h"
+
+/*--------------------------------------------------------------------------*/
+/* general definitions (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+#define ASYNC_TEST_MODULE_NR	APP_FRC2_MODULE_NR_DEF /**< module of the asynchronous objects */
+#define ASYNC_TEST_TX_OBJ		((uint8_t) CAN_CONFIG_MSG_MAIN_OBJ_TX_ASYNC) /**< message object of the asynchronous objects */
+#define ASYNC_TEST_DATA_TX_QUEUE_LENGTH	4 /**< default length of the asynchronous data TX queue */
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions (private/not exported)                        */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (public/exported)                                       */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+extern void set_main_tx_pending(uint8_t buffer_id);
+extern uint32_t complete_main_tx(uint8_t buffer_id);
+
+/*--------------------------------------------------------------------------*/
+/* global variables (private/not exported)                                  */
+/*--------------------------------------------------------------------------*/
+static lcsa_errorcode_t err = LCSA_ERROR_OK;
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+static void async_test_tx_complete_all(void);
+static void async_test_log_open(char *file_name);
+static void async_test_log_check(char *file_name, const char *exp_file_name);
+
+static int doesFileExist(const char *filename);
+static void get_expected_file_path(const char *filename, char *filepath);
+
+/*--------------------------------------------------------------------------*/
+/* function definition (public/exported)                                    */
+/*--------------------------------------------------------------------------*/
+// setUp will be called before each test
+void setUp(void)
+{
+	static uint8_t init_once = 0;
+
+	if (init_once != 1)
+	{
+		init_once = 1;
+
+		err = lcsa_init(LCSA_BAUD_RATE_DEFAULT);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = app_frc2_init(APP_FRC2_MODULE_NR_DEF);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = lcsa_start();
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+	}
+}
+
+// tearDown will be called after each test
+void tearDown(void)
+{
+	// no object of a failed test may stay in the transmit path
+	async_test_tx_complete_all();
+}
+
+/**
+ * @test test_async_ctrl_tx_refill
+ * @brief objects queued while the transmit path is busy are sent in order from the transmit complete handler
+ */
+void test_async_ctrl_tx_refill(void)
+{
+	byte_t data[CAN_CONFIG_ASYNC_CTRL_TX_DLC] = { 0x1A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+	uint16_t i;
+
+	async_test_log_open("_tc_async_ctrl_tx_refill.log");
+
+	// the hardware fifo takes 8 objects, the other objects wait in the ctrl queue
+	set_main_tx_pending(ASYNC_TEST_TX_OBJ);
+	for (i = 0; i < 12; i++)
+	{
+		data[1] = (byte_t) i;
+		XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_send_data_to_async_ctrl_tx_queue(ASYNC_TEST_MODULE_NR, CAN_ASYNC_CTRL_TX_TYPE_SLAVE, data));
+	}
+	XTFW_ASSERT_EQUAL_UINT16(4, can_async_ctrl_tx_queue_state);
+
+	// every transmit complete sends the next object of the fifo and refills the fifo from the queue
+	for (i = 0; i < 12; i++)
+	{
+		XTFW_ASSERT_EQUAL_UINT(0, complete_main_tx(ASYNC_TEST_TX_OBJ));
+	}
+	XTFW_ASSERT_EQUAL_UINT16(0, can_async_ctrl_tx_queue_state);
+
+	async_test_log_check("_tc_async_ctrl_tx_refill.log", "tc_async_ctrl_tx_refill_exp.log");
+}
+
+/**
+ * @test test_async_data_tx_ring
+ * @brief the data queue takes objects up to its length while the transmit path is busy and is drained in order from
+ * the transmit complete handler
+ */
+void test_async_data_tx_ring(void)
+{
+	byte_t data[CAN_CONFIG_ASYNC_DATA_TX_DLC] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77 };
+	byte_t bulk[20];
+	uint16_t accepted = 0xFFFF;
+	uint16_t i;
+
+	async_test_log_open("_tc_async_data_tx_ring.log");
+
+	for (i = 0; i < sizeof(bulk); i++)
+	{
+		bulk[i] = (byte_t)(0x80 + i);
+	}
+
+	// the hardware fifo takes 8 objects, the data queue takes 4 objects
+	set_main_tx_pending(ASYNC_TEST_TX_OBJ);
+	for (i = 0; i < (8 + ASYNC_TEST_DATA_TX_QUEUE_LENGTH); i++)
+	{
+		data[0] = (byte_t) i;
+		XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_send_data_to_async_data_tx_queue(ASYNC_TEST_MODULE_NR, CAN_ASYNC_DATA_TX_TYPE_SLAVE, CAN_CONFIG_ASYNC_DATA_TX_DLC, data));
+	}
+	XTFW_ASSERT_EQUAL_UINT16(ASYNC_TEST_DATA_TX_QUEUE_LENGTH, can_async_data_tx_queue_get_nr_of_objs());
+	XTFW_ASSERT_EQUAL_UINT16(0, can_async_data_tx_queue_get_nr_of_free_objs());
+
+	// a full queue rejects further objects and accepts no bytes of a data stream
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ASYNC_DATA_TX_QUEUE_OVERFLOW, can_async_send_data_to_async_data_tx_queue(ASYNC_TEST_MODULE_NR, CAN_ASYNC_DATA_TX_TYPE_SLAVE, CAN_CONFIG_ASYNC_DATA_TX_DLC, data));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_send_bulk_to_async_data_tx_queue(ASYNC_TEST_MODULE_NR, CAN_ASYNC_DATA_TX_TYPE_SLAVE, bulk, sizeof(bulk), &accepted));
+	XTFW_ASSERT_EQUAL_UINT16(0, accepted);
+
+	// every transmit complete moves one object of the queue to the fifo
+	for (i = 0; i < ASYNC_TEST_DATA_TX_QUEUE_LENGTH; i++)
+	{
+		XTFW_ASSERT_EQUAL_UINT(0, complete_main_tx(ASYNC_TEST_TX_OBJ));
+		XTFW_ASSERT_EQUAL_UINT16(ASYNC_TEST_DATA_TX_QUEUE_LENGTH - 1 - i, can_async_data_tx_queue_get_nr_of_objs());
+	}
+
+	// the data stream is split into full objects, the free running indices continue after the wrap of the ring
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_send_bulk_to_async_data_tx_queue(ASYNC_TEST_MODULE_NR, CAN_ASYNC_DATA_TX_TYPE_SLAVE, bulk, sizeof(bulk), &accepted));
+	XTFW_ASSERT_EQUAL_UINT16(sizeof(bulk), accepted);
+	XTFW_ASSERT_EQUAL_UINT16(3, can_async_data_tx_queue_get_nr_of_objs());
+
+	async_test_tx_complete_all();
+	XTFW_ASSERT_EQUAL_UINT16(0, can_async_data_tx_queue_get_nr_of_objs());
+	XTFW_ASSERT_EQUAL_UINT16(ASYNC_TEST_DATA_TX_QUEUE_LENGTH, can_async_data_tx_queue_get_nr_of_free_objs());
+
+	async_test_log_check("_tc_async_data_tx_ring.log", "tc_async_data_tx_ring_exp.log");
+}
+
+/*--------------------------------------------------------------------------*/
+/* function definition (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief completes the transmission of the asynchronous message object until it is idle
+ */
+static void async_test_tx_complete_all(void)
+{
+	while (complete_main_tx(ASYNC_TEST_TX_OBJ) == 0)
+	{
+	}
+}
+
+static void async_test_log_open(char *file_name)
+{
+	can_main_hw_set_log_file_name(file_name);
+	if (can_main_hw_log_open() == EXIT_FAILURE)
+	{
+		TEST_FAIL_MESSAGE("log open fails");
+	}
+}
+
+static void async_test_log_check(char *file_name, const char *exp_file_name)
+{
+	char file_path[_MAX_PATH];
+
+	can_main_hw_log_close();
+	XTFW_ASSERT_EQUAL_INT(1, doesFileExist(file_name));
+
+	/* compare file content */
+	get_expected_file_path(exp_file_name, file_path);
+	TEST_ASSERT_BINARY_FILE(file_path, file_name);
+}
+
+static int doesFileExist(const char *filename)
+{
+	struct stat st;
+	int result = stat(filename, &st);
+	return result == 0;
+}
+
+static void get_expected_file_path(const char *filename, char *filepath)
+{
+	char drive[_MAX_DRIVE];
+	char dir[_MAX_DIR];
+	char fname[_MAX_FNAME];
+
+	_splitpath(Unity.TestFile, drive, dir, NULL, NULL);
+	strcpy(fname, drive);
+	strcat(fname, dir);
+	strcat(fname, "..\\expected\\file\\");
+	strcat(fname, filename);
+	strcpy(filepath, fname);
+}
+
+/** @} */
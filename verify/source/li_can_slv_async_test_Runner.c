@@ -0,0 +1,63 @@
+/* AUTOGENERATED FILE. DO NOT EDIT. */
+
+/*=======Test Runner Used To Run Each Test Below=====*/
+#define RUN_TEST(TestFunc, TestLineNum) \
+{ \
+  Unity.CurrentTestName = #TestFunc; \
+  Unity.CurrentTestLineNumber = TestLineNum; \
+  Unity.NumberOfTests++; \
+  if (TEST_PROTECT()) \
+  { \
+      setUp(); \
+      TestFunc(); \
+  } \
+  if (TEST_PROTECT()) \
+  { \
+    tearDown(); \
+  } \
+  UnityConcludeTest(); \
+}
+
+/*=======Automagically Detected Files To Include=====*/
+#include "unity.h"
+#include <setjmp.h>
+#include <stdio.h>
+#include "xtfw.h"
+#include "io_can_hw.h"
+#include "io_can_main_hw.h"
+#include "unittest_canpie-fd.h"
+#include <li_can_slv/api/li_can_slv_api.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <windows.h>
+#include <string.h>
+#include <li_can_slv/async/io_can_async.h>
+#include <li_can_slv/config/li_can_slv_config_defines.h>
+#include <li_can_slv/error/io_can_errno.h>
+
+/*=======External Functions This Runner Calls=====*/
+extern void setUp(void);
+extern void tearDown(void);
+extern void test_async_ctrl_tx_refill(void);
+extern void test_async_data_tx_ring(void);
+
+
+/*=======Test Reset Option=====*/
+void resetTest(void);
+void resetTest(void)
+{
+  tearDown();
+  setUp();
+}
+
+
+/*=======MAIN=====*/
+int main(void)
+{
+  UnityBegin("/root/repo/verify/source/li_can_slv_async_test.c");
+  RUN_TEST(test_async_ctrl_tx_refill, 126);
+  RUN_TEST(test_async_data_tx_ring, 156);
+
+  return (UnityEnd());
+}
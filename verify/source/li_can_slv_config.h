@@ -45,7 +45,10 @@ extern "C" {
 //#define LI_CAN_SLV_USE_MODULE_IO_CONFIG
 //#define LI_CAN_SLV_USE_TUPLE
 //#define LI_CAN_SLV_USE_UNKNOWN_MODULE
+// the xload_info is only needed by the resume of li_can_slv_resume_test
+#ifndef LI_CAN_SLV_TEST_RESUME
 #define LI_CAN_SLV_DO_NOT_USE_XLOAD_INFO
+#endif // #ifndef LI_CAN_SLV_TEST_RESUME
 
 /*--------------------------------------------------------------------------*/
 /* main/monitor definitions                                                 */
@@ -80,19 +83,85 @@ extern "C" {
 #define LI_CAN_SLV_SET_SYNC_PROCESS_PERIODE_MAX (50)
 #define LI_CAN_SLV_SYNC_CHECK_MODULE_NR_AND_DLC
 
+// CAN FD changes the frame layout of all synchronous objects, so it is only enabled for li_can_slv_sync_fd_test
+#ifdef LI_CAN_SLV_TEST_SYNC_FD
+#define LI_CAN_SLV_USE_SYNC_FD
+#endif // #ifdef LI_CAN_SLV_TEST_SYNC_FD
+
 /*--------------------------------------------------------------------------*/
 /* LI_CAN_SLV Asynchronous protocol definitions                             */
 /*--------------------------------------------------------------------------*/
 #define LI_CAN_SLV_USE_ASYNC
 #define LI_CAN_SLV_USE_ASYNC_DOWNLOAD
+#define LI_CAN_SLV_USE_ASYNC_UPLOAD
+#define LI_CAN_SLV_USE_ASYNC_DOWNLOAD_WINDOW
+#define LI_CAN_SLV_USE_ASYNC_DOWNLOAD_LZ
+#define LI_CAN_SLV_USE_XLOAD_CRC16
+#define LI_CAN_SLV_USE_DOWNLOAD_CRC_CHECK
 //#define LI_CAN_SLV_USE_ASYNC_TUNNEL
 
+// the tunnel needs the serial channel of li_can_slv_tunnel_test, so it is only enabled there
+#ifdef LI_CAN_SLV_TEST_TUNNEL
+#define LI_CAN_SLV_USE_ASYNC_TUNNEL
+#define LI_CAN_SLV_USE_ASYNC_TUNNEL_RX_RING
+#define LI_CAN_SLV_SET_ASYNC_TUNNEL_RX_RING_SIZE	(64)
+#define LI_CAN_SLV_USE_ASYNC_ISOTP
+#define LI_CAN_SLV_SET_ASYNC_ISOTP_BLOCK_SIZE	(2)
+#define LI_CAN_SLV_SET_ASYNC_ISOTP_STMIN	(5)
+#endif // #ifdef LI_CAN_SLV_TEST_TUNNEL
+
+// the shaper holds back asynchronous objects, so it is only enabled for li_can_slv_shaper_test
+#ifdef LI_CAN_SLV_TEST_SHAPER
+#define LI_CAN_SLV_USE_ASYNC_TX_SHAPER
+#define LI_CAN_SLV_SET_ASYNC_TX_SHAPER_GUARD_MS	(2)
+#endif // #ifdef LI_CAN_SLV_TEST_SHAPER
+
+// the pipelined download hands the blocks to a commit handle, so it is only enabled for li_can_slv_pipeline_test
+#ifdef LI_CAN_SLV_TEST_PIPELINE
+#define LI_CAN_SLV_USE_ASYNC_DOWNLOAD_PIPELINE
+#define LI_CAN_SLV_SET_ASYNC_DOWNLOAD_PIPELINE_BLOCKS	(2)
+#endif // #ifdef LI_CAN_SLV_TEST_PIPELINE
+
+// the resume keeps the progress of the download in the xload_info, so it is only enabled for li_can_slv_resume_test
+#ifdef LI_CAN_SLV_TEST_RESUME
+#define LI_CAN_SLV_USE_ASYNC_DOWNLOAD_RESUME
+#endif // #ifdef LI_CAN_SLV_TEST_RESUME
+
+// CAN FD data objects change the buffer sizes of the up/download, so they are only enabled for li_can_slv_xload_fd_test
+#ifdef LI_CAN_SLV_TEST_XLOAD_FD
+#define LI_CAN_SLV_USE_XLOAD_FD
+#endif // #ifdef LI_CAN_SLV_TEST_XLOAD_FD
+
+/*--------------------------------------------------------------------------*/
+/* LI_CAN_SLV utility definitions                                           */
+/*--------------------------------------------------------------------------*/
+// the quality measurement needs li_can_slv_quality, so it is only enabled for li_can_slv_quality_test
+#ifdef LI_CAN_SLV_TEST_QUALITY
+#define LI_CAN_SLV_USE_QUALITY
+#define LI_CAN_SLV_SET_QUALITY_WINDOW_MS	(80)
+#endif // #ifdef LI_CAN_SLV_TEST_QUALITY
+
+// the analyzer needs li_can_slv_analyzer, so it is only enabled for li_can_slv_analyzer_test
+#ifdef LI_CAN_SLV_TEST_ANALYZER
+#define LI_CAN_SLV_USE_ANALYZER
+#define LI_CAN_SLV_SET_ANALYZER_SIZE	(8)
+#define LI_CAN_SLV_SET_ANALYZER_POST_TRIGGER	(4)
+#endif // #ifdef LI_CAN_SLV_TEST_ANALYZER
+
+// the traffic counters need li_can_slv_traffic, so they are only enabled for li_can_slv_traffic_test
+#ifdef LI_CAN_SLV_TEST_TRAFFIC
+#define LI_CAN_SLV_USE_TRAFFIC
+#define LI_CAN_SLV_SET_TRAFFIC_SIZE	(4)
+#endif // #ifdef LI_CAN_SLV_TEST_TRAFFIC
+
 /*--------------------------------------------------------------------------*/
 /* HW/architecture definitions                                              */
 /*--------------------------------------------------------------------------*/
 #define LI_CAN_SLV_ARCH_USE_CANPIE_CH1_FOR_MAIN_NODE
 #define LI_CAN_SLV_ARCH_SET_BYTE_ORDER_LITTLE_ENDIAN
 #define LI_CAN_SLV_ARCH_MAIN_NODE_MAX_NOF_MSG_OBJ	(32)
+#define LI_CAN_SLV_ARCH_USE_CANPIE_ADAPTER_ERROR_HANDLER
+#define LI_CAN_SLV_ARCH_SET_ERROR_HANDLER_RATE_LIMIT_MS	(10)
 
 #ifdef LI_CAN_SLV_MON
 #define LI_CAN_SLV_ARCH_USE_CANPIE_CH2_FOR_MON_NODE
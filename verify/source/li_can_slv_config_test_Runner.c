@@ -0,0 +1,67 @@
+/* AUTOGENERATED FILE. DO NOT EDIT. */
+
+/*=======Test Runner Used To Run Each Test Below=====*/
+#define RUN_TEST(TestFunc, TestLineNum) \
+{ \
+  Unity.CurrentTestName = #TestFunc; \
+  Unity.CurrentTestLineNumber = TestLineNum; \
+  Unity.NumberOfTests++; \
+  if (TEST_PROTECT()) \
+  { \
+      setUp(); \
+      TestFunc(); \
+  } \
+  if (TEST_PROTECT()) \
+  { \
+    tearDown(); \
+  } \
+  UnityConcludeTest(); \
+}
+
+/*=======Automagically Detected Files To Include=====*/
+#include "unity.h"
+#include <setjmp.h>
+#include <stdio.h>
+#include "xtfw.h"
+#include "io_can_hw.h"
+#include "io_can_main_hw.h"
+#include "io_app_module_change.h"
+#include "unittest_canpie-fd.h"
+#include <li_can_slv/api/li_can_slv_api.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <windows.h>
+#include <string.h>
+#include <li_can_slv/core/io_can_main.h>
+#include <li_can_slv/core/io_can_main_handler.h>
+#include <li_can_slv/core/io_can_mon.h>
+#include <li_can_slv/sync/io_can_sync_handler.h>
+
+/*=======External Functions This Runner Calls=====*/
+extern void setUp(void);
+extern void tearDown(void);
+extern void test_lcsa_init_deinit(void);
+extern void test_lcsa_init_reinit(void);
+extern void test_can_conifg_max_module_numbers(void);
+
+
+/*=======Test Reset Option=====*/
+void resetTest(void);
+void resetTest(void)
+{
+  tearDown();
+  setUp();
+}
+
+
+/*=======MAIN=====*/
+int main(void)
+{
+  UnityBegin("/root/repo/verify/source/li_can_slv_config_test.c");
+  RUN_TEST(test_lcsa_init_deinit, 85);
+  RUN_TEST(test_lcsa_init_reinit, 126);
+  RUN_TEST(test_can_conifg_max_module_numbers, 166);
+
+  return (UnityEnd());
+}
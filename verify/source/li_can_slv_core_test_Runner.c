@@ -0,0 +1,89 @@
+/* AUTOGENERATED FILE. DO NOT EDIT. */
+
+/*=======Test Runner Used To Run Each Test Below=====*/
+#define RUN_TEST(TestFunc, TestLineNum) \
+{ \
+  Unity.CurrentTestName = #TestFunc; \
+  Unity.CurrentTestLineNumber = TestLineNum; \
+  Unity.NumberOfTests++; \
+  if (TEST_PROTECT()) \
+  { \
+      setUp(); \
+      TestFunc(); \
+  } \
+  if (TEST_PROTECT()) \
+  { \
+    tearDown(); \
+  } \
+  UnityConcludeTest(); \
+}
+
+/*=======Automagically Detected Files To Include=====*/
+#include "unity.h"
+#include <setjmp.h>
+#include <stdio.h>
+#include "xtfw.h"
+#include "io_can_hw.h"
+#include "io_can_main_hw.h"
+#include "io_app_module_change.h"
+#include "unittest_canpie-fd.h"
+#include <li_can_slv/api/li_can_slv_api.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <windows.h>
+#include <string.h>
+#include <li_can_slv/core/io_can_main.h>
+#include <li_can_slv/core/io_can_mon.h>
+#include <li_can_slv/core/io_can_main_handler.h>
+#include <li_can_slv/sync/io_can_sync_handler.h>
+
+/*=======External Functions This Runner Calls=====*/
+extern void setUp(void);
+extern void tearDown(void);
+extern void test_sys_msg_first_status_req(void);
+extern void test_sys_msg_status_req(void);
+extern void test_sys_msg_status_req_broadcast(void);
+extern void test_sys_msg_version_req(void);
+extern void test_sys_msg_version_req_broadcast(void);
+extern void test_sys_msg_invalid_dlc(void);
+extern void test_sys_msg_broadcast_no_module(void);
+extern void test_sys_msg_invalid_module_number(void);
+extern void test_sys_msg_broadcast_not_allowed(void);
+extern void test_sys_msg_broadcast_allowed(void);
+extern void test_sys_msg_stay_silent_sys(void);
+extern void test_sys_system_time(void);
+extern void test_sys_msg_change_module_nr(void);
+extern void test_sys_msg_factory_reset(void);
+
+
+/*=======Test Reset Option=====*/
+void resetTest(void);
+void resetTest(void)
+{
+  tearDown();
+  setUp();
+}
+
+
+/*=======MAIN=====*/
+int main(void)
+{
+  UnityBegin("/root/repo/verify/source/li_can_slv_core_test.c");
+  RUN_TEST(test_sys_msg_first_status_req, 152);
+  RUN_TEST(test_sys_msg_status_req, 197);
+  RUN_TEST(test_sys_msg_status_req_broadcast, 230);
+  RUN_TEST(test_sys_msg_version_req, 266);
+  RUN_TEST(test_sys_msg_version_req_broadcast, 301);
+  RUN_TEST(test_sys_msg_invalid_dlc, 339);
+  RUN_TEST(test_sys_msg_broadcast_no_module, 356);
+  RUN_TEST(test_sys_msg_invalid_module_number, 380);
+  RUN_TEST(test_sys_msg_broadcast_not_allowed, 418);
+  RUN_TEST(test_sys_msg_broadcast_allowed, 453);
+  RUN_TEST(test_sys_msg_stay_silent_sys, 486);
+  RUN_TEST(test_sys_system_time, 682);
+  RUN_TEST(test_sys_msg_change_module_nr, 731);
+  RUN_TEST(test_sys_msg_factory_reset, 842);
+
+  return (UnityEnd());
+}
@@ -31,6 +31,15 @@
 #include "unity.h"
 #include "xtfw.h"
 
+#include <li_can_slv/api/li_can_slv_api.h>
+
+// add some logical modules here as c include for test only
+#include "io_app_frc2.c"
+
+#include <li_can_slv/arch/canpie_adapter/io_can_main_hw_handler.h>
+
+#include "canpie.h"
+
 /*--------------------------------------------------------------------------*/
 /* general definitions (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
@@ -46,6 +55,9 @@
 /*--------------------------------------------------------------------------*/
 /* function prototypes (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
+extern void set_main_can_state(uint8_t state, uint8_t type);
+extern uint32_t get_main_can_state_cnt(void);
+extern uint32_t send_main_error(uint8_t state, uint8_t type);
 
 /*--------------------------------------------------------------------------*/
 /* global variables (private/not exported)                                  */
@@ -61,7 +73,18 @@
 // setUp will be called before each test
 void setUp(void)
 {
+	static uint8_t init_once = 0;
 
+	if (init_once != 1)
+	{
+		init_once = 1;
+
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, lcsa_init(LCSA_BAUD_RATE_DEFAULT));
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, app_frc2_init(APP_FRC2_MODULE_NR_DEF));
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, lcsa_start());
+	}
+
+	set_main_can_state(eCP_STATE_BUS_ACTIVE, eCP_ERR_TYPE_NONE);
 }
 
 // tearDown will be called after each test
@@ -79,6 +102,45 @@ void test_error_send(void)
 	XTFW_ASSERT_EQUAL_UINT(0, 0);
 }
 
+/**
+ * @test test_error_handler_rate_limit
+ * @brief error events of the driver are evaluated at most once per rate limit, events in between are coalesced
+ * and the driver state is only polled while the bus is disturbed
+ */
+void test_error_handler_rate_limit(void)
+{
+	uint32_t cnt;
+
+	// the first event is evaluated at once, the disturbed bus is polled until it is active again
+	unittest_system_ticks = 100;
+	XTFW_ASSERT_EQUAL_UINT(0, send_main_error(eCP_STATE_BUS_PASSIVE, eCP_ERR_TYPE_CRC));
+	cnt = get_main_can_state_cnt();
+	XTFW_ASSERT_EQUAL_UINT(0, can_main_hw_handler_error());
+	XTFW_ASSERT_EQUAL_UINT32(cnt + 1, get_main_can_state_cnt());
+	XTFW_ASSERT_EQUAL_UINT(0, can_main_hw_handler_error());
+	XTFW_ASSERT_EQUAL_UINT32(cnt + 1, get_main_can_state_cnt());
+
+	// events within the rate limit are deferred, the error type of the first one is kept
+	unittest_system_ticks = 105;
+	XTFW_ASSERT_EQUAL_UINT(0, send_main_error(eCP_STATE_BUS_ACTIVE, eCP_ERR_TYPE_ACK));
+	unittest_system_ticks = 106;
+	XTFW_ASSERT_EQUAL_UINT(0, send_main_error(eCP_STATE_BUS_ACTIVE, eCP_ERR_TYPE_NONE));
+	unittest_system_ticks = 108;
+	XTFW_ASSERT_EQUAL_UINT(0, can_main_hw_handler_error());
+	XTFW_ASSERT_EQUAL_UINT32(cnt + 1, get_main_can_state_cnt());
+
+	// the deferred event is evaluated when the rate limit expires, then the disturbed bus is polled again
+	unittest_system_ticks = 100 + LI_CAN_SLV_ERROR_HANDLER_RATE_LIMIT_MS;
+	XTFW_ASSERT_EQUAL_UINT(0, can_main_hw_handler_error());
+	XTFW_ASSERT_EQUAL_UINT32(cnt + 1, get_main_can_state_cnt());
+	XTFW_ASSERT_EQUAL_UINT(0, can_main_hw_handler_error());
+	XTFW_ASSERT_EQUAL_UINT32(cnt + 2, get_main_can_state_cnt());
+	XTFW_ASSERT_EQUAL_UINT(0, can_main_hw_handler_error());
+	XTFW_ASSERT_EQUAL_UINT32(cnt + 2, get_main_can_state_cnt());
+
+	unittest_system_ticks = 0;
+}
+
 /*--------------------------------------------------------------------------*/
 /* function definition (private/not exported)                               */
 /*--------------------------------------------------------------------------*/
@@ -0,0 +1,466 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/**
+ * @file li_can_slv_pipeline_test.c
+ * @addtogroup unittest
+ * @{
+ */
+
+/*--------------------------------------------------------------------------*/
+/* include files                                                            */
+/*--------------------------------------------------------------------------*/
+#include "unity_config.h"
+#include "unity.h"
+#include "xtfw.h"
+
+#include <li_can_slv/api/li_can_slv_api.h>
+
+// add some logical modules here as c include for test only
+#include "io_app_frc2.c"
+#include "io_app_incx.c"
+#include "io_app_inxy.c"
+#include "io_app_ma_w.c"
+
+// used for the logging of the can output
+#include "io_can_hw.h"
+#include "io_can_main_hw.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <windows.h>
+
+#include <string.h>
+
+#include <li_can_slv/xload/li_can_slv_xload.h>
+#include <li_can_slv/xload/li_can_slv_xload_buffer.h>
+#include <li_can_slv/xload/li_can_slv_xload_crc16.h>
+#include <li_can_slv/async/io_can_async.h>
+#include <li_can_slv/error/io_can_errno.h>
+
+#include "unittest_canpie-fd.h"
+
+/*--------------------------------------------------------------------------*/
+/* general definitions (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+#define PIPELINE_TEST_MODULE_NR	APP_FRC2_MODULE_NR_DEF /**< module of the downloads */
+#define PIPELINE_TEST_BLOCK_OBJS	2 /**< data objects of a block */
+#define PIPELINE_TEST_BLOCK_SIZE	(PIPELINE_TEST_BLOCK_OBJS * (CAN_DLC_MAX - 1)) /**< bytes of a block */
+#define PIPELINE_TEST_IMAGE_SIZE	(512) /**< size of the programmed image */
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions (private/not exported)                        */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (public/exported)                                       */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (private/not exported)                                  */
+/*--------------------------------------------------------------------------*/
+static lcsa_errorcode_t err = LCSA_ERROR_OK;
+static uint16_t commit_cnt = 0; /**< number of started commits */
+static uint16_t commit_depth = 0; /**< nesting of the block commit handle */
+static uint16_t commit_depth_max = 0; /**< maximum nesting of the block commit handle */
+static uint16_t commit_sync = FALSE; /**< the block commit handle programs the block at once */
+static const byte_t *commit_data = NULL; /**< data of the running commit */
+static uint16_t commit_len = 0; /**< number of bytes of the running commit */
+static uint16_t end_cnt = 0;
+static uint16_t image_len = 0;
+static byte_t image[PIPELINE_TEST_IMAGE_SIZE];
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+static li_can_slv_errorcode_t dload_start_request_hdl(li_can_slv_xload_component_t *dload_component);
+static li_can_slv_errorcode_t dload_block_commit_hdl(li_can_slv_xload_component_t *dload_component, const byte_t *data, uint16_t len);
+static li_can_slv_errorcode_t dload_end_hdl(li_can_slv_xload_component_t *dload_component, li_can_slv_xload_end_handle_status_t *status);
+
+static void pipeline_test_start(uint16_t crc);
+static void pipeline_test_fill(byte_t *dst, byte_t first);
+static li_can_slv_errorcode_t pipeline_test_block(byte_t first);
+static li_can_slv_errorcode_t pipeline_test_committed(li_can_slv_errorcode_t rc);
+static void pipeline_test_log_open(char *file_name);
+static void pipeline_test_log_check(char *file_name, const char *exp_file_name);
+
+static int doesFileExist(const char *filename);
+static void get_expected_file_path(const char *filename, char *filepath);
+
+/*--------------------------------------------------------------------------*/
+/* function definition (public/exported)                                    */
+/*--------------------------------------------------------------------------*/
+// setUp will be called before each test
+void setUp(void)
+{
+	static uint8_t init_once = 0;
+
+	if (init_once != 1)
+	{
+		init_once = 1;
+
+		err = lcsa_init(LCSA_BAUD_RATE_DEFAULT);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = app_frc2_init(APP_FRC2_MODULE_NR_DEF);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = lcsa_start();
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = lcsa_dload_set_start_request_handle(&dload_start_request_hdl);
+		err = lcsa_dload_set_block_commit_handle(&dload_block_commit_hdl);
+		err = lcsa_dload_set_end_handle(&dload_end_hdl);
+	}
+
+	commit_cnt = 0;
+	commit_depth_max = 0;
+	commit_sync = FALSE;
+	commit_data = NULL;
+	commit_len = 0;
+	end_cnt = 0;
+	image_len = 0;
+	memset(image, 0x00, sizeof(image));
+}
+
+// tearDown will be called after each test
+void tearDown(void)
+{
+	// no block of a failed test may stay in the block buffers
+	while (li_can_slv_dload_block_committed(LI_CAN_SLV_ERR_OK) == LI_CAN_SLV_ERR_OK)
+	{
+	}
+}
+
+/**
+ * @test test_dload_pipeline_in_order
+ * @brief every block is acknowledged at once and committed in order, the end follows the last commit
+ */
+void test_dload_pipeline_in_order(void)
+{
+	byte_t exp[2 * PIPELINE_TEST_BLOCK_SIZE];
+
+	pipeline_test_fill(&exp[0], 0x00);
+	pipeline_test_fill(&exp[PIPELINE_TEST_BLOCK_SIZE], 0x10);
+
+	pipeline_test_log_open("_tc_dload_pipeline_in_order.log");
+
+	pipeline_test_start(li_can_slv_xload_crc16_update(li_can_slv_xload_crc16_init(), exp, sizeof(exp)));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_block(0x00));
+	XTFW_ASSERT_EQUAL_UINT16(1, commit_cnt);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_block(0x10));
+	XTFW_ASSERT_EQUAL_UINT16(1, commit_cnt);
+
+	// the end of the first commit starts the commit of the second block
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_committed(LI_CAN_SLV_ERR_OK));
+	XTFW_ASSERT_EQUAL_UINT16(2, commit_cnt);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_committed(LI_CAN_SLV_ERR_OK));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_end(PIPELINE_TEST_MODULE_NR));
+
+	XTFW_ASSERT_EQUAL_UINT16(1, end_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(sizeof(exp), image_len);
+	XTFW_ASSERT_EQUAL_MEMORY(exp, image, sizeof(exp));
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_DLOAD_BUF_UNDERFLOW, li_can_slv_dload_block_committed(LI_CAN_SLV_ERR_OK));
+
+	pipeline_test_log_check("_tc_dload_pipeline_in_order.log", "tc_dload_pipeline_in_order_exp.log");
+}
+
+/**
+ * @test test_dload_pipeline_full
+ * @brief a block received while all block buffers are used is acknowledged after the next commit, the end waits for
+ * the commit of all blocks
+ */
+void test_dload_pipeline_full(void)
+{
+	byte_t exp[3 * PIPELINE_TEST_BLOCK_SIZE];
+
+	pipeline_test_fill(&exp[0], 0x00);
+	pipeline_test_fill(&exp[PIPELINE_TEST_BLOCK_SIZE], 0x10);
+	pipeline_test_fill(&exp[2 * PIPELINE_TEST_BLOCK_SIZE], 0x20);
+
+	pipeline_test_log_open("_tc_dload_pipeline_full.log");
+
+	pipeline_test_start(li_can_slv_xload_crc16_update(li_can_slv_xload_crc16_init(), exp, sizeof(exp)));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_block(0x00));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_block(0x10));
+	// both block buffers are used, the third block waits in the download buffer without acknowledge
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_block(0x20));
+	XTFW_ASSERT_EQUAL_UINT16(1, commit_cnt);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_committed(LI_CAN_SLV_ERR_OK));
+	XTFW_ASSERT_EQUAL_UINT16(2, commit_cnt);
+
+	// the end is handled after the commit of the last block
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_end(PIPELINE_TEST_MODULE_NR));
+	XTFW_ASSERT_EQUAL_UINT16(0, end_cnt);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_committed(LI_CAN_SLV_ERR_OK));
+	XTFW_ASSERT_EQUAL_UINT16(3, commit_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(0, end_cnt);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_committed(LI_CAN_SLV_ERR_OK));
+	XTFW_ASSERT_EQUAL_UINT16(1, end_cnt);
+
+	XTFW_ASSERT_EQUAL_UINT16(sizeof(exp), image_len);
+	XTFW_ASSERT_EQUAL_MEMORY(exp, image, sizeof(exp));
+
+	pipeline_test_log_check("_tc_dload_pipeline_full.log", "tc_dload_pipeline_full_exp.log");
+}
+
+/**
+ * @test test_dload_pipeline_commit_error
+ * @brief a failed commit terminates the download at the next block boundary
+ */
+void test_dload_pipeline_commit_error(void)
+{
+	pipeline_test_log_open("_tc_dload_pipeline_commit_error.log");
+
+	pipeline_test_start(0x0000);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_block(0x00));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_committed(ERR_MSG_CAN_DLOAD_FLASH_WRITE_MAIN));
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_DLOAD_FLASH_WRITE_MAIN, pipeline_test_block(0x10));
+
+	XTFW_ASSERT_EQUAL_UINT16(1, commit_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(0, end_cnt);
+
+	pipeline_test_log_check("_tc_dload_pipeline_commit_error.log", "tc_dload_pipeline_commit_error_exp.log");
+}
+
+/**
+ * @test test_dload_pipeline_termination_during_commit
+ * @brief the commit of a terminated download only frees its block buffer, the next download is committed after it
+ */
+void test_dload_pipeline_termination_during_commit(void)
+{
+	byte_t exp[PIPELINE_TEST_BLOCK_SIZE];
+
+	pipeline_test_fill(&exp[0], 0x40);
+
+	pipeline_test_log_open("_tc_dload_pipeline_termination_during_commit.log");
+
+	pipeline_test_start(0x0000);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_block(0x00));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_block(0x10));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_termination(PIPELINE_TEST_MODULE_NR, ERR_MSG_CAN_DLOAD_DENIED));
+
+	// the first block of the next download waits for the block buffer of the running commit
+	pipeline_test_start(li_can_slv_xload_crc16_update(li_can_slv_xload_crc16_init(), exp, sizeof(exp)));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_block(0x40));
+	XTFW_ASSERT_EQUAL_UINT16(1, commit_cnt);
+
+	// the failed commit of the terminated download neither programs nor terminates the next download
+	commit_data = NULL;
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_block_committed(ERR_MSG_CAN_DLOAD_FLASH_WRITE_MAIN));
+	XTFW_ASSERT_EQUAL_UINT16(2, commit_cnt);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_committed(LI_CAN_SLV_ERR_OK));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_end(PIPELINE_TEST_MODULE_NR));
+
+	XTFW_ASSERT_EQUAL_UINT16(1, end_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(sizeof(exp), image_len);
+	XTFW_ASSERT_EQUAL_MEMORY(exp, image, sizeof(exp));
+
+	pipeline_test_log_check("_tc_dload_pipeline_termination_during_commit.log", "tc_dload_pipeline_termination_during_commit_exp.log");
+}
+
+/**
+ * @test test_dload_pipeline_sync_commit
+ * @brief a commit reported within the block commit handle starts the next commit without nesting the handle
+ */
+void test_dload_pipeline_sync_commit(void)
+{
+	byte_t exp[3 * PIPELINE_TEST_BLOCK_SIZE];
+
+	pipeline_test_fill(&exp[0], 0x00);
+	pipeline_test_fill(&exp[PIPELINE_TEST_BLOCK_SIZE], 0x10);
+	pipeline_test_fill(&exp[2 * PIPELINE_TEST_BLOCK_SIZE], 0x20);
+
+	pipeline_test_log_open("_tc_dload_pipeline_sync_commit.log");
+
+	pipeline_test_start(li_can_slv_xload_crc16_update(li_can_slv_xload_crc16_init(), exp, sizeof(exp)));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_block(0x00));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_block(0x10));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_block(0x20));
+
+	// the remaining blocks are programmed within the handle
+	commit_sync = TRUE;
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, pipeline_test_committed(LI_CAN_SLV_ERR_OK));
+	XTFW_ASSERT_EQUAL_UINT16(3, commit_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(1, commit_depth_max);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_end(PIPELINE_TEST_MODULE_NR));
+
+	XTFW_ASSERT_EQUAL_UINT16(1, end_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(sizeof(exp), image_len);
+	XTFW_ASSERT_EQUAL_MEMORY(exp, image, sizeof(exp));
+
+	pipeline_test_log_check("_tc_dload_pipeline_sync_commit.log", "tc_dload_pipeline_sync_commit_exp.log");
+}
+
+/*--------------------------------------------------------------------------*/
+/* function definition (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+static li_can_slv_errorcode_t dload_start_request_hdl(li_can_slv_xload_component_t *dload_component)
+{
+	return (li_can_slv_dload_start_ackn(dload_component->module_nr, LI_CAN_SLV_XLOAD_MAX_BYTES_PER_BLOCK_DLOAD, 0));
+}
+
+static li_can_slv_errorcode_t dload_block_commit_hdl(li_can_slv_xload_component_t *dload_component, const byte_t *data, uint16_t len)
+{
+	dload_component = dload_component;
+
+	commit_depth++;
+	if (commit_depth > commit_depth_max)
+	{
+		commit_depth_max = commit_depth;
+	}
+	commit_cnt++;
+	commit_data = data;
+	commit_len = len;
+
+	if (commit_sync != FALSE)
+	{
+		(void) pipeline_test_committed(LI_CAN_SLV_ERR_OK);
+	}
+	commit_depth--;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+static li_can_slv_errorcode_t dload_end_hdl(li_can_slv_xload_component_t *dload_component, li_can_slv_xload_end_handle_status_t *status)
+{
+	dload_component = dload_component;
+	end_cnt++;
+	*status = LI_CAN_SLV_XLOAD_STACK_END_HANDLING;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+/**
+ * @brief programs the block of the running commit to the image and reports the end of the commit
+ * @param rc result of the commit
+ * @return return value of li_can_slv_dload_block_committed()
+ */
+static li_can_slv_errorcode_t pipeline_test_committed(li_can_slv_errorcode_t rc)
+{
+	if ((rc == LI_CAN_SLV_ERR_OK) && (commit_data != NULL) && ((image_len + commit_len) <= PIPELINE_TEST_IMAGE_SIZE))
+	{
+		memcpy(&image[image_len], commit_data, commit_len);
+		image_len += commit_len;
+	}
+	commit_data = NULL;
+	return (li_can_slv_dload_block_committed(rc));
+}
+
+/**
+ * @brief sends the download start request of the component TESTCOMP
+ * @param crc CRC16 of the component
+ */
+static void pipeline_test_start(uint16_t crc)
+{
+	byte_t req1[8] = { CAN_ASYNC_DL_START_REQUEST1, 'T', 'E', 'S', 'T', 'C', 'O', 'M' };
+	byte_t req2[8] = { CAN_ASYNC_DL_START_REQUEST2, 'P', 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 };
+
+	req2[2] = (byte_t)(crc >> 8);
+	req2[3] = (byte_t)(crc & 0x00FFu);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_start_request1(PIPELINE_TEST_MODULE_NR, req1));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_start_request2(PIPELINE_TEST_MODULE_NR, req2));
+}
+
+/**
+ * @brief sends the data objects and the data block end of one block
+ * @param first value of the first byte of the block, the following bytes are counted up
+ * @return return value of li_can_slv_dload_data_block_end()
+ */
+static li_can_slv_errorcode_t pipeline_test_block(byte_t first)
+{
+	byte_t data[PIPELINE_TEST_BLOCK_SIZE];
+	byte_t obj[8];
+	byte_t block_end[8] = { CAN_ASYNC_DL_DATA_BLOCK_END, 0, PIPELINE_TEST_BLOCK_SIZE, 0, PIPELINE_TEST_BLOCK_OBJS, 0, 0, 0 };
+	uint16_t i;
+
+	pipeline_test_fill(data, first);
+	obj[0] = CAN_ASYNC_DL_DATA;
+	for (i = 0; i < PIPELINE_TEST_BLOCK_OBJS; i++)
+	{
+		memcpy(&obj[1], &data[i * (CAN_DLC_MAX - 1)], CAN_DLC_MAX - 1);
+		XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_data(PIPELINE_TEST_MODULE_NR, CAN_DLC_MAX, obj));
+	}
+	return (li_can_slv_dload_data_block_end(PIPELINE_TEST_MODULE_NR, block_end));
+}
+
+/**
+ * @brief fills the data of one block, the bytes are counted up
+ * @param[out] dst data of the block
+ * @param first value of the first byte
+ */
+static void pipeline_test_fill(byte_t *dst, byte_t first)
+{
+	uint16_t i;
+
+	for (i = 0; i < PIPELINE_TEST_BLOCK_SIZE; i++)
+	{
+		dst[i] = first++;
+	}
+}
+
+static void pipeline_test_log_open(char *file_name)
+{
+	can_main_hw_set_log_file_name(file_name);
+	if (can_main_hw_log_open() == EXIT_FAILURE)
+	{
+		TEST_FAIL_MESSAGE("log open fails");
+	}
+}
+
+static void pipeline_test_log_check(char *file_name, const char *exp_file_name)
+{
+	char file_path[_MAX_PATH];
+
+	can_main_hw_log_close();
+	XTFW_ASSERT_EQUAL_INT(1, doesFileExist(file_name));
+
+	/* compare file content */
+	get_expected_file_path(exp_file_name, file_path);
+	TEST_ASSERT_BINARY_FILE(file_path, file_name);
+}
+
+static int doesFileExist(const char *filename)
+{
+	struct stat st;
+	int result = stat(filename, &st);
+	return result == 0;
+}
+
+static void get_expected_file_path(const char *filename, char *filepath)
+{
+	char drive[_MAX_DRIVE];
+	char dir[_MAX_DIR];
+	char fname[_MAX_FNAME];
+
+	_splitpath(Unity.TestFile, drive, dir, NULL, NULL);
+	strcpy(fname, drive);
+	strcat(fname, dir);
+	strcat(fname, "..\\expected\\file\\");
+	strcat(fname, filename);
+	strcpy(filepath, fname);
+}
+
+/** @} */
@@ -0,0 +1,71 @@
+/* AUTOGENERATED FILE. DO NOT EDIT. */
+
+/*=======Test Runner Used To Run Each Test Below=====*/
+#define RUN_TEST(TestFunc, TestLineNum) \
+{ \
+  Unity.CurrentTestName = #TestFunc; \
+  Unity.CurrentTestLineNumber = TestLineNum; \
+  Unity.NumberOfTests++; \
+  if (TEST_PROTECT()) \
+  { \
+      setUp(); \
+      TestFunc(); \
+  } \
+  if (TEST_PROTECT()) \
+  { \
+    tearDown(); \
+  } \
+  UnityConcludeTest(); \
+}
+
+/*=======Automagically Detected Files To Include=====*/
+#include "unity.h"
+#include <setjmp.h>
+#include <stdio.h>
+#include "xtfw.h"
+#include "io_can_hw.h"
+#include "io_can_main_hw.h"
+#include "unittest_canpie-fd.h"
+#include <li_can_slv/api/li_can_slv_api.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <windows.h>
+#include <string.h>
+#include <li_can_slv/xload/li_can_slv_xload.h>
+#include <li_can_slv/xload/li_can_slv_xload_buffer.h>
+#include <li_can_slv/xload/li_can_slv_xload_crc16.h>
+#include <li_can_slv/async/io_can_async.h>
+#include <li_can_slv/error/io_can_errno.h>
+
+/*=======External Functions This Runner Calls=====*/
+extern void setUp(void);
+extern void tearDown(void);
+extern void test_dload_pipeline_in_order(void);
+extern void test_dload_pipeline_full(void);
+extern void test_dload_pipeline_commit_error(void);
+extern void test_dload_pipeline_termination_during_commit(void);
+extern void test_dload_pipeline_sync_commit(void);
+
+
+/*=======Test Reset Option=====*/
+void resetTest(void);
+void resetTest(void)
+{
+  tearDown();
+  setUp();
+}
+
+
+/*=======MAIN=====*/
+int main(void)
+{
+  UnityBegin("/root/repo/verify/source/li_can_slv_pipeline_test.c");
+  RUN_TEST(test_dload_pipeline_in_order, 158);
+  RUN_TEST(test_dload_pipeline_full, 191);
+  RUN_TEST(test_dload_pipeline_commit_error, 231);
+  RUN_TEST(test_dload_pipeline_termination_during_commit, 250);
+  RUN_TEST(test_dload_pipeline_sync_commit, 286);
+
+  return (UnityEnd());
+}
@@ -39,6 +39,10 @@ extern "C" {
 #include <string.h>
 #include <stdlib.h>
 
+#ifdef LI_CAN_SLV_USE_ASYNC_TUNNEL
+#include <li_can_slv/error/li_can_slv_error_types.h>
+#endif // #ifdef LI_CAN_SLV_USE_ASYNC_TUNNEL
+
 /*--------------------------------------------------------------------------*/
 /* general definitions                                                      */
 /*--------------------------------------------------------------------------*/
@@ -46,7 +50,8 @@ extern "C" {
 
 #define li_can_slv_port_nop()
 
-#define li_can_slv_port_get_system_ticks()	(0)
+extern uint32_t unittest_system_ticks;
+#define li_can_slv_port_get_system_ticks()	(unittest_system_ticks)
 #define li_can_slv_port_msec_2_ticks(a)	(a)
 #define li_can_slv_port_ticks_2_msec(a)	(a)
 
@@ -113,6 +118,16 @@ extern "C" {
 /*--------------------------------------------------------------------------*/
 /* function prototypes                                                      */
 /*--------------------------------------------------------------------------*/
+#ifdef LI_CAN_SLV_USE_ASYNC_TUNNEL
+// serial channel of the tunnel, implemented by li_can_slv_tunnel_test
+li_can_slv_errorcode_t com_chan_init(li_can_slv_errorcode_t (*pputc)(char_t dat), li_can_slv_errorcode_t (*pxon)(void), li_can_slv_errorcode_t (*pxoff)(void));
+li_can_slv_errorcode_t com_chan_close(void);
+li_can_slv_errorcode_t com_clear_rx_buffer(void);
+void com_xon_rx(void);
+void com_xoff_rx(void);
+void com_data_rx(byte_t *data, uint16_t len);
+#endif // #ifdef LI_CAN_SLV_USE_ASYNC_TUNNEL
+
 #ifdef __cplusplus
 }// closing brace for extern "C"
 #endif // #ifdef __cplusplus
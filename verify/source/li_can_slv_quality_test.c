@@ -0,0 +1,270 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/**
+ * @file li_can_slv_quality_test.c
+ * @addtogroup unittest
+ * @{
+ */
+
+/*--------------------------------------------------------------------------*/
+/* include files                                                            */
+/*--------------------------------------------------------------------------*/
+#include "unity_config.h"
+#include "unity.h"
+#include "xtfw.h"
+
+#include <li_can_slv/api/li_can_slv_api.h>
+
+// add some logical modules here as c include for test only
+#include "io_app_frc2.c"
+
+#include <li_can_slv/util/io_can_quality.h>
+#include <li_can_slv/error/io_can_errno.h>
+
+/*--------------------------------------------------------------------------*/
+/* general definitions (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+#define QUALITY_TEST_SLOT_MS	(10) /**< one of the 8 slots of the quality window of 80 ms */
+#define QUALITY_TEST_WINDOW_BITS	(250uL * 80uL) /**< bits the default baud rate of 250 kBaud can transfer in the quality window */
+#define QUALITY_TEST_FRAME_BITS	(135uL) /**< classic frame with 8 data bytes including the worst case number of stuff bits */
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions (private/not exported)                        */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (public/exported)                                       */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (private/not exported)                                  */
+/*--------------------------------------------------------------------------*/
+static lcsa_errorcode_t err = LCSA_ERROR_OK;
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+static void quality_test_process_at(uint32_t ms);
+
+/*--------------------------------------------------------------------------*/
+/* function definition (public/exported)                                    */
+/*--------------------------------------------------------------------------*/
+// setUp will be called before each test
+void setUp(void)
+{
+	static uint8_t init_once = 0;
+
+	if (init_once != 1)
+	{
+		init_once = 1;
+
+		err = lcsa_init(LCSA_BAUD_RATE_DEFAULT);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = app_frc2_init(APP_FRC2_MODULE_NR_DEF);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = lcsa_start();
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+	}
+
+	// every test starts with an empty quality window at tick 0
+	unittest_system_ticks = 0;
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_quality_init());
+}
+
+// tearDown will be called after each test
+void tearDown(void)
+{
+	unittest_system_ticks = 0;
+}
+
+/**
+ * @test test_quality_window_node_load
+ * @brief the bits of a slot count for the node load until the slot leaves the quality window
+ */
+void test_quality_window_node_load(void)
+{
+	uint16_t node_load = 0xFFFF;
+	uint16_t i;
+
+	for (i = 0; i < 20; i++)
+	{
+		can_quality_rx(CAN_QUALITY_NODE_MAIN, 8);
+	}
+
+	// the current slot is not finished yet
+	quality_test_process_at(QUALITY_TEST_SLOT_MS - 1);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_quality_node_load_get(CAN_QUALITY_NODE_MAIN, &node_load));
+	XTFW_ASSERT_EQUAL_UINT16(0, node_load);
+
+	quality_test_process_at(QUALITY_TEST_SLOT_MS);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_quality_node_load_get(CAN_QUALITY_NODE_MAIN, &node_load));
+	XTFW_ASSERT_EQUAL_UINT16((20 * QUALITY_TEST_FRAME_BITS * 1000) / QUALITY_TEST_WINDOW_BITS, node_load);
+
+	// the slot stays in the window for 7 more slots
+	for (i = 2; i <= 8; i++)
+	{
+		quality_test_process_at(i * QUALITY_TEST_SLOT_MS);
+		XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_quality_node_load_get(CAN_QUALITY_NODE_MAIN, &node_load));
+		XTFW_ASSERT_EQUAL_UINT16((20 * QUALITY_TEST_FRAME_BITS * 1000) / QUALITY_TEST_WINDOW_BITS, node_load);
+	}
+
+	quality_test_process_at(9 * QUALITY_TEST_SLOT_MS);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_quality_node_load_get(CAN_QUALITY_NODE_MAIN, &node_load));
+	XTFW_ASSERT_EQUAL_UINT16(0, node_load);
+
+	// the monitor node has not counted anything
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_quality_node_load_get(CAN_QUALITY_NODE_MON, &node_load));
+	XTFW_ASSERT_EQUAL_UINT16(0, node_load);
+}
+
+/**
+ * @test test_quality_window_delayed_process
+ * @brief slots without a call of can_quality_process() are taken as idle
+ */
+void test_quality_window_delayed_process(void)
+{
+	uint16_t node_load = 0xFFFF;
+	uint16_t i;
+
+	for (i = 0; i < 20; i++)
+	{
+		can_quality_tx(CAN_QUALITY_NODE_MAIN, 8);
+	}
+	quality_test_process_at(QUALITY_TEST_SLOT_MS);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_quality_node_load_get(CAN_QUALITY_NODE_MAIN, &node_load));
+	XTFW_ASSERT_EQUAL_UINT16((20 * QUALITY_TEST_FRAME_BITS * 1000) / QUALITY_TEST_WINDOW_BITS, node_load);
+
+	// one delayed call moves the window by 3 slots, the slot with the messages is still in the window
+	quality_test_process_at(4 * QUALITY_TEST_SLOT_MS + 5);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_quality_node_load_get(CAN_QUALITY_NODE_MAIN, &node_load));
+	XTFW_ASSERT_EQUAL_UINT16((20 * QUALITY_TEST_FRAME_BITS * 1000) / QUALITY_TEST_WINDOW_BITS, node_load);
+
+	// the slots stay aligned to the first slot, so the next call moves the window by 5 slots
+	quality_test_process_at(9 * QUALITY_TEST_SLOT_MS);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_quality_node_load_get(CAN_QUALITY_NODE_MAIN, &node_load));
+	XTFW_ASSERT_EQUAL_UINT16(0, node_load);
+}
+
+/**
+ * @test test_quality_window_current_quality
+ * @brief the current quality is calculated from the quality window, the quality from all counted messages
+ */
+void test_quality_window_current_quality(void)
+{
+	uint16_t current_quality = 0;
+	uint16_t quality = 0;
+	can_quality_t statistic;
+	uint16_t i;
+
+	for (i = 0; i < 60; i++)
+	{
+		can_quality_rx(CAN_QUALITY_NODE_MAIN, 8);
+	}
+	for (i = 0; i < 30; i++)
+	{
+		can_quality_tx(CAN_QUALITY_NODE_MAIN, 2);
+	}
+	for (i = 0; i < 10; i++)
+	{
+		can_quality_lec(CAN_QUALITY_NODE_MAIN, CAN_QUALITY_LEC_CRC);
+	}
+
+	// the values are calculated at the end of the slot only
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_quality_current_get(&current_quality));
+	XTFW_ASSERT_EQUAL_UINT16(1000, current_quality);
+
+	quality_test_process_at(QUALITY_TEST_SLOT_MS);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_quality_current_get(&current_quality));
+	XTFW_ASSERT_EQUAL_UINT16(900, current_quality);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_quality_get(&quality));
+	XTFW_ASSERT_EQUAL_UINT16(900, quality);
+
+	// 100 messages without error in the next slot
+	for (i = 0; i < 100; i++)
+	{
+		can_quality_rx(CAN_QUALITY_NODE_MAIN, 8);
+	}
+	quality_test_process_at(2 * QUALITY_TEST_SLOT_MS);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_quality_current_get(&current_quality));
+	XTFW_ASSERT_EQUAL_UINT16(950, current_quality);
+
+	// the errors leave the window, the quality since the start keeps them
+	quality_test_process_at(9 * QUALITY_TEST_SLOT_MS);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_quality_current_get(&current_quality));
+	XTFW_ASSERT_EQUAL_UINT16(1000, current_quality);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_quality_get(&quality));
+	XTFW_ASSERT_EQUAL_UINT16(950, quality);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_quality_statistic_get(CAN_QUALITY_NODE_MAIN, &statistic));
+	XTFW_ASSERT_EQUAL_UINT32(160, statistic.rx_msg_cnt);
+	XTFW_ASSERT_EQUAL_UINT32(160 * 8, statistic.rx_byte_cnt);
+	XTFW_ASSERT_EQUAL_UINT32(30, statistic.tx_msg_cnt);
+	XTFW_ASSERT_EQUAL_UINT32(30 * 2, statistic.tx_byte_cnt);
+	XTFW_ASSERT_EQUAL_UINT32(10, statistic.cnt_lec[CAN_QUALITY_LEC_CRC]);
+	XTFW_ASSERT_EQUAL_UINT32(0, statistic.cnt_lec[CAN_QUALITY_LEC_STUFF]);
+	XTFW_ASSERT_EQUAL_UINT16(1000, statistic.current_quality);
+	XTFW_ASSERT_EQUAL_UINT16(950, statistic.quality);
+}
+
+/**
+ * @test test_quality_invalid_node
+ * @brief counters of unknown nodes and last error codes are ignored, the statistic of unknown nodes is rejected
+ */
+void test_quality_invalid_node(void)
+{
+	uint16_t node_load = 0;
+	can_quality_t statistic;
+
+	can_quality_rx(CAN_QUALITY_NR_OF_NODES, 8);
+	can_quality_tx(CAN_QUALITY_NR_OF_NODES, 8);
+	can_quality_lec(CAN_QUALITY_NODE_MAIN, CAN_QUALITY_NR_OF_LEC);
+
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_QUALITY_INVALID_NODE, can_quality_node_load_get(CAN_QUALITY_NR_OF_NODES, &node_load));
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_QUALITY_INVALID_NODE, can_quality_statistic_get(CAN_QUALITY_NR_OF_NODES, &statistic));
+
+	quality_test_process_at(QUALITY_TEST_SLOT_MS);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_quality_statistic_get(CAN_QUALITY_NODE_MAIN, &statistic));
+	XTFW_ASSERT_EQUAL_UINT32(0, statistic.rx_msg_cnt);
+	XTFW_ASSERT_EQUAL_UINT32(0, statistic.tx_msg_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(0, statistic.node_load);
+	XTFW_ASSERT_EQUAL_UINT16(1000, statistic.current_quality);
+}
+
+/*--------------------------------------------------------------------------*/
+/* function definition (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief sets the system ticks and calls the quality process
+ * @param ms time since the start of the test
+ */
+static void quality_test_process_at(uint32_t ms)
+{
+	unittest_system_ticks = ms;
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_quality_process());
+}
+
+/** @} */
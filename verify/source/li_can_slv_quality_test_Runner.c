@@ -0,0 +1,58 @@
+/* AUTOGENERATED FILE. DO NOT EDIT. */
+
+/*=======Test Runner Used To Run Each Test Below=====*/
+#define RUN_TEST(TestFunc, TestLineNum) \
+{ \
+  Unity.CurrentTestName = #TestFunc; \
+  Unity.CurrentTestLineNumber = TestLineNum; \
+  Unity.NumberOfTests++; \
+  if (TEST_PROTECT()) \
+  { \
+      setUp(); \
+      TestFunc(); \
+  } \
+  if (TEST_PROTECT()) \
+  { \
+    tearDown(); \
+  } \
+  UnityConcludeTest(); \
+}
+
+/*=======Automagically Detected Files To Include=====*/
+#include "unity.h"
+#include <setjmp.h>
+#include <stdio.h>
+#include "xtfw.h"
+#include <li_can_slv/api/li_can_slv_api.h>
+#include <li_can_slv/util/io_can_quality.h>
+#include <li_can_slv/error/io_can_errno.h>
+
+/*=======External Functions This Runner Calls=====*/
+extern void setUp(void);
+extern void tearDown(void);
+extern void test_quality_window_node_load(void);
+extern void test_quality_window_delayed_process(void);
+extern void test_quality_window_current_quality(void);
+extern void test_quality_invalid_node(void);
+
+
+/*=======Test Reset Option=====*/
+void resetTest(void);
+void resetTest(void)
+{
+  tearDown();
+  setUp();
+}
+
+
+/*=======MAIN=====*/
+int main(void)
+{
+  UnityBegin("/root/repo/verify/source/li_can_slv_quality_test.c");
+  RUN_TEST(test_quality_window_node_load, 105);
+  RUN_TEST(test_quality_window_delayed_process, 145);
+  RUN_TEST(test_quality_window_current_quality, 173);
+  RUN_TEST(test_quality_invalid_node, 234);
+
+  return (UnityEnd());
+}
@@ -0,0 +1,487 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/**
+ * @file li_can_slv_resume_test.c
+ * @addtogroup unittest
+ * @{
+ */
+
+/*--------------------------------------------------------------------------*/
+/* include files                                                            */
+/*--------------------------------------------------------------------------*/
+#include "unity_config.h"
+#include "unity.h"
+#include "xtfw.h"
+
+#include <li_can_slv/api/li_can_slv_api.h>
+
+// add some logical modules here as c include for test only
+#include "io_app_frc2.c"
+#include "io_app_incx.c"
+#include "io_app_inxy.c"
+#include "io_app_ma_w.c"
+
+// used for the logging of the can output
+#include "io_can_hw.h"
+#include "io_can_main_hw.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <windows.h>
+
+#include <string.h>
+
+#include <li_can_slv/xload/li_can_slv_xload.h>
+#include <li_can_slv/xload/li_can_slv_xload_buffer.h>
+#include <li_can_slv/xload/li_can_slv_xload_crc16.h>
+#include <li_can_slv/xload/li_can_slv_xload_info.h>
+#include <li_can_slv/async/io_can_async.h>
+#include <li_can_slv/error/io_can_errno.h>
+
+#include "unittest_canpie-fd.h"
+
+/*--------------------------------------------------------------------------*/
+/* general definitions (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+#define RESUME_TEST_MODULE_NR	APP_FRC2_MODULE_NR_DEF /**< module of the downloads */
+#define RESUME_TEST_BLOCK_OBJS	2 /**< data objects of a block */
+#define RESUME_TEST_BLOCK_SIZE	(RESUME_TEST_BLOCK_OBJS * (CAN_DLC_MAX - 1)) /**< bytes of a block */
+#define RESUME_TEST_BLOCKS	3 /**< blocks of the component */
+#define RESUME_TEST_IMAGE_SIZE	(RESUME_TEST_BLOCKS * RESUME_TEST_BLOCK_SIZE) /**< size of the component */
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions (private/not exported)                        */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (public/exported)                                       */
+/*--------------------------------------------------------------------------*/
+li_can_slv_xload_info_t xload_info;
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (private/not exported)                                  */
+/*--------------------------------------------------------------------------*/
+static lcsa_errorcode_t err = LCSA_ERROR_OK;
+static uint16_t start_reject = FALSE; /**< the download start request handle rejects the download */
+static uint32_t start_offset = 0; /**< resume offset seen by the download start request handle */
+static uint16_t end_cnt = 0;
+static uint16_t image_len = 0;
+static byte_t image[RESUME_TEST_IMAGE_SIZE];
+static byte_t component[RESUME_TEST_IMAGE_SIZE];
+static uint16_t component_crc = 0;
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+static li_can_slv_errorcode_t dload_version_request_hdl(li_can_slv_xload_component_t *dload_component, li_can_slv_xload_end_handle_status_t *status);
+static li_can_slv_errorcode_t dload_start_request_hdl(li_can_slv_xload_component_t *dload_component);
+static li_can_slv_errorcode_t dload_data_block_end_hdl(li_can_slv_xload_component_t *dload_component);
+static li_can_slv_errorcode_t dload_end_hdl(li_can_slv_xload_component_t *dload_component, li_can_slv_xload_end_handle_status_t *status);
+
+static void resume_test_opt_in(byte_t flags);
+static li_can_slv_errorcode_t resume_test_start(byte_t download_id);
+static li_can_slv_errorcode_t resume_test_block(uint16_t offset);
+static void resume_test_interrupt(uint16_t blocks);
+static void resume_test_log_open(char *file_name);
+static void resume_test_log_check(char *file_name, const char *exp_file_name);
+
+static int doesFileExist(const char *filename);
+static void get_expected_file_path(const char *filename, char *filepath);
+
+/*--------------------------------------------------------------------------*/
+/* function definition (public/exported)                                    */
+/*--------------------------------------------------------------------------*/
+// setUp will be called before each test
+void setUp(void)
+{
+	static uint8_t init_once = 0;
+	uint16_t i;
+
+	if (init_once != 1)
+	{
+		init_once = 1;
+
+		// the xload_info isn't valid yet and is cleaned by lcsa_init()
+		(void) lcsa_init(LCSA_BAUD_RATE_DEFAULT);
+
+		err = app_frc2_init(APP_FRC2_MODULE_NR_DEF);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = lcsa_start();
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = lcsa_dload_set_version_request_handle(&dload_version_request_hdl);
+		err = lcsa_dload_set_start_request_handle(&dload_start_request_hdl);
+		err = lcsa_dload_set_data_block_end_handle(&dload_data_block_end_hdl);
+		err = lcsa_dload_set_end_handle(&dload_end_hdl);
+	}
+
+	for (i = 0; i < RESUME_TEST_IMAGE_SIZE; i++)
+	{
+		component[i] = (byte_t)(0x30 + i);
+	}
+	component_crc = li_can_slv_xload_crc16_update(li_can_slv_xload_crc16_init(), component, sizeof(component));
+
+	li_can_slv_xload_info_clean();
+	start_reject = FALSE;
+	start_offset = 0;
+	end_cnt = 0;
+	image_len = 0;
+	memset(image, 0x00, sizeof(image));
+}
+
+// tearDown will be called after each test
+void tearDown(void)
+{
+
+}
+
+/**
+ * @test test_dload_resume_progress
+ * @brief the accepted download start stores the component, every programmed block stores the offset and the running
+ * CRC, the completed download clears the progress
+ */
+void test_dload_resume_progress(void)
+{
+	li_can_slv_xload_component_t stored;
+	uint32_t offset;
+	uint16_t crc;
+	uint16_t i;
+
+	resume_test_log_open("_tc_dload_resume_progress.log");
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, resume_test_start(0x01));
+	li_can_slv_xload_info_get_dload_component(&stored);
+	XTFW_ASSERT_EQUAL_UINT16(component_crc, stored.crc);
+	XTFW_ASSERT_EQUAL_UINT16(0x01, stored.download_id);
+	XTFW_ASSERT_EQUAL_MEMORY("TESTCOMP", stored.name, 8);
+
+	for (i = 0; i < RESUME_TEST_BLOCKS; i++)
+	{
+		XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, resume_test_block(i * RESUME_TEST_BLOCK_SIZE));
+		li_can_slv_xload_info_get_dload_resume(&offset, &crc);
+		XTFW_ASSERT_EQUAL_UINT32((i + 1) * RESUME_TEST_BLOCK_SIZE, offset);
+		XTFW_ASSERT_EQUAL_UINT16(li_can_slv_xload_crc16_update(li_can_slv_xload_crc16_init(), component, (i + 1) * RESUME_TEST_BLOCK_SIZE), crc);
+	}
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_end(RESUME_TEST_MODULE_NR));
+	XTFW_ASSERT_EQUAL_UINT16(1, end_cnt);
+	li_can_slv_xload_info_get_dload_resume(&offset, &crc);
+	XTFW_ASSERT_EQUAL_UINT32(0, offset);
+
+	resume_test_log_check("_tc_dload_resume_progress.log", "tc_dload_resume_progress_exp.log");
+}
+
+/**
+ * @test test_dload_resume_opt_in
+ * @brief only the exact opt-in of the version request long2 resumes the download, a download start without the opt-in
+ * starts at 0 and clears the progress
+ */
+void test_dload_resume_opt_in(void)
+{
+	uint32_t offset;
+	uint16_t crc;
+
+	resume_test_log_open("_tc_dload_resume_opt_in.log");
+
+	resume_test_interrupt(2);
+
+	// other flags in byte 8 are no opt-in
+	resume_test_opt_in(XLOAD_FLAG_RESUME | XLOAD_FLAG_LZ);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, resume_test_start(0x01));
+	XTFW_ASSERT_EQUAL_UINT32(0, start_offset);
+	XTFW_ASSERT_EQUAL_UINT32(0, li_can_slv_dload_get_resume_offset());
+	li_can_slv_xload_info_get_dload_resume(&offset, &crc);
+	XTFW_ASSERT_EQUAL_UINT32(0, offset);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_termination(RESUME_TEST_MODULE_NR, ERR_MSG_CAN_DLOAD_DENIED));
+
+	resume_test_interrupt(2);
+	resume_test_opt_in(XLOAD_FLAG_RESUME);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, resume_test_start(0x01));
+	XTFW_ASSERT_EQUAL_UINT32(2 * RESUME_TEST_BLOCK_SIZE, start_offset);
+	XTFW_ASSERT_EQUAL_UINT32(2 * RESUME_TEST_BLOCK_SIZE, li_can_slv_dload_get_resume_offset());
+
+	// the opt-in is only valid for one download start
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_termination(RESUME_TEST_MODULE_NR, ERR_MSG_CAN_DLOAD_DENIED));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, resume_test_start(0x01));
+	XTFW_ASSERT_EQUAL_UINT32(0, start_offset);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_termination(RESUME_TEST_MODULE_NR, ERR_MSG_CAN_DLOAD_DENIED));
+
+	resume_test_log_check("_tc_dload_resume_opt_in.log", "tc_dload_resume_opt_in_exp.log");
+}
+
+/**
+ * @test test_dload_resume_block_ackn
+ * @brief the download start acknowledge of a resumed download is followed by a block acknowledge with the offset and
+ * the running CRC, the download continues at the offset and ends with the CRC of the whole component
+ */
+void test_dload_resume_block_ackn(void)
+{
+	uint32_t offset;
+	uint16_t crc;
+
+	resume_test_log_open("_tc_dload_resume_block_ackn.log");
+
+	resume_test_interrupt(2);
+	resume_test_opt_in(XLOAD_FLAG_RESUME);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, resume_test_start(0x01));
+	XTFW_ASSERT_EQUAL_UINT32(2 * RESUME_TEST_BLOCK_SIZE, start_offset);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, resume_test_block(2 * RESUME_TEST_BLOCK_SIZE));
+	li_can_slv_xload_info_get_dload_resume(&offset, &crc);
+	XTFW_ASSERT_EQUAL_UINT32(RESUME_TEST_IMAGE_SIZE, offset);
+	XTFW_ASSERT_EQUAL_UINT16(component_crc, crc);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_end(RESUME_TEST_MODULE_NR));
+	XTFW_ASSERT_EQUAL_UINT16(1, end_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(RESUME_TEST_IMAGE_SIZE, image_len);
+	XTFW_ASSERT_EQUAL_MEMORY(component, image, RESUME_TEST_IMAGE_SIZE);
+
+	resume_test_log_check("_tc_dload_resume_block_ackn.log", "tc_dload_resume_block_ackn_exp.log");
+}
+
+/**
+ * @test test_dload_resume_rejected_start
+ * @brief a download start rejected by the application keeps the progress of the interrupted download
+ */
+void test_dload_resume_rejected_start(void)
+{
+	li_can_slv_xload_component_t stored;
+	uint32_t offset;
+	uint16_t crc;
+
+	resume_test_log_open("_tc_dload_resume_rejected_start.log");
+
+	resume_test_interrupt(2);
+
+	// a rejected resume and a rejected start of another download leave the xload_info untouched
+	start_reject = TRUE;
+	resume_test_opt_in(XLOAD_FLAG_RESUME);
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_DLOAD_DENIED, resume_test_start(0x01));
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_DLOAD_DENIED, resume_test_start(0x02));
+	start_reject = FALSE;
+
+	li_can_slv_xload_info_get_dload_component(&stored);
+	XTFW_ASSERT_EQUAL_UINT16(0x01, stored.download_id);
+	li_can_slv_xload_info_get_dload_resume(&offset, &crc);
+	XTFW_ASSERT_EQUAL_UINT32(2 * RESUME_TEST_BLOCK_SIZE, offset);
+	XTFW_ASSERT_EQUAL_UINT16(li_can_slv_xload_crc16_update(li_can_slv_xload_crc16_init(), component, 2 * RESUME_TEST_BLOCK_SIZE), crc);
+
+	// the progress is still resumed after the rejected starts
+	resume_test_opt_in(XLOAD_FLAG_RESUME);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, resume_test_start(0x01));
+	XTFW_ASSERT_EQUAL_UINT32(2 * RESUME_TEST_BLOCK_SIZE, start_offset);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_termination(RESUME_TEST_MODULE_NR, ERR_MSG_CAN_DLOAD_DENIED));
+
+	resume_test_log_check("_tc_dload_resume_rejected_start.log", "tc_dload_resume_rejected_start_exp.log");
+}
+
+/**
+ * @test test_dload_resume_version
+ * @brief a progress stored with another layout version of the xload_info is never resumed
+ */
+void test_dload_resume_version(void)
+{
+	uint32_t offset;
+	uint16_t crc;
+
+	resume_test_log_open("_tc_dload_resume_version.log");
+
+	resume_test_interrupt(2);
+	xload_info.resume.version = LI_CAN_SLV_XLOAD_INFO_RESUME_VERSION - 1;
+	li_can_slv_xload_info_get_dload_resume(&offset, &crc);
+	XTFW_ASSERT_EQUAL_UINT32(0, offset);
+
+	resume_test_opt_in(XLOAD_FLAG_RESUME);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, resume_test_start(0x01));
+	XTFW_ASSERT_EQUAL_UINT32(0, start_offset);
+	XTFW_ASSERT_EQUAL_UINT16(LI_CAN_SLV_XLOAD_INFO_RESUME_VERSION, xload_info.resume.version);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_termination(RESUME_TEST_MODULE_NR, ERR_MSG_CAN_DLOAD_DENIED));
+
+	resume_test_log_check("_tc_dload_resume_version.log", "tc_dload_resume_version_exp.log");
+}
+
+/*--------------------------------------------------------------------------*/
+/* function definition (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+static li_can_slv_errorcode_t dload_version_request_hdl(li_can_slv_xload_component_t *dload_component, li_can_slv_xload_end_handle_status_t *status)
+{
+	dload_component = dload_component;
+	*status = LI_CAN_SLV_XLOAD_STACK_END_HANDLING;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+static li_can_slv_errorcode_t dload_start_request_hdl(li_can_slv_xload_component_t *dload_component)
+{
+	// the programmed part of a resumed download must not be erased
+	start_offset = li_can_slv_dload_get_resume_offset();
+	if (start_reject != FALSE)
+	{
+		return (ERR_MSG_CAN_DLOAD_DENIED);
+	}
+	image_len = (uint16_t) start_offset;
+	return (li_can_slv_dload_start_ackn(dload_component->module_nr, LI_CAN_SLV_XLOAD_MAX_BYTES_PER_BLOCK_DLOAD, 0));
+}
+
+static li_can_slv_errorcode_t dload_data_block_end_hdl(li_can_slv_xload_component_t *dload_component)
+{
+	li_can_slv_errorcode_t rc;
+	uint16_t len;
+
+	dload_component = dload_component;
+
+	rc = xload_buffer_get_len(&len);
+	if ((rc == LI_CAN_SLV_ERR_OK) && ((image_len + len) <= RESUME_TEST_IMAGE_SIZE))
+	{
+		rc = xload_buffer_get_bytes(&image[image_len], len);
+		image_len += len;
+	}
+	return (rc);
+}
+
+static li_can_slv_errorcode_t dload_end_hdl(li_can_slv_xload_component_t *dload_component, li_can_slv_xload_end_handle_status_t *status)
+{
+	dload_component = dload_component;
+	end_cnt++;
+	*status = LI_CAN_SLV_XLOAD_STACK_END_HANDLING;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+/**
+ * @brief sends the version request long of the component TESTCOMP
+ * @param flags byte 8 of the version request long2, #XLOAD_FLAG_RESUME is the opt-in to the resume
+ */
+static void resume_test_opt_in(byte_t flags)
+{
+	byte_t req1[8] = { CAN_ASYNC_DL_VERSION_REQUEST_LONG1, 0x00, 'T', 'E', 'S', 'T', 'C', 'O' };
+	byte_t req2[8] = { CAN_ASYNC_DL_VERSION_REQUEST_LONG2, 0x00, 'M', 'P', 0x00, 0x00, 0x00, 0x00 };
+
+	req2[7] = flags;
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_version_request_long1(RESUME_TEST_MODULE_NR, req1));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_version_request_long2(RESUME_TEST_MODULE_NR, req2));
+}
+
+/**
+ * @brief sends the download start request of the component TESTCOMP
+ * @param download_id download ID of the component
+ * @return return value of li_can_slv_dload_start_request2()
+ */
+static li_can_slv_errorcode_t resume_test_start(byte_t download_id)
+{
+	byte_t req1[8] = { CAN_ASYNC_DL_START_REQUEST1, 'T', 'E', 'S', 'T', 'C', 'O', 'M' };
+	byte_t req2[8] = { CAN_ASYNC_DL_START_REQUEST2, 'P', 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+	req2[2] = (byte_t)(component_crc >> 8);
+	req2[3] = (byte_t)(component_crc & 0x00FFu);
+	req2[7] = download_id;
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_start_request1(RESUME_TEST_MODULE_NR, req1));
+	return (li_can_slv_dload_start_request2(RESUME_TEST_MODULE_NR, req2));
+}
+
+/**
+ * @brief sends the data objects and the data block end of one block of the component
+ * @param offset offset of the block in the component
+ * @return return value of li_can_slv_dload_data_block_end()
+ */
+static li_can_slv_errorcode_t resume_test_block(uint16_t offset)
+{
+	byte_t obj[8];
+	byte_t block_end[8] = { CAN_ASYNC_DL_DATA_BLOCK_END, 0, RESUME_TEST_BLOCK_SIZE, 0, RESUME_TEST_BLOCK_OBJS, 0, 0, 0 };
+	uint16_t i;
+
+	obj[0] = CAN_ASYNC_DL_DATA;
+	for (i = 0; i < RESUME_TEST_BLOCK_OBJS; i++)
+	{
+		memcpy(&obj[1], &component[offset + i * (CAN_DLC_MAX - 1)], CAN_DLC_MAX - 1);
+		XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_data(RESUME_TEST_MODULE_NR, CAN_DLC_MAX, obj));
+	}
+	return (li_can_slv_dload_data_block_end(RESUME_TEST_MODULE_NR, block_end));
+}
+
+/**
+ * @brief starts the download of the component without opt-in and terminates it after some blocks
+ * @param blocks number of programmed blocks
+ */
+static void resume_test_interrupt(uint16_t blocks)
+{
+	uint16_t i;
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, resume_test_start(0x01));
+	for (i = 0; i < blocks; i++)
+	{
+		XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, resume_test_block(i * RESUME_TEST_BLOCK_SIZE));
+	}
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_termination(RESUME_TEST_MODULE_NR, ERR_MSG_CAN_DLOAD_DENIED));
+}
+
+static void resume_test_log_open(char *file_name)
+{
+	can_main_hw_set_log_file_name(file_name);
+	if (can_main_hw_log_open() == EXIT_FAILURE)
+	{
+		TEST_FAIL_MESSAGE("log open fails");
+	}
+}
+
+static void resume_test_log_check(char *file_name, const char *exp_file_name)
+{
+	char file_path[_MAX_PATH];
+
+	can_main_hw_log_close();
+	XTFW_ASSERT_EQUAL_INT(1, doesFileExist(file_name));
+
+	/* compare file content */
+	get_expected_file_path(exp_file_name, file_path);
+	TEST_ASSERT_BINARY_FILE(file_path, file_name);
+}
+
+static int doesFileExist(const char *filename)
+{
+	struct stat st;
+	int result = stat(filename, &st);
+	return result == 0;
+}
+
+static void get_expected_file_path(const char *filename, char *filepath)
+{
+	char drive[_MAX_DRIVE];
+	char dir[_MAX_DIR];
+	char fname[_MAX_FNAME];
+
+	_splitpath(Unity.TestFile, drive, dir, NULL, NULL);
+	strcpy(fname, drive);
+	strcat(fname, dir);
+	strcat(fname, "..\\expected\\file\\");
+	strcat(fname, filename);
+	strcpy(filepath, fname);
+}
+
+/** @} */
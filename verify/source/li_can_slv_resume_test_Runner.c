@@ -0,0 +1,72 @@
+/* AUTOGENERATED FILE. DO NOT EDIT. */
+
+/*=======Test Runner Used To Run Each Test Below=====*/
+#define RUN_TEST(TestFunc, TestLineNum) \
+{ \
+  Unity.CurrentTestName = #TestFunc; \
+  Unity.CurrentTestLineNumber = TestLineNum; \
+  Unity.NumberOfTests++; \
+  if (TEST_PROTECT()) \
+  { \
+      setUp(); \
+      TestFunc(); \
+  } \
+  if (TEST_PROTECT()) \
+  { \
+    tearDown(); \
+  } \
+  UnityConcludeTest(); \
+}
+
+/*=======Automagically Detected Files To Include=====*/
+#include "unity.h"
+#include <setjmp.h>
+#include <stdio.h>
+#include "xtfw.h"
+#include "io_can_hw.h"
+#include "io_can_main_hw.h"
+#include "unittest_canpie-fd.h"
+#include <li_can_slv/api/li_can_slv_api.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <windows.h>
+#include <string.h>
+#include <li_can_slv/xload/li_can_slv_xload.h>
+#include <li_can_slv/xload/li_can_slv_xload_buffer.h>
+#include <li_can_slv/xload/li_can_slv_xload_crc16.h>
+#include <li_can_slv/xload/li_can_slv_xload_info.h>
+#include <li_can_slv/async/io_can_async.h>
+#include <li_can_slv/error/io_can_errno.h>
+
+/*=======External Functions This Runner Calls=====*/
+extern void setUp(void);
+extern void tearDown(void);
+extern void test_dload_resume_progress(void);
+extern void test_dload_resume_opt_in(void);
+extern void test_dload_resume_block_ackn(void);
+extern void test_dload_resume_rejected_start(void);
+extern void test_dload_resume_version(void);
+
+
+/*=======Test Reset Option=====*/
+void resetTest(void);
+void resetTest(void)
+{
+  tearDown();
+  setUp();
+}
+
+
+/*=======MAIN=====*/
+int main(void)
+{
+  UnityBegin("/root/repo/verify/source/li_can_slv_resume_test.c");
+  RUN_TEST(test_dload_resume_progress, 164);
+  RUN_TEST(test_dload_resume_opt_in, 200);
+  RUN_TEST(test_dload_resume_block_ackn, 237);
+  RUN_TEST(test_dload_resume_rejected_start, 267);
+  RUN_TEST(test_dload_resume_version, 302);
+
+  return (UnityEnd());
+}
@@ -0,0 +1,287 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/**
+ * @file li_can_slv_shaper_test.c
+ * @addtogroup unittest
+ * @{
+ */
+
+/*--------------------------------------------------------------------------*/
+/* include files                                                            */
+/*--------------------------------------------------------------------------*/
+#include "unity_config.h"
+#include "unity.h"
+#include "xtfw.h"
+
+#include <li_can_slv/api/li_can_slv_api.h>
+
+// add some logical modules here as c include for test only
+#include "io_app_frc2.c"
+
+// used for the logging of the can output
+#include "io_can_hw.h"
+#include "io_can_main_hw.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <windows.h>
+
+#include <string.h>
+
+#include <li_can_slv/async/io_can_async.h>
+#include <li_can_slv/config/li_can_slv_config_defines.h>
+#include <li_can_slv/error/io_can_errno.h>
+#include <li_can_slv/sync/io_can_sync_handler.h>
+
+#include "unittest_canpie-fd.h"
+
+/*--------------------------------------------------------------------------*/
+/* general definitions (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+#define SHAPER_TEST_MODULE_NR	APP_FRC2_MODULE_NR_DEF /**< module of the asynchronous objects */
+#define SHAPER_TEST_TX_OBJ		((uint8_t) CAN_CONFIG_MSG_MAIN_OBJ_TX_ASYNC) /**< message object of the asynchronous objects */
+#define SHAPER_TEST_PERIODE_MS	10 /**< period of the process requests */
+#define SHAPER_TEST_GUARD_MS	2 /**< guard window of li_can_slv_shaper_test */
+#define SHAPER_TEST_RATE	((250 * 30) / 100) /**< bits per ms of the default bus share at 250 kBaud */
+#define SHAPER_TEST_FRAME_BITS	(55 + (8 * 9)) /**< accounted bits of an object with 8 data bytes */
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions (private/not exported)                        */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (public/exported)                                       */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+extern uint32_t complete_main_tx(uint8_t buffer_id);
+
+/*--------------------------------------------------------------------------*/
+/* global variables (private/not exported)                                  */
+/*--------------------------------------------------------------------------*/
+static lcsa_errorcode_t err = LCSA_ERROR_OK;
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+static void shaper_test_process_request_at(uint32_t ms);
+static void shaper_test_send(uint16_t nr_of_objs);
+static void shaper_test_tx_complete_all(void);
+static void shaper_test_log_open(char *file_name);
+static void shaper_test_log_check(char *file_name, const char *exp_file_name);
+
+static int doesFileExist(const char *filename);
+static void get_expected_file_path(const char *filename, char *filepath);
+
+/*--------------------------------------------------------------------------*/
+/* function definition (public/exported)                                    */
+/*--------------------------------------------------------------------------*/
+// setUp will be called before each test
+void setUp(void)
+{
+	static uint8_t init_once = 0;
+
+	if (init_once != 1)
+	{
+		init_once = 1;
+
+		err = lcsa_init(LCSA_BAUD_RATE_DEFAULT);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = app_frc2_init(APP_FRC2_MODULE_NR_DEF);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = lcsa_start();
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+	}
+}
+
+// tearDown will be called after each test
+void tearDown(void)
+{
+	// no object of a failed test may stay in the transmit path
+	shaper_test_tx_complete_all();
+}
+
+/**
+ * @test test_shaper_budget
+ * @brief the objects are sent as long as the token bucket holds the bus share of one process period, held back
+ * objects are sent when the bucket is refilled every ms
+ */
+void test_shaper_budget(void)
+{
+	uint16_t nr_of_objs;
+	int32_t tokens;
+
+	// the measured process period defines the depth of the bucket
+	shaper_test_process_request_at(1000);
+	shaper_test_process_request_at(1000 + SHAPER_TEST_PERIODE_MS);
+	shaper_test_tx_complete_all();
+
+	shaper_test_log_open("_tc_shaper_budget.log");
+
+	// the objects are admitted until the bucket is empty, the last admitted object borrows from the next refill
+	unittest_system_ticks = 1000 + (2 * SHAPER_TEST_PERIODE_MS);
+	shaper_test_send(10);
+	nr_of_objs = 0;
+	for (tokens = SHAPER_TEST_RATE * SHAPER_TEST_PERIODE_MS; tokens > 0; tokens -= SHAPER_TEST_FRAME_BITS)
+	{
+		nr_of_objs++;
+	}
+	XTFW_ASSERT_EQUAL_UINT16(10 - nr_of_objs, can_async_data_tx_queue_get_nr_of_objs());
+
+	// a refill of 1 ms lets one object pass, then the bucket is empty again
+	unittest_system_ticks += 1;
+	can_async_tx_shaper_process();
+	XTFW_ASSERT_EQUAL_UINT16(10 - nr_of_objs - 1, can_async_data_tx_queue_get_nr_of_objs());
+	can_async_tx_shaper_process();
+	XTFW_ASSERT_EQUAL_UINT16(10 - nr_of_objs - 1, can_async_data_tx_queue_get_nr_of_objs());
+
+	// after a whole period the bucket is full
+	unittest_system_ticks += SHAPER_TEST_PERIODE_MS;
+	can_async_tx_shaper_process();
+	XTFW_ASSERT_EQUAL_UINT16(0, can_async_data_tx_queue_get_nr_of_objs());
+
+	shaper_test_tx_complete_all();
+	shaper_test_log_check("_tc_shaper_budget.log", "tc_shaper_budget_exp.log");
+}
+
+/**
+ * @test test_shaper_guard
+ * @brief no objects are sent shortly before the predicted process request, the process request releases them
+ */
+void test_shaper_guard(void)
+{
+	shaper_test_process_request_at(2000);
+	shaper_test_process_request_at(2000 + SHAPER_TEST_PERIODE_MS);
+	shaper_test_tx_complete_all();
+
+	shaper_test_log_open("_tc_shaper_guard.log");
+
+	// the guard window starts before the next process request
+	unittest_system_ticks = 2000 + (2 * SHAPER_TEST_PERIODE_MS) - SHAPER_TEST_GUARD_MS;
+	shaper_test_send(1);
+	XTFW_ASSERT_EQUAL_UINT16(1, can_async_data_tx_queue_get_nr_of_objs());
+	unittest_system_ticks += SHAPER_TEST_GUARD_MS - 1;
+	can_async_tx_shaper_process();
+	XTFW_ASSERT_EQUAL_UINT16(1, can_async_data_tx_queue_get_nr_of_objs());
+
+	// the object is sent after the process request
+	shaper_test_process_request_at(2000 + (2 * SHAPER_TEST_PERIODE_MS));
+	XTFW_ASSERT_EQUAL_UINT16(0, can_async_data_tx_queue_get_nr_of_objs());
+
+	// a late process request does not block the objects
+	unittest_system_ticks = 2000 + (4 * SHAPER_TEST_PERIODE_MS);
+	shaper_test_send(1);
+	XTFW_ASSERT_EQUAL_UINT16(0, can_async_data_tx_queue_get_nr_of_objs());
+
+	shaper_test_tx_complete_all();
+	shaper_test_log_check("_tc_shaper_guard.log", "tc_shaper_guard_exp.log");
+}
+
+/*--------------------------------------------------------------------------*/
+/* function definition (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief receives a process request on the main and the monitor node
+ * @param ms receive time
+ */
+static void shaper_test_process_request_at(uint32_t ms)
+{
+	byte_t rx_data[8] = { 0 };
+
+	unittest_system_ticks = ms;
+	XTFW_ASSERT_EQUAL_UINT(0, can_sync_handler_rx(CAN_CONFIG_MSG_MAIN_OBJ_RX_PROCESS, 0, CAN_CONFIG_PROCESS_ID, rx_data));
+	XTFW_ASSERT_EQUAL_UINT(0, can_sync_handler_rx_mon(CAN_CONFIG_MSG_MON_OBJ_RX_PROCESS, 0, CAN_CONFIG_PROCESS_ID, rx_data));
+}
+
+/**
+ * @brief adds numbered objects to the asynchronous data TX queue
+ * @param nr_of_objs number of objects
+ */
+static void shaper_test_send(uint16_t nr_of_objs)
+{
+	byte_t data[CAN_CONFIG_ASYNC_DATA_TX_DLC] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77 };
+	uint16_t i;
+
+	for (i = 0; i < nr_of_objs; i++)
+	{
+		data[0] = (byte_t) i;
+		XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_send_data_to_async_data_tx_queue(SHAPER_TEST_MODULE_NR, CAN_ASYNC_DATA_TX_TYPE_SLAVE, CAN_CONFIG_ASYNC_DATA_TX_DLC, data));
+	}
+}
+
+/**
+ * @brief completes the transmission of the asynchronous message object until it is idle
+ */
+static void shaper_test_tx_complete_all(void)
+{
+	while (complete_main_tx(SHAPER_TEST_TX_OBJ) == 0)
+	{
+	}
+}
+
+static void shaper_test_log_open(char *file_name)
+{
+	can_main_hw_set_log_file_name(file_name);
+	if (can_main_hw_log_open() == EXIT_FAILURE)
+	{
+		TEST_FAIL_MESSAGE("log open fails");
+	}
+}
+
+static void shaper_test_log_check(char *file_name, const char *exp_file_name)
+{
+	char file_path[_MAX_PATH];
+
+	can_main_hw_log_close();
+	XTFW_ASSERT_EQUAL_INT(1, doesFileExist(file_name));
+
+	/* compare file content */
+	get_expected_file_path(exp_file_name, file_path);
+	TEST_ASSERT_BINARY_FILE(file_path, file_name);
+}
+
+static int doesFileExist(const char *filename)
+{
+	struct stat st;
+	int result = stat(filename, &st);
+	return result == 0;
+}
+
+static void get_expected_file_path(const char *filename, char *filepath)
+{
+	char drive[_MAX_DRIVE];
+	char dir[_MAX_DIR];
+	char fname[_MAX_FNAME];
+
+	_splitpath(Unity.TestFile, drive, dir, NULL, NULL);
+	strcpy(fname, drive);
+	strcat(fname, dir);
+	strcat(fname, "..\\expected\\file\\");
+	strcat(fname, filename);
+	strcpy(filepath, fname);
+}
+
+/** @} */
@@ -0,0 +1,260 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/**
+ * @file li_can_slv_sync_fd_test.c
+ * @addtogroup unittest
+ * @{
+ */
+
+/*--------------------------------------------------------------------------*/
+/* include files                                                            */
+/*--------------------------------------------------------------------------*/
+#include "unity_config.h"
+#include "unity.h"
+#include "xtfw.h"
+
+#include <li_can_slv/api/li_can_slv_api.h>
+
+// add some logical modules here as c include for test only
+#include "io_app_frc2.c"
+#include "io_app_incx.c"
+#include "io_app_inxy.c"
+#include "io_app_ma_w.c"
+
+// used for the logging of the can output
+#include "io_can_hw.h"
+#include "io_can_main_hw.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <windows.h>
+
+#include <string.h>
+
+#include <li_can_slv/core/io_can_main.h>
+#include <li_can_slv/core/io_can_mon.h>
+#include <li_can_slv/sync/io_can_sync_handler.h>
+
+#include "unittest_canpie-fd.h"
+
+/*--------------------------------------------------------------------------*/
+/* general definitions (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+#define SYNC_FD_TEST_MA_W_RX_ID	0x3C0 /**< identifier of receive object 0 of module 113, it carries all receive objects */
+#define SYNC_FD_TEST_MA_W_RX_SIZE	32 /**< payload length of the CAN FD frame with the 4 receive objects of module 113 */
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions (private/not exported)                        */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (public/exported)                                       */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+extern void receive_main_tx_on_mon_rx(void);
+extern uint32_t send_fd_to_main_rx_handler(uint16_t can_id, uint8_t size, uint8_t *data);
+extern uint32_t send_fd_to_mon_rx_handler(uint16_t can_id, uint8_t size, uint8_t *data);
+
+/*--------------------------------------------------------------------------*/
+/* global variables (private/not exported)                                  */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+static void sync_fd_test_process_request(void);
+static void sync_fd_test_log_open(char *file_name);
+static void sync_fd_test_log_check(char *file_name, const char *exp_file_name);
+
+static int doesFileExist(const char *filename);
+static void get_expected_file_path(const char *filename, char *filepath);
+
+/*--------------------------------------------------------------------------*/
+/* function definition (public/exported)                                    */
+/*--------------------------------------------------------------------------*/
+// setUp will be called before each test
+void setUp(void)
+{
+	app_frc2_image_valid_cnt = 0;
+	app_ma_w_image_valid_cnt = 0;
+	app_ma_w_image_not_valid_cnt = 0;
+
+	XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, lcsa_init(LCSA_BAUD_RATE_DEFAULT));
+
+	// table 0
+	XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, app_frc2_init(APP_FRC2_MODULE_NR_DEF));
+
+	// table 1
+	XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, app_ma_w_init(0, APP_MA_W_MODULE_NR_DEF));
+
+	XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, lcsa_start());
+}
+
+// tearDown will be called after each test
+void tearDown(void)
+{
+	lcsa_deinit();
+	can_main_hw_log_close();
+}
+
+/**
+ * @test test_sync_fd_tx
+ * @brief all transmit objects of a logical module are sent in one CAN FD frame on a process request
+ */
+void test_sync_fd_tx(void)
+{
+	sync_fd_test_log_open("_tc_sync_fd_tx.log");
+
+	app_frc2_set_force(102);
+	app_ma_w_tx1_set_word0(0, 283);
+	app_ma_w_tx2_set_word0(0, 0x1234);
+	app_ma_w_tx4_set_word0(0, 0xABCD);
+
+	sync_fd_test_process_request();
+
+	sync_fd_test_log_check("_tc_sync_fd_tx.log", "tc_sync_fd_tx_exp.log");
+}
+
+/**
+ * @test test_sync_fd_rx
+ * @brief one CAN FD frame is split into the receive objects of a logical module and validates its image
+ */
+void test_sync_fd_rx(void)
+{
+	byte_t rx_data[SYNC_FD_TEST_MA_W_RX_SIZE];
+	uint16_t i;
+
+	for (i = 0; i < SYNC_FD_TEST_MA_W_RX_SIZE; i++)
+	{
+		rx_data[i] = (byte_t) i;
+	}
+
+	sync_fd_test_log_open("_tc_sync_fd_rx.log");
+
+	sync_fd_test_process_request();
+
+	XTFW_ASSERT_EQUAL_UINT(0, send_fd_to_main_rx_handler(SYNC_FD_TEST_MA_W_RX_ID, SYNC_FD_TEST_MA_W_RX_SIZE, rx_data));
+	XTFW_ASSERT_EQUAL_UINT(0, send_fd_to_mon_rx_handler(SYNC_FD_TEST_MA_W_RX_ID, SYNC_FD_TEST_MA_W_RX_SIZE, rx_data));
+
+	XTFW_ASSERT_EQUAL_INT(0, app_ma_w_image_valid_cnt);
+
+	sync_fd_test_process_request();
+
+	XTFW_ASSERT_EQUAL_INT(1, app_frc2_image_valid_cnt);
+	XTFW_ASSERT_EQUAL_INT(1, app_ma_w_image_valid_cnt);
+	XTFW_ASSERT_EQUAL_INT(0, app_ma_w_image_not_valid_cnt);
+
+	// every object uses its own slot of 8 bytes in the frame
+	XTFW_ASSERT_EQUAL_UINT16(0x0001, app_ma_w_rx1_get_word0(0));
+	XTFW_ASSERT_EQUAL_UINT16(0x0607, app_ma_w_rx1_get_word3(0));
+	XTFW_ASSERT_EQUAL_UINT16(0x0809, app_ma_w_rx2_get_word0(0));
+	XTFW_ASSERT_EQUAL_UINT16(0x1011, app_ma_w_rx3_get_word0(0));
+	XTFW_ASSERT_EQUAL_UINT16(0x1E1F, app_ma_w_rx4_get_word3(0));
+
+	sync_fd_test_log_check("_tc_sync_fd_rx.log", "tc_sync_fd_rx_exp.log");
+}
+
+/**
+ * @test test_sync_fd_rx_wrong_size
+ * @brief a CAN FD frame with a wrong payload length is rejected and does not validate the image
+ */
+void test_sync_fd_rx_wrong_size(void)
+{
+	byte_t rx_data[SYNC_FD_TEST_MA_W_RX_SIZE] = { 0 };
+
+	sync_fd_test_log_open("_tc_sync_fd_rx_wrong_size.log");
+
+	sync_fd_test_process_request();
+
+	XTFW_ASSERT_EQUAL_UINT(0, send_fd_to_main_rx_handler(SYNC_FD_TEST_MA_W_RX_ID, 24, rx_data));
+	XTFW_ASSERT_EQUAL_UINT(0, send_fd_to_mon_rx_handler(SYNC_FD_TEST_MA_W_RX_ID, 24, rx_data));
+
+	sync_fd_test_process_request();
+
+	XTFW_ASSERT_EQUAL_INT(0, app_ma_w_image_valid_cnt);
+	XTFW_ASSERT_EQUAL_INT(1, app_ma_w_image_not_valid_cnt);
+
+	sync_fd_test_log_check("_tc_sync_fd_rx_wrong_size.log", "tc_sync_fd_rx_wrong_size_exp.log");
+}
+
+/*--------------------------------------------------------------------------*/
+/* function definition (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief sends a process request on main and monitor and passes the transmitted frames to the monitor
+ */
+static void sync_fd_test_process_request(void)
+{
+	byte_t rx_data[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+	XTFW_ASSERT_EQUAL_UINT(0, can_sync_handler_rx(CAN_CONFIG_MSG_MAIN_OBJ_RX_PROCESS, 0, 0x001, rx_data));
+	XTFW_ASSERT_EQUAL_UINT(0, can_sync_handler_rx_mon(CAN_CONFIG_MSG_MON_OBJ_RX_PROCESS, 0, 0x001, rx_data));
+
+	receive_main_tx_on_mon_rx();
+}
+
+static void sync_fd_test_log_open(char *file_name)
+{
+	can_main_hw_set_log_file_name(file_name);
+	if (can_main_hw_log_open() == EXIT_FAILURE)
+	{
+		TEST_FAIL_MESSAGE("log open fails");
+	}
+}
+
+static void sync_fd_test_log_check(char *file_name, const char *exp_file_name)
+{
+	char file_path[_MAX_PATH];
+
+	can_main_hw_log_close();
+	XTFW_ASSERT_EQUAL_INT(1, doesFileExist(file_name));
+
+	/* compare file content */
+	get_expected_file_path(exp_file_name, file_path);
+	TEST_ASSERT_BINARY_FILE(file_path, file_name);
+}
+
+static int doesFileExist(const char *filename)
+{
+	struct stat st;
+	int result = stat(filename, &st);
+	return result == 0;
+}
+
+static void get_expected_file_path(const char *filename, char *filepath)
+{
+	char drive[_MAX_DRIVE];
+	char dir[_MAX_DIR];
+	char fname[_MAX_FNAME];
+
+	_splitpath(Unity.TestFile, drive, dir, NULL, NULL);
+	strcpy(fname, drive);
+	strcat(fname, dir);
+	strcat(fname, "..\\expected\\file\\");
+	strcat(fname, filename);
+	strcpy(filepath, fname);
+}
+
+/** @} */
@@ -0,0 +1,89 @@
+/* AUTOGENERATED FILE. DO NOT EDIT. */
+
+/*=======Test Runner Used To Run Each Test Below=====*/
+#define RUN_TEST(TestFunc, TestLineNum) \
+{ \
+  Unity.CurrentTestName = #TestFunc; \
+  Unity.CurrentTestLineNumber = TestLineNum; \
+  Unity.NumberOfTests++; \
+  if (TEST_PROTECT()) \
+  { \
+      setUp(); \
+      TestFunc(); \
+  } \
+  if (TEST_PROTECT()) \
+  { \
+    tearDown(); \
+  } \
+  UnityConcludeTest(); \
+}
+
+/*=======Automagically Detected Files To Include=====*/
+#include "unity.h"
+#include <setjmp.h>
+#include <stdio.h>
+#include "xtfw.h"
+#include "io_can_hw.h"
+#include "io_can_main_hw.h"
+#include "io_app_module_change.h"
+#include "unittest_canpie-fd.h"
+#include <li_can_slv/api/li_can_slv_api.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <windows.h>
+#include <string.h>
+#include <li_can_slv/core/io_can_main.h>
+#include <li_can_slv/core/io_can_main_handler.h>
+#include <li_can_slv/core/io_can_mon.h>
+#include <li_can_slv/sync/io_can_sync_handler.h>
+
+/*=======External Functions This Runner Calls=====*/
+extern void setUp(void);
+extern void tearDown(void);
+extern void test_process_req(void);
+extern void test_sync_check_image_not_valid(void);
+extern void test_sync_check_image_valid(void);
+extern void test_sync_image_ERR_MSG_CAN_MAIN_RX_WRONG_DLC(void);
+extern void test_sync_image_ERR_MSG_CAN_MON_RX_WRONG_DLC(void);
+extern void test_sync_image_ERR_MSG_CAN_MON_TX_WRONG_DLC(void);
+extern void test_sync_image_ERR_MSG_CAN_MAIN_MON_DATA_RX(void);
+extern void test_sync_image_ERR_MSG_CAN_MAIN_MON_DATA_TX(void);
+extern void test_sync_image_ERR_MSG_CAN_MAIN_NR_OF_RX_DATA(void);
+extern void test_sync_image_ERR_MSG_CAN_MON_NR_OF_RX_DATA(void);
+extern void test_sync_image_ERR_MSG_CAN_MON_NR_OF_TX_DATA(void);
+extern void test_sync_NO_MON_DATA(void);
+extern void test_sync_critical_module_no_error(void);
+extern void test_sync_reinit_stack_no_tx_data(void);
+
+
+/*=======Test Reset Option=====*/
+void resetTest(void);
+void resetTest(void)
+{
+  tearDown();
+  setUp();
+}
+
+
+/*=======MAIN=====*/
+int main(void)
+{
+  UnityBegin("/root/repo/verify/source/li_can_slv_sync_test.c");
+  RUN_TEST(test_process_req, 152);
+  RUN_TEST(test_sync_check_image_not_valid, 215);
+  RUN_TEST(test_sync_check_image_valid, 279);
+  RUN_TEST(test_sync_image_ERR_MSG_CAN_MAIN_RX_WRONG_DLC, 371);
+  RUN_TEST(test_sync_image_ERR_MSG_CAN_MON_RX_WRONG_DLC, 457);
+  RUN_TEST(test_sync_image_ERR_MSG_CAN_MON_TX_WRONG_DLC, 546);
+  RUN_TEST(test_sync_image_ERR_MSG_CAN_MAIN_MON_DATA_RX, 634);
+  RUN_TEST(test_sync_image_ERR_MSG_CAN_MAIN_MON_DATA_TX, 753);
+  RUN_TEST(test_sync_image_ERR_MSG_CAN_MAIN_NR_OF_RX_DATA, 833);
+  RUN_TEST(test_sync_image_ERR_MSG_CAN_MON_NR_OF_RX_DATA, 918);
+  RUN_TEST(test_sync_image_ERR_MSG_CAN_MON_NR_OF_TX_DATA, 1005);
+  RUN_TEST(test_sync_NO_MON_DATA, 1092);
+  RUN_TEST(test_sync_critical_module_no_error, 1215);
+  RUN_TEST(test_sync_reinit_stack_no_tx_data, 1312);
+
+  return (UnityEnd());
+}
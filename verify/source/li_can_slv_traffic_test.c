@@ -0,0 +1,250 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/**
+ * @file li_can_slv_traffic_test.c
+ * @addtogroup unittest
+ * @{
+ */
+
+/*--------------------------------------------------------------------------*/
+/* include files                                                            */
+/*--------------------------------------------------------------------------*/
+#include "unity_config.h"
+#include "unity.h"
+#include "xtfw.h"
+
+#include <li_can_slv/api/li_can_slv_api.h>
+
+// add some logical modules here as c include for test only
+#include "io_app_frc2.c"
+#include "io_app_ma_w.c"
+
+#include <li_can_slv/util/io_can_traffic.h>
+#include <li_can_slv/error/io_can_errno.h>
+
+/*--------------------------------------------------------------------------*/
+/* general definitions (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+#define TRAFFIC_TEST_SIZE	(4) /**< counted identifiers, see LI_CAN_SLV_SET_TRAFFIC_SIZE of the verify configuration */
+#define TRAFFIC_TEST_MAX_ENTRIES	(16) /**< size of the snapshot table of the tests */
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions (private/not exported)                        */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (public/exported)                                       */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+extern uint32_t send_to_main_rx_handler(uint16_t can_id, uint8_t dlc, uint8_t *data);
+extern uint32_t send_to_mon_rx_handler(uint16_t can_id, uint8_t dlc, uint8_t *data);
+
+/*--------------------------------------------------------------------------*/
+/* global variables (private/not exported)                                  */
+/*--------------------------------------------------------------------------*/
+static lcsa_errorcode_t err = LCSA_ERROR_OK;
+static can_traffic_entry_t traffic_test_entries[TRAFFIC_TEST_MAX_ENTRIES];
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+static can_traffic_entry_t *traffic_test_find(uint16_t nr_of_entries, uint16_t node, uint16_t canid);
+
+/*--------------------------------------------------------------------------*/
+/* function definition (public/exported)                                    */
+/*--------------------------------------------------------------------------*/
+// setUp will be called before each test
+void setUp(void)
+{
+	static uint8_t init_once = 0;
+
+	if (init_once != 1)
+	{
+		init_once = 1;
+
+		err = lcsa_init(LCSA_BAUD_RATE_DEFAULT);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = app_frc2_init(APP_FRC2_MODULE_NR_DEF);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = app_ma_w_init(0, APP_MA_W_MODULE_NR_DEF);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = lcsa_start();
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+	}
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_traffic_reset());
+}
+
+// tearDown will be called after each test
+void tearDown(void)
+{
+}
+
+/**
+ * @test test_traffic_table_overflow
+ * @brief identifiers which do not fit into the full counter table are counted as overflow, the counted identifiers
+ * are still counted
+ */
+void test_traffic_table_overflow(void)
+{
+	can_traffic_entry_t *entry;
+	uint16_t nr_of_entries = 0;
+	uint32_t overflow = 0xFFFFFFFF;
+	uint16_t i;
+
+	// the table takes one identifier per entry
+	for (i = 0; i < TRAFFIC_TEST_SIZE; i++)
+	{
+		can_traffic_rx(CAN_TRAFFIC_NODE_MAIN, 0x500 + i, CAN_TRAFFIC_REASON_ACCEPTED);
+	}
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_traffic_get_overflow(&overflow));
+	XTFW_ASSERT_EQUAL_UINT32(0, overflow);
+
+	// the same identifier on the monitor node needs an own entry
+	can_traffic_rx(CAN_TRAFFIC_NODE_MON, 0x500, CAN_TRAFFIC_REASON_ACCEPTED);
+	can_traffic_rx(CAN_TRAFFIC_NODE_MAIN, 0x600, CAN_TRAFFIC_REASON_DROPPED);
+	can_traffic_rx(CAN_TRAFFIC_NODE_MAIN, 0x600, CAN_TRAFFIC_REASON_DROPPED);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_traffic_get_overflow(&overflow));
+	XTFW_ASSERT_EQUAL_UINT32(3, overflow);
+
+	// counted identifiers are still counted, an unknown reason is counted as dropped
+	can_traffic_rx(CAN_TRAFFIC_NODE_MAIN, 0x501, CAN_TRAFFIC_REASON_WRONG_DLC);
+	can_traffic_rx(CAN_TRAFFIC_NODE_MAIN, 0x501, CAN_TRAFFIC_NR_OF_REASONS);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_traffic_get_overflow(&overflow));
+	XTFW_ASSERT_EQUAL_UINT32(3, overflow);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_traffic_snapshot(traffic_test_entries, TRAFFIC_TEST_MAX_ENTRIES, &nr_of_entries));
+	XTFW_ASSERT_EQUAL_UINT16(TRAFFIC_TEST_SIZE, nr_of_entries);
+	for (i = 0; i < TRAFFIC_TEST_SIZE; i++)
+	{
+		entry = traffic_test_find(nr_of_entries, CAN_TRAFFIC_NODE_MAIN, 0x500 + i);
+		XTFW_ASSERT_NOT_NULL(entry);
+		XTFW_ASSERT_EQUAL_UINT32(1, entry->cnt[CAN_TRAFFIC_REASON_ACCEPTED]);
+	}
+	entry = traffic_test_find(nr_of_entries, CAN_TRAFFIC_NODE_MAIN, 0x501);
+	XTFW_ASSERT_EQUAL_UINT32(1, entry->cnt[CAN_TRAFFIC_REASON_WRONG_DLC]);
+	XTFW_ASSERT_EQUAL_UINT32(1, entry->cnt[CAN_TRAFFIC_REASON_DROPPED]);
+	XTFW_ASSERT_NULL(traffic_test_find(nr_of_entries, CAN_TRAFFIC_NODE_MON, 0x500));
+	XTFW_ASSERT_NULL(traffic_test_find(nr_of_entries, CAN_TRAFFIC_NODE_MAIN, 0x600));
+
+	// a smaller snapshot table is filled up
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_traffic_snapshot(traffic_test_entries, 2, &nr_of_entries));
+	XTFW_ASSERT_EQUAL_UINT16(2, nr_of_entries);
+
+	// the reset frees the table and clears the overflow
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_traffic_reset());
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_traffic_get_overflow(&overflow));
+	XTFW_ASSERT_EQUAL_UINT32(0, overflow);
+	can_traffic_rx(CAN_TRAFFIC_NODE_MAIN, 0x600, CAN_TRAFFIC_REASON_DROPPED);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_traffic_snapshot(traffic_test_entries, TRAFFIC_TEST_MAX_ENTRIES, &nr_of_entries));
+	XTFW_ASSERT_EQUAL_UINT16(1, nr_of_entries);
+	XTFW_ASSERT_EQUAL_UINT16(0x600, traffic_test_entries[0].canid);
+	XTFW_ASSERT_EQUAL_UINT16(CAN_TRAFFIC_NODE_MAIN, traffic_test_entries[0].node);
+	XTFW_ASSERT_EQUAL_UINT32(1, traffic_test_entries[0].cnt[CAN_TRAFFIC_REASON_DROPPED]);
+}
+
+/**
+ * @test test_traffic_sync_not_in_table
+ * @brief synchronous process data of the configured logical modules is counted beside the full counter table
+ */
+void test_traffic_sync_not_in_table(void)
+{
+	byte_t data[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+	can_traffic_entry_t *entry;
+	uint16_t nr_of_entries = 0;
+	uint32_t overflow = 0xFFFFFFFF;
+	uint16_t i;
+
+	for (i = 0; i < TRAFFIC_TEST_SIZE; i++)
+	{
+		can_traffic_rx(CAN_TRAFFIC_NODE_MAIN, 0x500 + i, CAN_TRAFFIC_REASON_ACCEPTED);
+	}
+
+	// output data of the logical module ma_w
+	XTFW_ASSERT_EQUAL_UINT(0, send_to_main_rx_handler(0x3C0, 8, data));
+	XTFW_ASSERT_EQUAL_UINT(0, send_to_main_rx_handler(0x3C0, 4, data));
+	XTFW_ASSERT_EQUAL_UINT(0, send_to_main_rx_handler(0x3C1, 8, data));
+	XTFW_ASSERT_EQUAL_UINT(0, send_to_mon_rx_handler(0x3C0, 8, data));
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_traffic_get_overflow(&overflow));
+	XTFW_ASSERT_EQUAL_UINT32(0, overflow);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_traffic_snapshot(traffic_test_entries, TRAFFIC_TEST_MAX_ENTRIES, &nr_of_entries));
+	XTFW_ASSERT_EQUAL_UINT16(TRAFFIC_TEST_SIZE + 3, nr_of_entries);
+
+	entry = traffic_test_find(nr_of_entries, CAN_TRAFFIC_NODE_MAIN, 0x3C0);
+	XTFW_ASSERT_NOT_NULL(entry);
+	XTFW_ASSERT_EQUAL_UINT32(1, entry->cnt[CAN_TRAFFIC_REASON_ACCEPTED]);
+	XTFW_ASSERT_EQUAL_UINT32(1, entry->cnt[CAN_TRAFFIC_REASON_WRONG_DLC]);
+
+	entry = traffic_test_find(nr_of_entries, CAN_TRAFFIC_NODE_MAIN, 0x3C1);
+	XTFW_ASSERT_NOT_NULL(entry);
+	XTFW_ASSERT_EQUAL_UINT32(1, entry->cnt[CAN_TRAFFIC_REASON_ACCEPTED]);
+
+	entry = traffic_test_find(nr_of_entries, CAN_TRAFFIC_NODE_MON, 0x3C0);
+	XTFW_ASSERT_NOT_NULL(entry);
+	XTFW_ASSERT_EQUAL_UINT32(1, entry->cnt[CAN_TRAFFIC_REASON_ACCEPTED]);
+}
+
+/**
+ * @test test_traffic_reason
+ * @brief error codes of the receive functions are mapped to the reasons
+ */
+void test_traffic_reason(void)
+{
+	XTFW_ASSERT_EQUAL_UINT16(CAN_TRAFFIC_REASON_ACCEPTED, can_traffic_reason(LI_CAN_SLV_ERR_OK));
+	XTFW_ASSERT_EQUAL_UINT16(CAN_TRAFFIC_REASON_WRONG_DLC, can_traffic_reason(ERR_MSG_CAN_MAIN_RX_WRONG_DLC));
+	XTFW_ASSERT_EQUAL_UINT16(CAN_TRAFFIC_REASON_WRONG_DLC, can_traffic_reason(ERR_MSG_CAN_MON_TX_WRONG_DLC));
+	XTFW_ASSERT_EQUAL_UINT16(CAN_TRAFFIC_REASON_WRONG_MODULE_NR, can_traffic_reason(ERR_MSG_CAN_MON_RX_WRONG_MODULE_NR));
+	XTFW_ASSERT_EQUAL_UINT16(CAN_TRAFFIC_REASON_DROPPED, can_traffic_reason(ERR_MSG_CAN_MSG_SEND_BUSY));
+}
+
+/*--------------------------------------------------------------------------*/
+/* function definition (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief searches an identifier in the snapshot table
+ * @param nr_of_entries number of entries of the snapshot
+ * @param node #CAN_TRAFFIC_NODE_MAIN or #CAN_TRAFFIC_NODE_MON
+ * @param canid CAN identifier
+ * @return entry of the identifier or NULL if not counted
+ */
+static can_traffic_entry_t *traffic_test_find(uint16_t nr_of_entries, uint16_t node, uint16_t canid)
+{
+	uint16_t i;
+
+	for (i = 0; i < nr_of_entries; i++)
+	{
+		if ((traffic_test_entries[i].node == node) && (traffic_test_entries[i].canid == canid))
+		{
+			return (&traffic_test_entries[i]);
+		}
+	}
+	return (NULL);
+}
+
+/** @} */
@@ -0,0 +1,806 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/**
+ * @file li_can_slv_tunnel_test.c
+ * @addtogroup unittest
+ * @{
+ */
+
+/*--------------------------------------------------------------------------*/
+/* include files                                                            */
+/*--------------------------------------------------------------------------*/
+#include "unity_config.h"
+#include "unity.h"
+#include "xtfw.h"
+
+#include <li_can_slv/api/li_can_slv_api.h>
+
+// add some logical modules here as c include for test only
+#include "io_app_frc2.c"
+
+// used for the logging of the can output
+#include "io_can_hw.h"
+#include "io_can_main_hw.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <windows.h>
+
+#include <string.h>
+
+#include <li_can_slv/async/io_can_async.h>
+#include <li_can_slv/async/io_can_async_isotp.h>
+#include <li_can_slv/config/li_can_slv_config_defines.h>
+#include <li_can_slv/error/io_can_errno.h>
+
+#include "unittest_canpie-fd.h"
+
+/*--------------------------------------------------------------------------*/
+/* general definitions (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+#define TUNNEL_TEST_MODULE_NR	APP_FRC2_MODULE_NR_DEF /**< module of the tunnel */
+#define TUNNEL_TEST_PRIM_MODULE_NR	1 /**< module number of the primary node of the tunnel */
+#define TUNNEL_TEST_TX_OBJ		((uint8_t) CAN_CONFIG_MSG_MAIN_OBJ_TX_ASYNC) /**< message object of the asynchronous objects */
+#define TUNNEL_TEST_DATA_TX_QUEUE_LENGTH	4 /**< default length of the asynchronous data TX queue */
+#define TUNNEL_TEST_DATA_RX_ID	(CAN_CONFIG_ASYNC_DATA_RX_SLAVE_ID + ((TUNNEL_TEST_MODULE_NR - 1) * CAN_CONFIG_NR_OF_MODULE_OBJS)) /**< CAN identifier of the tunnel data of the module */
+#define TUNNEL_TEST_RX_RING_SIZE	64 /**< size of the tunnel receive ring of li_can_slv_tunnel_test */
+#define TUNNEL_TEST_ISOTP_BS	2 /**< ISO-TP block size of li_can_slv_tunnel_test */
+#define TUNNEL_TEST_ISOTP_STMIN	5 /**< ISO-TP separation time of li_can_slv_tunnel_test */
+#define TUNNEL_TEST_ISOTP_TIMEOUT_MS	1000 /**< default ISO-TP timeout */
+#define TUNNEL_TEST_COALESCE_TIMEOUT_MS	50 /**< default delay of a partly filled object while tunnel data is transmitted */
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions (private/not exported)                        */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (public/exported)                                       */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+extern void set_main_tx_pending(uint8_t buffer_id);
+extern uint32_t complete_main_tx(uint8_t buffer_id);
+extern uint32_t send_to_main_rx_handler(uint16_t can_id, uint8_t dlc, uint8_t *data);
+
+/*--------------------------------------------------------------------------*/
+/* global variables (private/not exported)                                  */
+/*--------------------------------------------------------------------------*/
+static lcsa_errorcode_t err = LCSA_ERROR_OK;
+static uint16_t tunnel_test_xon_rx_cnt = 0; /**< number of XON received from the tunnel partner */
+static uint16_t tunnel_test_xoff_rx_cnt = 0; /**< number of XOFF received from the tunnel partner */
+static uint16_t tunnel_test_writable_cnt = 0; /**< number of calls of the writable callback */
+static uint16_t tunnel_test_readable_cnt = 0; /**< number of calls of the readable callback */
+static uint16_t tunnel_test_isotp_rx_cnt = 0; /**< number of calls of the ISO-TP receive callback */
+static li_can_slv_errorcode_t tunnel_test_isotp_rx_err = LI_CAN_SLV_ERR_OK; /**< result of the last ISO-TP reception */
+static uint16_t tunnel_test_isotp_rx_len = 0; /**< length of the last received ISO-TP message */
+static uint16_t tunnel_test_isotp_tx_cnt = 0; /**< number of calls of the ISO-TP transmit callback */
+static li_can_slv_errorcode_t tunnel_test_isotp_tx_err = LI_CAN_SLV_ERR_OK; /**< result of the last ISO-TP transmission */
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+static void tunnel_test_ctrl_rx(byte_t cmd);
+static void tunnel_test_ctrl_rx_prim(byte_t cmd, byte_t prim_modnr);
+static void tunnel_test_writable(void);
+static void tunnel_test_readable(void);
+static void tunnel_test_data_rx(byte_t first, uint16_t nr_of_objs);
+static void tunnel_test_open_uds(void);
+static void tunnel_test_isotp_frame_rx(const byte_t *frame, uint8_t dlc);
+static void tunnel_test_isotp_rx(li_can_slv_errorcode_t err, byte_t *data, uint16_t len);
+static void tunnel_test_isotp_tx(li_can_slv_errorcode_t err);
+static void tunnel_test_tx_complete_all(void);
+static void tunnel_test_log_open(char *file_name);
+static void tunnel_test_log_check(char *file_name, const char *exp_file_name);
+
+static int doesFileExist(const char *filename);
+static void get_expected_file_path(const char *filename, char *filepath);
+
+/*--------------------------------------------------------------------------*/
+/* function definition (public/exported)                                    */
+/*--------------------------------------------------------------------------*/
+// setUp will be called before each test
+void setUp(void)
+{
+	static uint8_t init_once = 0;
+
+	if (init_once != 1)
+	{
+		init_once = 1;
+
+		err = lcsa_init(LCSA_BAUD_RATE_DEFAULT);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = app_frc2_init(APP_FRC2_MODULE_NR_DEF);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = lcsa_start();
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+	}
+}
+
+// tearDown will be called after each test
+void tearDown(void)
+{
+	// no object of a failed test may stay in the transmit path, the tunnel is closed for the next test
+	tunnel_test_tx_complete_all();
+	if (can_async_tunnel.state != LI_CAN_SLV_ASYNC_TUNNEL_FREE)
+	{
+		tunnel_test_ctrl_rx(LI_CAN_SLV_ASYNC_TUNNEL_CLOSE);
+		tunnel_test_tx_complete_all();
+	}
+	(void) can_async_tunnel_set_writable_cbk(NULL);
+	(void) can_async_tunnel_set_readable_cbk(NULL);
+	(void) can_async_isotp_set_rx_cbk(NULL);
+	(void) can_async_isotp_set_tx_cbk(NULL);
+	(void) can_async_isotp_set_rx_buffer(NULL, 0);
+	tunnel_test_xon_rx_cnt = 0;
+	tunnel_test_xoff_rx_cnt = 0;
+	tunnel_test_writable_cnt = 0;
+	tunnel_test_readable_cnt = 0;
+	tunnel_test_isotp_rx_cnt = 0;
+	tunnel_test_isotp_rx_len = 0;
+	tunnel_test_isotp_tx_cnt = 0;
+	unittest_system_ticks = 0;
+}
+
+/**
+ * @test test_tunnel_write
+ * @brief the written bytes are sent as full objects, the remaining bytes are sent at once if no tunnel data is pending
+ */
+void test_tunnel_write(void)
+{
+	byte_t data[21];
+	uint16_t accepted = 0xFFFF;
+	uint16_t i;
+
+	for (i = 0; i < sizeof(data); i++)
+	{
+		data[i] = (byte_t) i;
+	}
+
+	// the tunnel must be open
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ASYNC_TNL_WRONG_STATE, can_async_tunnel_write(data, sizeof(data), &accepted));
+	XTFW_ASSERT_EQUAL_UINT16(0, accepted);
+
+	tunnel_test_log_open("_tc_tunnel_write.log");
+	tunnel_test_ctrl_rx(LI_CAN_SLV_ASYNC_TUNNEL_OPEN);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ASYNC_TUNNEL_ACTIVE, can_async_tunnel.state);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_tunnel_write(data, sizeof(data), &accepted));
+	XTFW_ASSERT_EQUAL_UINT16(sizeof(data), accepted);
+	XTFW_ASSERT_EQUAL_UINT16(0, can_async_data_tx_queue_get_nr_of_objs());
+
+	tunnel_test_tx_complete_all();
+	tunnel_test_log_check("_tc_tunnel_write.log", "tc_tunnel_write_exp.log");
+}
+
+/**
+ * @test test_tunnel_writev_send_obj
+ * @brief several buffers are packed into full objects while the transmit path is busy, bytes which do not fit into
+ * the queue are not accepted
+ */
+void test_tunnel_writev_send_obj(void)
+{
+	byte_t obj[CAN_CONFIG_ASYNC_DATA_TX_DLC] = { 0x00, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7 };
+	byte_t data0[20];
+	byte_t data1[20];
+	can_async_tunnel_iovec_t iov[2];
+	uint16_t accepted = 0xFFFF;
+	uint16_t i;
+
+	for (i = 0; i < sizeof(data0); i++)
+	{
+		data0[i] = (byte_t)(0x20 + i);
+		data1[i] = (byte_t)(0x40 + i);
+	}
+	iov[0].data = data0;
+	iov[0].len = sizeof(data0);
+	iov[1].data = data1;
+	iov[1].len = sizeof(data1);
+
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ASYNC_TNL_WRONG_STATE, can_async_tunnel_send_obj(obj, sizeof(obj)));
+
+	tunnel_test_log_open("_tc_tunnel_writev_send_obj.log");
+	tunnel_test_ctrl_rx(LI_CAN_SLV_ASYNC_TUNNEL_OPEN);
+	tunnel_test_tx_complete_all();
+
+	// complete objects fill the hardware fifo of 8 objects
+	set_main_tx_pending(TUNNEL_TEST_TX_OBJ);
+	for (i = 0; i < 8; i++)
+	{
+		obj[0] = (byte_t) i;
+		XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_tunnel_send_obj(obj, sizeof(obj)));
+	}
+	XTFW_ASSERT_EQUAL_UINT16(0, can_async_data_tx_queue_get_nr_of_objs());
+
+	// the buffers are packed like one buffer, the last 8 bytes wait in the temporary object
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_tunnel_writev(iov, 2, &accepted));
+	XTFW_ASSERT_EQUAL_UINT16(sizeof(data0) + sizeof(data1), accepted);
+	XTFW_ASSERT_EQUAL_UINT16(TUNNEL_TEST_DATA_TX_QUEUE_LENGTH, can_async_data_tx_queue_get_nr_of_objs());
+
+	// the queue and the temporary object are full
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_tunnel_write(data0, 1, &accepted));
+	XTFW_ASSERT_EQUAL_UINT16(0, accepted);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_tunnel_writev(iov, 2, &accepted));
+	XTFW_ASSERT_EQUAL_UINT16(0, accepted);
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ASYNC_DATA_TX_QUEUE_OVERFLOW, can_async_tunnel_send_obj(obj, sizeof(obj)));
+
+	// after the transmission the temporary object is sent first
+	tunnel_test_tx_complete_all();
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_tunnel_write(data0, 1, &accepted));
+	XTFW_ASSERT_EQUAL_UINT16(1, accepted);
+
+	tunnel_test_tx_complete_all();
+	tunnel_test_log_check("_tc_tunnel_writev_send_obj.log", "tc_tunnel_writev_send_obj_exp.log");
+}
+
+/**
+ * @test test_tunnel_xon_xoff
+ * @brief a XOFF of the tunnel partner holds back the queued tunnel data until the XON, the writable flag follows the
+ * watermarks of the queue and the writable callback is called once the queue is emptied
+ */
+void test_tunnel_xon_xoff(void)
+{
+	byte_t data[3 * CAN_CONFIG_ASYNC_DATA_TX_DLC];
+	uint16_t accepted = 0xFFFF;
+	uint16_t i;
+
+	for (i = 0; i < sizeof(data); i++)
+	{
+		data[i] = (byte_t)(0x60 + i);
+	}
+
+	tunnel_test_log_open("_tc_tunnel_xon_xoff.log");
+	tunnel_test_ctrl_rx(LI_CAN_SLV_ASYNC_TUNNEL_OPEN);
+	tunnel_test_tx_complete_all();
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_tunnel_set_writable_cbk(tunnel_test_writable));
+	XTFW_ASSERT_EQUAL_UINT16(TRUE, can_async_tunnel_is_writable());
+
+	// the transmission is stopped, the objects stay in the queue up to the high watermark
+	tunnel_test_ctrl_rx(CAN_ASYNC_XOFF);
+	XTFW_ASSERT_EQUAL_UINT16(1, tunnel_test_xoff_rx_cnt);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_tunnel_write(data, sizeof(data), &accepted));
+	XTFW_ASSERT_EQUAL_UINT16(sizeof(data), accepted);
+	XTFW_ASSERT_EQUAL_UINT16(3, can_async_data_tx_queue_get_nr_of_objs());
+	XTFW_ASSERT_EQUAL_UINT16(FALSE, can_async_tunnel_is_writable());
+
+	// the XON of another primary node is ignored
+	tunnel_test_ctrl_rx_prim(CAN_ASYNC_XON, TUNNEL_TEST_PRIM_MODULE_NR + 1);
+	XTFW_ASSERT_EQUAL_UINT16(0, tunnel_test_xon_rx_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(3, can_async_data_tx_queue_get_nr_of_objs());
+
+	// the XON sends the queued objects, the tunnel is writable again below the low watermark
+	tunnel_test_ctrl_rx(CAN_ASYNC_XON);
+	XTFW_ASSERT_EQUAL_UINT16(1, tunnel_test_xon_rx_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(0, can_async_data_tx_queue_get_nr_of_objs());
+	XTFW_ASSERT_EQUAL_UINT16(TRUE, can_async_tunnel_is_writable());
+	XTFW_ASSERT_EQUAL_UINT16(1, tunnel_test_writable_cnt);
+
+	tunnel_test_tx_complete_all();
+	tunnel_test_log_check("_tc_tunnel_xon_xoff.log", "tc_tunnel_xon_xoff_exp.log");
+}
+
+/**
+ * @test test_tunnel_coalesce_timeout
+ * @brief while tunnel data is transmitted a partly filled object is filled up to a full object, but it is sent at
+ * the latest when the delay from its first byte elapsed
+ */
+void test_tunnel_coalesce_timeout(void)
+{
+	byte_t obj[CAN_CONFIG_ASYNC_DATA_TX_DLC] = { 0x00, 0xB1, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7 };
+	byte_t data[10];
+	uint16_t accepted = 0xFFFF;
+	uint16_t i;
+
+	for (i = 0; i < sizeof(data); i++)
+	{
+		data[i] = (byte_t)(0xC0 + i);
+	}
+
+	tunnel_test_log_open("_tc_tunnel_coalesce_timeout.log");
+	tunnel_test_ctrl_rx(LI_CAN_SLV_ASYNC_TUNNEL_OPEN);
+	tunnel_test_tx_complete_all();
+
+	// the hardware fifo takes 8 objects, one object is pending in the queue
+	set_main_tx_pending(TUNNEL_TEST_TX_OBJ);
+	for (i = 0; i < (8 + 1); i++)
+	{
+		obj[0] = (byte_t) i;
+		XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_tunnel_send_obj(obj, sizeof(obj)));
+	}
+	XTFW_ASSERT_EQUAL_UINT16(1, can_async_data_tx_queue_get_nr_of_objs());
+
+	// the partly filled object waits within the delay and is filled up to a full object
+	unittest_system_ticks = 1000;
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_tunnel_write(&data[0], 3, &accepted));
+	XTFW_ASSERT_EQUAL_UINT16(3, accepted);
+	unittest_system_ticks += TUNNEL_TEST_COALESCE_TIMEOUT_MS - 1;
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_tunnel_process_tx_data());
+	XTFW_ASSERT_EQUAL_UINT16(1, can_async_data_tx_queue_get_nr_of_objs());
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_tunnel_write(&data[3], 7, &accepted));
+	XTFW_ASSERT_EQUAL_UINT16(7, accepted);
+	XTFW_ASSERT_EQUAL_UINT16(2, can_async_data_tx_queue_get_nr_of_objs());
+
+	// the delay of the remaining bytes starts with their first byte
+	unittest_system_ticks += TUNNEL_TEST_COALESCE_TIMEOUT_MS - 1;
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_tunnel_process_tx_data());
+	XTFW_ASSERT_EQUAL_UINT16(2, can_async_data_tx_queue_get_nr_of_objs());
+	unittest_system_ticks += 1;
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_tunnel_process_tx_data());
+	XTFW_ASSERT_EQUAL_UINT16(3, can_async_data_tx_queue_get_nr_of_objs());
+
+	tunnel_test_tx_complete_all();
+	tunnel_test_log_check("_tc_tunnel_coalesce_timeout.log", "tc_tunnel_coalesce_timeout_exp.log");
+}
+
+/**
+ * @test test_tunnel_rx_ring
+ * @brief received tunnel data is read without copying from the receive ring, also across its wrap around, XOFF and XON
+ * are sent to the tunnel partner at the watermarks of the ring
+ */
+void test_tunnel_rx_ring(void)
+{
+	byte_t obj[CAN_CONFIG_ASYNC_DATA_RX_DLC] = { 0 };
+	const byte_t *data = NULL;
+	uint16_t i;
+
+	tunnel_test_log_open("_tc_tunnel_rx_ring.log");
+	tunnel_test_ctrl_rx(LI_CAN_SLV_ASYNC_TUNNEL_OPEN);
+	tunnel_test_tx_complete_all();
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_tunnel_set_readable_cbk(tunnel_test_readable));
+
+	// the readable callback is called for the first object, XOFF is sent at 3/4 of the ring
+	XTFW_ASSERT_EQUAL_UINT16(0, can_async_tunnel_rx_peek(&data));
+	tunnel_test_data_rx(0, 6);
+	XTFW_ASSERT_EQUAL_UINT16(1, tunnel_test_readable_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(6 * CAN_CONFIG_ASYNC_DATA_RX_DLC, can_async_tunnel_rx_get_nr_of_bytes());
+
+	// XON is sent when the ring is read down to 1/4
+	XTFW_ASSERT_EQUAL_UINT16(6 * CAN_CONFIG_ASYNC_DATA_RX_DLC, can_async_tunnel_rx_peek(&data));
+	for (i = 0; i < (6 * CAN_CONFIG_ASYNC_DATA_RX_DLC); i++)
+	{
+		XTFW_ASSERT_EQUAL_UINT8((byte_t) i, data[i]);
+	}
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_tunnel_rx_consume(5 * CAN_CONFIG_ASYNC_DATA_RX_DLC));
+	XTFW_ASSERT_EQUAL_UINT16(CAN_CONFIG_ASYNC_DATA_RX_DLC, can_async_tunnel_rx_get_nr_of_bytes());
+
+	// the data wraps around the end of the ring, it is returned in two contiguous parts
+	tunnel_test_data_rx(6 * CAN_CONFIG_ASYNC_DATA_RX_DLC, 4);
+	XTFW_ASSERT_EQUAL_UINT16(1, tunnel_test_readable_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(TUNNEL_TEST_RX_RING_SIZE - (5 * CAN_CONFIG_ASYNC_DATA_RX_DLC), can_async_tunnel_rx_peek(&data));
+	XTFW_ASSERT_EQUAL_UINT8(5 * CAN_CONFIG_ASYNC_DATA_RX_DLC, data[0]);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_tunnel_rx_consume(TUNNEL_TEST_RX_RING_SIZE - (5 * CAN_CONFIG_ASYNC_DATA_RX_DLC)));
+	XTFW_ASSERT_EQUAL_UINT16(2 * CAN_CONFIG_ASYNC_DATA_RX_DLC, can_async_tunnel_rx_peek(&data));
+	XTFW_ASSERT_EQUAL_UINT8(TUNNEL_TEST_RX_RING_SIZE, data[0]);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_tunnel_rx_consume(2 * CAN_CONFIG_ASYNC_DATA_RX_DLC));
+	XTFW_ASSERT_EQUAL_UINT16(0, can_async_tunnel_rx_get_nr_of_bytes());
+
+	// more bytes than received can not be released, an object which does not fit into the ring is dropped
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ASYNC_TNL_WRONG_STATE, can_async_tunnel_rx_consume(1));
+	tunnel_test_data_rx(0, TUNNEL_TEST_RX_RING_SIZE / CAN_CONFIG_ASYNC_DATA_RX_DLC);
+	XTFW_ASSERT_EQUAL_UINT16(2, tunnel_test_readable_cnt);
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ASYNC_TNL_RX_OVERFLOW, can_async_tunnel_data_rx(obj, sizeof(obj)));
+	XTFW_ASSERT_EQUAL_UINT16(TUNNEL_TEST_RX_RING_SIZE, can_async_tunnel_rx_get_nr_of_bytes());
+
+	// closing the tunnel empties the ring
+	tunnel_test_tx_complete_all();
+	tunnel_test_ctrl_rx(LI_CAN_SLV_ASYNC_TUNNEL_CLOSE);
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ASYNC_TNL_WRONG_STATE, can_async_tunnel_data_rx(obj, sizeof(obj)));
+
+	tunnel_test_tx_complete_all();
+	tunnel_test_log_check("_tc_tunnel_rx_ring.log", "tc_tunnel_rx_ring_exp.log");
+}
+
+/**
+ * @test test_isotp_single_frame
+ * @brief short messages are received and sent as single frames on the tunnel of the UDS connection type
+ */
+void test_isotp_single_frame(void)
+{
+	byte_t sf[] = { 0x03, 0x22, 0xF1, 0x90 };
+	byte_t msg[5] = { 0x62, 0xF1, 0x90, 0x41, 0x42 };
+	byte_t buf[16];
+
+	tunnel_test_log_open("_tc_isotp_single_frame.log");
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ASYNC_TNL_WRONG_STATE, can_async_isotp_send(msg, sizeof(msg)));
+
+	tunnel_test_open_uds();
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_set_rx_cbk(tunnel_test_isotp_rx));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_set_tx_cbk(tunnel_test_isotp_tx));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_set_rx_buffer(buf, sizeof(buf)));
+
+	// the single frame is copied to the receive buffer
+	tunnel_test_isotp_frame_rx(sf, sizeof(sf));
+	XTFW_ASSERT_EQUAL_UINT16(1, tunnel_test_isotp_rx_cnt);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, tunnel_test_isotp_rx_err);
+	XTFW_ASSERT_EQUAL_UINT16(3, tunnel_test_isotp_rx_len);
+	XTFW_ASSERT_EQUAL_MEMORY(&sf[1], buf, 3);
+
+	// the single frame is sent at once, a message which does not fit into one frame must not be empty
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ASYNC_ISOTP_INVALID_LENGTH, can_async_isotp_send(msg, 0));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_send(msg, sizeof(msg)));
+	XTFW_ASSERT_EQUAL_UINT16(1, tunnel_test_isotp_tx_cnt);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, tunnel_test_isotp_tx_err);
+
+	tunnel_test_tx_complete_all();
+	tunnel_test_log_check("_tc_isotp_single_frame.log", "tc_isotp_single_frame_exp.log");
+}
+
+/**
+ * @test test_isotp_flow_control
+ * @brief a long message is received with a flow control after every block and sent within the block size and the
+ * separation time of the flow control of the receiver
+ */
+void test_isotp_flow_control(void)
+{
+	byte_t ff[] = { 0x10, 27, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05 };
+	byte_t cf[CAN_CONFIG_ASYNC_DATA_RX_DLC];
+	byte_t fc_cts_bs[] = { 0x30, 0x02, 0x05 };
+	byte_t fc_cts[] = { 0x30, 0x00, 0x00 };
+	byte_t msg[30];
+	byte_t buf[32];
+	uint16_t i;
+	uint16_t j;
+
+	for (i = 0; i < sizeof(msg); i++)
+	{
+		msg[i] = (byte_t)(0x80 + i);
+	}
+
+	tunnel_test_log_open("_tc_isotp_flow_control.log");
+	tunnel_test_open_uds();
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_set_rx_cbk(tunnel_test_isotp_rx));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_set_tx_cbk(tunnel_test_isotp_tx));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_set_rx_buffer(buf, sizeof(buf)));
+
+	// the first frame is answered with a flow control with the own block size and separation time
+	tunnel_test_isotp_frame_rx(ff, sizeof(ff));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_process());
+
+	// after a block of consecutive frames the next flow control is sent
+	for (i = 0; i < 3; i++)
+	{
+		cf[0] = (byte_t)(0x21 + i);
+		for (j = 1; j < sizeof(cf); j++)
+		{
+			cf[j] = (byte_t)(6 + (i * 7) + (j - 1));
+		}
+		tunnel_test_isotp_frame_rx(cf, sizeof(cf));
+		XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_process());
+	}
+	XTFW_ASSERT_EQUAL_UINT16(1, tunnel_test_isotp_rx_cnt);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, tunnel_test_isotp_rx_err);
+	XTFW_ASSERT_EQUAL_UINT16(27, tunnel_test_isotp_rx_len);
+	for (i = 0; i < 27; i++)
+	{
+		XTFW_ASSERT_EQUAL_UINT8((byte_t) i, buf[i]);
+	}
+
+	// the first frame waits for the flow control of the receiver
+	unittest_system_ticks = 1000;
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_send(msg, sizeof(msg)));
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ASYNC_ISOTP_BUSY, can_async_isotp_send(msg, sizeof(msg)));
+
+	// the first consecutive frame is sent at once, the second after the separation time
+	tunnel_test_isotp_frame_rx(fc_cts_bs, sizeof(fc_cts_bs));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_process());
+	unittest_system_ticks += TUNNEL_TEST_ISOTP_STMIN;
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_process());
+	unittest_system_ticks += 1;
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_process());
+
+	// the block is complete, the remaining frames are sent after the next flow control
+	unittest_system_ticks += 10;
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_process());
+	XTFW_ASSERT_EQUAL_UINT16(0, tunnel_test_isotp_tx_cnt);
+	tunnel_test_isotp_frame_rx(fc_cts, sizeof(fc_cts));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_process());
+	XTFW_ASSERT_EQUAL_UINT16(1, tunnel_test_isotp_tx_cnt);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, tunnel_test_isotp_tx_err);
+
+	tunnel_test_tx_complete_all();
+	tunnel_test_log_check("_tc_isotp_flow_control.log", "tc_isotp_flow_control_exp.log");
+}
+
+/**
+ * @test test_isotp_timeout_abort
+ * @brief missing consecutive frames and flow controls end the reception and the transmission with a timeout, an
+ * overflow flow control and the close of the tunnel abort the transmission
+ */
+void test_isotp_timeout_abort(void)
+{
+	byte_t ff[] = { 0x10, 20, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05 };
+	byte_t fc_ovflw[] = { 0x32, 0x00, 0x00 };
+	byte_t msg[20] = { 0 };
+	byte_t buf[32];
+
+	tunnel_test_log_open("_tc_isotp_timeout_abort.log");
+	tunnel_test_open_uds();
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_set_rx_cbk(tunnel_test_isotp_rx));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_set_tx_cbk(tunnel_test_isotp_tx));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_set_rx_buffer(buf, sizeof(buf)));
+
+	// the reception ends if no consecutive frame follows within the timeout
+	unittest_system_ticks = 1000;
+	tunnel_test_isotp_frame_rx(ff, sizeof(ff));
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ASYNC_ISOTP_BUSY, can_async_isotp_set_rx_buffer(NULL, 0));
+	unittest_system_ticks += TUNNEL_TEST_ISOTP_TIMEOUT_MS - 1;
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_process());
+	XTFW_ASSERT_EQUAL_UINT16(0, tunnel_test_isotp_rx_cnt);
+	unittest_system_ticks += 1;
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_process());
+	XTFW_ASSERT_EQUAL_UINT16(1, tunnel_test_isotp_rx_cnt);
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ASYNC_ISOTP_TIMEOUT, tunnel_test_isotp_rx_err);
+
+	// the transmission ends if no flow control follows within the timeout
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_send(msg, sizeof(msg)));
+	unittest_system_ticks += TUNNEL_TEST_ISOTP_TIMEOUT_MS;
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_process());
+	XTFW_ASSERT_EQUAL_UINT16(1, tunnel_test_isotp_tx_cnt);
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ASYNC_ISOTP_TIMEOUT, tunnel_test_isotp_tx_err);
+
+	// the receiver rejects the message with an overflow flow control
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_send(msg, sizeof(msg)));
+	tunnel_test_isotp_frame_rx(fc_ovflw, sizeof(fc_ovflw));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_process());
+	XTFW_ASSERT_EQUAL_UINT16(2, tunnel_test_isotp_tx_cnt);
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ASYNC_ISOTP_OVERFLOW, tunnel_test_isotp_tx_err);
+
+	// the close of the tunnel aborts the transmission
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_send(msg, sizeof(msg)));
+	tunnel_test_tx_complete_all();
+	tunnel_test_ctrl_rx(LI_CAN_SLV_ASYNC_TUNNEL_CLOSE);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_isotp_process());
+	XTFW_ASSERT_EQUAL_UINT16(3, tunnel_test_isotp_tx_cnt);
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_ASYNC_TNL_WRONG_STATE, tunnel_test_isotp_tx_err);
+
+	tunnel_test_tx_complete_all();
+	tunnel_test_log_check("_tc_isotp_timeout_abort.log", "tc_isotp_timeout_abort_exp.log");
+}
+
+/**
+ * @brief opens the serial channel of the tunnel
+ * @param pputc adds a character to the tunnel
+ * @param pxon sends XON to the tunnel partner
+ * @param pxoff sends XOFF to the tunnel partner
+ * @return #LI_CAN_SLV_ERR_OK
+ */
+li_can_slv_errorcode_t com_chan_init(li_can_slv_errorcode_t (*pputc)(char_t dat), li_can_slv_errorcode_t (*pxon)(void), li_can_slv_errorcode_t (*pxoff)(void))
+{
+	(void) pputc;
+	(void) pxon;
+	(void) pxoff;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+/**
+ * @brief closes the serial channel of the tunnel
+ * @return #LI_CAN_SLV_ERR_OK
+ */
+li_can_slv_errorcode_t com_chan_close(void)
+{
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+/**
+ * @brief empties the receive buffer of the serial channel
+ * @return #LI_CAN_SLV_ERR_OK
+ */
+li_can_slv_errorcode_t com_clear_rx_buffer(void)
+{
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+/**
+ * @brief XON of the tunnel partner received
+ */
+void com_xon_rx(void)
+{
+	tunnel_test_xon_rx_cnt++;
+}
+
+/**
+ * @brief XOFF of the tunnel partner received
+ */
+void com_xoff_rx(void)
+{
+	tunnel_test_xoff_rx_cnt++;
+}
+
+/**
+ * @brief tunnel data received
+ * @param data received data bytes
+ * @param len number of received data bytes
+ */
+void com_data_rx(byte_t *data, uint16_t len)
+{
+	(void) data;
+	(void) len;
+}
+
+/*--------------------------------------------------------------------------*/
+/* function definition (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief receives a tunnel command of the primary node
+ * @param cmd tunnel command
+ */
+static void tunnel_test_ctrl_rx(byte_t cmd)
+{
+	tunnel_test_ctrl_rx_prim(cmd, TUNNEL_TEST_PRIM_MODULE_NR);
+}
+
+/**
+ * @brief receives a tunnel command of a primary node
+ * @param cmd tunnel command
+ * @param prim_modnr module number of the primary node
+ */
+static void tunnel_test_ctrl_rx_prim(byte_t cmd, byte_t prim_modnr)
+{
+	byte_t data[CAN_CONFIG_ASYNC_CTRL_RX_DLC] = { 0x00, 0x00, 0x00, 0x00, CAN_ASYNC_CONNECTION_TYPE_DEFAULT, 0x00, 0x00, 0x00 };
+
+	data[0] = cmd;
+	data[1] = prim_modnr;
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_send_data_to_async_ctrl_rx_queue(TUNNEL_TEST_MODULE_NR, CAN_CONFIG_ASYNC_CTRL_RX_DLC, data));
+}
+
+/**
+ * @brief receives tunnel data objects, the data bytes are numbered continuously
+ * @param first number of the first data byte
+ * @param nr_of_objs number of received objects
+ */
+static void tunnel_test_data_rx(byte_t first, uint16_t nr_of_objs)
+{
+	byte_t data[CAN_CONFIG_ASYNC_DATA_RX_DLC];
+	uint16_t i;
+	uint16_t j;
+
+	for (i = 0; i < nr_of_objs; i++)
+	{
+		for (j = 0; j < sizeof(data); j++)
+		{
+			data[j] = first++;
+		}
+		XTFW_ASSERT_EQUAL_UINT(0, send_to_main_rx_handler(TUNNEL_TEST_DATA_RX_ID, sizeof(data), data));
+	}
+}
+
+/**
+ * @brief opens the tunnel with the UDS connection type
+ */
+static void tunnel_test_open_uds(void)
+{
+	byte_t data[CAN_CONFIG_ASYNC_CTRL_RX_DLC] = { LI_CAN_SLV_ASYNC_TUNNEL_OPEN, TUNNEL_TEST_PRIM_MODULE_NR, 0x00, 0x00, CAN_ASYNC_CONNECTION_TYPE_UDS_PROTOCOL, 0x00, 0x00, 0x00 };
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_send_data_to_async_ctrl_rx_queue(TUNNEL_TEST_MODULE_NR, CAN_CONFIG_ASYNC_CTRL_RX_DLC, data));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ASYNC_TUNNEL_ACTIVE, can_async_tunnel.state);
+	tunnel_test_tx_complete_all();
+}
+
+/**
+ * @brief receives an ISO-TP frame as tunnel data object
+ * @param frame received frame
+ * @param dlc data length code of the frame
+ */
+static void tunnel_test_isotp_frame_rx(const byte_t *frame, uint8_t dlc)
+{
+	byte_t data[CAN_CONFIG_ASYNC_DATA_RX_DLC];
+
+	memcpy(data, frame, dlc);
+	XTFW_ASSERT_EQUAL_UINT(0, send_to_main_rx_handler(TUNNEL_TEST_DATA_RX_ID, dlc, data));
+}
+
+/**
+ * @brief ISO-TP receive callback
+ * @param err result of the reception
+ * @param data receive buffer
+ * @param len length of the received message
+ */
+static void tunnel_test_isotp_rx(li_can_slv_errorcode_t err, byte_t *data, uint16_t len)
+{
+	(void) data;
+	tunnel_test_isotp_rx_cnt++;
+	tunnel_test_isotp_rx_err = err;
+	tunnel_test_isotp_rx_len = len;
+}
+
+/**
+ * @brief ISO-TP transmit callback
+ * @param err result of the transmission
+ */
+static void tunnel_test_isotp_tx(li_can_slv_errorcode_t err)
+{
+	tunnel_test_isotp_tx_cnt++;
+	tunnel_test_isotp_tx_err = err;
+}
+
+/**
+ * @brief readable callback of the tunnel
+ */
+static void tunnel_test_readable(void)
+{
+	tunnel_test_readable_cnt++;
+}
+
+/**
+ * @brief writable callback of the tunnel
+ */
+static void tunnel_test_writable(void)
+{
+	tunnel_test_writable_cnt++;
+}
+
+/**
+ * @brief completes the transmission of the asynchronous message object until it is idle
+ */
+static void tunnel_test_tx_complete_all(void)
+{
+	while (complete_main_tx(TUNNEL_TEST_TX_OBJ) == 0)
+	{
+	}
+}
+
+static void tunnel_test_log_open(char *file_name)
+{
+	can_main_hw_set_log_file_name(file_name);
+	if (can_main_hw_log_open() == EXIT_FAILURE)
+	{
+		TEST_FAIL_MESSAGE("log open fails");
+	}
+}
+
+static void tunnel_test_log_check(char *file_name, const char *exp_file_name)
+{
+	char file_path[_MAX_PATH];
+
+	can_main_hw_log_close();
+	XTFW_ASSERT_EQUAL_INT(1, doesFileExist(file_name));
+
+	/* compare file content */
+	get_expected_file_path(exp_file_name, file_path);
+	TEST_ASSERT_BINARY_FILE(file_path, file_name);
+}
+
+static int doesFileExist(const char *filename)
+{
+	struct stat st;
+	int result = stat(filename, &st);
+	return result == 0;
+}
+
+static void get_expected_file_path(const char *filename, char *filepath)
+{
+	char drive[_MAX_DRIVE];
+	char dir[_MAX_DIR];
+	char fname[_MAX_FNAME];
+
+	_splitpath(Unity.TestFile, drive, dir, NULL, NULL);
+	strcpy(fname, drive);
+	strcat(fname, dir);
+	strcat(fname, "..\\expected\\file\\");
+	strcat(fname, filename);
+	strcpy(filepath, fname);
+}
+
+/** @} */
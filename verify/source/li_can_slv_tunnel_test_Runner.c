@@ -0,0 +1,76 @@
+/* AUTOGENERATED FILE. DO NOT EDIT. */
+
+/*=======Test Runner Used To Run Each Test Below=====*/
+#define RUN_TEST(TestFunc, TestLineNum) \
+{ \
+  Unity.CurrentTestName = #TestFunc; \
+  Unity.CurrentTestLineNumber = TestLineNum; \
+  Unity.NumberOfTests++; \
+  if (TEST_PROTECT()) \
+  { \
+      setUp(); \
+      TestFunc(); \
+  } \
+  if (TEST_PROTECT()) \
+  { \
+    tearDown(); \
+  } \
+  UnityConcludeTest(); \
+}
+
+/*=======Automagically Detected Files To Include=====*/
+#include "unity.h"
+#include <setjmp.h>
+#include <stdio.h>
+#include "xtfw.h"
+#include "io_can_hw.h"
+#include "io_can_main_hw.h"
+#include "unittest_canpie-fd.h"
+#include <li_can_slv/api/li_can_slv_api.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <windows.h>
+#include <string.h>
+#include <li_can_slv/async/io_can_async.h>
+#include <li_can_slv/async/io_can_async_isotp.h>
+#include <li_can_slv/config/li_can_slv_config_defines.h>
+#include <li_can_slv/error/io_can_errno.h>
+
+/*=======External Functions This Runner Calls=====*/
+extern void setUp(void);
+extern void tearDown(void);
+extern void test_tunnel_write(void);
+extern void test_tunnel_writev_send_obj(void);
+extern void test_tunnel_xon_xoff(void);
+extern void test_tunnel_coalesce_timeout(void);
+extern void test_tunnel_rx_ring(void);
+extern void test_isotp_single_frame(void);
+extern void test_isotp_flow_control(void);
+extern void test_isotp_timeout_abort(void);
+
+
+/*=======Test Reset Option=====*/
+void resetTest(void);
+void resetTest(void)
+{
+  tearDown();
+  setUp();
+}
+
+
+/*=======MAIN=====*/
+int main(void)
+{
+  UnityBegin("/root/repo/verify/source/li_can_slv_tunnel_test.c");
+  RUN_TEST(test_tunnel_write, 168);
+  RUN_TEST(test_tunnel_writev_send_obj, 199);
+  RUN_TEST(test_tunnel_xon_xoff, 259);
+  RUN_TEST(test_tunnel_coalesce_timeout, 305);
+  RUN_TEST(test_tunnel_rx_ring, 358);
+  RUN_TEST(test_isotp_single_frame, 416);
+  RUN_TEST(test_isotp_flow_control, 451);
+  RUN_TEST(test_isotp_timeout_abort, 527);
+
+  return (UnityEnd());
+}
@@ -0,0 +1,349 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/**
+ * @file li_can_slv_xload_fd_test.c
+ * @addtogroup unittest
+ * @{
+ */
+
+/*--------------------------------------------------------------------------*/
+/* include files                                                            */
+/*--------------------------------------------------------------------------*/
+#include "unity_config.h"
+#include "unity.h"
+#include "xtfw.h"
+
+#include <li_can_slv/api/li_can_slv_api.h>
+
+// add some logical modules here as c include for test only
+#include "io_app_frc2.c"
+#include "io_app_incx.c"
+#include "io_app_inxy.c"
+#include "io_app_ma_w.c"
+
+// used for the logging of the can output
+#include "io_can_hw.h"
+#include "io_can_main_hw.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <windows.h>
+
+#include <string.h>
+
+#include <li_can_slv/xload/li_can_slv_xload.h>
+#include <li_can_slv/xload/li_can_slv_xload_buffer.h>
+#include <li_can_slv/xload/li_can_slv_xload_crc16.h>
+#include <li_can_slv/async/io_can_async.h>
+#include <li_can_slv/error/io_can_errno.h>
+
+#include "unittest_canpie-fd.h"
+
+/*--------------------------------------------------------------------------*/
+/* general definitions (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+#define XLOAD_FD_TEST_MODULE_NR	APP_FRC2_MODULE_NR_DEF /**< module of the up/downloads */
+#define XLOAD_FD_TEST_FD_OBJ_BYTES	(CAN_DLC_FD_MAX - 1) /**< data bytes of a CAN FD data object */
+#define XLOAD_FD_TEST_BLOCK_SIZE	((2 * XLOAD_FD_TEST_FD_OBJ_BYTES) + (CAN_DLC_MAX - 1)) /**< bytes of a block with 2 CAN FD and 1 classic data object */
+#define XLOAD_FD_TEST_ULOAD_SIZE	(70) /**< bytes of the uploaded component */
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions (private/not exported)                        */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (public/exported)                                       */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (private/not exported)                                  */
+/*--------------------------------------------------------------------------*/
+static lcsa_errorcode_t err = LCSA_ERROR_OK;
+static uint16_t block_end_cnt = 0;
+static uint16_t image_len = 0;
+static byte_t image[XLOAD_FD_TEST_BLOCK_SIZE];
+static uint16_t uload_read_pos = 0;
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+static li_can_slv_errorcode_t dload_start_request_hdl(li_can_slv_xload_component_t *dload_component);
+static li_can_slv_errorcode_t dload_data_block_end_hdl(li_can_slv_xload_component_t *dload_component);
+static li_can_slv_errorcode_t dload_end_hdl(li_can_slv_xload_component_t *dload_component, li_can_slv_xload_end_handle_status_t *status);
+static li_can_slv_errorcode_t uload_start_request_hdl(li_can_slv_xload_component_t *dload_component);
+static li_can_slv_errorcode_t uload_read(byte_t *data, uint16_t len);
+
+static void dload_test_start(uint16_t crc);
+static void dload_test_rx(uint16_t dlc, const byte_t *obj);
+static void uload_test(byte_t flags);
+static void dload_test_log_open(char *file_name);
+static void dload_test_log_check(char *file_name, const char *exp_file_name);
+
+static int doesFileExist(const char *filename);
+static void get_expected_file_path(const char *filename, char *filepath);
+
+/*--------------------------------------------------------------------------*/
+/* function definition (public/exported)                                    */
+/*--------------------------------------------------------------------------*/
+// setUp will be called before each test
+void setUp(void)
+{
+	static uint8_t init_once = 0;
+
+	if (init_once != 1)
+	{
+		init_once = 1;
+
+		err = lcsa_init(LCSA_BAUD_RATE_DEFAULT);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = app_frc2_init(APP_FRC2_MODULE_NR_DEF);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = lcsa_start();
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = lcsa_dload_set_start_request_handle(&dload_start_request_hdl);
+		err = lcsa_dload_set_data_block_end_handle(&dload_data_block_end_hdl);
+		err = lcsa_dload_set_end_handle(&dload_end_hdl);
+		err = lcsa_uload_set_start_request_handle(&uload_start_request_hdl);
+	}
+
+	block_end_cnt = 0;
+	image_len = 0;
+	uload_read_pos = 0;
+	memset(image, 0x00, sizeof(image));
+}
+
+// tearDown will be called after each test
+void tearDown(void)
+{
+
+}
+
+/**
+ * @test test_dload_fd_data
+ * @brief CAN FD and classic data objects of one block are received through the asynchronous ctrl RX path
+ */
+void test_dload_fd_data(void)
+{
+	byte_t exp[XLOAD_FD_TEST_BLOCK_SIZE];
+	byte_t obj[CAN_DLC_FD_MAX];
+	byte_t block_end[8] = { CAN_ASYNC_DL_DATA_BLOCK_END, 0, 0, 0, 3, 0, 0, 0 };
+	uint16_t i;
+
+	for (i = 0; i < XLOAD_FD_TEST_BLOCK_SIZE; i++)
+	{
+		exp[i] = (byte_t) i;
+	}
+	block_end[1] = (byte_t)(XLOAD_FD_TEST_BLOCK_SIZE >> 8);
+	block_end[2] = (byte_t)(XLOAD_FD_TEST_BLOCK_SIZE & 0x00FFu);
+
+	dload_test_log_open("_tc_dload_fd_data.log");
+
+	// the start acknowledge announces the CAN FD data objects
+	dload_test_start(li_can_slv_xload_crc16_update(li_can_slv_xload_crc16_init(), exp, sizeof(exp)));
+
+	obj[0] = CAN_ASYNC_DL_DATA;
+	memcpy(&obj[1], &exp[0], XLOAD_FD_TEST_FD_OBJ_BYTES);
+	dload_test_rx(CAN_DLC_FD_MAX, obj);
+	memcpy(&obj[1], &exp[XLOAD_FD_TEST_FD_OBJ_BYTES], XLOAD_FD_TEST_FD_OBJ_BYTES);
+	dload_test_rx(CAN_DLC_FD_MAX, obj);
+
+	// the master may fall back to a classic data object at the end of the block
+	memcpy(&obj[1], &exp[2 * XLOAD_FD_TEST_FD_OBJ_BYTES], CAN_DLC_MAX - 1);
+	dload_test_rx(CAN_DLC_MAX, obj);
+
+	dload_test_rx(CAN_DLC_MAX, block_end);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_end(XLOAD_FD_TEST_MODULE_NR));
+
+	XTFW_ASSERT_EQUAL_UINT16(1, block_end_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(sizeof(exp), image_len);
+	XTFW_ASSERT_EQUAL_MEMORY(exp, image, sizeof(exp));
+
+	dload_test_log_check("_tc_dload_fd_data.log", "tc_dload_fd_data_exp.log");
+}
+
+/**
+ * @test test_uload_fd_data
+ * @brief the data objects of an upload are sent as CAN FD frames when the master requests them
+ */
+void test_uload_fd_data(void)
+{
+	dload_test_log_open("_tc_uload_fd_data.log");
+	uload_test(XLOAD_FLAG_FD);
+	dload_test_log_check("_tc_uload_fd_data.log", "tc_uload_fd_data_exp.log");
+}
+
+/**
+ * @test test_uload_fd_not_requested
+ * @brief without the request of the master the data objects of an upload are sent as classic frames
+ */
+void test_uload_fd_not_requested(void)
+{
+	dload_test_log_open("_tc_uload_fd_not_requested.log");
+	uload_test(0);
+	dload_test_log_check("_tc_uload_fd_not_requested.log", "tc_uload_fd_not_requested_exp.log");
+}
+
+/*--------------------------------------------------------------------------*/
+/* function definition (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+static li_can_slv_errorcode_t dload_start_request_hdl(li_can_slv_xload_component_t *dload_component)
+{
+	return (li_can_slv_dload_start_ackn(dload_component->module_nr, LI_CAN_SLV_XLOAD_MAX_BYTES_PER_BLOCK_DLOAD, 0));
+}
+
+static li_can_slv_errorcode_t dload_data_block_end_hdl(li_can_slv_xload_component_t *dload_component)
+{
+	li_can_slv_errorcode_t rc;
+	uint16_t len;
+
+	dload_component = dload_component;
+
+	rc = xload_buffer_get_len(&len);
+	if ((rc == LI_CAN_SLV_ERR_OK) && ((image_len + len) <= XLOAD_FD_TEST_BLOCK_SIZE))
+	{
+		rc = xload_buffer_get_bytes(&image[image_len], len);
+		image_len += len;
+	}
+	block_end_cnt++;
+	return (rc);
+}
+
+static li_can_slv_errorcode_t dload_end_hdl(li_can_slv_xload_component_t *dload_component, li_can_slv_xload_end_handle_status_t *status)
+{
+	dload_component = dload_component;
+	*status = LI_CAN_SLV_XLOAD_STACK_END_HANDLING;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+static li_can_slv_errorcode_t uload_start_request_hdl(li_can_slv_xload_component_t *dload_component)
+{
+	dload_component = dload_component;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+/**
+ * @brief source of the uploaded component, the bytes are counted up
+ */
+static li_can_slv_errorcode_t uload_read(byte_t *data, uint16_t len)
+{
+	uint16_t i;
+
+	for (i = 0; i < len; i++)
+	{
+		data[i] = (byte_t) uload_read_pos++;
+	}
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+/**
+ * @brief sends the download start request of the component TESTCOMP
+ * @param crc CRC16 of the component
+ */
+static void dload_test_start(uint16_t crc)
+{
+	byte_t req1[8] = { CAN_ASYNC_DL_START_REQUEST1, 'T', 'E', 'S', 'T', 'C', 'O', 'M' };
+	byte_t req2[8] = { CAN_ASYNC_DL_START_REQUEST2, 'P', 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 };
+
+	req2[2] = (byte_t)(crc >> 8);
+	req2[3] = (byte_t)(crc & 0x00FFu);
+
+	dload_test_rx(CAN_DLC_MAX, req1);
+	dload_test_rx(CAN_DLC_MAX, req2);
+}
+
+/**
+ * @brief passes a received object with its payload length to the asynchronous ctrl RX path like the receive interrupt
+ * @param dlc payload length of the received frame
+ * @param[in] obj received object
+ */
+static void dload_test_rx(uint16_t dlc, const byte_t *obj)
+{
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, can_async_send_data_to_async_ctrl_rx_queue(XLOAD_FD_TEST_MODULE_NR, dlc, obj));
+}
+
+/**
+ * @brief uploads one block of the component TESTCOMP
+ * @param flags byte 5 of the upload start request 2
+ */
+static void uload_test(byte_t flags)
+{
+	byte_t req1[8] = { CAN_ASYNC_UL_START_REQUEST1, 'T', 'E', 'S', 'T', 'C', 'O', 'M' };
+	byte_t req2[8] = { CAN_ASYNC_UL_START_REQUEST2, 'P', 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 };
+	byte_t end_ackn[8] = { CAN_ASYNC_DL_END_ACKN, 0, 0, 0, 0, 0, 0, 0 };
+
+	req2[5] = flags;
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_uload_start_request1(XLOAD_FD_TEST_MODULE_NR, req1));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_uload_start_request2(XLOAD_FD_TEST_MODULE_NR, req2));
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_uload_data_from_source(&uload_read, XLOAD_FD_TEST_ULOAD_SIZE));
+	li_can_slv_uload_process();
+	XTFW_ASSERT_EQUAL_UINT16(XLOAD_FD_TEST_ULOAD_SIZE, uload_read_pos);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_uload_end_ackn(XLOAD_FD_TEST_MODULE_NR, end_ackn));
+}
+
+static void dload_test_log_open(char *file_name)
+{
+	can_main_hw_set_log_file_name(file_name);
+	if (can_main_hw_log_open() == EXIT_FAILURE)
+	{
+		TEST_FAIL_MESSAGE("log open fails");
+	}
+}
+
+static void dload_test_log_check(char *file_name, const char *exp_file_name)
+{
+	char file_path[_MAX_PATH];
+
+	can_main_hw_log_close();
+	XTFW_ASSERT_EQUAL_INT(1, doesFileExist(file_name));
+
+	/* compare file content */
+	get_expected_file_path(exp_file_name, file_path);
+	TEST_ASSERT_BINARY_FILE(file_path, file_name);
+}
+
+static int doesFileExist(const char *filename)
+{
+	struct stat st;
+	int result = stat(filename, &st);
+	return result == 0;
+}
+
+static void get_expected_file_path(const char *filename, char *filepath)
+{
+	char drive[_MAX_DRIVE];
+	char dir[_MAX_DIR];
+	char fname[_MAX_FNAME];
+
+	_splitpath(Unity.TestFile, drive, dir, NULL, NULL);
+	strcpy(fname, drive);
+	strcat(fname, dir);
+	strcat(fname, "..\\expected\\file\\");
+	strcat(fname, filename);
+	strcpy(filepath, fname);
+}
+
+/** @} */
@@ -0,0 +1,692 @@
+/****************************************************************************/
+/*                                                                          */
+/*                     Copyright (c) 2018, Liebherr PME1                    */
+/*                         ALL RIGHTS RESERVED                              */
+/*                                                                          */
+/* This file is part of li_can_slv stack which is free software: you can    */
+/* redistribute it and/or modify it under the terms of the GNU General      */
+/* Public License as published by the Free Software Foundation, either      */
+/* version 3 of the License, or (at your option) any later version.         */
+/*                                                                          */
+/* The li_can_slv stack is distributed in the hope that it will be useful,  */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of           */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General */
+/* Public License for more details.                                         */
+/*                                                                          */
+/* You should have received a copy of the GNU General Public License which  */
+/* should be located in the the root of the Stack. If not, contact Liebherr */
+/* to obtain a copy.                                                        */
+/****************************************************************************/
+
+/**
+ * @file li_can_slv_xload_test.c
+ * @addtogroup unittest
+ * @{
+ */
+
+/*--------------------------------------------------------------------------*/
+/* include files                                                            */
+/*--------------------------------------------------------------------------*/
+#include "unity_config.h"
+#include "unity.h"
+#include "xtfw.h"
+
+#include <li_can_slv/api/li_can_slv_api.h>
+
+// add some logical modules here as c include for test only
+#include "io_app_frc2.c"
+#include "io_app_incx.c"
+#include "io_app_inxy.c"
+#include "io_app_ma_w.c"
+
+// used for the logging of the can output
+#include "io_can_hw.h"
+#include "io_can_main_hw.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <windows.h>
+
+#include <string.h>
+
+#include <li_can_slv/xload/li_can_slv_xload.h>
+#include <li_can_slv/xload/li_can_slv_xload_buffer.h>
+#include <li_can_slv/xload/li_can_slv_xload_crc16.h>
+#include <li_can_slv/async/io_can_async.h>
+#include <li_can_slv/error/io_can_errno.h>
+
+#include "unittest_canpie-fd.h"
+
+/*--------------------------------------------------------------------------*/
+/* general definitions (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+#define XLOAD_TEST_MODULE_NR	APP_FRC2_MODULE_NR_DEF /**< module of the downloads */
+#define XLOAD_TEST_BLOCK_OBJS	2 /**< data objects of a block */
+#define XLOAD_TEST_BLOCK_SIZE	(XLOAD_TEST_BLOCK_OBJS * (CAN_DLC_MAX - 1)) /**< bytes of a block */
+#define XLOAD_TEST_IMAGE_SIZE	(512) /**< size of the programmed image */
+#define XLOAD_TEST_ULOAD_SIZE	(20) /**< size of the uploaded component, the last data object is filled up */
+
+/*--------------------------------------------------------------------------*/
+/* structure/type definitions (private/not exported)                        */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (public/exported)                                       */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------*/
+/* global variables (private/not exported)                                  */
+/*--------------------------------------------------------------------------*/
+static lcsa_errorcode_t err = LCSA_ERROR_OK;
+static uint16_t block_end_cnt = 0;
+static uint16_t max_bytes_per_block = LI_CAN_SLV_XLOAD_MAX_BYTES_PER_BLOCK_DLOAD; /**< maximum bytes per block of the start acknowledge */
+static uint16_t image_len = 0;
+static byte_t image[XLOAD_TEST_IMAGE_SIZE];
+static uint16_t uload_progress_cnt = 0;
+static uint16_t uload_progress_bytes = 0;
+static uint16_t uload_block_sent_cnt = 0;
+static li_can_slv_errorcode_t uload_block_sent_err = LI_CAN_SLV_ERR_OK;
+
+/*--------------------------------------------------------------------------*/
+/* function prototypes (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+static li_can_slv_errorcode_t dload_start_request_hdl(li_can_slv_xload_component_t *dload_component);
+static li_can_slv_errorcode_t dload_data_block_end_hdl(li_can_slv_xload_component_t *dload_component);
+static li_can_slv_errorcode_t dload_end_hdl(li_can_slv_xload_component_t *dload_component, li_can_slv_xload_end_handle_status_t *status);
+static li_can_slv_errorcode_t uload_start_request_hdl(li_can_slv_xload_component_t *uload_component);
+static void uload_progress_hdl(li_can_slv_xload_component_t *uload_component, uint16_t bytes_sent, uint16_t data_length);
+static void uload_block_sent_hdl(li_can_slv_xload_component_t *uload_component, li_can_slv_errorcode_t err);
+
+static void dload_test_start(uint16_t crc);
+static void dload_test_fill(byte_t *dst, byte_t first);
+static li_can_slv_errorcode_t dload_test_block(byte_t first, byte_t seq, byte_t flags);
+static li_can_slv_errorcode_t dload_test_lz_block(const byte_t *data, uint16_t len);
+static void uload_test_start(void);
+static void dload_test_log_open(char *file_name);
+static void dload_test_log_check(char *file_name, const char *exp_file_name);
+
+static int doesFileExist(const char *filename);
+static void get_expected_file_path(const char *filename, char *filepath);
+
+/*--------------------------------------------------------------------------*/
+/* function definition (public/exported)                                    */
+/*--------------------------------------------------------------------------*/
+// setUp will be called before each test
+void setUp(void)
+{
+	static uint8_t init_once = 0;
+
+	if (init_once != 1)
+	{
+		init_once = 1;
+
+		err = lcsa_init(LCSA_BAUD_RATE_DEFAULT);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = app_frc2_init(APP_FRC2_MODULE_NR_DEF);
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = lcsa_start();
+		XTFW_ASSERT_EQUAL_UINT(LCSA_ERROR_OK, err);
+
+		err = lcsa_dload_set_start_request_handle(&dload_start_request_hdl);
+		err = lcsa_dload_set_data_block_end_handle(&dload_data_block_end_hdl);
+		err = lcsa_dload_set_end_handle(&dload_end_hdl);
+		err = lcsa_uload_set_start_request_handle(&uload_start_request_hdl);
+		err = lcsa_uload_set_progress_handle(&uload_progress_hdl);
+		err = lcsa_uload_set_block_sent_handle(&uload_block_sent_hdl);
+	}
+
+	block_end_cnt = 0;
+	max_bytes_per_block = LI_CAN_SLV_XLOAD_MAX_BYTES_PER_BLOCK_DLOAD;
+	uload_progress_cnt = 0;
+	uload_progress_bytes = 0;
+	uload_block_sent_cnt = 0;
+	uload_block_sent_err = LI_CAN_SLV_ERR_OK;
+	image_len = 0;
+	memset(image, 0x00, sizeof(image));
+}
+
+// tearDown will be called after each test
+void tearDown(void)
+{
+
+}
+
+/**
+ * @test test_dload_window_in_order
+ * @brief numbered blocks received in order are programmed and acknowledged with their number
+ */
+void test_dload_window_in_order(void)
+{
+	byte_t exp[3 * XLOAD_TEST_BLOCK_SIZE];
+
+	dload_test_fill(&exp[0], 0x00);
+	dload_test_fill(&exp[XLOAD_TEST_BLOCK_SIZE], 0x10);
+	dload_test_fill(&exp[2 * XLOAD_TEST_BLOCK_SIZE], 0x20);
+
+	dload_test_log_open("_tc_dload_window_in_order.log");
+
+	dload_test_start(li_can_slv_xload_crc16_update(li_can_slv_xload_crc16_init(), exp, sizeof(exp)));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_block(0x00, 0, XLOAD_FLAG_WINDOW));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_block(0x10, 1, XLOAD_FLAG_WINDOW));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_block(0x20, 2, XLOAD_FLAG_WINDOW));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_end(XLOAD_TEST_MODULE_NR));
+
+	XTFW_ASSERT_EQUAL_UINT16(3, block_end_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(sizeof(exp), image_len);
+	XTFW_ASSERT_EQUAL_MEMORY(exp, image, sizeof(exp));
+
+	dload_test_log_check("_tc_dload_window_in_order.log", "tc_dload_window_in_order_exp.log");
+}
+
+/**
+ * @test test_dload_window_lost_block
+ * @brief the blocks after a lost block are dropped, the retransmission is requested once
+ */
+void test_dload_window_lost_block(void)
+{
+	byte_t exp[3 * XLOAD_TEST_BLOCK_SIZE];
+
+	dload_test_fill(&exp[0], 0x00);
+	dload_test_fill(&exp[XLOAD_TEST_BLOCK_SIZE], 0x10);
+	dload_test_fill(&exp[2 * XLOAD_TEST_BLOCK_SIZE], 0x20);
+
+	dload_test_log_open("_tc_dload_window_lost_block.log");
+
+	dload_test_start(li_can_slv_xload_crc16_update(li_can_slv_xload_crc16_init(), exp, sizeof(exp)));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_block(0x00, 0, XLOAD_FLAG_WINDOW));
+	// block 1 is lost, block 2 and 3 are dropped
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_block(0x20, 2, XLOAD_FLAG_WINDOW));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_block(0x30, 3, XLOAD_FLAG_WINDOW));
+	XTFW_ASSERT_EQUAL_UINT16(1, block_end_cnt);
+
+	// the master goes back to block 1
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_block(0x10, 1, XLOAD_FLAG_WINDOW));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_block(0x20, 2, XLOAD_FLAG_WINDOW));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_end(XLOAD_TEST_MODULE_NR));
+
+	XTFW_ASSERT_EQUAL_UINT16(3, block_end_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(sizeof(exp), image_len);
+	XTFW_ASSERT_EQUAL_MEMORY(exp, image, sizeof(exp));
+
+	dload_test_log_check("_tc_dload_window_lost_block.log", "tc_dload_window_lost_block_exp.log");
+}
+
+/**
+ * @test test_dload_window_duplicate_block
+ * @brief a block sent again after a lost acknowledge is acknowledged again but not programmed
+ */
+void test_dload_window_duplicate_block(void)
+{
+	byte_t exp[3 * XLOAD_TEST_BLOCK_SIZE];
+
+	dload_test_fill(&exp[0], 0x00);
+	dload_test_fill(&exp[XLOAD_TEST_BLOCK_SIZE], 0x10);
+	dload_test_fill(&exp[2 * XLOAD_TEST_BLOCK_SIZE], 0x20);
+
+	dload_test_log_open("_tc_dload_window_duplicate_block.log");
+
+	dload_test_start(li_can_slv_xload_crc16_update(li_can_slv_xload_crc16_init(), exp, sizeof(exp)));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_block(0x00, 0, XLOAD_FLAG_WINDOW));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_block(0x10, 1, XLOAD_FLAG_WINDOW));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_block(0x10, 1, XLOAD_FLAG_WINDOW));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_block(0x20, 2, XLOAD_FLAG_WINDOW));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_end(XLOAD_TEST_MODULE_NR));
+
+	XTFW_ASSERT_EQUAL_UINT16(3, block_end_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(sizeof(exp), image_len);
+	XTFW_ASSERT_EQUAL_MEMORY(exp, image, sizeof(exp));
+
+	dload_test_log_check("_tc_dload_window_duplicate_block.log", "tc_dload_window_duplicate_block_exp.log");
+}
+
+/**
+ * @test test_dload_window_out_of_window
+ * @brief a block outside of the window is dropped and the expected block is requested
+ */
+void test_dload_window_out_of_window(void)
+{
+	byte_t exp[2 * XLOAD_TEST_BLOCK_SIZE];
+
+	dload_test_fill(&exp[0], 0x00);
+	dload_test_fill(&exp[XLOAD_TEST_BLOCK_SIZE], 0x10);
+
+	dload_test_log_open("_tc_dload_window_out_of_window.log");
+
+	dload_test_start(li_can_slv_xload_crc16_update(li_can_slv_xload_crc16_init(), exp, sizeof(exp)));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_block(0x00, 0, XLOAD_FLAG_WINDOW));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_block(0x80, 0x80, XLOAD_FLAG_WINDOW));
+	XTFW_ASSERT_EQUAL_UINT16(1, block_end_cnt);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_block(0x10, 1, XLOAD_FLAG_WINDOW));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_end(XLOAD_TEST_MODULE_NR));
+
+	XTFW_ASSERT_EQUAL_UINT16(2, block_end_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(sizeof(exp), image_len);
+	XTFW_ASSERT_EQUAL_MEMORY(exp, image, sizeof(exp));
+
+	dload_test_log_check("_tc_dload_window_out_of_window.log", "tc_dload_window_out_of_window_exp.log");
+}
+
+/**
+ * @test test_dload_window_no_opt_in
+ * @brief a stop-and-wait master with padding in the data block end is not sequence checked
+ */
+void test_dload_window_no_opt_in(void)
+{
+	byte_t exp[2 * XLOAD_TEST_BLOCK_SIZE];
+
+	dload_test_fill(&exp[0], 0x00);
+	dload_test_fill(&exp[XLOAD_TEST_BLOCK_SIZE], 0x10);
+
+	dload_test_log_open("_tc_dload_window_no_opt_in.log");
+
+	dload_test_start(li_can_slv_xload_crc16_update(li_can_slv_xload_crc16_init(), exp, sizeof(exp)));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_block(0x00, 0x55, 0xAA));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_block(0x10, 0x55, 0xAA));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_end(XLOAD_TEST_MODULE_NR));
+
+	XTFW_ASSERT_EQUAL_UINT16(2, block_end_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(sizeof(exp), image_len);
+	XTFW_ASSERT_EQUAL_MEMORY(exp, image, sizeof(exp));
+
+	dload_test_log_check("_tc_dload_window_no_opt_in.log", "tc_dload_window_no_opt_in_exp.log");
+}
+
+/**
+ * @test test_dload_lz_literal
+ * @brief a compressed block of literals only is programmed as plain data
+ */
+void test_dload_lz_literal(void)
+{
+	const byte_t lz[] = { 0xFF, 'L', 'I', 'T', 'E', 'R', 'A', 'L', 'S', 0x03, 'O', 'K' };
+	const byte_t exp[] = { 'L', 'I', 'T', 'E', 'R', 'A', 'L', 'S', 'O', 'K' };
+
+	dload_test_log_open("_tc_dload_lz_literal.log");
+
+	dload_test_start(li_can_slv_xload_crc16_update(li_can_slv_xload_crc16_init(), exp, sizeof(exp)));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_lz_block(lz, sizeof(lz)));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_end(XLOAD_TEST_MODULE_NR));
+
+	XTFW_ASSERT_EQUAL_UINT16(1, block_end_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(sizeof(exp), image_len);
+	XTFW_ASSERT_EQUAL_MEMORY(exp, image, sizeof(exp));
+
+	dload_test_log_check("_tc_dload_lz_literal.log", "tc_dload_lz_literal_exp.log");
+}
+
+/**
+ * @test test_dload_lz_match_across_blocks
+ * @brief a match split between two blocks is decompressed with the window of the previous block
+ */
+void test_dload_lz_match_across_blocks(void)
+{
+	// literals 1 to 4, a match of 8 bytes at offset 4 split after its first byte, literals 5 to 7
+	const byte_t lz1[] = { 0xEF, 0x01, 0x02, 0x03, 0x04, 0x03 };
+	const byte_t lz2[] = { 0x05, 0x05, 0x06, 0x07 };
+	const byte_t exp[] = { 0x01, 0x02, 0x03, 0x04, 0x01, 0x02, 0x03, 0x04, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 };
+
+	dload_test_log_open("_tc_dload_lz_match_across_blocks.log");
+
+	dload_test_start(li_can_slv_xload_crc16_update(li_can_slv_xload_crc16_init(), exp, sizeof(exp)));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_lz_block(lz1, sizeof(lz1)));
+	XTFW_ASSERT_EQUAL_UINT16(4, image_len);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_lz_block(lz2, sizeof(lz2)));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_end(XLOAD_TEST_MODULE_NR));
+
+	XTFW_ASSERT_EQUAL_UINT16(2, block_end_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(sizeof(exp), image_len);
+	XTFW_ASSERT_EQUAL_MEMORY(exp, image, sizeof(exp));
+
+	dload_test_log_check("_tc_dload_lz_match_across_blocks.log", "tc_dload_lz_match_across_blocks_exp.log");
+}
+
+/**
+ * @test test_dload_lz_bad_offset
+ * @brief a match pointing before the first decompressed byte terminates the download
+ */
+void test_dload_lz_bad_offset(void)
+{
+	// a literal followed by a match at offset 2
+	const byte_t lz[] = { 0xFD, 0xAA, 0x01, 0x00 };
+
+	dload_test_log_open("_tc_dload_lz_bad_offset.log");
+
+	dload_test_start(0x0000);
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_DLOAD_LZ_FORMAT, dload_test_lz_block(lz, sizeof(lz)));
+	XTFW_ASSERT_EQUAL_UINT16(0, block_end_cnt);
+
+	dload_test_log_check("_tc_dload_lz_bad_offset.log", "tc_dload_lz_bad_offset_exp.log");
+}
+
+/**
+ * @test test_dload_lz_block_overflow
+ * @brief a compressed block decompressing to more than the block buffer terminates the download
+ */
+void test_dload_lz_block_overflow(void)
+{
+	// a literal followed by 15 matches of 18 bytes at offset 1 are 271 bytes
+	const byte_t lz[] = { 0x01, 0x55, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x0F,
+			0x00, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x0F };
+
+	dload_test_log_open("_tc_dload_lz_block_overflow.log");
+
+	dload_test_start(0x0000);
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_DLOAD_BUF_OVERFLOW, dload_test_lz_block(lz, sizeof(lz)));
+	XTFW_ASSERT_EQUAL_UINT16(0, block_end_cnt);
+
+	dload_test_log_check("_tc_dload_lz_block_overflow.log", "tc_dload_lz_block_overflow_exp.log");
+}
+
+/**
+ * @test test_dload_lz_max_bytes_per_block
+ * @brief a compressed block decompressing to more than the maximum bytes per block of the start acknowledge
+ * terminates the download
+ */
+void test_dload_lz_max_bytes_per_block(void)
+{
+	const byte_t lz[] = { 0xFF, 'L', 'I', 'T', 'E', 'R', 'A', 'L', 'S', 0x03, 'O', 'K' };
+
+	dload_test_log_open("_tc_dload_lz_max_bytes_per_block.log");
+
+	max_bytes_per_block = 8;
+	dload_test_start(0x0000);
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_DLOAD_BUF_OVERFLOW, dload_test_lz_block(lz, sizeof(lz)));
+	XTFW_ASSERT_EQUAL_UINT16(0, block_end_cnt);
+
+	dload_test_log_check("_tc_dload_lz_max_bytes_per_block.log", "tc_dload_lz_max_bytes_per_block_exp.log");
+}
+
+/**
+ * @test test_dload_crc_bad
+ * @brief a download with a CRC different from the download start request is terminated at the end
+ */
+void test_dload_crc_bad(void)
+{
+	byte_t exp[XLOAD_TEST_BLOCK_SIZE];
+
+	dload_test_fill(&exp[0], 0x00);
+
+	dload_test_log_open("_tc_dload_crc_bad.log");
+
+	dload_test_start(li_can_slv_xload_crc16_update(li_can_slv_xload_crc16_init(), exp, sizeof(exp)) ^ 0x0001u);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, dload_test_block(0x00, 0, 0));
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_DLOAD_BAD_CRC, li_can_slv_dload_end(XLOAD_TEST_MODULE_NR));
+
+	dload_test_log_check("_tc_dload_crc_bad.log", "tc_dload_crc_bad_exp.log");
+}
+
+/**
+ * @test test_uload_process
+ * @brief a started upload block is sent by li_can_slv_uload_process(), which reports the progress and the end of the
+ * block
+ */
+void test_uload_process(void)
+{
+	byte_t data[XLOAD_TEST_ULOAD_SIZE];
+	byte_t end_ackn[8] = { CAN_ASYNC_DL_END_ACKN, 0, 0, 0, 0, 0, 0, 0 };
+	uint16_t i;
+
+	for (i = 0; i < sizeof(data); i++)
+	{
+		data[i] = (byte_t)(0x30 + i);
+	}
+
+	dload_test_log_open("_tc_uload_process.log");
+
+	uload_test_start();
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_uload_data_from_buffer_start(data, sizeof(data)));
+	XTFW_ASSERT_EQUAL_UINT(ERR_MSG_CAN_DLOAD_IN_PROGRESS, li_can_slv_uload_data_from_buffer_start(data, sizeof(data)));
+	XTFW_ASSERT_EQUAL_UINT16(0, uload_progress_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(0, uload_block_sent_cnt);
+
+	// the block of 20 bytes is sent in 3 data objects followed by the data block end
+	li_can_slv_uload_process();
+	XTFW_ASSERT_EQUAL_UINT16(3, uload_progress_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(sizeof(data), uload_progress_bytes);
+	XTFW_ASSERT_EQUAL_UINT16(1, uload_block_sent_cnt);
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, uload_block_sent_err);
+
+	// a finished block does not send anything
+	li_can_slv_uload_process();
+	XTFW_ASSERT_EQUAL_UINT16(3, uload_progress_cnt);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_uload_end_ackn(XLOAD_TEST_MODULE_NR, end_ackn));
+
+	dload_test_log_check("_tc_uload_process.log", "tc_uload_process_exp.log");
+}
+
+/**
+ * @test test_uload_data_from_buffer
+ * @brief li_can_slv_uload_data_from_buffer() returns after the whole block is queued
+ */
+void test_uload_data_from_buffer(void)
+{
+	byte_t data[XLOAD_TEST_ULOAD_SIZE];
+	byte_t end_ackn[8] = { CAN_ASYNC_DL_END_ACKN, 0, 0, 0, 0, 0, 0, 0 };
+	uint16_t i;
+
+	for (i = 0; i < sizeof(data); i++)
+	{
+		data[i] = (byte_t)(0x30 + i);
+	}
+
+	dload_test_log_open("_tc_uload_data_from_buffer.log");
+
+	uload_test_start();
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_uload_data_from_buffer(data, sizeof(data)));
+	XTFW_ASSERT_EQUAL_UINT16(3, uload_progress_cnt);
+	XTFW_ASSERT_EQUAL_UINT16(1, uload_block_sent_cnt);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_uload_end_ackn(XLOAD_TEST_MODULE_NR, end_ackn));
+
+	dload_test_log_check("_tc_uload_data_from_buffer.log", "tc_uload_data_from_buffer_exp.log");
+}
+
+/*--------------------------------------------------------------------------*/
+/* function definition (private/not exported)                               */
+/*--------------------------------------------------------------------------*/
+static li_can_slv_errorcode_t dload_start_request_hdl(li_can_slv_xload_component_t *dload_component)
+{
+	return (li_can_slv_dload_start_ackn(dload_component->module_nr, max_bytes_per_block, 0));
+}
+
+static li_can_slv_errorcode_t dload_data_block_end_hdl(li_can_slv_xload_component_t *dload_component)
+{
+	li_can_slv_errorcode_t rc;
+	uint16_t len;
+
+	dload_component = dload_component;
+
+	rc = xload_buffer_get_len(&len);
+	if ((rc == LI_CAN_SLV_ERR_OK) && ((image_len + len) <= XLOAD_TEST_IMAGE_SIZE))
+	{
+		rc = xload_buffer_get_bytes(&image[image_len], len);
+		image_len += len;
+	}
+	block_end_cnt++;
+	return (rc);
+}
+
+static li_can_slv_errorcode_t dload_end_hdl(li_can_slv_xload_component_t *dload_component, li_can_slv_xload_end_handle_status_t *status)
+{
+	dload_component = dload_component;
+	*status = LI_CAN_SLV_XLOAD_STACK_END_HANDLING;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+static li_can_slv_errorcode_t uload_start_request_hdl(li_can_slv_xload_component_t *uload_component)
+{
+	uload_component = uload_component;
+	return (LI_CAN_SLV_ERR_OK);
+}
+
+static void uload_progress_hdl(li_can_slv_xload_component_t *uload_component, uint16_t bytes_sent, uint16_t data_length)
+{
+	uload_component = uload_component;
+	data_length = data_length;
+	uload_progress_cnt++;
+	uload_progress_bytes = bytes_sent;
+}
+
+static void uload_block_sent_hdl(li_can_slv_xload_component_t *uload_component, li_can_slv_errorcode_t err)
+{
+	uload_component = uload_component;
+	uload_block_sent_cnt++;
+	uload_block_sent_err = err;
+}
+
+/**
+ * @brief sends the upload start request of the component TESTCOMP
+ */
+static void uload_test_start(void)
+{
+	byte_t req1[8] = { CAN_ASYNC_UL_START_REQUEST1, 'T', 'E', 'S', 'T', 'C', 'O', 'M' };
+	byte_t req2[8] = { CAN_ASYNC_UL_START_REQUEST2, 'P', 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_uload_start_request1(XLOAD_TEST_MODULE_NR, req1));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_uload_start_request2(XLOAD_TEST_MODULE_NR, req2));
+}
+
+/**
+ * @brief sends the download start request of the component TESTCOMP
+ * @param crc CRC16 of the component
+ */
+static void dload_test_start(uint16_t crc)
+{
+	byte_t req1[8] = { CAN_ASYNC_DL_START_REQUEST1, 'T', 'E', 'S', 'T', 'C', 'O', 'M' };
+	byte_t req2[8] = { CAN_ASYNC_DL_START_REQUEST2, 'P', 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 };
+
+	req2[2] = (byte_t)(crc >> 8);
+	req2[3] = (byte_t)(crc & 0x00FFu);
+
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_start_request1(XLOAD_TEST_MODULE_NR, req1));
+	XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_start_request2(XLOAD_TEST_MODULE_NR, req2));
+}
+
+/**
+ * @brief sends the data objects and the data block end of one block
+ * @param first value of the first byte of the block, the following bytes are counted up
+ * @param seq number of the block in byte 6 of the data block end
+ * @param flags byte 7 of the data block end
+ * @return return value of li_can_slv_dload_data_block_end()
+ */
+static li_can_slv_errorcode_t dload_test_block(byte_t first, byte_t seq, byte_t flags)
+{
+	byte_t data[XLOAD_TEST_BLOCK_SIZE];
+	byte_t obj[8];
+	byte_t block_end[8] = { CAN_ASYNC_DL_DATA_BLOCK_END, 0, XLOAD_TEST_BLOCK_SIZE, 0, XLOAD_TEST_BLOCK_OBJS, 0, 0, 0 };
+	uint16_t i;
+
+	dload_test_fill(data, first);
+	obj[0] = CAN_ASYNC_DL_DATA;
+	for (i = 0; i < XLOAD_TEST_BLOCK_OBJS; i++)
+	{
+		memcpy(&obj[1], &data[i * (CAN_DLC_MAX - 1)], CAN_DLC_MAX - 1);
+		XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_data(XLOAD_TEST_MODULE_NR, CAN_DLC_MAX, obj));
+	}
+
+	block_end[5] = seq;
+	block_end[6] = flags;
+	return (li_can_slv_dload_data_block_end(XLOAD_TEST_MODULE_NR, block_end));
+}
+
+/**
+ * @brief sends the compressed data objects and the data block end of one block, the last object is filled up
+ * @param[in] data compressed data of the block
+ * @param len number of compressed bytes
+ * @return return value of li_can_slv_dload_data_block_end()
+ */
+static li_can_slv_errorcode_t dload_test_lz_block(const byte_t *data, uint16_t len)
+{
+	byte_t obj[8];
+	byte_t block_end[8] = { CAN_ASYNC_DL_DATA_BLOCK_END, 0, 0, 0, 0, 0, 0, 0 };
+	uint16_t objs = 0;
+	uint16_t i;
+	uint16_t n;
+
+	obj[0] = CAN_ASYNC_DL_DATA_LZ;
+	for (i = 0; i < len; i += n)
+	{
+		n = len - i;
+		if (n > (CAN_DLC_MAX - 1))
+		{
+			n = CAN_DLC_MAX - 1;
+		}
+		memset(&obj[1], 0x00, CAN_DLC_MAX - 1);
+		memcpy(&obj[1], &data[i], n);
+		XTFW_ASSERT_EQUAL_UINT(LI_CAN_SLV_ERR_OK, li_can_slv_dload_data_lz(XLOAD_TEST_MODULE_NR, CAN_DLC_MAX, obj));
+		objs++;
+	}
+
+	block_end[1] = (byte_t)(len >> 8);
+	block_end[2] = (byte_t)(len & 0x00FFu);
+	block_end[3] = (byte_t)(objs >> 8);
+	block_end[4] = (byte_t)(objs & 0x00FFu);
+	return (li_can_slv_dload_data_block_end(XLOAD_TEST_MODULE_NR, block_end));
+}
+
+/**
+ * @brief fills the data of one block, the bytes are counted up
+ * @param[out] dst data of the block
+ * @param first value of the first byte
+ */
+static void dload_test_fill(byte_t *dst, byte_t first)
+{
+	uint16_t i;
+
+	for (i = 0; i < XLOAD_TEST_BLOCK_SIZE; i++)
+	{
+		dst[i] = first++;
+	}
+}
+
+static void dload_test_log_open(char *file_name)
+{
+	can_main_hw_set_log_file_name(file_name);
+	if (can_main_hw_log_open() == EXIT_FAILURE)
+	{
+		TEST_FAIL_MESSAGE("log open fails");
+	}
+}
+
+static void dload_test_log_check(char *file_name, const char *exp_file_name)
+{
+	char file_path[_MAX_PATH];
+
+	can_main_hw_log_close();
+	XTFW_ASSERT_EQUAL_INT(1, doesFileExist(file_name));
+
+	/* compare file content */
+	get_expected_file_path(exp_file_name, file_path);
+	TEST_ASSERT_BINARY_FILE(file_path, file_name);
+}
+
+static int doesFileExist(const char *filename)
+{
+	struct stat st;
+	int result = stat(filename, &st);
+	return result == 0;
+}
+
+static void get_expected_file_path(const char *filename, char *filepath)
+{
+	char drive[_MAX_DRIVE];
+	char dir[_MAX_DIR];
+	char fname[_MAX_FNAME];
+
+	_splitpath(Unity.TestFile, drive, dir, NULL, NULL);
+	strcpy(fname, drive);
+	strcat(fname, dir);
+	strcat(fname, "..\\expected\\file\\");
+	strcat(fname, filename);
+	strcpy(filepath, fname);
+}
+
+/** @} */
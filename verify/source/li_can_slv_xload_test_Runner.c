@@ -0,0 +1,87 @@
+/* AUTOGENERATED FILE. DO NOT EDIT. */
+
+/*=======Test Runner Used To Run Each Test Below=====*/
+#define RUN_TEST(TestFunc, TestLineNum) \
+{ \
+  Unity.CurrentTestName = #TestFunc; \
+  Unity.CurrentTestLineNumber = TestLineNum; \
+  Unity.NumberOfTests++; \
+  if (TEST_PROTECT()) \
+  { \
+      setUp(); \
+      TestFunc(); \
+  } \
+  if (TEST_PROTECT()) \
+  { \
+    tearDown(); \
+  } \
+  UnityConcludeTest(); \
+}
+
+/*=======Automagically Detected Files To Include=====*/
+#include "unity.h"
+#include <setjmp.h>
+#include <stdio.h>
+#include "xtfw.h"
+#include "io_can_hw.h"
+#include "io_can_main_hw.h"
+#include "unittest_canpie-fd.h"
+#include <li_can_slv/api/li_can_slv_api.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <windows.h>
+#include <string.h>
+#include <li_can_slv/xload/li_can_slv_xload.h>
+#include <li_can_slv/xload/li_can_slv_xload_buffer.h>
+#include <li_can_slv/xload/li_can_slv_xload_crc16.h>
+#include <li_can_slv/async/io_can_async.h>
+#include <li_can_slv/error/io_can_errno.h>
+
+/*=======External Functions This Runner Calls=====*/
+extern void setUp(void);
+extern void tearDown(void);
+extern void test_dload_window_in_order(void);
+extern void test_dload_window_lost_block(void);
+extern void test_dload_window_duplicate_block(void);
+extern void test_dload_window_out_of_window(void);
+extern void test_dload_window_no_opt_in(void);
+extern void test_dload_lz_literal(void);
+extern void test_dload_lz_match_across_blocks(void);
+extern void test_dload_lz_bad_offset(void);
+extern void test_dload_lz_block_overflow(void);
+extern void test_dload_lz_max_bytes_per_block(void);
+extern void test_dload_crc_bad(void);
+extern void test_uload_process(void);
+extern void test_uload_data_from_buffer(void);
+
+
+/*=======Test Reset Option=====*/
+void resetTest(void);
+void resetTest(void)
+{
+  tearDown();
+  setUp();
+}
+
+
+/*=======MAIN=====*/
+int main(void)
+{
+  UnityBegin("/root/repo/verify/source/li_can_slv_xload_test.c");
+  RUN_TEST(test_dload_window_in_order, 162);
+  RUN_TEST(test_dload_window_lost_block, 189);
+  RUN_TEST(test_dload_window_duplicate_block, 222);
+  RUN_TEST(test_dload_window_out_of_window, 250);
+  RUN_TEST(test_dload_window_no_opt_in, 278);
+  RUN_TEST(test_dload_lz_literal, 303);
+  RUN_TEST(test_dload_lz_match_across_blocks, 325);
+  RUN_TEST(test_dload_lz_bad_offset, 351);
+  RUN_TEST(test_dload_lz_block_overflow, 369);
+  RUN_TEST(test_dload_lz_max_bytes_per_block, 388);
+  RUN_TEST(test_dload_crc_bad, 407);
+  RUN_TEST(test_uload_process, 426);
+  RUN_TEST(test_uload_data_from_buffer, 466);
+
+  return (UnityEnd());
+}